@@ -0,0 +1,102 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/error.h>
+#include <quick-lint-js/narrow-cast.h>
+#include <quick-lint-js/output-stream.h>
+#include <quick-lint-js/padded-string.h>
+#include <quick-lint-js/text-error-reporter.h>
+#include <quick-lint-js/vim-qflist-json-error-reporter.h>
+#include <vector>
+
+namespace quick_lint_js {
+namespace {
+// Discards output, but counts the bytes so the benchmark can report
+// throughput.
+class null_output_stream final : public output_stream {
+ public:
+  std::size_t flushed_size() const noexcept { return this->flushed_size_; }
+
+ protected:
+  void flush_impl(string8_view data) override {
+    ::benchmark::DoNotOptimize(data.data());
+    this->flushed_size_ += data.size();
+  }
+
+ private:
+  std::size_t flushed_size_ = 0;
+};
+
+// Source code with many short lines, each containing an identifier.
+struct many_identifiers {
+  explicit many_identifiers(int line_count) {
+    string8 code;
+    for (int i = 0; i < line_count; ++i) {
+      code += u8"  someVariable;\n";
+    }
+    this->source = padded_string(std::move(code));
+    for (int i = 0; i < line_count; ++i) {
+      const char8 *begin = &this->source[i * 16 + 2];
+      this->identifiers.emplace_back(source_code_span(begin, begin + 12));
+    }
+  }
+
+  padded_string source;
+  std::vector<identifier> identifiers;
+};
+
+template <class Reporter>
+void report_all(Reporter &reporter, const many_identifiers &code) {
+  for (const identifier &name : code.identifiers) {
+    reporter.report(error_use_of_undeclared_variable{name});
+  }
+}
+
+void benchmark_text_error_reporter(::benchmark::State &state) {
+  many_identifiers code(narrow_cast<int>(state.range(0)));
+  null_output_stream output;
+  for (auto _ : state) {
+    text_error_reporter reporter(&output);
+    reporter.set_source(&code.source, /*file_name=*/"hello.js");
+    report_all(reporter, code);
+    reporter.flush();
+  }
+  state.SetItemsProcessed(narrow_cast<std::int64_t>(state.iterations()) *
+                          state.range(0));
+  state.SetBytesProcessed(narrow_cast<std::int64_t>(output.flushed_size()));
+}
+BENCHMARK(benchmark_text_error_reporter)->Arg(10)->Arg(10'000);
+
+void benchmark_vim_qflist_json_error_reporter(::benchmark::State &state) {
+  many_identifiers code(narrow_cast<int>(state.range(0)));
+  null_output_stream output;
+  for (auto _ : state) {
+    vim_qflist_json_error_reporter reporter(&output);
+    reporter.set_source(&code.source, /*file_name=*/"hello.js",
+                        /*vim_bufnr=*/42);
+    report_all(reporter, code);
+    reporter.finish();
+  }
+  state.SetItemsProcessed(narrow_cast<std::int64_t>(state.iterations()) *
+                          state.range(0));
+  state.SetBytesProcessed(narrow_cast<std::int64_t>(output.flushed_size()));
+}
+BENCHMARK(benchmark_vim_qflist_json_error_reporter)->Arg(10)->Arg(10'000);
+}
+}
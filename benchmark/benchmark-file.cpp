@@ -0,0 +1,95 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <quick-lint-js/file.h>
+#include <quick-lint-js/narrow-cast.h>
+#include <quick-lint-js/std-filesystem.h>
+#include <string>
+
+namespace quick_lint_js {
+namespace {
+class temporary_file {
+ public:
+  explicit temporary_file(std::size_t size)
+      : path_(filesystem::temp_directory_path() /
+              ("quick-lint-js-benchmark-file-" + std::to_string(size) +
+               ".js")) {
+    std::string line = "let x = y + z;  // a line of JavaScript\n";
+    std::string content;
+    content.reserve(size);
+    while (content.size() < size) {
+      content.append(line, 0, std::min(line.size(), size - content.size()));
+    }
+    std::ofstream file(this->path_, std::ios::binary);
+    file << content;
+    if (!file) {
+      std::fprintf(stderr, "fatal: failed to write %s\n",
+                   this->path_.string().c_str());
+      std::exit(1);
+    }
+  }
+
+  temporary_file(const temporary_file &) = delete;
+  temporary_file &operator=(const temporary_file &) = delete;
+
+  ~temporary_file() { filesystem::remove(this->path_); }
+
+  std::string path() const { return this->path_.string(); }
+
+ private:
+  filesystem::path path_;
+};
+
+void benchmark_read_file(::benchmark::State &state,
+                         read_file_strategy strategy) {
+  std::size_t size = narrow_cast<std::size_t>(state.range(0));
+  temporary_file file(size);
+  std::string path = file.path();
+
+  for (auto _ : state) {
+    read_file_result result = read_file(path.c_str(), strategy);
+    result.exit_if_not_ok();
+    // Touch every page, like the lexer would.
+    padded_string_view view = result.content.view();
+    for (std::size_t i = 0; i < size; i += 4096) {
+      ::benchmark::DoNotOptimize(view.data()[i]);
+    }
+  }
+
+  double iteration_count = static_cast<double>(state.iterations());
+  state.counters["bytes"] =
+      ::benchmark::Counter(static_cast<double>(size) * iteration_count,
+                           ::benchmark::Counter::kIsRate);
+}
+BENCHMARK_CAPTURE(benchmark_read_file, read, read_file_strategy::read)
+    ->RangeMultiplier(10)
+    ->Range(1'000, 100'000'000)->Arg(20'000'000)->Arg(40'000'000);
+BENCHMARK_CAPTURE(benchmark_read_file, memory_map,
+                  read_file_strategy::memory_map)
+    ->RangeMultiplier(10)
+    ->Range(1'000, 100'000'000)->Arg(20'000'000)->Arg(40'000'000);
+BENCHMARK_CAPTURE(benchmark_read_file, automatic,
+                  read_file_strategy::automatic)
+    ->RangeMultiplier(10)
+    ->Range(1'000, 100'000'000)->Arg(20'000'000)->Arg(40'000'000);
+}  // namespace
+}  // namespace quick_lint_js
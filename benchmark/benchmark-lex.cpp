@@ -14,14 +14,50 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
+#include <algorithm>
 #include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <quick-lint-js/char8.h>
 #include <quick-lint-js/error.h>
+#include <quick-lint-js/file.h>
+#include <quick-lint-js/lex-simd.h>
+#include <quick-lint-js/lex-structural-index.h>
+#include <quick-lint-js/lex-token-stream.h>
 #include <quick-lint-js/lex.h>
+#include <quick-lint-js/narrow-cast.h>
 #include <quick-lint-js/padded-string.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
 
 namespace quick_lint_js {
 namespace {
+const char8 jquery_snippet[] = u8R"(/*!
+ * Copyright JS Foundation and other contributors
+ * Released under the MIT license
+ * https://jquery.org/license
+ *
+ * Date: 2020-05-04T22:49Z
+ */
+function buildFragment( elems, context, scripts, selection, ignored ) {
+	var elem, tmp, tag, wrap, attached, j,
+		fragment = context.createDocumentFragment(),
+		nodes = [],
+		i = 0,
+		l = elems.length;
+
+	for ( ; i < l; i++ ) {
+		elem = elems[ i ];
+
+		if ( elem || elem === 0 ) {
+
+			// Add nodes directly
+			if ( toType( elem ) === "object" ) {
+)";
+
 void benchmark_lex(::benchmark::State &state, const char8 *raw_source) {
   padded_string source(raw_source);
   for (auto _ : state) {
@@ -55,28 +91,486 @@ BENCHMARK_CAPTURE(benchmark_lex, long_identifier_1,
                   u8"reenterHydrationStateFromDehydratedSuspenseInstance");
 BENCHMARK_CAPTURE(benchmark_lex, long_identifier_2,
                   u8"didWarnAboutGetSnapshotBeforeUpdateWithoutDidUpdate");
-BENCHMARK_CAPTURE(benchmark_lex, jquery_snippet,
-                  u8R"(/*!
- * Copyright JS Foundation and other contributors
- * Released under the MIT license
- * https://jquery.org/license
- *
- * Date: 2020-05-04T22:49Z
- */
-function buildFragment( elems, context, scripts, selection, ignored ) {
-	var elem, tmp, tag, wrap, attached, j,
-		fragment = context.createDocumentFragment(),
-		nodes = [],
-		i = 0,
-		l = elems.length;
+BENCHMARK_CAPTURE(benchmark_lex, jquery_snippet, jquery_snippet);
+BENCHMARK_CAPTURE(benchmark_lex, short_block_comments,
+                  u8"/**/ x /* a */ x /* b c */ x /* short comment */ x");
+BENCHMARK_CAPTURE(
+    benchmark_lex, long_block_comment,
+    u8"/* Returns the position of the first character which is not part of the "
+    u8"identifier. The identifier must not contain escape sequences; call "
+    u8"parse_identifier_slow for those instead. */ x");
+BENCHMARK_CAPTURE(benchmark_lex, keyword_heavy,
+                  u8R"(export default class Parser extends Base {
+  static async *parse(input) {
+    if (input === null || typeof input !== "object") return false;
+    for (const key in input) {
+      if (key instanceof Error) throw new TypeError(key);
+      else if (this.super) continue;
+      let value = await input[key];
+      switch (value) { case true: break; default: yield void value; }
+    }
+    try { delete input.x; } catch (e) { debugger; } finally { var done = true; }
+    do { var items = new Set(); } while (false);
+    import("module").then(function (module) { with (module) return this; });
+    return get, set, from, of, as;
+  }
+}
+)");
+BENCHMARK_CAPTURE(benchmark_lex, accented_identifiers,
+                  u8R"(const résumé = créerDocument(thème, entête);
+for (const élément of résumé.éléments) {
+  const durée = élément.début - élément.fin;
+  total = total + durée * coefficientÉté;
+}
+)");
+BENCHMARK_CAPTURE(benchmark_lex, cjk_identifiers,
+                  u8R"(const 用户名 = 获取用户(标识符);
+for (const 项目 of 用户名.购物车) {
+  const 价格 = 项目.单价 * 项目.数量;
+  合计 = 合计 + 价格;
+  表示する(項目名, 価格);
+}
+)");
 
-	for ( ; i < l; i++ ) {
-		elem = elems[ i ];
+void set_byte_counters(::benchmark::State &state, int bytes_per_iteration) {
+  double iteration_count = static_cast<double>(state.iterations());
+  state.counters["bytes"] = ::benchmark::Counter(
+      bytes_per_iteration * iteration_count, ::benchmark::Counter::kIsRate);
+}
 
-		if ( elem || elem === 0 ) {
+// token_bytes is the memory needed to keep one token.
+void set_token_counters(::benchmark::State &state, int tokens_per_iteration,
+                        double token_bytes) {
+  double iteration_count = static_cast<double>(state.iterations());
+  state.counters["tokens"] = ::benchmark::Counter(
+      tokens_per_iteration * iteration_count, ::benchmark::Counter::kIsRate);
+  state.counters["token_bytes"] = token_bytes;
+}
 
-			// Add nodes directly
-			if ( toType( elem ) === "object" ) {
-)");
+void benchmark_lex_pull_tokens(::benchmark::State &state,
+                               padded_string_view source) {
+  int token_count = 0;
+  for (auto _ : state) {
+    token_count = 0;
+    lexer l(source, &null_error_reporter::instance);
+    while (l.peek().type != token_type::end_of_file) {
+      ::benchmark::DoNotOptimize(l.peek());
+      l.skip();
+      token_count += 1;
+    }
+  }
+  set_byte_counters(state, narrow_cast<int>(source.null_terminator() -
+                                            source.data()));
+  set_token_counters(state, token_count, sizeof(token));
+}
+
+void benchmark_lex_token_stream(::benchmark::State &state,
+                                padded_string_view source) {
+  int token_count = 0;
+  std::size_t storage_size = 0;
+  for (auto _ : state) {
+    token_stream tokens =
+        token_stream::lex(source, &null_error_reporter::instance);
+    ::benchmark::DoNotOptimize(tokens);
+    token_count = tokens.size();
+    storage_size = tokens.storage_size();
+  }
+  set_byte_counters(state, narrow_cast<int>(source.null_terminator() -
+                                            source.data()));
+  set_token_counters(
+      state, token_count,
+      static_cast<double>(storage_size) / static_cast<double>(token_count));
+}
+
+void benchmark_lex_token_stream_in_parallel(::benchmark::State &state,
+                                            padded_string_view source,
+                                            int thread_count, int chunk_size) {
+  int token_count = 0;
+  std::size_t storage_size = 0;
+  for (auto _ : state) {
+    token_stream tokens = token_stream::lex_in_parallel(
+        source, &null_error_reporter::instance, thread_count, chunk_size);
+    ::benchmark::DoNotOptimize(tokens);
+    token_count = tokens.size();
+    storage_size = tokens.storage_size();
+  }
+  set_byte_counters(state, narrow_cast<int>(source.null_terminator() -
+                                            source.data()));
+  set_token_counters(
+      state, token_count,
+      static_cast<double>(storage_size) / static_cast<double>(token_count));
+  state.counters["threads"] = thread_count;
+}
+
+void benchmark_lex_pull_tokens_jquery_snippet(::benchmark::State &state) {
+  padded_string source(jquery_snippet);
+  benchmark_lex_pull_tokens(state, &source);
+}
+BENCHMARK(benchmark_lex_pull_tokens_jquery_snippet);
+
+void benchmark_lex_token_stream_jquery_snippet(::benchmark::State &state) {
+  padded_string source(jquery_snippet);
+  benchmark_lex_token_stream(state, &source);
+}
+BENCHMARK(benchmark_lex_token_stream_jquery_snippet);
+
+// Lex about 1 MiB of code in 64 KiB chunks using state.range(0) threads.
+void benchmark_lex_token_stream_in_parallel_jquery_snippets(
+    ::benchmark::State &state) {
+  string8 source_text;
+  while (source_text.size() < 1024 * 1024) {
+    source_text += jquery_snippet;
+  }
+  padded_string source(std::move(source_text));
+  benchmark_lex_token_stream_in_parallel(
+      state, &source, narrow_cast<int>(state.range(0)),
+      /*chunk_size=*/64 * 1024);
+}
+BENCHMARK(benchmark_lex_token_stream_in_parallel_jquery_snippets)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4);
+
+// Lex a string literal whose body is state.range(0) bytes long, made by
+// repeating the given fragment.
+// The lexer rewrites escape sequences in place, so restore the source before
+// each iteration.
+void benchmark_lex_escaped_identifiers(::benchmark::State &state) {
+  string8_view original_source =
+      u8R"(var \u{61}lpha = b\u0065ta + gamm\u{61};
+c\u006fnsole.log(\u{61}lpha, b\u0065ta, gamm\u{61});
+)";
+  padded_string source{string8(original_source)};
+  for (auto _ : state) {
+    std::copy(original_source.begin(), original_source.end(), source.data());
+    lexer l(&source, &null_error_reporter::instance);
+    while (l.peek().type != token_type::end_of_file) {
+      l.skip();
+    }
+    ::benchmark::DoNotOptimize(l.peek().type);
+  }
+  set_byte_counters(state, narrow_cast<int>(original_source.size()));
+}
+BENCHMARK(benchmark_lex_escaped_identifiers);
+
+void benchmark_lex_long_string(::benchmark::State &state,
+                               const char8 *fragment) {
+  std::size_t length = static_cast<std::size_t>(state.range(0));
+  string8 body;
+  while (body.size() < length) {
+    body += fragment;
+  }
+  body.resize(length);
+  padded_string source(u8"'" + body + u8"'");
+  for (auto _ : state) {
+    lexer l(&source, &null_error_reporter::instance, lexer_strategy::direct);
+    ::benchmark::DoNotOptimize(l.peek().type);
+  }
+  set_byte_counters(state, source.size());
+}
+BENCHMARK_CAPTURE(benchmark_lex_long_string, ascii,
+                  u8"The quick brown fox jumps over the lazy dog. ")
+    ->Arg(16)
+    ->Arg(256)
+    ->Arg(4096);
+BENCHMARK_CAPTURE(benchmark_lex_long_string, utf_8,
+                  u8"いろはにほへと ちりぬるを ")
+    ->Arg(16)
+    ->Arg(256)
+    ->Arg(4096);
+
+enum class numeric_literal_style {
+  decimal,
+  hex,
+  floating_point,
+};
+
+// Lex an array literal of about 64 KiB of numbers, like a lookup table or an
+// embedded font.
+void benchmark_lex_numeric_array(::benchmark::State &state,
+                                 numeric_literal_style style) {
+  string8 code = u8"var table = [";
+  std::uint32_t seed = 12345;
+  while (code.size() < 64 * 1024) {
+    // Linear congruential generator (from Numerical Recipes).
+    seed = seed * 1664525 + 1013904223;
+    std::uint32_t value = seed >> (seed % 24);
+    std::string literal;
+    switch (style) {
+    case numeric_literal_style::decimal:
+      literal = std::to_string(value);
+      break;
+    case numeric_literal_style::hex: {
+      std::ostringstream stream;
+      stream << "0x" << std::hex << value;
+      literal = stream.str();
+      break;
+    }
+    case numeric_literal_style::floating_point:
+      literal = std::to_string(value) + "." + std::to_string(seed % 100000) +
+                "e-" + std::to_string(seed % 12);
+      break;
+    }
+    code += string8(literal.begin(), literal.end());
+    code += (seed & 0xf) == 0 ? u8",\n" : u8",";
+  }
+  code += u8"];\n";
+  padded_string source(std::move(code));
+  for (auto _ : state) {
+    lexer l(&source, &null_error_reporter::instance, lexer_strategy::direct);
+    while (l.peek().type != token_type::end_of_file) {
+      l.skip();
+    }
+    ::benchmark::DoNotOptimize(l.peek().type);
+  }
+  set_byte_counters(state, source.size());
+}
+BENCHMARK_CAPTURE(benchmark_lex_numeric_array, decimal,
+                  numeric_literal_style::decimal);
+BENCHMARK_CAPTURE(benchmark_lex_numeric_array, hex,
+                  numeric_literal_style::hex);
+BENCHMARK_CAPTURE(benchmark_lex_numeric_array, floating_point,
+                  numeric_literal_style::floating_point);
+
+void benchmark_skip_ascii_identifier_characters(
+    ::benchmark::State &state, const lex_simd_routines *routines) {
+  int length = static_cast<int>(state.range(0));
+  padded_string source(string8(static_cast<unsigned>(length), u8'x'));
+  for (auto _ : state) {
+    char8 *end = routines->skip_ascii_identifier_characters(source.data());
+    ::benchmark::DoNotOptimize(end);
+  }
+  set_byte_counters(state, length);
+}
+
+// Lex a template literal whose body is state.range(0) bytes long, made by
+// repeating the given fragment. Each '}' in the fragment must end a
+// substitution.
+void benchmark_lex_long_template(::benchmark::State &state,
+                                 const char8 *fragment) {
+  std::size_t length = static_cast<std::size_t>(state.range(0));
+  string8 body;
+  while (body.size() < length) {
+    body += fragment;
+  }
+  padded_string source(u8"`" + body + u8"`");
+  for (auto _ : state) {
+    lexer l(&source, &null_error_reporter::instance, lexer_strategy::direct);
+    const char8 *template_begin = l.peek().begin;
+    while (l.peek().type != token_type::end_of_file) {
+      if (l.peek().type == token_type::right_curly) {
+        l.skip_in_template(template_begin);
+      } else {
+        l.skip();
+      }
+    }
+    ::benchmark::DoNotOptimize(l.peek().type);
+  }
+  set_byte_counters(state, source.size());
+}
+BENCHMARK_CAPTURE(benchmark_lex_long_template, html,
+                  u8"<li class=\"item\"><a href=\"/docs/\">Docs</a></li>\n")
+    ->Arg(1024)
+    ->Arg(16384);
+BENCHMARK_CAPTURE(benchmark_lex_long_template, html_with_substitutions,
+                  u8"<li class=\"${cls}\"><a href=\"${url}\">${text}</a>"
+                  u8"</li>\n")
+    ->Arg(1024)
+    ->Arg(16384);
+
+// Lex pretty-printed code nested state.range(0) blocks deep, indented with
+// two spaces per level.
+void benchmark_lex_deeply_indented(::benchmark::State &state) {
+  int depth = static_cast<int>(state.range(0));
+  string8 code;
+  for (int i = 0; i < depth; ++i) {
+    string8 indentation(static_cast<unsigned>(i * 2), u8' ');
+    code += indentation + u8"// Check the next level.\n";
+    code += indentation + u8"if (level > limit) {\n";
+    code += indentation + u8"  return compute(level, limit);\n";
+  }
+  for (int i = depth - 1; i >= 0; --i) {
+    code += string8(static_cast<unsigned>(i * 2), u8' ') + u8"}\n";
+  }
+  padded_string source(std::move(code));
+  for (auto _ : state) {
+    lexer l(&source, &null_error_reporter::instance, lexer_strategy::direct);
+    while (l.peek().type != token_type::end_of_file) {
+      l.skip();
+    }
+    ::benchmark::DoNotOptimize(l.peek().type);
+  }
+  set_byte_counters(state, source.size());
+}
+BENCHMARK(benchmark_lex_deeply_indented)->Arg(4)->Arg(16)->Arg(64);
+
+void benchmark_find_block_comment_special_character(
+    ::benchmark::State &state, const lex_simd_routines *routines) {
+  int length = static_cast<int>(state.range(0));
+  padded_string source(string8(static_cast<unsigned>(length), u8' '));
+  for (auto _ : state) {
+    char8 *end = routines->find_block_comment_special_character(source.data());
+    ::benchmark::DoNotOptimize(end);
+  }
+  set_byte_counters(state, length);
+}
+
+void benchmark_find_line_comment_special_character(
+    ::benchmark::State &state, const lex_simd_routines *routines) {
+  int length = static_cast<int>(state.range(0));
+  padded_string source(string8(static_cast<unsigned>(length), u8' '));
+  for (auto _ : state) {
+    char8 *end = routines->find_line_comment_special_character(source.data());
+    ::benchmark::DoNotOptimize(end);
+  }
+  set_byte_counters(state, length);
+}
+
+void benchmark_find_string_special_character(
+    ::benchmark::State &state, const lex_simd_routines *routines) {
+  int length = static_cast<int>(state.range(0));
+  padded_string source(string8(static_cast<unsigned>(length), u8' '));
+  for (auto _ : state) {
+    char8 *end = routines->find_string_special_character(source.data(), u8'"');
+    ::benchmark::DoNotOptimize(end);
+  }
+  set_byte_counters(state, length);
+}
+
+void benchmark_find_template_special_character(
+    ::benchmark::State &state, const lex_simd_routines *routines) {
+  int length = static_cast<int>(state.range(0));
+  padded_string source(string8(static_cast<unsigned>(length), u8' '));
+  for (auto _ : state) {
+    char8 *end = routines->find_template_special_character(source.data());
+    ::benchmark::DoNotOptimize(end);
+  }
+  set_byte_counters(state, length);
+}
+
+void benchmark_build_lex_structural_index(
+    ::benchmark::State &state, const lex_simd_routines *routines) {
+  int length = static_cast<int>(state.range(0));
+  padded_string source(string8(static_cast<unsigned>(length), u8'x'));
+  for (auto _ : state) {
+    lex_structural_index index(&source, *routines);
+    ::benchmark::DoNotOptimize(index);
+  }
+  set_byte_counters(state, length);
+}
+
+bool register_lex_simd_benchmarks() {
+  for (const lex_simd_routines *routines : supported_lex_simd_routines()) {
+    ::benchmark::RegisterBenchmark(
+        (std::string("benchmark_skip_ascii_identifier_characters/") +
+         routines->name)
+            .c_str(),
+        benchmark_skip_ascii_identifier_characters, routines)
+        ->Arg(16)
+        ->Arg(64)
+        ->Arg(1024);
+    ::benchmark::RegisterBenchmark(
+        (std::string("benchmark_find_block_comment_special_character/") +
+         routines->name)
+            .c_str(),
+        benchmark_find_block_comment_special_character, routines)
+        ->Arg(16)
+        ->Arg(64)
+        ->Arg(1024);
+    ::benchmark::RegisterBenchmark(
+        (std::string("benchmark_find_line_comment_special_character/") +
+         routines->name)
+            .c_str(),
+        benchmark_find_line_comment_special_character, routines)
+        ->Arg(16)
+        ->Arg(64)
+        ->Arg(1024);
+    ::benchmark::RegisterBenchmark(
+        (std::string("benchmark_find_string_special_character/") +
+         routines->name)
+            .c_str(),
+        benchmark_find_string_special_character, routines)
+        ->Arg(16)
+        ->Arg(64)
+        ->Arg(1024);
+    ::benchmark::RegisterBenchmark(
+        (std::string("benchmark_find_template_special_character/") +
+         routines->name)
+            .c_str(),
+        benchmark_find_template_special_character, routines)
+        ->Arg(16)
+        ->Arg(64)
+        ->Arg(1024);
+    ::benchmark::RegisterBenchmark(
+        (std::string("benchmark_build_lex_structural_index/") +
+         routines->name)
+            .c_str(),
+        benchmark_build_lex_structural_index, routines)
+        ->Arg(64)
+        ->Arg(4096)
+        ->Arg(65536);
+  }
+  return true;
+}
+bool registered_lex_simd_benchmarks = register_lex_simd_benchmarks();
+
+// Lex a real JavaScript file, named by the QLJS_LEX_BENCHMARK_SOURCE_FILE
+// environment variable.
+//
+// NOTE(strager): The lexer rewrites escaped identifiers in place. We lex the
+// same buffer every iteration, so only the first iteration sees escapes.
+void benchmark_lex_source_file(::benchmark::State &state,
+                               file_content *source, lexer_strategy strategy) {
+  for (auto _ : state) {
+    lexer l(source->view(), &null_error_reporter::instance, strategy);
+    while (l.peek().type != token_type::end_of_file) {
+      l.skip();
+    }
+    ::benchmark::DoNotOptimize(l.peek().type);
+  }
+  set_byte_counters(state, source->size());
+}
+
+bool register_lex_source_file_benchmarks() {
+  const char *path = std::getenv("QLJS_LEX_BENCHMARK_SOURCE_FILE");
+  if (!path || path[0] == '\0') {
+    return false;
+  }
+  read_file_result file = read_file(path);
+  file.exit_if_not_ok();
+  // NOTE(strager): Leak the file so it outlives the benchmarks.
+  file_content *source = new file_content(std::move(file.content));
+  ::benchmark::RegisterBenchmark("benchmark_lex_source_file/direct",
+                                 benchmark_lex_source_file, source,
+                                 lexer_strategy::direct);
+  ::benchmark::RegisterBenchmark("benchmark_lex_source_file/structural_index",
+                                 benchmark_lex_source_file, source,
+                                 lexer_strategy::structural_index);
+  ::benchmark::RegisterBenchmark("benchmark_lex_source_file/automatic",
+                                 benchmark_lex_source_file, source,
+                                 lexer_strategy::automatic);
+  ::benchmark::RegisterBenchmark(
+      "benchmark_lex_source_file/pull_tokens",
+      [source](::benchmark::State &state) -> void {
+        benchmark_lex_pull_tokens(state, source->view());
+      });
+  ::benchmark::RegisterBenchmark(
+      "benchmark_lex_source_file/token_stream",
+      [source](::benchmark::State &state) -> void {
+        benchmark_lex_token_stream(state, source->view());
+      });
+  ::benchmark::RegisterBenchmark(
+      "benchmark_lex_source_file/token_stream_in_parallel",
+      [source](::benchmark::State &state) -> void {
+        int thread_count = std::max(
+            2, narrow_cast<int>(std::thread::hardware_concurrency()));
+        benchmark_lex_token_stream_in_parallel(state, source->view(),
+                                               thread_count,
+                                               /*chunk_size=*/64 * 1024);
+      });
+  return true;
+}
+bool registered_lex_source_file_benchmarks =
+    register_lex_source_file_benchmarks();
 }  // namespace
 }  // namespace quick_lint_js
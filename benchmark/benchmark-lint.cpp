@@ -14,16 +14,24 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
+#include <algorithm>
 #include <benchmark/benchmark.h>
 #include <cstdio>
 #include <cstdlib>
 #include <quick-lint-js/buffering-visitor.h>
+#include <quick-lint-js/char8.h>
 #include <quick-lint-js/error.h>
 #include <quick-lint-js/file.h>
 #include <quick-lint-js/lint.h>
+#include <quick-lint-js/narrow-cast.h>
+#include <quick-lint-js/padded-string.h>
+#include <quick-lint-js/parallel.h>
 #include <quick-lint-js/parse.h>
 #include <quick-lint-js/warning.h>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 QLJS_WARNING_IGNORE_MSVC(4996)  // Function or variable may be unsafe.
 
@@ -42,7 +50,7 @@ void benchmark_lint(benchmark::State &state) {
   read_file_result source(quick_lint_js::read_file(source_path));
   source.exit_if_not_ok();
 
-  parser p(&source.content, &null_error_reporter::instance);
+  parser p(source.content.view(), &null_error_reporter::instance);
   buffering_visitor visitor;
   p.parse_and_visit_module(visitor);
 
@@ -50,6 +58,8 @@ void benchmark_lint(benchmark::State &state) {
     linter l(&null_error_reporter::instance);
     visitor.move_into(l);
   }
+  state.counters["buffered_bytes"] =
+      static_cast<double>(visitor.encoded_size());
 }
 BENCHMARK(benchmark_lint);
 
@@ -67,11 +77,94 @@ void benchmark_parse_and_lint(benchmark::State &state) {
   source.exit_if_not_ok();
 
   for (auto _ : state) {
-    parser p(&source.content, &null_error_reporter::instance);
+    parser p(source.content.view(), &null_error_reporter::instance);
     linter l(&null_error_reporter::instance);
     p.parse_and_visit_module(l);
   }
 }
 BENCHMARK(benchmark_parse_and_lint);
+
+// Simulate a generated module with many top-level declarations, each used
+// from inside a function.
+void benchmark_parse_and_lint_many_declarations(benchmark::State &state) {
+  int declaration_count = narrow_cast<int>(state.range(0));
+  string8 source_code;
+  for (int i = 0; i < declaration_count; ++i) {
+    std::string name = "v" + std::to_string(i);
+    source_code += u8"let ";
+    source_code.append(name.begin(), name.end());
+    source_code += u8" = 0;\n";
+  }
+  source_code += u8"function f() {\n";
+  for (int i = 0; i < declaration_count; ++i) {
+    std::string name = "v" + std::to_string(i);
+    source_code.append(name.begin(), name.end());
+    source_code += u8";\n";
+  }
+  source_code += u8"}\n";
+  padded_string source(std::move(source_code));
+
+  for (auto _ : state) {
+    parser p(&source, &null_error_reporter::instance);
+    linter l(&null_error_reporter::instance);
+    p.parse_and_visit_module(l);
+  }
+
+  double iteration_count = static_cast<double>(state.iterations());
+  state.counters["declarations"] = ::benchmark::Counter(
+      static_cast<double>(declaration_count) * iteration_count,
+      ::benchmark::Counter::kIsRate);
+}
+BENCHMARK(benchmark_parse_and_lint_many_declarations)
+    ->RangeMultiplier(4)
+    ->Range(4, 16384);
+
+// Simulate 'quick-lint-js --jobs=N' with many copies of the same file.
+void benchmark_parse_and_lint_files_in_parallel(benchmark::State &state) {
+  const char *source_path_env_var = "QLJS_LINT_BENCHMARK_SOURCE_FILE";
+  const char *source_path = std::getenv(source_path_env_var);
+  if (!source_path || *source_path == '\0') {
+    std::fprintf(stderr,
+                 "fatal: The %s environment variable was not set.\n"
+                 "       Set it to the path of a JavaScript source file.\n",
+                 source_path_env_var);
+    std::exit(1);
+  }
+  read_file_result source(quick_lint_js::read_file(source_path));
+  source.exit_if_not_ok();
+
+  int thread_count = narrow_cast<int>(state.range(0));
+  int file_count = 256;
+  // Each file gets its own copy of the source code because the lexer can
+  // modify its input.
+  std::vector<padded_string> files(
+      narrow_cast<std::size_t>(file_count),
+      padded_string(string8(source.content.string_view())));
+
+  for (auto _ : state) {
+    for_each_in_parallel_in_order<int>(
+        /*item_count=*/file_count, /*thread_count=*/thread_count,
+        /*produce=*/
+        [&](int i) -> int {
+          padded_string &file = files[narrow_cast<std::size_t>(i)];
+          parser p(&file, &null_error_reporter::instance);
+          linter l(&null_error_reporter::instance);
+          p.parse_and_visit_module(l);
+          return i;
+        },
+        /*consume=*/
+        [](int, int &&i) -> void { ::benchmark::DoNotOptimize(i); });
+  }
+
+  double iteration_count = static_cast<double>(state.iterations());
+  state.counters["files"] =
+      ::benchmark::Counter(static_cast<double>(file_count) * iteration_count,
+                           ::benchmark::Counter::kIsRate);
+}
+BENCHMARK(benchmark_parse_and_lint_files_in_parallel)
+    ->RangeMultiplier(2)
+    ->Range(1,
+            std::max(1, static_cast<int>(std::thread::hardware_concurrency())))
+    ->UseRealTime();
 }  // namespace
 }  // namespace quick_lint_js
@@ -0,0 +1,131 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <optional>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/lsp-server.h>
+#include <quick-lint-js/narrow-cast.h>
+#include <string>
+#include <vector>
+
+namespace quick_lint_js {
+namespace {
+string8 make_message(const std::string &body) {
+  std::string message = "Content-Length: " + std::to_string(body.size()) +
+                        "\r\n\r\n" + body;
+  return string8(message.begin(), message.end());
+}
+
+// A program with line_count lines, each declaring a variable.
+std::string make_document(int line_count) {
+  std::string code;
+  for (int i = 0; i < line_count; ++i) {
+    code += "let v" + std::to_string(i) + " = " + std::to_string(i) + ";\\n";
+  }
+  return code;
+}
+
+std::string did_open_body(const std::string &text) {
+  return R"({"jsonrpc":"2.0","method":"textDocument/didOpen","params":{)"
+         R"("textDocument":{"uri":"file:///bench.js",)"
+         R"("languageId":"javascript","version":0,"text":")" +
+         text + R"("}}})";
+}
+
+// Simulates typing: the trace alternates between typing 'x' at the end of a
+// line in the middle of the document and deleting it again.
+std::vector<string8> make_incremental_edit_trace(int line_count,
+                                                 int edit_count) {
+  int line = line_count / 2;
+  int character =
+      narrow_cast<int>(("let v" + std::to_string(line) + " = ").size());
+  std::vector<string8> trace;
+  for (int i = 0; i < edit_count; ++i) {
+    bool insert = i % 2 == 0;
+    std::string range = R"({"start":{"line":)" + std::to_string(line) +
+                        R"(,"character":)" + std::to_string(character) +
+                        R"(},"end":{"line":)" + std::to_string(line) +
+                        R"(,"character":)" +
+                        std::to_string(character + (insert ? 0 : 1)) + "}}";
+    trace.push_back(make_message(
+        R"({"jsonrpc":"2.0","method":"textDocument/didChange","params":{)"
+        R"("textDocument":{"uri":"file:///bench.js","version":)" +
+        std::to_string(i + 1) + R"(},"contentChanges":[{"range":)" + range +
+        R"(,"text":")" + (insert ? "x" : "") + R"("}]}})"));
+  }
+  return trace;
+}
+
+// Like make_incremental_edit_trace, but each edit resends the whole document
+// (like a client which does not support incremental sync).
+std::vector<string8> make_full_edit_trace(int line_count, int edit_count) {
+  std::string text = make_document(line_count);
+  std::vector<string8> trace;
+  for (int i = 0; i < edit_count; ++i) {
+    bool insert = i % 2 == 0;
+    trace.push_back(make_message(
+        R"({"jsonrpc":"2.0","method":"textDocument/didChange","params":{)"
+        R"("textDocument":{"uri":"file:///bench.js","version":)" +
+        std::to_string(i + 1) + R"(},"contentChanges":[{"text":")" +
+        (insert ? "x" : "") + text + R"("}]}})"));
+  }
+  return trace;
+}
+
+// Measures the latency from a keystroke (a didChange message arriving) to the
+// diagnostics for that keystroke being written.
+void replay_edit_trace(::benchmark::State &state,
+                       const std::vector<string8> &trace, int line_count) {
+  lsp_server server;
+  lsp_message_parser parser;
+  string8 out;
+  parser.append(make_message(did_open_body(make_document(line_count))));
+  server.handle_message(*parser.next_message(), &out);
+  server.publish_pending_diagnostics(&out);
+
+  std::size_t edit_index = 0;
+  for (auto _ : state) {
+    out.clear();
+    parser.append(trace[edit_index]);
+    while (std::optional<string8_view> message = parser.next_message()) {
+      server.handle_message(*message, &out);
+    }
+    server.publish_pending_diagnostics(&out);
+    ::benchmark::DoNotOptimize(out.data());
+    edit_index = (edit_index + 1) % trace.size();
+  }
+  state.SetItemsProcessed(narrow_cast<std::int64_t>(state.iterations()));
+}
+
+void benchmark_lsp_incremental_change(::benchmark::State &state) {
+  int line_count = narrow_cast<int>(state.range(0));
+  std::vector<string8> trace =
+      make_incremental_edit_trace(line_count, /*edit_count=*/100);
+  replay_edit_trace(state, trace, line_count);
+}
+BENCHMARK(benchmark_lsp_incremental_change)->Arg(100)->Arg(1000)->Arg(10000);
+
+void benchmark_lsp_full_change(::benchmark::State &state) {
+  int line_count = narrow_cast<int>(state.range(0));
+  std::vector<string8> trace =
+      make_full_edit_trace(line_count, /*edit_count=*/100);
+  replay_edit_trace(state, trace, line_count);
+}
+BENCHMARK(benchmark_lsp_full_change)->Arg(100)->Arg(1000)->Arg(10000);
+}
+}
@@ -15,21 +15,62 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
+#include <new>
+#include <quick-lint-js/char8.h>
 #include <quick-lint-js/error.h>
 #include <quick-lint-js/file.h>
+#include <quick-lint-js/have.h>
 #include <quick-lint-js/null-visitor.h>
 #include <quick-lint-js/padded-string.h>
+#include <quick-lint-js/parse-parallel.h>
 #include <quick-lint-js/parse.h>
 #include <quick-lint-js/warning.h>
 #include <string>
+#include <utility>
+
+#if QLJS_HAVE_GETRUSAGE
+#include <sys/resource.h>
+#endif
 
 QLJS_WARNING_IGNORE_MSVC(4996)  // Function or variable may be unsafe.
 
+namespace {
+// Number of calls to the global operator new. Benchmarks run on one thread, so
+// this doesn't need to be atomic.
+std::uint64_t global_allocation_count = 0;
+}
+
+// Count heap allocations so benchmarks can report them. See
+// report_allocations.
+void *operator new(std::size_t size) {
+  global_allocation_count += 1;
+  void *p = std::malloc(size == 0 ? 1 : size);
+  if (!p) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
 namespace quick_lint_js {
 namespace {
-void benchmark_parse(benchmark::State &state) {
+// Report the number of heap allocations per iteration since
+// allocation_count_before was sampled.
+void report_allocations(benchmark::State &state,
+                        std::uint64_t allocation_count_before) {
+  state.counters["allocations"] = ::benchmark::Counter(
+      static_cast<double>(global_allocation_count - allocation_count_before),
+      ::benchmark::Counter::kAvgIterations);
+}
+
+read_file_result read_benchmark_source_file() {
   const char *source_path_env_var = "QLJS_PARSE_BENCHMARK_SOURCE_FILE";
   const char *source_path = std::getenv(source_path_env_var);
   if (!source_path || *source_path == '\0') {
@@ -41,13 +82,156 @@ void benchmark_parse(benchmark::State &state) {
   }
   read_file_result source(quick_lint_js::read_file(source_path));
   source.exit_if_not_ok();
+  return source;
+}
 
+void benchmark_parse(benchmark::State &state) {
+  read_file_result source = read_benchmark_source_file();
+
+  std::uint64_t allocation_count_before = global_allocation_count;
   for (auto _ : state) {
-    parser p(&source.content, &null_error_reporter::instance);
+    parser p(source.content.view(), &null_error_reporter::instance);
     null_visitor visitor;
     p.parse_and_visit_module(visitor);
   }
+  report_allocations(state, allocation_count_before);
 }
 BENCHMARK(benchmark_parse);
+
+// Measure the time to visit only module-level code, as when an editor wants
+// module-level diagnostics before linting function bodies.
+void benchmark_parse_skipping_function_bodies(benchmark::State &state) {
+  read_file_result source = read_benchmark_source_file();
+
+  std::size_t skipped_function_bodies = 0;
+  for (auto _ : state) {
+    parser p(source.content.view(), &null_error_reporter::instance);
+    p.set_skip_function_bodies(true);
+    null_visitor visitor;
+    p.parse_and_visit_module(visitor);
+    skipped_function_bodies = p.skipped_function_bodies().size();
+  }
+  state.counters["skipped_function_bodies"] =
+      static_cast<double>(skipped_function_bodies);
+}
+BENCHMARK(benchmark_parse_skipping_function_bodies);
+
+// Simulate a big library of module-level functions, parsing function bodies
+// on state.range(0) threads.
+void benchmark_parse_module_level_functions_in_parallel(
+    benchmark::State &state) {
+  string8 source_code;
+  for (int i = 0; i < 20000; ++i) {
+    source_code +=
+        u8"function transform(items, options) {\n"
+        u8"  let result = [];\n"
+        u8"  for (let i = 0; i < items.length; ++i) {\n"
+        u8"    let item = items[i];\n"
+        u8"    if (options.filter(item)) { result.push(options.map(item)); }\n"
+        u8"  }\n"
+        u8"  return result.sort((a, b) => { return a.key - b.key; });\n"
+        u8"}\n";
+  }
+  padded_string source(std::move(source_code));
+
+  int thread_count = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    null_visitor visitor;
+    parse_and_visit_module_in_parallel(&source, &null_error_reporter::instance,
+                                       visitor, thread_count);
+  }
+}
+BENCHMARK(benchmark_parse_module_level_functions_in_parallel)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->UseRealTime();
+
+// Simulate callback-heavy code, such as promise chains, where most functions
+// are arrow functions and function expressions.
+void benchmark_parse_callbacks(benchmark::State &state) {
+  string8 source_code;
+  for (int i = 0; i < 1000; ++i) {
+    source_code +=
+        u8"fetch(url)\n"
+        u8"  .then((response) => { return response.json(); })\n"
+        u8"  .then(function (data) { items.push(...data.items); })\n"
+        u8"  .catch((error) => { console.error(error); });\n"
+        u8"button.addEventListener('click', (e) => {\n"
+        u8"  setTimeout(() => { render({ onClick() { go(e); } }); }, 0);\n"
+        u8"});\n";
+  }
+  padded_string source(std::move(source_code));
+
+  std::uint64_t allocation_count_before = global_allocation_count;
+  for (auto _ : state) {
+    parser p(&source, &null_error_reporter::instance);
+    null_visitor visitor;
+    p.parse_and_visit_module(visitor);
+  }
+  report_allocations(state, allocation_count_before);
+}
+BENCHMARK(benchmark_parse_callbacks);
+
+#if QLJS_HAVE_GETRUSAGE
+// The peak resident set size of this process, in bytes.
+double peak_rss() {
+  ::rusage usage;
+  if (::getrusage(RUSAGE_SELF, &usage) != 0) {
+    std::perror("getrusage");
+    std::exit(1);
+  }
+#if defined(__APPLE__)
+  return static_cast<double>(usage.ru_maxrss);  // Bytes.
+#else
+  return static_cast<double>(usage.ru_maxrss) * 1024.0;  // Kilobytes.
+#endif
+}
+
+// Parse a synthetic 100 MiB module and report the process's peak memory
+// usage. Expression memory is reused between statements, so peak memory should
+// be the source code plus the lexer's structural index (about half the size of
+// the source code), regardless of how many statements the module has.
+//
+// NOTE(strager): Peak memory usage is measured for the whole process. Run this
+// benchmark by itself with --benchmark_filter.
+void benchmark_parse_huge_module_peak_memory(benchmark::State &state) {
+  std::size_t target_size = 100 * 1024 * 1024;
+  string8 source_code;
+  source_code.reserve(target_size + 1024);
+  for (int i = 0; source_code.size() < target_size; ++i) {
+    std::string n = std::to_string(i);
+    string8 n8(n.begin(), n.end());
+    source_code += u8"const item" + n8 + u8" = { id: " + n8 +
+                   u8", tags: ['a', 'b', 'c'], total: price * (1 + tax) };\n";
+    source_code += u8"function handler" + n8 +
+                   u8"(event) {\n"
+                   u8"  if (event.target && event.target.value > " +
+                   n8 +
+                   u8") {\n"
+                   u8"    return items.map((x) => x.id + item" +
+                   n8 +
+                   u8".id);\n"
+                   u8"  }\n"
+                   u8"  return [event.x, event.y, event.z].filter(Boolean);\n"
+                   u8"}\n";
+  }
+  padded_string source(std::move(source_code));
+
+  for (auto _ : state) {
+    parser p(&source, &null_error_reporter::instance);
+    null_visitor visitor;
+    p.parse_and_visit_module(visitor);
+  }
+
+  double mebibyte = 1024.0 * 1024.0;
+  state.counters["source_MiB"] =
+      static_cast<double>(source.size()) / mebibyte;
+  state.counters["peak_rss_MiB"] = peak_rss() / mebibyte;
+}
+BENCHMARK(benchmark_parse_huge_module_peak_memory)
+    ->Iterations(1)
+    ->Unit(::benchmark::kMillisecond);
+#endif
 }  // namespace
 }  // namespace quick_lint_js
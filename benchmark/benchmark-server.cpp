@@ -0,0 +1,146 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/have.h>
+#include <quick-lint-js/lint-server.h>
+#include <quick-lint-js/std-filesystem.h>
+#include <string>
+#include <thread>
+
+#if QLJS_HAVE_UNIX_DOMAIN_SOCKETS
+#include <fcntl.h>
+#include <spawn.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+#endif
+
+// Compare the cost of linting a small file with a long-running
+// quick-lint-js --server against the cost of starting quick-lint-js for the
+// file.
+namespace quick_lint_js {
+namespace {
+#if QLJS_HAVE_UNIX_DOMAIN_SOCKETS
+// About 2 KiB of JavaScript, similar to a typical small module.
+std::string make_small_module() {
+  std::string code;
+  for (int i = 0; code.size() < 2048; ++i) {
+    std::string n = std::to_string(i);
+    code += "import {thing" + n + "} from './thing" + n + ".js';\n";
+    code += "export function doThing" + n + "(x, y) {\n";
+    code += "  let result = thing" + n + "(x) + y;\n";
+    code += "  return result * 2;\n";
+    code += "}\n";
+  }
+  return code;
+}
+
+class temporary_directory {
+ public:
+  explicit temporary_directory() {
+    std::string name =
+        (filesystem::temp_directory_path() / "quick-lint-js.XXXXXX").string();
+    if (!::mkdtemp(name.data())) {
+      std::cerr << "failed to create temporary directory\n";
+      std::abort();
+    }
+    this->path = name;
+  }
+
+  ~temporary_directory() { filesystem::remove_all(this->path); }
+
+  filesystem::path path;
+};
+
+void benchmark_server_request(::benchmark::State &state) {
+  temporary_directory temp;
+  std::string socket_path = (temp.path / "server.sock").string();
+  lint_socket_server server(socket_path.c_str());
+  if (!server.ok()) {
+    state.SkipWithError(server.error().c_str());
+    return;
+  }
+  std::thread server_thread([&]() -> void { server.run(); });
+
+  {
+    std::string code = make_small_module();
+    lint_request request;
+    request.files.push_back(lint_request_file{
+        .path = "module.js",
+        .vim_bufnr = std::nullopt,
+        .content = string8(code.begin(), code.end()),
+    });
+
+    lint_client client(socket_path.c_str());
+    if (!client.ok()) {
+      state.SkipWithError(client.error().c_str());
+    } else {
+      for (auto _ : state) {
+        std::optional<lint_response> response = client.send(request);
+        if (!response.has_value()) {
+          state.SkipWithError(client.error().c_str());
+          break;
+        }
+        ::benchmark::DoNotOptimize(response);
+      }
+    }
+  }
+
+  server.stop();
+  server_thread.join();
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(benchmark_server_request)->UseRealTime();
+
+void benchmark_fork_exec(::benchmark::State &state) {
+  temporary_directory temp;
+  std::string js_path = (temp.path / "module.js").string();
+  std::ofstream(js_path) << make_small_module();
+
+  ::posix_spawn_file_actions_t file_actions;
+  ::posix_spawn_file_actions_init(&file_actions);
+  ::posix_spawn_file_actions_addopen(&file_actions, STDOUT_FILENO,
+                                     "/dev/null", O_WRONLY, 0);
+  ::posix_spawn_file_actions_addopen(&file_actions, STDERR_FILENO,
+                                     "/dev/null", O_WRONLY, 0);
+  char *argv[] = {const_cast<char *>(QLJS_BENCHMARK_QUICK_LINT_JS_EXE),
+                  js_path.data(), nullptr};
+  for (auto _ : state) {
+    ::pid_t pid;
+    int rc = ::posix_spawn(&pid, argv[0], &file_actions, /*attrp=*/nullptr,
+                           argv, environ);
+    if (rc != 0) {
+      state.SkipWithError("posix_spawn failed");
+      break;
+    }
+    int status;
+    ::waitpid(pid, &status, 0);
+  }
+  ::posix_spawn_file_actions_destroy(&file_actions);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(benchmark_fork_exec)->UseRealTime();
+#endif
+}
+}
@@ -0,0 +1,52 @@
+# Give TARGET a generated header, <quick-lint-js/build-id.h>, which defines
+# QLJS_BUILD_ID: a string which changes whenever a source file in
+# SOURCE_DIRECTORY changes.
+#
+# NOTE(strager): Source files are found when CMake configures the build. Re-run
+# CMake after adding a source file.
+set(QUICK_LINT_JS_BUILD_ID_SCRIPT "${CMAKE_CURRENT_LIST_FILE}")
+
+function (quick_lint_js_add_build_id TARGET SOURCE_DIRECTORY)
+  file(
+    GLOB_RECURSE SOURCES
+    "${SOURCE_DIRECTORY}/*.cpp"
+    "${SOURCE_DIRECTORY}/*.h"
+  )
+  set(GENERATED_DIRECTORY "${CMAKE_CURRENT_BINARY_DIR}/generated")
+  set(HEADER "${GENERATED_DIRECTORY}/quick-lint-js/build-id.h")
+  add_custom_command(
+    OUTPUT "${HEADER}"
+    COMMAND
+      "${CMAKE_COMMAND}"
+      "-DSOURCE_DIRECTORY=${SOURCE_DIRECTORY}"
+      "-DHEADER=${HEADER}"
+      -P "${QUICK_LINT_JS_BUILD_ID_SCRIPT}"
+    DEPENDS ${SOURCES} "${QUICK_LINT_JS_BUILD_ID_SCRIPT}"
+    COMMENT "Generating quick-lint-js/build-id.h"
+    VERBATIM
+  )
+  target_sources("${TARGET}" PRIVATE "${HEADER}")
+  target_include_directories("${TARGET}" PRIVATE "${GENERATED_DIRECTORY}")
+endfunction ()
+
+# Script mode: write HEADER.
+if (CMAKE_SCRIPT_MODE_FILE)
+  file(
+    GLOB_RECURSE SOURCES
+    RELATIVE "${SOURCE_DIRECTORY}"
+    "${SOURCE_DIRECTORY}/*.cpp"
+    "${SOURCE_DIRECTORY}/*.h"
+  )
+  list(SORT SOURCES)
+  set(HASHES "")
+  foreach (SOURCE ${SOURCES})
+    file(SHA256 "${SOURCE_DIRECTORY}/${SOURCE}" HASH)
+    string(APPEND HASHES "${SOURCE} ${HASH}\n")
+  endforeach ()
+  string(SHA256 BUILD_ID "${HASHES}")
+  file(
+    WRITE "${HEADER}"
+    "// Generated by QuickLintJSBuildID.cmake. Do not edit.\n"
+    "#define QLJS_BUILD_ID \"${BUILD_ID}\"\n"
+  )
+endif ()
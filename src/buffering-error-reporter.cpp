@@ -0,0 +1,88 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <iostream>
+#include <quick-lint-js/assert.h>
+#include <quick-lint-js/buffering-error-reporter.h>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/error.h>
+#include <quick-lint-js/lex.h>
+#include <quick-lint-js/location.h>
+#include <quick-lint-js/optional.h>
+#include <quick-lint-js/padded-string.h>
+#include <quick-lint-js/unreachable.h>
+#include <utility>
+#include <variant>
+
+namespace quick_lint_js {
+void buffering_error_reporter::set_source(padded_string_view input) {
+  this->locator_.emplace(input);
+}
+
+#define QLJS_ERROR_TYPE(name, struct_body, format_call)                 \
+  void buffering_error_reporter::report(name e) {                       \
+    this->errors_.emplace_back(std::in_place_type<name>, std::move(e)); \
+  }
+QLJS_X_ERROR_TYPES
+#undef QLJS_ERROR_TYPE
+
+void buffering_error_reporter::report_fatal_error_unimplemented_character(
+    const char *qljs_file_name, int qljs_line, const char *qljs_function_name,
+    const char8 *character) {
+  error_reporter::write_fatal_error_unimplemented_character(
+      /*qljs_file_name=*/qljs_file_name,
+      /*qljs_line=*/qljs_line,
+      /*qljs_function_name=*/qljs_function_name,
+      /*character=*/character,
+      /*locator=*/get(this->locator_),
+      /*out=*/std::cerr);
+}
+
+void buffering_error_reporter::report_fatal_error_unimplemented_token(
+    const char *qljs_file_name, int qljs_line, const char *qljs_function_name,
+    token_type type, const char8 *token_begin) {
+  error_reporter::write_fatal_error_unimplemented_token(
+      /*qljs_file_name=*/qljs_file_name,
+      /*qljs_line=*/qljs_line,
+      /*qljs_function_name=*/qljs_function_name,
+      /*type=*/type,
+      /*token_begin=*/token_begin,
+      /*locator=*/get(this->locator_),
+      /*out=*/std::cerr);
+}
+
+void buffering_error_reporter::move_into(error_reporter *other) {
+  struct reporter {
+    void operator()(std::monostate) { QLJS_UNREACHABLE(); }
+
+#define QLJS_ERROR_TYPE(name, struct_body, format_call) \
+  void operator()(const name &e) { this->other->report(e); }
+    QLJS_X_ERROR_TYPES
+#undef QLJS_ERROR_TYPE
+
+    error_reporter *other;
+  };
+
+  for (const error &e : this->errors_) {
+    std::visit(reporter{other}, e);
+  }
+  this->errors_.clear();
+}
+
+bool buffering_error_reporter::empty() const noexcept {
+  return this->errors_.empty();
+}
+}
@@ -21,6 +21,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <optional>
+#include <ostream>
 #include <quick-lint-js/assert.h>
 #include <quick-lint-js/char8.h>
 #include <quick-lint-js/file-handle.h>
@@ -28,16 +29,26 @@
 #include <quick-lint-js/have.h>
 #include <quick-lint-js/math-overflow.h>
 #include <quick-lint-js/narrow-cast.h>
+#include <quick-lint-js/unreachable.h>
 #include <string>
+#include <utility>
 
 #if QLJS_HAVE_FCNTL_H
 #include <fcntl.h>
 #endif
 
+#if QLJS_HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+
 #if QLJS_HAVE_SYS_STAT_H
 #include <sys/stat.h>
 #endif
 
+#if QLJS_HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
 #if QLJS_HAVE_WINDOWS_H
 #include <Windows.h>
 #endif
@@ -50,7 +61,106 @@
 #error "Unsupported platform"
 #endif
 
+#if defined(QLJS_FILE_POSIX) && QLJS_HAVE_SYS_MMAN_H
+#define QLJS_FILE_MMAP
+#endif
+
 namespace quick_lint_js {
+file_content::file_content() noexcept = default;
+
+file_content::file_content(padded_string &&string) noexcept
+    : string_(std::move(string)) {}
+
+file_content file_content::adopt_memory_mapping(char8 *mapping,
+                                                std::size_t mapping_size,
+                                                int size) noexcept {
+  QLJS_ASSERT(mapping_size - narrow_cast<std::size_t>(size) >=
+              narrow_cast<std::size_t>(padded_string::padding_size));
+  file_content content;
+  content.mapping_ = mapping;
+  content.mapping_size_ = mapping_size;
+  content.mapping_content_size_ = size;
+  return content;
+}
+
+file_content::file_content(file_content &&other) noexcept
+    : string_(std::move(other.string_)),
+      mapping_(std::exchange(other.mapping_, nullptr)),
+      mapping_size_(std::exchange(other.mapping_size_, 0)),
+      mapping_content_size_(std::exchange(other.mapping_content_size_, 0)) {}
+
+file_content &file_content::operator=(file_content &&other) noexcept {
+  if (this != &other) {
+    this->unmap();
+    this->string_ = std::move(other.string_);
+    this->mapping_ = std::exchange(other.mapping_, nullptr);
+    this->mapping_size_ = std::exchange(other.mapping_size_, 0);
+    this->mapping_content_size_ =
+        std::exchange(other.mapping_content_size_, 0);
+  }
+  return *this;
+}
+
+file_content::~file_content() { this->unmap(); }
+
+padded_string_view file_content::view() noexcept {
+  if (this->is_memory_mapped()) {
+    return padded_string_view(this->mapping_, this->mapping_content_size_);
+  } else {
+    return padded_string_view(&this->string_);
+  }
+}
+
+string8_view file_content::string_view() const noexcept {
+  if (this->is_memory_mapped()) {
+    return string8_view(
+        this->mapping_, narrow_cast<std::size_t>(this->mapping_content_size_));
+  } else {
+    return string8_view(this->string_.c_str(),
+                        narrow_cast<std::size_t>(this->string_.size()));
+  }
+}
+
+int file_content::size() const noexcept {
+  return narrow_cast<int>(this->string_view().size());
+}
+
+void file_content::unmap() noexcept {
+  if (!this->mapping_) {
+    return;
+  }
+#if defined(QLJS_FILE_MMAP)
+  if (::munmap(this->mapping_, this->mapping_size_) != 0) {
+    std::fprintf(stderr, "error: failed to unmap file: %s\n",
+                 std::strerror(errno));
+  }
+#else
+  QLJS_UNREACHABLE();
+#endif
+  this->mapping_ = nullptr;
+}
+
+std::ostream &operator<<(std::ostream &out, const file_content &x) {
+  out << out_string8(x.string_view());
+  return out;
+}
+
+bool operator==(string8_view x, const file_content &y) noexcept {
+  return y == x;
+}
+
+bool operator!=(string8_view x, const file_content &y) noexcept {
+  return !(x == y);
+}
+
+bool operator==(const file_content &x, string8_view y) noexcept {
+  return x.string_view() == y;
+}
+
+bool operator!=(const file_content &x, string8_view y) noexcept {
+  return !(x == y);
+}
+
 void read_file_result::exit_if_not_ok() const {
   if (!this->ok()) {
     std::fprintf(stderr, "error: %s\n", this->error.c_str());
@@ -65,6 +175,10 @@ read_file_result read_file_result::failure(const std::string &error) {
 }
 
 namespace {
+#if defined(QLJS_FILE_MMAP)
+constexpr int memory_map_threshold = 32 * 1024 * 1024;
+#endif
+
 #if defined(QLJS_FILE_WINDOWS)
 using platform_file = windows_handle_file;
 #endif
@@ -72,82 +186,165 @@ using platform_file = windows_handle_file;
 using platform_file = posix_fd_file;
 #endif
 
-void read_file_buffered(platform_file &file, int buffer_size,
-                        read_file_result *out) {
+// Returns an error message, or an empty string on success.
+std::string read_file_buffered(platform_file &file, int buffer_size,
+                               padded_string *out) {
   for (;;) {
-    int size_before = out->content.size();
+    int size_before = out->size();
     {
       std::optional<int> new_size = checked_add(size_before, buffer_size);
       if (!new_size.has_value()) {
         // TODO(strager): Should we try a small buffer size?
-        out->error = "file too large to read into memory";
-        return;
+        return "file too large to read into memory";
       }
-      out->content.resize(size_before + buffer_size);
+      out->resize(size_before + buffer_size);
     }
 
     std::optional<int> read_size =
-        file.read(&out->content.data()[size_before], buffer_size);
+        file.read(&out->data()[size_before], buffer_size);
     if (!read_size.has_value()) {
-      out->error = "failed to read from file: " + file.get_last_error_message();
-      return;
+      return "failed to read from file: " + file.get_last_error_message();
     }
     std::optional<int> new_size = checked_add(size_before, *read_size);
     QLJS_ASSERT(new_size.has_value());
-    out->content.resize(*new_size);
+    out->resize(*new_size);
     if (*read_size == 0) {
       // We read the entire file.
-      return;
+      return "";
     }
   }
 }
 
 read_file_result read_file_with_expected_size(platform_file &file,
                                               int file_size, int buffer_size) {
-  read_file_result result;
+  padded_string content;
 
   std::optional<int> size_to_read = checked_add(file_size, 1);
   if (!size_to_read.has_value()) {
-    result.error = "file too large to read into memory";
-    return result;
+    return read_file_result::failure("file too large to read into memory");
   }
-  result.content.resize(*size_to_read);
+  content.resize(*size_to_read);
 
-  std::optional<int> read_size =
-      file.read(result.content.data(), *size_to_read);
+  std::optional<int> read_size = file.read(content.data(), *size_to_read);
   if (!read_size.has_value()) {
-    result.error = "failed to read from file: " + file.get_last_error_message();
-    return result;
+    return read_file_result::failure("failed to read from file: " +
+                                     file.get_last_error_message());
   }
+  std::string error;
   if (*read_size == file_size) {
     // We possibly read the entire file. Make extra sure by reading one more
     // byte.
     std::optional<int> extra_read_size =
-        file.read(result.content.data() + file_size, 1);
+        file.read(content.data() + file_size, 1);
     if (!extra_read_size.has_value()) {
-      result.error =
-          "failed to read from file: " + file.get_last_error_message();
-      return result;
+      return read_file_result::failure("failed to read from file: " +
+                                       file.get_last_error_message());
     }
-    result.content.resize(*read_size + *extra_read_size);
+    content.resize(*read_size + *extra_read_size);
     if (*extra_read_size == 0) {
       // We definitely read the entire file.
-      return result;
     } else {
       // We didn't read the entire file the first time. Keep reading.
-      read_file_buffered(file, buffer_size, &result);
-      return result;
+      error = read_file_buffered(file, buffer_size, &content);
     }
   } else {
-    result.content.resize(*read_size);
+    content.resize(*read_size);
     // We did not read the entire file. There is more data to read.
-    read_file_buffered(file, buffer_size, &result);
-    return result;
+    error = read_file_buffered(file, buffer_size, &content);
   }
+
+  read_file_result result;
+  if (error.empty()) {
+    result.content = file_content(std::move(content));
+  } else {
+    result.error = std::move(error);
+  }
+  return result;
+}
+
+#if defined(QLJS_FILE_MMAP)
+std::size_t round_up(std::size_t x, std::size_t multiple) noexcept {
+  return (x + multiple - 1) / multiple * multiple;
 }
 
+std::size_t round_down(std::size_t x, std::size_t multiple) noexcept {
+  return x / multiple * multiple;
+}
+
+// Map a regular file into memory, followed by padded_string::padding_size null
+// bytes.
+//
+// Returns std::nullopt if mapping failed. The caller should fall back to
+// reading the file.
+//
+// NOTE(strager): If another process truncates the file while we are using the
+// mapping, we might crash with SIGBUS.
+std::optional<file_content> memory_map_file(posix_fd_file &file,
+                                            int file_size) {
+  QLJS_ASSERT(file_size > 0);
+  long page_size_long = ::sysconf(_SC_PAGESIZE);
+  if (page_size_long <= 0) {
+    return std::nullopt;
+  }
+  std::size_t page_size = narrow_cast<std::size_t>(page_size_long);
+  std::size_t size = narrow_cast<std::size_t>(file_size);
+  std::size_t padding_size =
+      narrow_cast<std::size_t>(padded_string::padding_size);
+
+  // Reserve address space for the file and its padding. Anonymous memory is
+  // zero-filled, giving us null padding bytes.
+  std::size_t mapping_size = round_up(size + padding_size, page_size);
+  void *mapping = ::mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapping == MAP_FAILED) {
+    return std::nullopt;
+  }
+  char8 *data = static_cast<char8 *>(mapping);
+
+  // The kernel zero-fills the remainder of the file's last page. If that slack
+  // is big enough for our padding, map every page of the file. Otherwise, map
+  // only the file's whole pages and copy the last partial page into the
+  // anonymous memory.
+  std::size_t slack = round_up(size, page_size) - size;
+  std::size_t file_mapping_size = slack >= padding_size
+                                      ? round_up(size, page_size)
+                                      : round_down(size, page_size);
+  if (file_mapping_size > 0) {
+    // MAP_PRIVATE: The lexer writes into the buffer; don't modify the file.
+    int flags = MAP_PRIVATE | MAP_FIXED;
+#if defined(MAP_POPULATE)
+    // The lexer reads every page. Fault them in up front, which is much
+    // cheaper than faulting one page at a time.
+    flags |= MAP_POPULATE;
+#endif
+    void *file_mapping =
+        ::mmap(data, file_mapping_size, PROT_READ | PROT_WRITE, flags,
+               file.get(), /*offset=*/0);
+    if (file_mapping == MAP_FAILED) {
+      ::munmap(mapping, mapping_size);
+      return std::nullopt;
+    }
+  }
+  for (std::size_t offset = file_mapping_size; offset < size;) {
+    ::ssize_t read_size =
+        ::pread(file.get(), data + offset, size - offset,
+                narrow_cast<::off_t>(offset));
+    if (read_size <= 0) {
+      // The file shrank or we failed to read.
+      ::munmap(mapping, mapping_size);
+      return std::nullopt;
+    }
+    offset += narrow_cast<std::size_t>(read_size);
+  }
+
+  return file_content::adopt_memory_mapping(data, mapping_size, file_size);
+}
+#endif
+
 #if defined(QLJS_FILE_WINDOWS)
-read_file_result read_file(const char *path, windows_handle_file &file) {
+read_file_result read_file(const char *path, windows_handle_file &file,
+                           read_file_strategy) {
+  // TODO(strager): Memory-map files on Windows too.
   int buffer_size = 1024;  // TODO(strager): Compute a good buffer size.
 
   ::LARGE_INTEGER file_size;
@@ -178,9 +375,30 @@ int reasonable_buffer_size(const struct stat &s) noexcept {
   return narrow_cast<int>(
       std::clamp(s.st_blksize, /*lo=*/minimum_buffer_size, /*hi=*/megabyte));
 }
+
+#if defined(QLJS_FILE_MMAP)
+bool should_memory_map(read_file_strategy strategy,
+                       const struct stat &s) noexcept {
+  if (!S_ISREG(s.st_mode) || s.st_size == 0) {
+    return false;
+  }
+  switch (strategy) {
+  case read_file_strategy::automatic:
+    // For small files, setting up and tearing down a mapping costs more than
+    // copying. See benchmark-file.cpp.
+    return s.st_size >= memory_map_threshold;
+  case read_file_strategy::memory_map:
+    return true;
+  case read_file_strategy::read:
+    return false;
+  }
+  QLJS_UNREACHABLE();
+}
+#endif
 }
 
-read_file_result read_file(const char *path, posix_fd_file &file) {
+read_file_result read_file(const char *path, posix_fd_file &file,
+                           read_file_strategy strategy) {
   struct stat s;
   int rc = ::fstat(file.get(), &s);
   if (rc == -1) {
@@ -194,6 +412,19 @@ read_file_result read_file(const char *path, posix_fd_file &file) {
     return read_file_result::failure(
         std::string("file too large to read into memory: ") + path);
   }
+#if defined(QLJS_FILE_MMAP)
+  if (should_memory_map(strategy, s)) {
+    std::optional<file_content> content =
+        memory_map_file(file, narrow_cast<int>(file_size));
+    if (content.has_value()) {
+      read_file_result result;
+      result.content = std::move(*content);
+      return result;
+    }
+  }
+#else
+  static_cast<void>(strategy);
+#endif
   return read_file_with_expected_size(
       /*file=*/file, /*file_size=*/narrow_cast<int>(file_size),
       /*buffer_size=*/reasonable_buffer_size(s));
@@ -201,8 +432,12 @@ read_file_result read_file(const char *path, posix_fd_file &file) {
 #endif
 }
 
-#if defined(QLJS_FILE_WINDOWS)
 read_file_result read_file(const char *path) {
+  return read_file(path, read_file_strategy::automatic);
+}
+
+#if defined(QLJS_FILE_WINDOWS)
+read_file_result read_file(const char *path, read_file_strategy strategy) {
   // TODO(strager): Use CreateFileW.
   HANDLE handle = ::CreateFileA(
       path, /*dwDesiredAccess=*/GENERIC_READ,
@@ -217,12 +452,12 @@ read_file_result read_file(const char *path) {
                                      ": " + windows_error_message(error));
   }
   windows_handle_file file(handle);
-  return read_file(path, file);
+  return read_file(path, file, strategy);
 }
 #endif
 
 #if defined(QLJS_FILE_POSIX)
-read_file_result read_file(const char *path) {
+read_file_result read_file(const char *path, read_file_strategy strategy) {
   int fd = ::open(path, O_CLOEXEC | O_RDONLY);
   if (fd == -1) {
     int error = errno;
@@ -230,7 +465,7 @@ read_file_result read_file(const char *path) {
                                      ": " + std::strerror(error));
   }
   posix_fd_file file(fd);
-  return read_file(path, file);
+  return read_file(path, file, strategy);
 }
 #endif
 }
@@ -0,0 +1,68 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cstddef>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/json.h>
+#include <quick-lint-js/narrow-cast.h>
+#include <quick-lint-js/output-stream.h>
+
+namespace quick_lint_js {
+void write_json_escaped_string(output_stream &output, string8_view string) {
+  auto needs_escape = [](char8 c) -> bool {
+    return c == u8'"' || c == u8'\\' || static_cast<unsigned char>(c) < 0x20;
+  };
+  static constexpr char8 hex_digits[] = u8"0123456789abcdef";
+
+  const char8 *chunk_begin = string.data();
+  const char8 *end = string.data() + string.size();
+  for (const char8 *c = chunk_begin; c != end; ++c) {
+    if (!needs_escape(*c)) {
+      continue;
+    }
+    output.append_copy(string8_view(chunk_begin, narrow_cast<std::size_t>(
+                                                     c - chunk_begin)));
+    output.append_copy(u8'\\');
+    switch (*c) {
+    case u8'"':
+    case u8'\\':
+      output.append_copy(*c);
+      break;
+    case u8'\n':
+      output.append_copy(u8'n');
+      break;
+    case u8'\r':
+      output.append_copy(u8'r');
+      break;
+    case u8'\t':
+      output.append_copy(u8't');
+      break;
+    default: {
+      auto byte = static_cast<unsigned char>(*c);
+      output.append_copy(u8'u');
+      output.append_copy(u8'0');
+      output.append_copy(u8'0');
+      output.append_copy(hex_digits[byte >> 4]);
+      output.append_copy(hex_digits[byte & 0xf]);
+      break;
+    }
+    }
+    chunk_begin = c + 1;
+  }
+  output.append_copy(
+      string8_view(chunk_begin, narrow_cast<std::size_t>(end - chunk_begin)));
+}
+}
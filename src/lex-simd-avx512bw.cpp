@@ -0,0 +1,31 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// This file is compiled with -mavx512bw. Code in this file must only run if
+// the CPU supports AVX512BW; see lex_simd() in lex-simd.cpp.
+
+#include <quick-lint-js/have.h>
+#include <quick-lint-js/lex-simd-kernels.h>
+#include <quick-lint-js/lex-simd.h>
+#include <quick-lint-js/simd.h>
+
+#if QLJS_HAVE_X86_AVX512BW
+namespace quick_lint_js {
+extern const lex_simd_routines lex_simd_routines_avx512bw;
+const lex_simd_routines lex_simd_routines_avx512bw =
+    make_lex_simd_routines<char_vector_64_avx512bw>("avx512bw");
+}
+#endif
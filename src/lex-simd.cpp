@@ -0,0 +1,105 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <quick-lint-js/have.h>
+#include <quick-lint-js/lex-simd-kernels.h>
+#include <quick-lint-js/lex-simd.h>
+#include <quick-lint-js/simd.h>
+#include <vector>
+
+#if !defined(QLJS_HAVE_LEX_SIMD_AVX2)
+#define QLJS_HAVE_LEX_SIMD_AVX2 0
+#endif
+
+#if !defined(QLJS_HAVE_LEX_SIMD_AVX512BW)
+#define QLJS_HAVE_LEX_SIMD_AVX512BW 0
+#endif
+
+namespace quick_lint_js {
+#if QLJS_HAVE_LEX_SIMD_AVX2
+// Defined in lex-simd-avx2.cpp.
+extern const lex_simd_routines lex_simd_routines_avx2;
+#endif
+#if QLJS_HAVE_LEX_SIMD_AVX512BW
+// Defined in lex-simd-avx512bw.cpp.
+extern const lex_simd_routines lex_simd_routines_avx512bw;
+#endif
+
+namespace {
+#if QLJS_HAVE_X86_SSE2
+constexpr lex_simd_routines lex_simd_routines_default =
+    make_lex_simd_routines<char_vector_16_sse2>("sse2");
+#else
+constexpr lex_simd_routines lex_simd_routines_default =
+    make_lex_simd_routines<char_vector_1>("scalar");
+#endif
+
+#if QLJS_HAVE_LEX_SIMD_AVX2
+bool cpu_supports_avx2() noexcept {
+#if QLJS_HAVE_BUILTIN_CPU_SUPPORTS
+  return __builtin_cpu_supports("avx2");
+#else
+  return false;
+#endif
+}
+#endif
+
+#if QLJS_HAVE_LEX_SIMD_AVX512BW
+bool cpu_supports_avx512bw() noexcept {
+#if QLJS_HAVE_BUILTIN_CPU_SUPPORTS
+  return __builtin_cpu_supports("avx512bw");
+#else
+  return false;
+#endif
+}
+#endif
+
+const lex_simd_routines &choose_lex_simd() noexcept {
+#if QLJS_HAVE_LEX_SIMD_AVX512BW
+  if (cpu_supports_avx512bw()) {
+    return lex_simd_routines_avx512bw;
+  }
+#endif
+#if QLJS_HAVE_LEX_SIMD_AVX2
+  if (cpu_supports_avx2()) {
+    return lex_simd_routines_avx2;
+  }
+#endif
+  return lex_simd_routines_default;
+}
+}
+
+const lex_simd_routines &lex_simd() noexcept {
+  static const lex_simd_routines &routines = choose_lex_simd();
+  return routines;
+}
+
+std::vector<const lex_simd_routines *> supported_lex_simd_routines() {
+  std::vector<const lex_simd_routines *> routines;
+  routines.push_back(&lex_simd_routines_default);
+#if QLJS_HAVE_LEX_SIMD_AVX2
+  if (cpu_supports_avx2()) {
+    routines.push_back(&lex_simd_routines_avx2);
+  }
+#endif
+#if QLJS_HAVE_LEX_SIMD_AVX512BW
+  if (cpu_supports_avx512bw()) {
+    routines.push_back(&lex_simd_routines_avx512bw);
+  }
+#endif
+  return routines;
+}
+}
@@ -0,0 +1,58 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cstddef>
+#include <quick-lint-js/assert.h>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/lex-simd.h>
+#include <quick-lint-js/lex-structural-index.h>
+#include <quick-lint-js/narrow-cast.h>
+#include <quick-lint-js/padded-string.h>
+
+namespace quick_lint_js {
+static_assert(padded_string::padding_size >= 64,
+              "the last block (containing the null terminator) must not "
+              "extend past the padding");
+
+lex_structural_index::lex_structural_index(padded_string_view input)
+    : lex_structural_index(input, lex_simd()) {}
+
+lex_structural_index::lex_structural_index(padded_string_view input,
+                                           const lex_simd_routines &routines)
+    : input_(input.data()), routines_(routines) {
+  std::size_t size_including_null_terminator =
+      narrow_cast<std::size_t>(input.null_terminator() - input.data()) + 1;
+  std::size_t block_count = (size_including_null_terminator + 63) / 64;
+  this->blocks_.resize(block_count);
+  this->routines_.build_structural_index(this->input_, block_count,
+                                         this->blocks_.data());
+}
+
+void lex_structural_index::refresh(const char8 *begin,
+                                   const char8 *end) noexcept {
+  QLJS_ASSERT(begin <= end);
+  if (begin == end) {
+    return;
+  }
+  std::size_t first_block = narrow_cast<std::size_t>(begin - this->input_) / 64;
+  std::size_t last_block =
+      narrow_cast<std::size_t>(end - 1 - this->input_) / 64;
+  QLJS_ASSERT(last_block < this->blocks_.size());
+  this->routines_.build_structural_index(
+      this->input_ + first_block * 64, last_block - first_block + 1,
+      &this->blocks_[first_block]);
+}
+}
@@ -0,0 +1,520 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <quick-lint-js/assert.h>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/error.h>
+#include <quick-lint-js/lex-token-stream.h>
+#include <quick-lint-js/lex.h>
+#include <quick-lint-js/narrow-cast.h>
+#include <quick-lint-js/padded-string.h>
+#include <quick-lint-js/parallel.h>
+#include <quick-lint-js/unicode-identifier-table.h>
+#include <quick-lint-js/utf-8.h>
+#include <vector>
+
+namespace quick_lint_js {
+namespace {
+static_assert(static_cast<int>(token_type::star_star_equal) < 256,
+              "every token_type must fit in token_stream's 1-byte types");
+}
+
+// A token lexed by a lex_in_parallel worker, and the state of the worker's
+// token_stream_lexer around the token.
+struct speculative_token {
+  std::uint32_t begin_offset;
+  std::uint32_t end_offset;
+  token_type type;
+  bool has_leading_newline;
+  // The lexer's previous_ends_expression before this token.
+  bool previous_ends_expression;
+  bool in_template_before;
+  bool in_template_after;
+  // Whether errors were reported while lexing this token or the whitespace
+  // and comments before it.
+  bool had_errors;
+  // Whether this token was lexed by the same lexer as the token before it.
+  // (Workers start a new lexer after each character they cannot lex.)
+  bool follows_previous;
+};
+
+namespace {
+struct template_substitution {
+  const char8 *template_begin;
+  // The number of unclosed '{' tokens inside the substitution.
+  int curly_depth;
+};
+
+// A lexer which makes token_stream's guesses about regular expressions and
+// template substitutions.
+class token_stream_lexer {
+ public:
+  explicit token_stream_lexer(padded_string_view input,
+                              error_reporter *error_reporter,
+                              lexer_strategy strategy,
+                              bool previous_ends_expression)
+      : lexer_(input, error_reporter, strategy),
+        previous_ends_expression_(previous_ends_expression) {
+    this->reparse_if_regexp();
+  }
+
+  const token &peek() const noexcept { return this->lexer_.peek(); }
+
+  // Whether a '/' would be division if it was the current token.
+  bool previous_ends_expression() const noexcept {
+    return this->previous_ends_expression_;
+  }
+
+  // Whether the current token is inside a template substitution or is the
+  // rest of a template after a substitution.
+  bool in_template() const noexcept {
+    return !this->substitutions_.empty() || this->continues_template_;
+  }
+
+  // Precondition: this->peek().type != token_type::end_of_file.
+  void skip() {
+    const token &t = this->lexer_.peek();
+    this->previous_ends_expression_ = ends_expression(t.type);
+    switch (t.type) {
+    case token_type::incomplete_template:
+      if (!this->continues_template_) {
+        this->substitutions_.push_back(
+            template_substitution{.template_begin = t.begin, .curly_depth = 0});
+      }
+      break;
+
+    case token_type::left_curly:
+      if (!this->substitutions_.empty()) {
+        this->substitutions_.back().curly_depth += 1;
+      }
+      break;
+
+    case token_type::right_curly:
+      if (!this->substitutions_.empty()) {
+        template_substitution &s = this->substitutions_.back();
+        if (s.curly_depth == 0) {
+          this->lexer_.skip_in_template(s.template_begin);
+          if (this->lexer_.peek().type == token_type::complete_template) {
+            this->substitutions_.pop_back();
+          }
+          this->continues_template_ = true;
+          return;
+        }
+        s.curly_depth -= 1;
+      }
+      break;
+
+    default:
+      break;
+    }
+    this->continues_template_ = false;
+    this->lexer_.skip();
+    this->reparse_if_regexp();
+  }
+
+ private:
+  void reparse_if_regexp() {
+    switch (this->lexer_.peek().type) {
+    case token_type::slash:
+    case token_type::slash_equal:
+      if (!this->previous_ends_expression_) {
+        this->lexer_.reparse_as_regexp();
+      }
+      break;
+
+    default:
+      break;
+    }
+  }
+
+  lexer lexer_;
+  bool previous_ends_expression_;
+  std::vector<template_substitution> substitutions_;
+  // Whether the current token is the rest of a template after a
+  // substitution's '}'.
+  bool continues_template_ = false;
+};
+
+class error_counter final : public error_reporter {
+ public:
+#define QLJS_ERROR_TYPE(name, struct_body, format) \
+  void report(name) override { this->count += 1; }
+  QLJS_X_ERROR_TYPES
+#undef QLJS_ERROR_TYPE
+
+  void report_fatal_error_unimplemented_character(const char *, int,
+                                                  const char *,
+                                                  const char8 *) override {
+    this->count += 1;
+  }
+  void report_fatal_error_unimplemented_token(const char *, int, const char *,
+                                              token_type,
+                                              const char8 *) override {
+    this->count += 1;
+  }
+
+  int count = 0;
+};
+
+// Whether the given tokens are the same and were lexed in the same state. If
+// so, the tokens after them are lexed in the same state too.
+bool same_token_and_state(const speculative_token &a,
+                          const speculative_token &b) noexcept {
+  return a.begin_offset == b.begin_offset && a.end_offset == b.end_offset &&
+         a.type == b.type &&
+         a.previous_ends_expression == b.previous_ends_expression &&
+         !a.in_template_before &&
+         !b.in_template_before &&
+         !a.in_template_after && !b.in_template_after;
+}
+
+// How far past the end of a chunk a worker copies the input, so the worker
+// can finish lexing a token which straddles the end of the chunk.
+constexpr std::size_t speculation_overlap = 1024;
+
+// The lexer looks at most a few bytes past the end of a token to find where
+// the token ends. A worker does not trust tokens which end within this many
+// bytes of the end of the worker's copy of the input.
+constexpr std::size_t speculation_lookahead = 16;
+
+// Chunks begin after a line terminator, where a guess of 'code' is most
+// likely to be correct.
+std::vector<std::size_t> find_chunk_begins(const char8 *input,
+                                           std::size_t input_size,
+                                           std::size_t chunk_size) {
+  std::vector<std::size_t> chunk_begins = {0};
+  std::size_t begin = chunk_size;
+  while (begin < input_size) {
+    const void *newline =
+        std::memchr(&input[begin], '\n', input_size - begin);
+    if (!newline) {
+      break;
+    }
+    begin = narrow_cast<std::size_t>(static_cast<const char8 *>(newline) -
+                                     input) +
+            1;
+    if (begin >= input_size) {
+      break;
+    }
+    chunk_begins.push_back(begin);
+    begin += chunk_size;
+  }
+  return chunk_begins;
+}
+
+struct unlexable_character {
+  const char8 *begin;
+  const char8 *end;
+};
+
+// Find the first character in [begin, end) which would crash the lexer if a
+// token began with it.
+//
+// The lexer crashes on non-ASCII characters which cannot begin an identifier
+// (and on invalid UTF-8). Such characters are fine inside strings and
+// comments, but a worker which wrongly guessed that it is lexing code must
+// not crash.
+unlexable_character find_unlexable_character(const char8 *begin,
+                                             const char8 *end) {
+  const char8 *c = begin;
+  while (c < end) {
+    if (end - c >= 8) {
+      std::uint64_t bytes;
+      std::memcpy(&bytes, c, sizeof(bytes));
+      if ((bytes & 0x8080808080808080ULL) == 0) {
+        c += 8;
+        continue;
+      }
+    }
+    if (static_cast<std::uint8_t>(*c) < 0x80) {
+      c += 1;
+      continue;
+    }
+    decode_utf_8_result character = decode_utf_8(c);
+    if (!character.ok || !is_unicode_id_start(character.code_point) ||
+        c + character.size > end) {
+      return unlexable_character{.begin = c, .end = c + character.size};
+    }
+    c += character.size;
+  }
+  return unlexable_character{.begin = end, .end = end};
+}
+
+// Lex input[segment_begin, segment_end) as code, and append tokens to out.
+//
+// Return true if a token reaching chunk_end was lexed.
+bool lex_segment_speculatively(const char8 *input, std::size_t input_size,
+                               std::size_t segment_begin,
+                               std::size_t segment_end, std::size_t chunk_end,
+                               std::vector<speculative_token> &out) {
+  padded_string segment(
+      string8(&input[segment_begin], segment_end - segment_begin));
+  std::size_t trusted_end = segment_end == input_size
+                                ? segment_end
+                                : segment_end - std::min(segment_end,
+                                                         speculation_lookahead);
+  error_counter errors;
+  token_stream_lexer l(&segment, &errors, lexer_strategy::automatic,
+                       /*previous_ends_expression=*/false);
+  int counted_errors = 0;
+  bool follows_previous = false;
+  while (l.peek().type != token_type::end_of_file) {
+    const token &t = l.peek();
+    speculative_token st;
+    st.begin_offset = narrow_cast<std::uint32_t>(
+        segment_begin + narrow_cast<std::size_t>(t.begin - segment.data()));
+    st.end_offset = narrow_cast<std::uint32_t>(
+        segment_begin + narrow_cast<std::size_t>(t.end - segment.data()));
+    if (st.end_offset > trusted_end) {
+      return false;
+    }
+    st.type = t.type;
+    st.has_leading_newline = t.has_leading_newline;
+    st.previous_ends_expression = l.previous_ends_expression();
+    st.in_template_before = l.in_template();
+    st.had_errors = errors.count != counted_errors;
+    st.follows_previous = follows_previous;
+    counted_errors = errors.count;
+    l.skip();
+    st.in_template_after = l.in_template();
+    out.push_back(st);
+    if (st.end_offset >= chunk_end) {
+      return true;
+    }
+    follows_previous = true;
+  }
+  return false;
+}
+
+std::vector<speculative_token> lex_chunk_speculatively(
+    const char8 *input, std::size_t input_size, std::size_t chunk_begin,
+    std::size_t chunk_end) {
+  std::vector<speculative_token> tokens;
+  tokens.reserve((chunk_end - chunk_begin) / 4);
+  const char8 *copy_end =
+      &input[std::min(input_size, chunk_end + speculation_overlap)];
+  const char8 *segment_begin = &input[chunk_begin];
+  for (;;) {
+    unlexable_character unlexable =
+        find_unlexable_character(segment_begin, copy_end);
+    bool reached_chunk_end = lex_segment_speculatively(
+        input, input_size,
+        narrow_cast<std::size_t>(segment_begin - input),
+        narrow_cast<std::size_t>(unlexable.begin - input), chunk_end, tokens);
+    if (reached_chunk_end || unlexable.end >= copy_end) {
+      break;
+    }
+    segment_begin = unlexable.end;
+  }
+  return tokens;
+}
+}
+
+token_stream token_stream::lex(padded_string_view input,
+                               error_reporter *error_reporter) {
+  const char8 *input_begin = input.data();
+  token_stream tokens;
+  // Typical JavaScript has one token per 4 to 8 bytes. Reserving for the
+  // denser end avoids most reallocations without wasting much memory.
+  tokens.grow(
+      narrow_cast<std::size_t>(input.null_terminator() - input_begin) / 4);
+
+  token_stream_lexer l(input, error_reporter, lexer_strategy::automatic,
+                       /*previous_ends_expression=*/false);
+  while (l.peek().type != token_type::end_of_file) {
+    tokens.add(l.peek(), input_begin);
+    l.skip();
+  }
+  tokens.shrink_to_size();
+  return tokens;
+}
+
+token_stream token_stream::lex_in_parallel(padded_string_view input,
+                                           error_reporter *error_reporter,
+                                           int thread_count, int chunk_size) {
+  QLJS_ASSERT(chunk_size > 0);
+  char8 *input_begin = input.data();
+  std::size_t input_size =
+      narrow_cast<std::size_t>(input.null_terminator() - input_begin);
+  // The calling thread's lexer rewrites identifiers in input, so workers read
+  // a copy instead.
+  padded_string snapshot(string8(input_begin, input_size));
+  std::vector<std::size_t> chunk_begins = find_chunk_begins(
+      snapshot.data(), input_size, narrow_cast<std::size_t>(chunk_size));
+  if (chunk_begins.size() == 1) {
+    return lex(input, error_reporter);
+  }
+  auto chunk_end = [&](int chunk_index) -> std::size_t {
+    std::size_t next = narrow_cast<std::size_t>(chunk_index) + 1;
+    return next == chunk_begins.size() ? input_size : chunk_begins[next];
+  };
+
+  token_stream tokens;
+  tokens.grow(input_size / 4);
+
+  std::optional<token_stream_lexer> l;
+  l.emplace(input, error_reporter, lexer_strategy::direct,
+            /*previous_ends_expression=*/false);
+  if (l->peek().type == token_type::end_of_file) {
+    tokens.shrink_to_size();
+    return tokens;
+  }
+  // The most recently added token.
+  speculative_token last;
+  auto add_lexed_token = [&]() -> void {
+    const token &t = l->peek();
+    last.begin_offset = narrow_cast<std::uint32_t>(t.begin - input_begin);
+    last.end_offset = narrow_cast<std::uint32_t>(t.end - input_begin);
+    last.type = t.type;
+    last.previous_ends_expression = l->previous_ends_expression();
+    last.in_template_before = l->in_template();
+    tokens.add(t, input_begin);
+    l->skip();
+    last.in_template_after = l->in_template();
+  };
+  add_lexed_token();
+
+  const char8 *snapshot_begin = snapshot.data();
+  for_each_in_parallel_in_order<std::vector<speculative_token>>(
+      narrow_cast<int>(chunk_begins.size()), thread_count,
+      [&](int chunk_index) -> std::vector<speculative_token> {
+        return lex_chunk_speculatively(
+            snapshot_begin, input_size,
+            chunk_begins[narrow_cast<std::size_t>(chunk_index)],
+            chunk_end(chunk_index));
+      },
+      [&](int chunk_index, std::vector<speculative_token> &&speculative) {
+        std::size_t end = chunk_end(chunk_index);
+        std::size_t i = 0;
+        while (last.end_offset < end &&
+               l->peek().type != token_type::end_of_file) {
+          while (i < speculative.size() &&
+                 speculative[i].end_offset < last.end_offset) {
+            i += 1;
+          }
+          if (i < speculative.size() &&
+              same_token_and_state(speculative[i], last)) {
+            // Adopt the worker's tokens after the matching token. Stop before
+            // a token with errors so the errors are reported, and stop outside
+            // templates so a new lexer can resume lexing.
+            std::size_t adopted_end = i + 1;
+            for (std::size_t j = i + 1;
+                 j < speculative.size() && speculative[j].follows_previous &&
+                 !speculative[j].had_errors;
+                 ++j) {
+              // NOTE(strager): A lexer treats '#!' at the beginning of its
+              // input as a shebang, so do not resume lexing before '#!'.
+              const char8 *after = &input_begin[speculative[j].end_offset];
+              if (!speculative[j].in_template_after &&
+                  !(after[0] == '#' && after[1] == '!')) {
+                adopted_end = j + 1;
+              }
+            }
+            if (adopted_end > i + 1) {
+              tokens.add_speculative_tokens(&speculative[i + 1],
+                                            &speculative[adopted_end]);
+              last = speculative[adopted_end - 1];
+              l.emplace(
+                  padded_string_view(
+                      &input_begin[last.end_offset],
+                      narrow_cast<int>(input_size - last.end_offset)),
+                  error_reporter, lexer_strategy::direct,
+                  /*previous_ends_expression=*/ends_expression(last.type));
+              i = adopted_end;
+              continue;
+            }
+          }
+          add_lexed_token();
+        }
+      });
+
+  while (l->peek().type != token_type::end_of_file) {
+    add_lexed_token();
+  }
+  tokens.shrink_to_size();
+  return tokens;
+}
+
+std::size_t token_stream::storage_size() const noexcept {
+  return this->types_.size() * sizeof(this->types_[0]) +
+         this->begin_offsets_.size() * sizeof(this->begin_offsets_[0]) +
+         this->end_offsets_.size() * sizeof(this->end_offsets_[0]) +
+         this->leading_newline_bits_.size() *
+             sizeof(this->leading_newline_bits_[0]);
+}
+
+void token_stream::add(const token &t, const char8 *input_begin) {
+  std::size_t index = this->size_;
+  if (index == this->types_.size()) {
+    this->grow(index * 2);
+  }
+  this->types_[index] = static_cast<std::uint8_t>(t.type);
+  this->begin_offsets_[index] =
+      narrow_cast<std::uint32_t>(t.begin - input_begin);
+  this->end_offsets_[index] = narrow_cast<std::uint32_t>(t.end - input_begin);
+  if (t.has_leading_newline) {
+    this->leading_newline_bits_[index / 64] |= std::uint64_t{1}
+                                               << (index % 64);
+  }
+  this->size_ = index + 1;
+}
+
+void token_stream::add_speculative_tokens(const speculative_token *begin,
+                                          const speculative_token *end) {
+  std::size_t index = this->size_;
+  std::size_t new_size = index + narrow_cast<std::size_t>(end - begin);
+  if (new_size > this->types_.size()) {
+    this->grow(new_size * 2);
+  }
+  // NOTE(strager): Stores through std::uint8_t* can alias anything, so copy
+  // the arrays' pointers into locals. Otherwise, the compiler reloads each
+  // vector's data pointer after storing each token's type.
+  std::uint8_t *types = this->types_.data();
+  std::uint32_t *begin_offsets = this->begin_offsets_.data();
+  std::uint32_t *end_offsets = this->end_offsets_.data();
+  std::uint64_t *leading_newline_bits = this->leading_newline_bits_.data();
+  for (const speculative_token *t = begin; t != end; ++t) {
+    types[index] = static_cast<std::uint8_t>(t->type);
+    begin_offsets[index] = t->begin_offset;
+    end_offsets[index] = t->end_offset;
+    leading_newline_bits[index / 64] |=
+        std::uint64_t{t->has_leading_newline} << (index % 64);
+    index += 1;
+  }
+  this->size_ = index;
+}
+
+void token_stream::grow(std::size_t new_capacity) {
+  // Keep the capacity a multiple of 64 so every token has a newline bit.
+  new_capacity = (new_capacity + 64) / 64 * 64;
+  this->types_.resize(new_capacity);
+  this->begin_offsets_.resize(new_capacity);
+  this->end_offsets_.resize(new_capacity);
+  this->leading_newline_bits_.resize(new_capacity / 64);
+}
+
+void token_stream::shrink_to_size() {
+  this->types_.resize(this->size_);
+  this->begin_offsets_.resize(this->size_);
+  this->end_offsets_.resize(this->size_);
+  this->leading_newline_bits_.resize((this->size_ + 63) / 64);
+}
+}
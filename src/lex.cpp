@@ -15,6 +15,7 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <algorithm>
+#include <csetjmp>
 #include <cstdint>
 #include <cstring>
 #include <iterator>
@@ -22,15 +23,22 @@
 #include <quick-lint-js/assert.h>
 #include <quick-lint-js/bit.h>
 #include <quick-lint-js/char8.h>
+#include <quick-lint-js/crash.h>
 #include <quick-lint-js/error.h>
+#include <quick-lint-js/force-inline.h>
 #include <quick-lint-js/have.h>
 #include <quick-lint-js/integer.h>
+#include <quick-lint-js/lex-simd.h>
+#include <quick-lint-js/lex-structural-index.h>
 #include <quick-lint-js/lex.h>
 #include <quick-lint-js/narrow-cast.h>
 #include <quick-lint-js/padded-string.h>
 #include <quick-lint-js/simd.h>
+#include <quick-lint-js/unicode-identifier-table.h>
+#include <quick-lint-js/utf-8.h>
 #include <quick-lint-js/warning.h>
 #include <type_traits>
+#include <utility>
 
 #if QLJS_HAVE_X86_SSE4_2
 #include <nmmintrin.h>
@@ -128,10 +136,205 @@ source_code_span token::span() const noexcept {
   return source_code_span(this->begin, this->end);
 }
 
-lexer::lexer(padded_string_view input, error_reporter* error_reporter) noexcept
+namespace {
+// Building a lex_structural_index costs about 1 microsecond per 4 KiB (with
+// AVX2), plus an allocation. Small inputs rarely contain comments or strings
+// long enough to pay for it.
+constexpr int structural_index_minimum_input_size = 4096;
+
+bool is_ascii_whitespace(char8 c) noexcept {
+  return c == ' ' || c == '\t' || c == '\f' || c == '\v' || c == '\n' ||
+         c == '\r';
+}
+
+#if QLJS_HAVE_X86_SSE2
+using inline_char_vector = char_vector_16_sse2;
+#else
+using inline_char_vector = char_vector_1;
+#endif
+
+// Returns a pointer to the first character matching classify.
+//
+// Most strings, templates, and comments are short, so check the first few
+// characters inline. Fall back to the (possibly wider) out-of-line loop in
+// lex_simd_routines for long ones.
+template <class Classify, class FindOutOfLine>
+QLJS_FORCE_INLINE inline char8* find_first_match(
+    char8* c, Classify&& classify, FindOutOfLine&& find_out_of_line) noexcept {
+  std::uint32_t mask = classify(inline_char_vector::load(c)).mask();
+  if (mask != 0) {
+    return c + countr_zero(mask);
+  }
+  return find_out_of_line(c + inline_char_vector::size);
+}
+
+// Returns a pointer to the first character not matching classify.
+//
+// Most number literals are short, so check the first few characters inline.
+// Fall back to the (possibly wider) out-of-line loop in lex_simd_routines for
+// long ones.
+template <class Classify, class SkipOutOfLine>
+QLJS_FORCE_INLINE inline char8* skip_matches(
+    char8* c, Classify&& classify, SkipOutOfLine&& skip_out_of_line) noexcept {
+  int match_count = classify(inline_char_vector::load(c)).find_first_false();
+  if (match_count != inline_char_vector::size) {
+    return c + match_count;
+  }
+  return skip_out_of_line(c + inline_char_vector::size);
+}
+
+// Returns a pointer to the first character which is not [0-9].
+QLJS_FORCE_INLINE inline char8* skip_decimal_digits(char8* c) noexcept {
+  using char_vector = inline_char_vector;
+  return skip_matches(
+      c,
+      [](char_vector chars) {
+        return (chars > char_vector::repeated(u8'0' - 1)) &
+               (chars < char_vector::repeated(u8'9' + 1));
+      },
+      [](char8* rest) { return lex_simd().skip_decimal_digits(rest); });
+}
+
+// Returns a pointer to the first character which is not [0-9A-Fa-f].
+QLJS_FORCE_INLINE inline char8* skip_hex_digits(char8* c) noexcept {
+  using char_vector = inline_char_vector;
+  return skip_matches(
+      c,
+      [](char_vector chars) {
+        constexpr std::uint8_t upper_to_lower_mask = u8'a' - u8'A';
+        char_vector lower_cased_characters =
+            chars | char_vector::repeated(upper_to_lower_mask);
+        return ((chars > char_vector::repeated(u8'0' - 1)) &
+                (chars < char_vector::repeated(u8'9' + 1))) |
+               ((lower_cased_characters > char_vector::repeated(u8'a' - 1)) &
+                (lower_cased_characters < char_vector::repeated(u8'f' + 1)));
+      },
+      [](char8* rest) { return lex_simd().skip_hex_digits(rest); });
+}
+
+// Returns a pointer to the first character which is not [01].
+QLJS_FORCE_INLINE inline char8* skip_binary_digits(char8* c) noexcept {
+  using char_vector = inline_char_vector;
+  return skip_matches(
+      c,
+      [](char_vector chars) {
+        return (chars == char_vector::repeated(u8'0')) |
+               (chars == char_vector::repeated(u8'1'));
+      },
+      [](char8* rest) { return lex_simd().skip_binary_digits(rest); });
+}
+
+// Returns a pointer to the first quote, '\\', '\n', '\r', or '\0'.
+QLJS_FORCE_INLINE inline char8* find_string_special_character(
+    char8* c, char8 quote) noexcept {
+  using char_vector = inline_char_vector;
+  return find_first_match(
+      c,
+      [quote](char_vector chars) {
+        return (chars ==
+                char_vector::repeated(static_cast<std::uint8_t>(quote))) |
+               (chars == char_vector::repeated(u8'\\')) |
+               (chars == char_vector::repeated(u8'\n')) |
+               (chars == char_vector::repeated(u8'\r')) |
+               (chars == char_vector::repeated(u8'\0'));
+      },
+      [quote](char8* rest) {
+        return lex_simd().find_string_special_character(rest, quote);
+      });
+}
+
+// Returns a pointer to the first '\n', '\r', '\0', or 0xe2 (which might begin
+// U+2028 or U+2029).
+QLJS_FORCE_INLINE inline char8* find_line_comment_special_character(
+    char8* c) noexcept {
+  using char_vector = inline_char_vector;
+  return find_first_match(
+      c,
+      [](char_vector chars) {
+        return (chars == char_vector::repeated(u8'\n')) |
+               (chars == char_vector::repeated(u8'\r')) |
+               (chars == char_vector::repeated(u8'\0')) |
+               (chars == char_vector::repeated(0xe2));
+      },
+      [](char8* rest) {
+        return lex_simd().find_line_comment_special_character(rest);
+      });
+}
+
+// Returns a pointer to the first '*', '\n', '\r', '\0', or 0xe2 (which might
+// begin U+2028 or U+2029).
+QLJS_FORCE_INLINE inline char8* find_block_comment_special_character(
+    char8* c) noexcept {
+  using char_vector = inline_char_vector;
+  return find_first_match(
+      c,
+      [](char_vector chars) {
+        return (chars == char_vector::repeated(u8'*')) |
+               (chars == char_vector::repeated(u8'\n')) |
+               (chars == char_vector::repeated(u8'\r')) |
+               (chars == char_vector::repeated(u8'\0')) |
+               (chars == char_vector::repeated(0xe2));
+      },
+      [](char8* rest) {
+        return lex_simd().find_block_comment_special_character(rest);
+      });
+}
+
+// Returns a pointer to the first '*' or '\0'.
+QLJS_FORCE_INLINE inline char8* find_star_or_null(char8* c) noexcept {
+  using char_vector = inline_char_vector;
+  return find_first_match(
+      c,
+      [](char_vector chars) {
+        return (chars == char_vector::repeated(u8'*')) |
+               (chars == char_vector::repeated(u8'\0'));
+      },
+      [](char8* rest) { return lex_simd().find_star_or_null(rest); });
+}
+
+// Returns a pointer to the first '`', '\\', '$', or '\0'.
+QLJS_FORCE_INLINE inline char8* find_template_special_character(
+    char8* c) noexcept {
+  using char_vector = inline_char_vector;
+  return find_first_match(
+      c,
+      [](char_vector chars) {
+        return (chars == char_vector::repeated(u8'`')) |
+               (chars == char_vector::repeated(u8'\\')) |
+               (chars == char_vector::repeated(u8'$')) |
+               (chars == char_vector::repeated(u8'\0'));
+      },
+      [](char8* rest) {
+        return lex_simd().find_template_special_character(rest);
+      });
+}
+}
+
+lexer::lexer(padded_string_view input, error_reporter* error_reporter)
+    : lexer(input, error_reporter, lexer_strategy::automatic) {}
+
+lexer::lexer(padded_string_view input, error_reporter* error_reporter,
+             lexer_strategy strategy)
     : input_(input.data()),
       error_reporter_(error_reporter),
       original_input_(input) {
+  bool use_structural_index;
+  switch (strategy) {
+  case lexer_strategy::automatic:
+    use_structural_index = input.null_terminator() - input.data() >=
+                           structural_index_minimum_input_size;
+    break;
+  case lexer_strategy::direct:
+    use_structural_index = false;
+    break;
+  case lexer_strategy::structural_index:
+    use_structural_index = true;
+    break;
+  }
+  if (use_structural_index) {
+    this->structural_index_.emplace(input);
+  }
+
   this->last_token_.end = nullptr;
   this->parse_current_token();
 }
@@ -150,11 +353,21 @@ retry:
       switch (this->input_[1]) {
       case 'x':
       case 'X':
+        if (!this->is_hex_digit(this->input_[2]) && this->input_[2] != '.') {
+          // '0x' without digits. Report 'x' as garbage.
+          this->parse_number();
+          break;
+        }
         this->input_ += 2;
         this->parse_hexadecimal_number();
         break;
       case 'b':
       case 'B':
+        if (!this->is_binary_digit(this->input_[2])) {
+          // '0b' without digits. Report 'b' as garbage.
+          this->parse_number();
+          break;
+        }
         this->input_ += 2;
         this->parse_binary_number();
         break;
@@ -168,7 +381,8 @@ retry:
     this->last_token_.end = this->input_;
     break;
 
-  QLJS_CASE_IDENTIFIER_START : {
+  QLJS_CASE_IDENTIFIER_START:
+  identifier : {
     parsed_identifier ident = this->parse_identifier(this->input_);
     this->input_ = ident.after;
     this->last_token_.normalized_identifier_end = ident.end;
@@ -177,10 +391,10 @@ retry:
         this->last_token_.begin,
         narrow_cast<std::size_t>(this->last_token_.normalized_identifier_end -
                                  this->last_token_.begin)));
-    if (!ident.escape_sequences.empty() &&
+    if (ident.escape_sequences &&
         this->last_token_.type != token_type::identifier) {
       // Escape sequences in identifiers prevent it from becoming a keyword.
-      for (const source_code_span& escape_sequence : ident.escape_sequences) {
+      for (const source_code_span& escape_sequence : *ident.escape_sequences) {
         this->error_reporter_->report(
             error_keywords_cannot_contain_escape_sequences{
                 .escape_sequence = escape_sequence});
@@ -427,6 +641,12 @@ retry:
 
     char8* c = &this->input_[1];
     for (;;) {
+      if (this->structural_index_.has_value()) {
+        c = this->structural_index_->find_next(
+            lex_structural_index::bitmap::string, c);
+      } else {
+        c = find_string_special_character(c, opening_quote);
+      }
       switch (static_cast<unsigned char>(*c)) {
       case '\0':
         if (this->is_eof(c)) {
@@ -561,13 +781,19 @@ retry:
   }
 
   default:
+    if (static_cast<std::uint8_t>(this->input_[0]) >= 0x80) {
+      decode_utf_8_result character = decode_utf_8(this->input_);
+      if (character.ok &&
+          this->is_initial_identifier_character(character.code_point)) {
+        goto identifier;
+      }
+    }
     this->error_reporter_->report_fatal_error_unimplemented_character(
         /*qljs_file_name=*/__FILE__,
         /*qljs_line=*/__LINE__,
         /*qljs_function_name=*/__func__,
         /*character=*/this->input_);
-    QLJS_CRASH_DISALLOWING_CORE_DUMP();
-    break;
+    stop_after_fatal_error();
   }
 }
 
@@ -584,6 +810,12 @@ lexer::parsed_template_body lexer::parse_template_body(
     char8* input, const char8* template_begin, error_reporter* error_reporter) {
   char8* c = input;
   for (;;) {
+    if (this->structural_index_.has_value()) {
+      c = this->structural_index_->find_next(
+          lex_structural_index::bitmap::template_body, c);
+    } else {
+      c = find_template_special_character(c);
+    }
     switch (*c) {
     case '\0':
       if (this->is_eof(c)) {
@@ -697,13 +929,16 @@ next:
 
   case '/': {
     ++c;
-    if (this->is_identifier_character(*c)) {
+    if (this->is_ascii_identifier_byte(*c)) {
       parsed_identifier ident = this->parse_identifier(c);
       c = ident.after;
-      for (const source_code_span& escape_sequence : ident.escape_sequences) {
-        this->error_reporter_->report(
-            error_regexp_literal_flags_cannot_contain_unicode_escapes{
-                .escape_sequence = escape_sequence});
+      if (ident.escape_sequences) {
+        for (const source_code_span& escape_sequence :
+             *ident.escape_sequences) {
+          this->error_reporter_->report(
+              error_regexp_literal_flags_cannot_contain_unicode_escapes{
+                  .escape_sequence = escape_sequence});
+        }
       }
     }
     break;
@@ -727,6 +962,41 @@ void lexer::insert_semicolon() {
   this->last_token_.end = this->input_;
 }
 
+void lexer::seek(const char8* position) {
+  this->input_ = const_cast<char8*>(position);
+  this->last_token_.end = position;
+  this->parse_current_token();
+}
+
+error_reporter* lexer::exchange_error_reporter(
+    error_reporter* new_error_reporter) noexcept {
+  return std::exchange(this->error_reporter_, new_error_reporter);
+}
+
+void lexer::remember_rewritten_identifiers() {
+  QLJS_ASSERT(!this->remember_rewritten_identifiers_);
+  QLJS_ASSERT(this->rewritten_identifiers_.empty());
+  this->remember_rewritten_identifiers_ = true;
+}
+
+void lexer::restore_rewritten_identifiers() {
+  QLJS_ASSERT(this->remember_rewritten_identifiers_);
+  for (auto it = this->rewritten_identifiers_.rbegin();
+       it != this->rewritten_identifiers_.rend(); ++it) {
+    std::copy(it->original.begin(), it->original.end(), it->begin);
+    if (this->structural_index_.has_value()) {
+      this->structural_index_->refresh(it->begin,
+                                       it->begin + it->original.size());
+    }
+  }
+  this->rewritten_identifiers_.clear();
+  this->remember_rewritten_identifiers_ = false;
+}
+
+void lexer::set_read_only_input(bool read_only) noexcept {
+  this->read_only_input_ = read_only;
+}
+
 const char8* lexer::end_of_previous_token() const noexcept {
   bool semicolon_was_inserted =
       this->last_token_.type == token_type::semicolon &&
@@ -749,9 +1019,7 @@ void lexer::parse_binary_number() {
   QLJS_ASSERT(this->is_binary_digit(this->input_[0]));
   char8* input = this->input_;
 
-  while (this->is_binary_digit(*input)) {
-    input += 1;
-  }
+  input = skip_binary_digits(input);
 
   this->input_ = check_garbage_in_number_literal(input);
 }
@@ -762,7 +1030,7 @@ char8* lexer::check_garbage_in_number_literal(char8* input) {
     switch (*input) {
     QLJS_CASE_DECIMAL_DIGIT:
     QLJS_CASE_IDENTIFIER_START:
-      input += 1;
+      input = lex_simd().skip_ascii_identifier_characters(input + 1);
       break;
     default:
       goto done_parsing_garbage;
@@ -838,13 +1106,17 @@ void lexer::parse_number() {
 }
 
 template <class Func>
-char8* lexer::parse_digits_and_underscores(Func&& is_valid_digit,
+char8* lexer::parse_digits_and_underscores(Func&& skip_digits,
                                            char8* input) noexcept {
   bool has_trailing_underscore = false;
   const char8* garbage_begin = nullptr;
-  while (is_valid_digit(*input)) {
+  for (;;) {
+    char8* digits_end = skip_digits(input);
+    if (digits_end == input) {
+      break;
+    }
     has_trailing_underscore = false;
-    input += 1;
+    input = digits_end;
     if (*input == '_') {
       garbage_begin = input;
       has_trailing_underscore = true;
@@ -856,7 +1128,7 @@ char8* lexer::parse_digits_and_underscores(Func&& is_valid_digit,
           input += 1;
         }
 
-        if (is_valid_digit(*input)) {
+        if (skip_digits(input) != input) {
           this->error_reporter_->report(
               error_number_literal_contains_consecutive_underscores{
                   source_code_span(garbage_begin, input)});
@@ -878,16 +1150,19 @@ char8* lexer::parse_digits_and_underscores(Func&& is_valid_digit,
 
 char8* lexer::parse_decimal_digits_and_underscores(char8* input) noexcept {
   return this->parse_digits_and_underscores(
-      [](char8 character) -> bool { return is_digit(character); }, input);
+      [](char8* digits) -> char8* { return skip_decimal_digits(digits); },
+      input);
 }
 
 char8* lexer::parse_hex_digits_and_underscores(char8* input) noexcept {
   return this->parse_digits_and_underscores(
-      [](char8 character) -> bool { return is_hex_digit(character); }, input);
+      [](char8* digits) -> char8* { return skip_hex_digits(digits); }, input);
 }
 
 lexer::parsed_identifier lexer::parse_identifier(char8* input) {
-  QLJS_ASSERT(this->is_identifier_character(*input));
+  char8* identifier_begin = input;
+  QLJS_ASSERT(this->is_ascii_identifier_byte(*input) ||
+              static_cast<std::uint8_t>(*input) >= 0x80);
 
 #if QLJS_HAVE_X86_SSE2
   using char_vector = char_vector_16_sse2;
@@ -935,34 +1210,42 @@ lexer::parsed_identifier lexer::parse_identifier(char8* input) {
 #endif
   };
 
-  bool is_all_identifier_characters;
-  do {
-    char_vector chars = char_vector::load(input);
-    int identifier_character_count = count_identifier_characters(chars);
-
-    for (int i = 0; i < identifier_character_count; ++i) {
-      QLJS_ASSERT(is_identifier_character(input[i]));
-    }
-    input += identifier_character_count;
-
-    is_all_identifier_characters = identifier_character_count == chars.size;
-  } while (is_all_identifier_characters);
+  // Most identifiers are short, so check the first few characters inline.
+  // Fall back to the (possibly wider) out-of-line loop for long identifiers.
+  char_vector chars = char_vector::load(input);
+  int identifier_character_count = count_identifier_characters(chars);
+  for (int i = 0; i < identifier_character_count; ++i) {
+    QLJS_ASSERT(is_ascii_identifier_byte(input[i]));
+  }
+  input += identifier_character_count;
+  if (identifier_character_count == chars.size) {
+    input = lex_simd().skip_ascii_identifier_characters(input);
+  }
 
-  if (*input == u8'\\') {
-    return this->parse_identifier_slow(input);
+  if (*input == u8'\\' || static_cast<std::uint8_t>(*input) >= 0x80) {
+    return this->parse_identifier_slow(input,
+                                       /*identifier_begin=*/identifier_begin);
   } else {
-    QLJS_ASSERT(!is_identifier_character(input[0]));
+    QLJS_ASSERT(!is_ascii_identifier_byte(input[0]));
     return parsed_identifier{
         .end = input,
         .after = input,
-        .escape_sequences = {},
+        .escape_sequences = nullptr,
     };
   }
 }
 
-lexer::parsed_identifier lexer::parse_identifier_slow(char8* input) {
-  char8* end = input;
-  std::vector<source_code_span> escape_sequences;
+lexer::parsed_identifier lexer::parse_identifier_slow(
+    char8* input, const char8* identifier_begin) {
+  char8* begin = input;
+  vector<source_code_span>& escape_sequences = this->escape_sequences_;
+  if (!escape_sequences.empty()) {
+    escape_sequences.clear();
+  }
+  // The identifier with escape sequences resolved. It is copied over the
+  // original identifier after the original identifier is fully lexed.
+  string8& normalized = this->normalized_identifier_;
+  normalized.clear();
 
   auto parse_unicode_escape = [&]() {
     char8* escape_sequence_begin = input;
@@ -981,7 +1264,7 @@ lexer::parsed_identifier lexer::parse_identifier_slow(char8* input) {
           this->error_reporter_->report(
               error_unclosed_identifier_escape_sequence{.escape_sequence =
                                                             get_escape_span()});
-          end = std::copy(escape_sequence_begin, input, end);
+          normalized.append(escape_sequence_begin, input);
           return;
         }
         if (!this->is_hex_digit(*input)) {
@@ -995,7 +1278,7 @@ lexer::parsed_identifier lexer::parse_identifier_slow(char8* input) {
         this->error_reporter_->report(
             error_expected_hex_digits_in_unicode_escape{.escape_sequence =
                                                             get_escape_span()});
-        end = std::copy(escape_sequence_begin, input, end);
+        normalized.append(escape_sequence_begin, input);
         return;
       }
     } else {
@@ -1006,7 +1289,7 @@ lexer::parsed_identifier lexer::parse_identifier_slow(char8* input) {
           this->error_reporter_->report(
               error_unclosed_identifier_escape_sequence{.escape_sequence =
                                                             get_escape_span()});
-          end = std::copy(escape_sequence_begin, input, end);
+          normalized.append(escape_sequence_begin, input);
           return;
         }
         if (!this->is_hex_digit(*input)) {
@@ -1014,7 +1297,7 @@ lexer::parsed_identifier lexer::parse_identifier_slow(char8* input) {
               error_expected_hex_digits_in_unicode_escape{
                   .escape_sequence =
                       source_code_span(escape_sequence_begin, input + 1)});
-          end = std::copy(escape_sequence_begin, input, end);
+          normalized.append(escape_sequence_begin, input);
           return;
         }
         ++input;
@@ -1033,21 +1316,41 @@ lexer::parsed_identifier lexer::parse_identifier_slow(char8* input) {
       this->error_reporter_->report(
           error_escaped_code_point_in_identifier_out_of_range{
               .escape_sequence = get_escape_span()});
-      end = std::copy(escape_sequence_begin, input, end);
-    } else if (!this->is_identifier_character(code_point)) {
+      normalized.append(escape_sequence_begin, input);
+    } else if (!(escape_sequence_begin == identifier_begin
+                     ? this->is_initial_identifier_character(
+                           narrow_cast<char32_t>(code_point))
+                     : this->is_identifier_character(
+                           narrow_cast<char32_t>(code_point)))) {
       this->error_reporter_->report(
           error_escaped_character_disallowed_in_identifiers{
               .escape_sequence = get_escape_span()});
-      end = std::copy(escape_sequence_begin, input, end);
+      normalized.append(escape_sequence_begin, input);
     } else {
-      // TODO(strager): Support non-ASCII identifier characters.
-      *end++ = narrow_cast<char8>(code_point);
+      char8 encoded[4];
+      char8* encoded_end =
+          encode_utf_8(narrow_cast<char32_t>(code_point), encoded);
+      normalized.append(encoded, encoded_end);
       escape_sequences.emplace_back(escape_sequence_begin, input);
     }
   };
 
-  while (is_identifier_character(*input)) {
-    if (*input == u8'\\') {
+  for (;;) {
+    if (static_cast<std::uint8_t>(*input) >= 0x80) {
+      decode_utf_8_result character = decode_utf_8(input);
+      bool is_part_of_identifier =
+          character.ok &&
+          (input == identifier_begin
+               ? this->is_initial_identifier_character(character.code_point)
+               : this->is_identifier_character(character.code_point));
+      if (!is_part_of_identifier) {
+        break;
+      }
+      normalized.append(input, narrow_cast<std::size_t>(character.size));
+      input += character.size;
+    } else if (!is_ascii_identifier_byte(*input)) {
+      break;
+    } else if (*input == u8'\\') {
       if (input[1] == u8'u') {
         parse_unicode_escape();
       } else {
@@ -1056,20 +1359,41 @@ lexer::parsed_identifier lexer::parse_identifier_slow(char8* input) {
         char8* backslash_end = input;
         this->error_reporter_->report(error_unexpected_backslash_in_identifier{
             .backslash = source_code_span(backslash_begin, backslash_end)});
-        end = std::copy(backslash_begin, backslash_end, end);
+        normalized.append(backslash_begin, backslash_end);
       }
     } else {
-      *end++ = *input++;
+      normalized.push_back(*input++);
     }
   }
 
-  // Make the source code readable when debugging.
-  std::fill(end, input, u8' ');
+  // The shortest escape sequence ("\\uXXXX") is at least as long as the
+  // UTF-8 encoding of any code point it can express, so the normalized
+  // identifier always fits in place.
+  QLJS_ASSERT(normalized.size() <= narrow_cast<std::size_t>(input - begin));
+  char8* end = begin + normalized.size();
+  if (end != input) {
+    if (this->read_only_input_) {
+      stop_after_fatal_error();
+    }
+    if (this->remember_rewritten_identifiers_) {
+      this->rewritten_identifiers_.push_back(rewritten_identifier{
+          .begin = begin,
+          .original = string8(begin, input),
+      });
+    }
+    std::copy(normalized.begin(), normalized.end(), begin);
+    // Make the source code readable when debugging.
+    std::fill(end, input, u8' ');
+    if (this->structural_index_.has_value()) {
+      this->structural_index_->refresh(begin, input);
+    }
+  }
 
   return parsed_identifier{
       .end = end,
       .after = input,
-      .escape_sequences = std::move(escape_sequences),
+      .escape_sequences =
+          escape_sequences.empty() ? nullptr : &escape_sequences,
   };
 }
 
@@ -1082,11 +1406,31 @@ void lexer::skip_whitespace() {
 next:
   char8 c = input[0];
   if (c == ' ' || c == '\t' || c == '\f' || c == '\v') {
-    input += 1;
-    goto next;
+    if (!is_ascii_whitespace(input[1])) {
+      // Most tokens are separated by a single space.
+      input += 1;
+      goto next;
+    }
+    goto skip_ascii_whitespace_run;
   } else if (c == '\n' || c == '\r') {
-    this->last_token_.has_leading_newline = true;
-    input += 1;
+  skip_ascii_whitespace_run:
+    // Skip a run of ASCII whitespace (e.g. indentation) a vector at a time.
+    using char_vector = inline_char_vector;
+    char_vector chars = char_vector::load(input);
+    auto is_newline = (chars == char_vector::repeated(u8'\n')) |
+                      (chars == char_vector::repeated(u8'\r'));
+    auto is_whitespace = is_newline |
+                         (chars == char_vector::repeated(u8' ')) |
+                         (chars == char_vector::repeated(u8'\t')) |
+                         (chars == char_vector::repeated(u8'\f')) |
+                         (chars == char_vector::repeated(u8'\v'));
+    int whitespace_count = is_whitespace.find_first_false();
+    std::uint32_t newlines_in_whitespace =
+        is_newline.mask() & ((std::uint32_t(1) << whitespace_count) - 1);
+    if (newlines_in_whitespace != 0) {
+      this->last_token_.has_leading_newline = true;
+    }
+    input += whitespace_count;
     goto next;
   } else if (static_cast<unsigned char>(c) >= 0xc2) {
     [[unlikely]] switch (static_cast<unsigned char>(c)) {
@@ -1185,71 +1529,48 @@ void lexer::skip_block_comment() {
   QLJS_ASSERT(this->input_[0] == '/' && this->input_[1] == '*');
   char8* c = this->input_ + 2;
 
-#if QLJS_HAVE_X86_SSE2
-  using bool_vector = bool_vector_16_sse2;
-  using char_vector = char_vector_16_sse2;
-#else
-  using bool_vector = bool_vector_1;
-  using char_vector = char_vector_1;
-#endif
-
   auto is_comment_end = [](const char8* string) -> bool {
     return string[0] == '*' && string[1] == '/';
   };
 
   for (;;) {
-    char_vector chars = char_vector::load(c);
-    bool_vector matches = (chars == char_vector::repeated(u8'*')) |
-                          (chars == char_vector::repeated(u8'\0')) |
-                          (chars == char_vector::repeated(u8'\n')) |
-                          (chars == char_vector::repeated(u8'\r')) |
-                          (chars == char_vector::repeated(0xe2));
-    std::uint32_t mask = matches.mask();
-    if (mask != 0) {
-      for (int i = countr_zero(mask); i < chars.size; ++i) {
-        if (mask & (1U << i)) {
-          if (is_comment_end(&c[i])) {
-            c += i;
-            goto found_comment_end;
-          }
-          int newline_size = this->newline_character_size(&c[i]);
-          if (newline_size > 0) {
-            c += narrow_cast<std::ptrdiff_t>(i) + newline_size;
-            goto found_newline_in_comment;
-          }
-          if (c[i] == '\0') {
-            c += i;
-            goto found_end_of_file;
-          }
-        }
-      }
+    if (this->structural_index_.has_value()) {
+      c = this->structural_index_->find_next(
+          lex_structural_index::bitmap::block_comment, c);
+    } else {
+      c = find_block_comment_special_character(c);
+    }
+    if (is_comment_end(c)) {
+      goto found_comment_end;
     }
-    c += chars.size;
+    int newline_size = this->newline_character_size(c);
+    if (newline_size > 0) {
+      c += newline_size;
+      goto found_newline_in_comment;
+    }
+    if (*c == '\0') {
+      goto found_end_of_file;
+    }
+    c += 1;
   }
   QLJS_UNREACHABLE();
 
 found_newline_in_comment:
   this->last_token_.has_leading_newline = true;
   for (;;) {
-    char_vector chars = char_vector::load(c);
-    bool_vector matches = (chars == char_vector::repeated(u8'\0')) |
-                          (chars == char_vector::repeated(u8'*'));
-    std::uint32_t mask = matches.mask();
-    if (mask != 0) {
-      for (int i = countr_zero(mask); i < chars.size; ++i) {
-        if (mask & (1U << i)) {
-          if (is_comment_end(&c[i])) {
-            c += i;
-            goto found_comment_end;
-          }
-          if (c[i] == '\0') {
-            c += i;
-            goto found_end_of_file;
-          }
-        }
-      }
+    if (this->structural_index_.has_value()) {
+      c = this->structural_index_->find_next(
+          lex_structural_index::bitmap::block_comment, c);
+    } else {
+      c = find_star_or_null(c);
     }
-    c += chars.size;
+    if (is_comment_end(c)) {
+      goto found_comment_end;
+    }
+    if (*c == '\0') {
+      goto found_end_of_file;
+    }
+    c += 1;
   }
   QLJS_UNREACHABLE();
 
@@ -1267,6 +1588,12 @@ found_end_of_file:
 
 void lexer::skip_line_comment_body() {
   for (char8* c = this->input_;; ++c) {
+    if (this->structural_index_.has_value()) {
+      c = this->structural_index_->find_next(
+          lex_structural_index::bitmap::line_comment, c);
+    } else {
+      c = find_line_comment_special_character(c);
+    }
     int newline_size = this->newline_character_size(c);
     if (newline_size > 0) {
       this->input_ = c + newline_size;
@@ -1318,17 +1645,36 @@ bool lexer::is_hex_digit(char8 c) {
   }
 }
 
-bool lexer::is_identifier_character(int code_point) {
-  switch (code_point) {
+bool lexer::is_ascii_identifier_byte(char8 c) {
+  switch (c) {
   QLJS_CASE_IDENTIFIER_START:
   QLJS_CASE_DECIMAL_DIGIT:
     return true;
-  // TODO(strager): Support non-ASCII code points.
   default:
     return false;
   }
 }
 
+bool lexer::is_initial_identifier_character(char32_t code_point) {
+  if (code_point < 0x80) {
+    return code_point != u8'\\' &&
+           is_ascii_identifier_byte(narrow_cast<char8>(code_point)) &&
+           !is_digit(narrow_cast<char8>(code_point));
+  }
+  return is_unicode_id_start(code_point);
+}
+
+bool lexer::is_identifier_character(char32_t code_point) {
+  if (code_point < 0x80) {
+    return code_point != u8'\\' &&
+           is_ascii_identifier_byte(narrow_cast<char8>(code_point));
+  }
+  constexpr char32_t zero_width_non_joiner = 0x200c;
+  constexpr char32_t zero_width_joiner = 0x200d;
+  return code_point == zero_width_non_joiner ||
+         code_point == zero_width_joiner || is_unicode_id_continue(code_point);
+}
+
 int lexer::newline_character_size(const char8* input) {
   if (input[0] == u8'\n' || input[0] == u8'\r') {
     return 1;
@@ -1463,4 +1809,43 @@ std::ostream& operator<<(std::ostream& out, token_type type) {
   out << to_string(type);
   return out;
 }
+
+bool ends_expression(token_type type) noexcept {
+  switch (type) {
+  case token_type::complete_template:
+  case token_type::identifier:
+  case token_type::kw_false:
+  case token_type::kw_null:
+  case token_type::kw_super:
+  case token_type::kw_this:
+  case token_type::kw_true:
+  case token_type::minus_minus:
+  case token_type::number:
+  case token_type::plus_plus:
+  case token_type::regexp:
+  case token_type::right_curly:
+  case token_type::right_paren:
+  case token_type::right_square:
+  case token_type::string:
+    return true;
+  default:
+    return false;
+  }
+}
+
+namespace {
+thread_local std::jmp_buf* fatal_error_jmp_buf = nullptr;
+}
+
+std::jmp_buf* exchange_fatal_error_jmp_buf(
+    std::jmp_buf* new_jmp_buf) noexcept {
+  return std::exchange(fatal_error_jmp_buf, new_jmp_buf);
+}
+
+void stop_after_fatal_error() {
+  if (fatal_error_jmp_buf) {
+    std::longjmp(*fatal_error_jmp_buf, 1);
+  }
+  QLJS_CRASH_DISALLOWING_CORE_DUMP();
+}
 }
@@ -0,0 +1,127 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <boost/container/pmr/memory_resource.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <quick-lint-js/assert.h>
+#include <quick-lint-js/linked-bump-allocator.h>
+#include <utility>
+
+namespace quick_lint_js {
+linked_bump_allocator::linked_bump_allocator() noexcept = default;
+
+linked_bump_allocator::~linked_bump_allocator() { this->release(); }
+
+linked_bump_allocator::rewind_state
+linked_bump_allocator::prepare_for_rewind() noexcept {
+  return rewind_state(this->chunk_, this->next_allocation_, this->chunk_end_);
+}
+
+void linked_bump_allocator::rewind(rewind_state &&state) noexcept {
+#if !(defined(NDEBUG) && NDEBUG)
+  // Make use-after-rewind bugs easier to notice.
+  char *poison_end = this->next_allocation_;
+#endif
+  while (this->chunk_ != state.chunk_) {
+    QLJS_ASSERT(this->chunk_ && "rewind_state is not from this allocator");
+    chunk *c = this->chunk_;
+#if !(defined(NDEBUG) && NDEBUG)
+    std::memset(c->begin(), 0xcd, c->size);
+    poison_end = state.chunk_end_;
+#endif
+    this->chunk_ = c->previous;
+    c->previous = this->spare_chunks_;
+    this->spare_chunks_ = c;
+  }
+#if !(defined(NDEBUG) && NDEBUG)
+  if (state.next_allocation_) {
+    std::memset(state.next_allocation_, 0xcd,
+                static_cast<std::size_t>(poison_end - state.next_allocation_));
+  }
+#endif
+  this->next_allocation_ = state.next_allocation_;
+  this->chunk_end_ = state.chunk_end_;
+}
+
+void linked_bump_allocator::release() noexcept {
+  free_chunks(this->chunk_);
+  free_chunks(this->spare_chunks_);
+  this->chunk_ = nullptr;
+  this->next_allocation_ = nullptr;
+  this->chunk_end_ = nullptr;
+  this->spare_chunks_ = nullptr;
+  this->reserved_size_ = 0;
+}
+
+void *linked_bump_allocator::do_allocate(std::size_t bytes,
+                                         std::size_t alignment) {
+  QLJS_ASSERT((alignment & (alignment - 1)) == 0);
+  bytes = std::max(bytes, std::size_t(1));
+  std::size_t padding =
+      (~reinterpret_cast<std::uintptr_t>(this->next_allocation_) + 1) &
+      (alignment - 1);
+  std::size_t available =
+      static_cast<std::size_t>(this->chunk_end_ - this->next_allocation_);
+  if (padding + bytes > available) {
+    this->use_new_chunk(bytes + alignment - 1);
+    padding = (~reinterpret_cast<std::uintptr_t>(this->next_allocation_) + 1) &
+              (alignment - 1);
+  }
+  char *result = this->next_allocation_ + padding;
+  this->next_allocation_ = result + bytes;
+  return result;
+}
+
+void linked_bump_allocator::do_deallocate(void *, std::size_t, std::size_t) {
+  // Memory is freed by rewind or release.
+}
+
+bool linked_bump_allocator::do_is_equal(
+    const boost::container::pmr::memory_resource &other) const noexcept {
+  return this == &other;
+}
+
+void linked_bump_allocator::use_new_chunk(std::size_t minimum_size) {
+  chunk *c;
+  if (this->spare_chunks_ && this->spare_chunks_->size >= minimum_size) {
+    c = this->spare_chunks_;
+    this->spare_chunks_ = c->previous;
+  } else {
+    std::size_t size = std::max(minimum_size, default_chunk_size);
+    c = new (::operator new(sizeof(chunk) + size)) chunk{
+        .previous = nullptr,
+        .size = size,
+    };
+    this->reserved_size_ += size;
+  }
+  c->previous = this->chunk_;
+  this->chunk_ = c;
+  this->next_allocation_ = c->begin();
+  this->chunk_end_ = c->end();
+}
+
+void linked_bump_allocator::free_chunks(chunk *c) noexcept {
+  while (c) {
+    chunk *previous = c->previous;
+    ::operator delete(c);
+    c = previous;
+  }
+}
+}
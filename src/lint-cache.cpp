@@ -0,0 +1,522 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <quick-lint-js/buffering-error-reporter.h>
+#include <quick-lint-js/build-id.h>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/error.h>
+#include <quick-lint-js/file.h>
+#include <quick-lint-js/have.h>
+#include <quick-lint-js/language.h>
+#include <quick-lint-js/lex.h>
+#include <quick-lint-js/lint-cache.h>
+#include <quick-lint-js/location.h>
+#include <quick-lint-js/narrow-cast.h>
+#include <quick-lint-js/padded-string.h>
+#include <quick-lint-js/perfect-hash.h>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if QLJS_HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+
+#if QLJS_HAVE_WINDOWS_H
+#include <Windows.h>
+#endif
+
+// Entry format (integers are little-endian):
+//
+//   entry := magic u32(input_size) error*
+//   error := u16(error_type) field*
+//   field := source_code_span | identifier | variable_kind
+//   source_code_span := u32(begin_offset) u32(end_offset)
+//   identifier := source_code_span u32(normalized_size) byte*
+//   variable_kind := u8
+//
+// error_type is the error's index in QLJS_X_ERROR_TYPES. Fields appear in
+// the order they are declared in the error's struct.
+//
+// The lexer rewrites escape sequences in identifiers in place, and error
+// messages include identifiers' text. An identifier field therefore stores
+// the identifier's bytes as they were after lexing. load writes these bytes
+// back into the input, making the input look like a lexed input.
+
+using namespace std::literals::string_view_literals;
+
+namespace quick_lint_js {
+namespace {
+constexpr string8_view entry_magic = u8"qljs-lint-cache\n"sv;
+
+// A cache entry depends on how quick-lint-js lints, but this tree has no
+// version number to key on. Instead, mix in QLJS_BUILD_ID, which changes
+// whenever quick-lint-js' source code changes, and the definition of every
+// error type.
+//
+// Bump the number in this string when changing the entry format or when
+// changing what errors are reported for some input.
+constexpr string8_view lint_cache_version =
+    u8"quick-lint-js lint cache 3\n"
+    u8"build " QLJS_BUILD_ID "\n"
+#define QLJS_ERROR_TYPE(name, struct_body, format_call) \
+  #name #struct_body #format_call "\n"
+    QLJS_X_ERROR_TYPES
+#undef QLJS_ERROR_TYPE
+    ""sv;
+
+enum class cached_error_type : std::uint16_t {
+#define QLJS_ERROR_TYPE(name, struct_body, format_call) name,
+  QLJS_X_ERROR_TYPES
+#undef QLJS_ERROR_TYPE
+      count,
+};
+
+std::uint32_t input_size(padded_string_view input) noexcept {
+  return narrow_cast<std::uint32_t>(input.null_terminator() - input.data());
+}
+
+std::uint64_t load_u64_le(const char8 *p) noexcept {
+  std::uint64_t result = 0;
+  for (int i = 0; i < 8; ++i) {
+    result |= std::uint64_t(static_cast<std::uint8_t>(p[i])) << (i * 8);
+  }
+  return result;
+}
+
+std::uint64_t rotate_left(std::uint64_t x, int bits) noexcept {
+  return (x << bits) | (x >> (64 - bits));
+}
+
+// MurmurHash3's fmix64.
+std::uint64_t final_mix(std::uint64_t x) noexcept {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+  return x;
+}
+
+// field_reader converts to any field type. Error structs are aggregates, so
+// Error{f, f} compiles if and only if Error has at least two fields.
+class field_reader;
+
+template <class Error, class = void>
+struct has_two_fields : std::false_type {};
+template <class Error>
+struct has_two_fields<
+    Error, std::void_t<decltype(Error{std::declval<field_reader>(),
+                                      std::declval<field_reader>()})>>
+    : std::true_type {};
+
+template <class Error, class = void>
+struct has_three_fields : std::false_type {};
+template <class Error>
+struct has_three_fields<
+    Error, std::void_t<decltype(Error{std::declval<field_reader>(),
+                                      std::declval<field_reader>(),
+                                      std::declval<field_reader>()})>>
+    : std::true_type {};
+
+// Call f(field) for each field of the error struct e.
+template <class Error, class Func>
+void for_each_error_field(const Error &e, Func &&f) {
+  // NOTE(strager): If you get a compile error here, an error type has more
+  // fields than we support. Add another case.
+  if constexpr (has_three_fields<Error>::value) {
+    const auto &[a, b, c] = e;
+    f(a);
+    f(b);
+    f(c);
+  } else if constexpr (has_two_fields<Error>::value) {
+    const auto &[a, b] = e;
+    f(a);
+    f(b);
+  } else {
+    const auto &[a] = e;
+    f(a);
+  }
+}
+
+class entry_writer {
+ public:
+  explicit entry_writer(string8 *out, padded_string_view input) noexcept
+      : out_(*out), input_(input) {}
+
+  void write_u8(std::uint8_t x) { this->out_.push_back(static_cast<char8>(x)); }
+
+  void write_u16(std::uint16_t x) {
+    this->write_u8(static_cast<std::uint8_t>(x));
+    this->write_u8(static_cast<std::uint8_t>(x >> 8));
+  }
+
+  void write_u32(std::uint32_t x) {
+    this->write_u16(static_cast<std::uint16_t>(x));
+    this->write_u16(static_cast<std::uint16_t>(x >> 16));
+  }
+
+  void write_offset(const char8 *p) {
+    this->write_u32(narrow_cast<std::uint32_t>(p - this->input_.data()));
+  }
+
+  void write_field(const source_code_span &span) {
+    this->write_offset(span.begin());
+    this->write_offset(span.end());
+  }
+
+  void write_field(const identifier &ident) {
+    source_code_span span = ident.span();
+    this->write_field(span);
+    this->write_u32(narrow_cast<std::uint32_t>(ident.normalized_name().size()));
+    this->out_.append(span.string_view());
+  }
+
+  void write_field(variable_kind kind) {
+    this->write_u8(static_cast<std::uint8_t>(kind));
+  }
+
+ private:
+  string8 &out_;
+  padded_string_view input_;
+};
+
+class entry_reader {
+ public:
+  // Bytes which an identifier had after lexing.
+  struct identifier_patch {
+    char8 *begin;
+    string8_view lexed_text;
+  };
+
+  explicit entry_reader(string8_view entry, padded_string_view input) noexcept
+      : remaining_(entry), input_(input) {}
+
+  bool ok() const noexcept { return this->ok_; }
+  bool at_end() const noexcept { return this->remaining_.empty(); }
+
+  const std::vector<identifier_patch> &patches() const noexcept {
+    return this->patches_;
+  }
+
+  string8_view read_bytes(std::size_t size) noexcept {
+    if (size > this->remaining_.size()) {
+      this->ok_ = false;
+      this->remaining_ = string8_view();
+      return string8_view();
+    }
+    string8_view result = this->remaining_.substr(0, size);
+    this->remaining_ = this->remaining_.substr(size);
+    return result;
+  }
+
+  std::uint8_t read_u8() noexcept {
+    string8_view bytes = this->read_bytes(1);
+    return bytes.empty() ? 0 : static_cast<std::uint8_t>(bytes[0]);
+  }
+
+  std::uint16_t read_u16() noexcept {
+    std::uint16_t low = this->read_u8();
+    std::uint16_t high = this->read_u8();
+    return static_cast<std::uint16_t>(low | (high << 8));
+  }
+
+  std::uint32_t read_u32() noexcept {
+    std::uint32_t low = this->read_u16();
+    std::uint32_t high = this->read_u16();
+    return low | (high << 16);
+  }
+
+  source_code_span read_span() noexcept {
+    std::uint32_t begin = this->read_u32();
+    std::uint32_t end = this->read_u32();
+    if (!(begin <= end && end <= input_size(this->input_))) {
+      this->ok_ = false;
+      begin = 0;
+      end = 0;
+    }
+    return source_code_span(this->input_.data() + begin,
+                            this->input_.data() + end);
+  }
+
+  source_code_span read_field(std::in_place_type_t<source_code_span>) noexcept {
+    return this->read_span();
+  }
+
+  identifier read_field(std::in_place_type_t<identifier>) {
+    source_code_span span = this->read_span();
+    std::size_t span_size = span.string_view().size();
+    std::uint32_t normalized_size = this->read_u32();
+    if (normalized_size > span_size) {
+      this->ok_ = false;
+      normalized_size = 0;
+    }
+    string8_view lexed_text = this->read_bytes(span_size);
+    if (this->ok_) {
+      this->patches_.push_back(identifier_patch{
+          .begin = this->input_.data() + (span.begin() - this->input_.data()),
+          .lexed_text = lexed_text,
+      });
+    }
+    return identifier(span, span.begin() + normalized_size);
+  }
+
+  variable_kind read_field(std::in_place_type_t<variable_kind>) noexcept {
+    std::uint8_t kind = this->read_u8();
+    if (kind > static_cast<std::uint8_t>(variable_kind::_var)) {
+      this->ok_ = false;
+      return variable_kind::_var;
+    }
+    return static_cast<variable_kind>(kind);
+  }
+
+ private:
+  string8_view remaining_;
+  padded_string_view input_;
+  std::vector<identifier_patch> patches_;
+  bool ok_ = true;
+};
+
+// Deserializes one field of an error struct during aggregate initialization.
+class field_reader {
+ public:
+  explicit field_reader(entry_reader *reader) noexcept : reader_(reader) {}
+
+  template <class Field>
+  operator Field() const {
+    return this->reader_->read_field(std::in_place_type<Field>);
+  }
+
+ private:
+  entry_reader *reader_;
+};
+
+template <class Error>
+Error read_error(entry_reader &reader) {
+  // NOTE(strager): Braced initializers are evaluated left-to-right, so fields
+  // are read in declaration order.
+  field_reader f(&reader);
+  if constexpr (has_three_fields<Error>::value) {
+    return Error{f, f, f};
+  } else if constexpr (has_two_fields<Error>::value) {
+    return Error{f, f};
+  } else {
+    return Error{f};
+  }
+}
+
+// Returns false if the entry is malformed. In that case, neither input nor
+// reporter is modified.
+bool report_cached_errors(string8_view entry, padded_string_view input,
+                          error_reporter *reporter) {
+  entry_reader reader(entry, input);
+  if (reader.read_bytes(entry_magic.size()) != entry_magic) {
+    return false;
+  }
+  if (reader.read_u32() != input_size(input)) {
+    return false;
+  }
+
+  buffering_error_reporter errors;
+  while (reader.ok() && !reader.at_end()) {
+    std::uint16_t type = reader.read_u16();
+    switch (static_cast<cached_error_type>(type)) {
+#define QLJS_ERROR_TYPE(name, struct_body, format_call) \
+  case cached_error_type::name:                         \
+    errors.report(read_error<name>(reader));            \
+    break;
+      QLJS_X_ERROR_TYPES
+#undef QLJS_ERROR_TYPE
+
+    case cached_error_type::count:
+    default:
+      return false;
+    }
+  }
+  if (!reader.ok()) {
+    return false;
+  }
+
+  for (const entry_reader::identifier_patch &patch : reader.patches()) {
+    std::copy(patch.lexed_text.begin(), patch.lexed_text.end(), patch.begin);
+  }
+  errors.move_into(reporter);
+  return true;
+}
+
+bool write_file(const std::string &path, string8_view content) {
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  if (!file) {
+    return false;
+  }
+  std::size_t written =
+      std::fwrite(content.data(), 1, content.size(), file);
+  bool ok = written == content.size();
+  if (std::fclose(file) != 0) {
+    ok = false;
+  }
+  return ok;
+}
+
+void create_directory(const char *path) {
+  // Ignore errors. If the directory does not exist, storing and loading
+  // entries will fail.
+#if QLJS_HAVE_WINDOWS_H
+  ::CreateDirectoryA(path, nullptr);
+#elif QLJS_HAVE_SYS_STAT_H
+  ::mkdir(path, 0777);
+#else
+#error "Unsupported platform"
+#endif
+}
+
+void append_hex(std::string &out, std::uint64_t x) {
+  static constexpr char digits[] = "0123456789abcdef";
+  for (int shift = 60; shift >= 0; shift -= 4) {
+    out += digits[(x >> shift) & 0xf];
+  }
+}
+}
+
+lint_cache_key::lint_cache_key(string8_view input) noexcept {
+  // A fast non-cryptographic hash. Each of two 64-bit lanes consumes 8 bytes
+  // per step.
+  static constexpr std::uint64_t version_hash =
+      hash_fnv_1a_64(lint_cache_version);
+  static constexpr std::uint64_t k1 = 0x87c37b91114253d5ULL;
+  static constexpr std::uint64_t k2 = 0x4cf5ad432745937fULL;
+
+  std::uint64_t a = version_hash;
+  std::uint64_t b = final_mix(version_hash);
+  auto consume = [&](const char8 *block) -> void {
+    a = rotate_left(a ^ (load_u64_le(block) * k1), 31) * k2;
+    b = rotate_left(b ^ (load_u64_le(block + 8) * k2), 33) * k1;
+  };
+
+  const char8 *data = input.data();
+  std::size_t size = input.size();
+  std::size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    consume(data + i);
+  }
+  char8 tail[16] = {};
+  std::copy(data + i, data + size, tail);
+  consume(tail);
+
+  a ^= size;
+  b ^= size;
+  a += b;
+  b += a;
+  a = final_mix(a);
+  b = final_mix(b);
+  a += b;
+  b += a;
+  this->hash[0] = a;
+  this->hash[1] = b;
+}
+
+std::string lint_cache_key::to_string() const {
+  std::string result;
+  append_hex(result, this->hash[0]);
+  append_hex(result, this->hash[1]);
+  return result;
+}
+
+lint_cache_recording_error_reporter::lint_cache_recording_error_reporter(
+    error_reporter *target, padded_string_view input)
+    : target_(target), input_(input) {
+  entry_writer writer(&this->entry_, this->input_);
+  this->entry_.append(entry_magic);
+  writer.write_u32(input_size(input));
+}
+
+#define QLJS_ERROR_TYPE(name, struct_body, format_call)                      \
+  void lint_cache_recording_error_reporter::report(name e) {                 \
+    entry_writer writer(&this->entry_, this->input_);                        \
+    writer.write_u16(static_cast<std::uint16_t>(cached_error_type::name));   \
+    for_each_error_field(                                                    \
+        e, [&](const auto &field) -> void { writer.write_field(field); });   \
+    this->target_->report(std::move(e));                                     \
+  }
+QLJS_X_ERROR_TYPES
+#undef QLJS_ERROR_TYPE
+
+void lint_cache_recording_error_reporter::
+    report_fatal_error_unimplemented_character(const char *qljs_file_name,
+                                               int qljs_line,
+                                               const char *qljs_function_name,
+                                               const char8 *character) {
+  this->target_->report_fatal_error_unimplemented_character(
+      qljs_file_name, qljs_line, qljs_function_name, character);
+}
+
+void lint_cache_recording_error_reporter::
+    report_fatal_error_unimplemented_token(const char *qljs_file_name,
+                                           int qljs_line,
+                                           const char *qljs_function_name,
+                                           token_type type,
+                                           const char8 *token_begin) {
+  this->target_->report_fatal_error_unimplemented_token(
+      qljs_file_name, qljs_line, qljs_function_name, type, token_begin);
+}
+
+lint_cache::lint_cache(const char *directory) : directory_(directory) {
+  create_directory(directory);
+  std::random_device random;
+  this->temp_file_prefix_ =
+      (std::uint64_t(random()) << 32) ^ std::uint64_t(random());
+}
+
+bool lint_cache::load(const lint_cache_key &key, padded_string_view input,
+                      error_reporter *reporter) {
+  read_file_result entry = read_file(this->entry_path(key).c_str());
+  if (!entry.ok() ||
+      !report_cached_errors(entry.content.string_view(), input, reporter)) {
+    this->miss_count_ += 1;
+    return false;
+  }
+  this->hit_count_ += 1;
+  return true;
+}
+
+void lint_cache::store(const lint_cache_key &key,
+                       const lint_cache_recording_error_reporter &errors) {
+  // Write to a temporary file, then rename it, so other processes never see
+  // partially-written entries.
+  std::string path = this->entry_path(key);
+  std::string temp_path = path + ".tmp-";
+  append_hex(temp_path, this->temp_file_prefix_);
+  append_hex(temp_path, this->temp_file_counter_++);
+  if (!write_file(temp_path, errors.entry()) ||
+      std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    std::remove(temp_path.c_str());
+  }
+}
+
+std::string lint_cache::entry_path(const lint_cache_key &key) const {
+  std::string path = this->directory_;
+  path += '/';
+  path += key.to_string();
+  return path;
+}
+}
@@ -0,0 +1,674 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <quick-lint-js/assert.h>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/error.h>
+#include <quick-lint-js/file.h>
+#include <quick-lint-js/have.h>
+#include <quick-lint-js/lint-server.h>
+#include <quick-lint-js/lint.h>
+#include <quick-lint-js/location.h>
+#include <quick-lint-js/narrow-cast.h>
+#include <quick-lint-js/options.h>
+#include <quick-lint-js/output-stream.h>
+#include <quick-lint-js/padded-string.h>
+#include <quick-lint-js/parse.h>
+#include <quick-lint-js/text-error-reporter.h>
+#include <quick-lint-js/vim-qflist-json-error-reporter.h>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if QLJS_HAVE_UNIX_DOMAIN_SOCKETS
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace quick_lint_js {
+namespace {
+constexpr std::size_t size_field_size = 4;
+constexpr std::uint32_t content_not_given = 0xffff'ffff;
+
+void append_u8(string8 *out, std::uint8_t value) {
+  out->push_back(static_cast<char8>(value));
+}
+
+void append_u32(string8 *out, std::uint32_t value) {
+  for (int i = 0; i < 4; ++i) {
+    out->push_back(static_cast<char8>((value >> (i * 8)) & 0xff));
+  }
+}
+
+void write_u32(char8 *out, std::uint32_t value) {
+  for (int i = 0; i < 4; ++i) {
+    out[i] = static_cast<char8>((value >> (i * 8)) & 0xff);
+  }
+}
+
+std::uint32_t read_u32(const char8 *in) {
+  std::uint32_t value = 0;
+  for (int i = 0; i < 4; ++i) {
+    value |= std::uint32_t{static_cast<std::uint8_t>(in[i])} << (i * 8);
+  }
+  return value;
+}
+
+// Reads fields of a message. Each read_* function returns false if the
+// message is too short.
+class message_reader {
+ public:
+  explicit message_reader(string8_view data) noexcept : data_(data) {}
+
+  bool read_u8(std::uint8_t *out) noexcept {
+    if (this->data_.size() < 1) {
+      return false;
+    }
+    *out = static_cast<std::uint8_t>(this->data_[0]);
+    this->data_.remove_prefix(1);
+    return true;
+  }
+
+  bool read_u32(std::uint32_t *out) noexcept {
+    if (this->data_.size() < 4) {
+      return false;
+    }
+    *out = quick_lint_js::read_u32(this->data_.data());
+    this->data_.remove_prefix(4);
+    return true;
+  }
+
+  bool read_i32(std::int32_t *out) noexcept {
+    std::uint32_t value;
+    if (!this->read_u32(&value)) {
+      return false;
+    }
+    *out = static_cast<std::int32_t>(value);
+    return true;
+  }
+
+  bool read_bytes(std::uint32_t size, string8_view *out) noexcept {
+    if (this->data_.size() < size) {
+      return false;
+    }
+    *out = this->data_.substr(0, size);
+    this->data_.remove_prefix(size);
+    return true;
+  }
+
+  bool at_end() const noexcept { return this->data_.empty(); }
+
+ private:
+  string8_view data_;
+};
+
+std::string to_string(string8_view s) {
+  return std::string(reinterpret_cast<const char *>(s.data()), s.size());
+}
+
+// Replace response with an error response, including its size field.
+void make_error_response(string8 *response, std::string_view message) {
+  response->clear();
+  append_u32(response, narrow_cast<std::uint32_t>(1 + message.size()));
+  append_u8(response, static_cast<std::uint8_t>(lint_response_status::error));
+  response->append(reinterpret_cast<const char8 *>(message.data()),
+                   message.size());
+}
+
+// Forwards errors to another error_reporter, but keeps fatal errors for
+// lint_server_session to send back as an error response. (The other
+// reporters write fatal errors to stderr, which belongs to the server, not
+// to the client.)
+class fatal_error_capturing_error_reporter : public error_reporter {
+ public:
+  explicit fatal_error_capturing_error_reporter(error_reporter *other,
+                                                padded_string_view input,
+                                                const char *path) noexcept
+      : other_(other), locator_(input), path_(path) {}
+
+#define QLJS_ERROR_TYPE(name, struct_body, format) \
+  void report(name e) override { this->other_->report(e); }
+  QLJS_X_ERROR_TYPES
+#undef QLJS_ERROR_TYPE
+
+  void report_fatal_error_unimplemented_character(
+      const char *qljs_file_name, int qljs_line, const char *qljs_function_name,
+      const char8 *character) override {
+    std::ostringstream message;
+    message << this->path_ << ": ";
+    error_reporter::write_fatal_error_unimplemented_character(
+        /*qljs_file_name=*/qljs_file_name,
+        /*qljs_line=*/qljs_line,
+        /*qljs_function_name=*/qljs_function_name,
+        /*character=*/character,
+        /*locator=*/&this->locator_,
+        /*out=*/message);
+    this->fatal_error_ = std::move(message).str();
+  }
+
+  void report_fatal_error_unimplemented_token(
+      const char *qljs_file_name, int qljs_line, const char *qljs_function_name,
+      token_type type, const char8 *token_begin) override {
+    std::ostringstream message;
+    message << this->path_ << ": ";
+    error_reporter::write_fatal_error_unimplemented_token(
+        /*qljs_file_name=*/qljs_file_name,
+        /*qljs_line=*/qljs_line,
+        /*qljs_function_name=*/qljs_function_name,
+        /*type=*/type,
+        /*token_begin=*/token_begin,
+        /*locator=*/&this->locator_,
+        /*out=*/message);
+    this->fatal_error_ = std::move(message).str();
+  }
+
+  const std::string &fatal_error() const noexcept {
+    return this->fatal_error_;
+  }
+
+ private:
+  error_reporter *other_;
+  locator locator_;
+  const char *path_;
+  std::string fatal_error_;
+};
+}
+
+string8 encode_lint_request(const lint_request &request) {
+  string8 out;
+  append_u32(&out, 0);  // Size. Filled in below.
+  switch (request.output_format) {
+  case output_format::gnu_like:
+    append_u8(&out, 0);
+    break;
+  case output_format::vim_qflist_json:
+    append_u8(&out, 1);
+    break;
+  }
+  append_u32(&out, narrow_cast<std::uint32_t>(request.files.size()));
+  for (const lint_request_file &file : request.files) {
+    append_u32(&out, narrow_cast<std::uint32_t>(file.path.size()));
+    out.append(reinterpret_cast<const char8 *>(file.path.data()),
+               file.path.size());
+    append_u32(&out, static_cast<std::uint32_t>(
+                         file.vim_bufnr.has_value() ? *file.vim_bufnr : -1));
+    if (file.content.has_value()) {
+      append_u32(&out, narrow_cast<std::uint32_t>(file.content->size()));
+      out.append(*file.content);
+    } else {
+      append_u32(&out, content_not_given);
+    }
+  }
+  write_u32(out.data(),
+            narrow_cast<std::uint32_t>(out.size() - size_field_size));
+  return out;
+}
+
+std::optional<lint_response> decode_lint_response(string8_view response) {
+  message_reader reader(response);
+  std::uint8_t status;
+  if (!reader.read_u8(&status)) {
+    return std::nullopt;
+  }
+  switch (static_cast<lint_response_status>(status)) {
+  case lint_response_status::ok:
+  case lint_response_status::error:
+    break;
+  default:
+    return std::nullopt;
+  }
+  return lint_response{
+      .status = static_cast<lint_response_status>(status),
+      .output = string8(response.substr(1)),
+  };
+}
+
+void lint_server_session::handle_request(string8_view request,
+                                         string8 *response) {
+  response->clear();
+  append_u32(response, 0);  // Size. Filled in below.
+  append_u8(response, static_cast<std::uint8_t>(lint_response_status::ok));
+
+  auto finish_response = [&]() -> void {
+    write_u32(response->data(),
+              narrow_cast<std::uint32_t>(response->size() - size_field_size));
+  };
+  auto fail = [&](std::string_view message) -> void {
+    make_error_response(response, message);
+  };
+
+  struct request_file {
+    std::string path;
+    std::optional<int> vim_bufnr;
+    std::optional<string8_view> content;
+  };
+  std::vector<request_file> files;
+
+  message_reader reader(request);
+  std::uint8_t raw_output_format;
+  std::uint32_t file_count;
+  if (!reader.read_u8(&raw_output_format) || !reader.read_u32(&file_count)) {
+    fail("malformed request");
+    return;
+  }
+  output_format format;
+  switch (raw_output_format) {
+  case 0:
+    format = output_format::gnu_like;
+    break;
+  case 1:
+    format = output_format::vim_qflist_json;
+    break;
+  default:
+    fail("malformed request: unknown output format");
+    return;
+  }
+  for (std::uint32_t i = 0; i < file_count; ++i) {
+    std::uint32_t path_size;
+    string8_view path;
+    std::int32_t vim_bufnr;
+    std::uint32_t content_size;
+    if (!reader.read_u32(&path_size) || !reader.read_bytes(path_size, &path) ||
+        !reader.read_i32(&vim_bufnr) || !reader.read_u32(&content_size)) {
+      fail("malformed request");
+      return;
+    }
+    request_file &file = files.emplace_back();
+    file.path = to_string(path);
+    if (vim_bufnr != -1) {
+      file.vim_bufnr = vim_bufnr;
+    }
+    if (content_size != content_not_given) {
+      if (content_size > max_lint_message_size) {
+        fail("malformed request: file is too large");
+        return;
+      }
+      string8_view content;
+      if (!reader.read_bytes(content_size, &content)) {
+        fail("malformed request");
+        return;
+      }
+      file.content = content;
+    }
+  }
+  if (!reader.at_end()) {
+    fail("malformed request: unexpected data after last file");
+    return;
+  }
+
+  {
+    string8_output_stream output(response);
+    std::optional<text_error_reporter> text_reporter;
+    std::optional<vim_qflist_json_error_reporter> vim_reporter;
+    error_reporter *reporter = nullptr;
+    switch (format) {
+    case output_format::gnu_like:
+      reporter = &text_reporter.emplace(&output);
+      break;
+    case output_format::vim_qflist_json:
+      reporter = &vim_reporter.emplace(&output);
+      break;
+    }
+
+    for (request_file &file : files) {
+      read_file_result file_from_disk;
+      padded_string_view source(&this->source_);
+      if (file.content.has_value()) {
+        // Reuse source_'s allocation from earlier requests.
+        this->source_.resize(narrow_cast<int>(file.content->size()));
+        std::copy(file.content->begin(), file.content->end(),
+                  this->source_.data());
+        source = padded_string_view(&this->source_);
+      } else {
+        file_from_disk = read_file(file.path.c_str());
+        if (!file_from_disk.ok()) {
+          output.flush();
+          fail(file_from_disk.error);
+          return;
+        }
+        source = file_from_disk.content.view();
+      }
+
+      if (text_reporter.has_value()) {
+        text_reporter->set_source(source, file.path.c_str());
+      } else {
+        vim_reporter->set_source(source, file.path.c_str(), file.vim_bufnr);
+      }
+      // NOTE(strager): Unimplemented syntax would crash the process, taking
+      // the server and its other clients down with it. Fail only this
+      // request instead.
+      fatal_error_capturing_error_reporter file_reporter(reporter, source,
+                                                         file.path.c_str());
+      bool ok = catch_fatal_parse_errors([&]() -> void {
+        parser p(source, &file_reporter);
+        linter l(&file_reporter);
+        p.parse_and_visit_module(l);
+      });
+      if (!ok) {
+        output.flush();
+        fail(file_reporter.fatal_error());
+        return;
+      }
+    }
+
+    if (vim_reporter.has_value()) {
+      vim_reporter->finish();
+    }
+  }
+  finish_response();
+}
+
+#if QLJS_HAVE_UNIX_DOMAIN_SOCKETS
+namespace {
+#if defined(MSG_NOSIGNAL)
+// Don't kill the server with SIGPIPE if a client disconnects early.
+constexpr int send_flags = MSG_NOSIGNAL;
+#else
+constexpr int send_flags = 0;
+#endif
+
+void configure_socket(int fd) {
+  ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+#if defined(SO_NOSIGPIPE)
+  int enable = 1;
+  ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+#endif
+}
+
+// Returns false on error or end of file.
+bool read_exactly(int fd, void *buffer, std::size_t size) {
+  char *out = static_cast<char *>(buffer);
+  while (size > 0) {
+    ::ssize_t read_size = ::read(fd, out, size);
+    if (read_size == -1 && errno == EINTR) {
+      continue;
+    }
+    if (read_size <= 0) {
+      return false;
+    }
+    out += read_size;
+    size -= narrow_cast<std::size_t>(read_size);
+  }
+  return true;
+}
+
+bool write_all(int fd, string8_view data) {
+  while (!data.empty()) {
+    ::ssize_t written_size = ::send(fd, data.data(), data.size(), send_flags);
+    if (written_size == -1 && errno == EINTR) {
+      continue;
+    }
+    if (written_size <= 0) {
+      return false;
+    }
+    data.remove_prefix(narrow_cast<std::size_t>(written_size));
+  }
+  return true;
+}
+
+// Read one message (excluding its size field) into message.
+//
+// Returns false if the message is bigger than max_lint_message_size. The
+// rest of the message is not read, so the connection is unusable afterwards.
+bool read_message(int fd, string8 *message) {
+  char8 size_field[size_field_size];
+  if (!read_exactly(fd, size_field, sizeof(size_field))) {
+    return false;
+  }
+  std::uint32_t size = read_u32(size_field);
+  if (size > max_lint_message_size) {
+    return false;
+  }
+  message->resize(size);
+  return read_exactly(fd, message->data(), message->size());
+}
+
+bool make_socket_address(const char *socket_path, ::sockaddr_un *address,
+                         std::string *error) {
+  std::memset(address, 0, sizeof(*address));
+  address->sun_family = AF_UNIX;
+  std::size_t path_size = std::strlen(socket_path);
+  if (path_size >= sizeof(address->sun_path)) {
+    *error = std::string("socket path is too long: ") + socket_path;
+    return false;
+  }
+  std::memcpy(address->sun_path, socket_path, path_size);
+  return true;
+}
+}
+
+lint_socket_server::lint_socket_server(const char *socket_path) {
+  ::sockaddr_un address;
+  if (!make_socket_address(socket_path, &address, &this->error_)) {
+    return;
+  }
+
+  int listener_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listener_fd == -1) {
+    this->error_ =
+        std::string("failed to create socket: ") + std::strerror(errno);
+    return;
+  }
+  this->listener_.emplace(listener_fd);
+  configure_socket(listener_fd);
+
+  auto bind_socket = [&]() -> int {
+    return ::bind(listener_fd, reinterpret_cast<const ::sockaddr *>(&address),
+                  sizeof(address));
+  };
+  int rc = bind_socket();
+  if (rc == -1 && errno == EADDRINUSE) {
+    // The socket file might be left over from a server which exited without
+    // cleaning up. Replace it if nobody is listening. Never delete something
+    // which isn't a socket, such as a file given by mistake.
+    struct ::stat existing_file;
+    if (::lstat(socket_path, &existing_file) == 0 &&
+        !S_ISSOCK(existing_file.st_mode)) {
+      this->error_ =
+          std::string("failed to bind to ") + socket_path + ": not a socket";
+      return;
+    }
+    posix_fd_file probe(::socket(AF_UNIX, SOCK_STREAM, 0));
+    bool in_use =
+        ::connect(probe.get(), reinterpret_cast<const ::sockaddr *>(&address),
+                  sizeof(address)) == 0;
+    if (in_use) {
+      this->error_ = std::string("another server is already listening on ") +
+                     socket_path;
+      return;
+    }
+    ::unlink(socket_path);
+    rc = bind_socket();
+  }
+  if (rc == -1) {
+    this->error_ = std::string("failed to bind to ") + socket_path + ": " +
+                   std::strerror(errno);
+    return;
+  }
+  this->socket_path_ = socket_path;
+
+  if (::listen(listener_fd, SOMAXCONN) == -1) {
+    this->error_ = std::string("failed to listen on ") + socket_path + ": " +
+                   std::strerror(errno);
+    return;
+  }
+
+  int stop_fds[2];
+  if (::pipe(stop_fds) == -1) {
+    this->error_ =
+        std::string("failed to create pipe: ") + std::strerror(errno);
+    return;
+  }
+  this->stop_reader_.emplace(stop_fds[0]);
+  this->stop_writer_.emplace(stop_fds[1]);
+}
+
+lint_socket_server::~lint_socket_server() {
+  if (!this->socket_path_.empty()) {
+    ::unlink(this->socket_path_.c_str());
+  }
+}
+
+void lint_socket_server::run() {
+  QLJS_ASSERT(this->ok());
+  for (;;) {
+    ::pollfd poll_fds[2] = {
+        {.fd = this->listener_->get(), .events = POLLIN, .revents = 0},
+        {.fd = this->stop_reader_->get(), .events = POLLIN, .revents = 0},
+    };
+    int rc = ::poll(poll_fds, 2, /*timeout=*/-1);
+    if (rc == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+    if (poll_fds[1].revents != 0) {
+      break;
+    }
+    if (poll_fds[0].revents & POLLIN) {
+      int connection_fd = ::accept(this->listener_->get(), nullptr, nullptr);
+      if (connection_fd == -1) {
+        // The client might have given up already. Keep serving others.
+        continue;
+      }
+      configure_socket(connection_fd);
+      {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->connection_fds_.push_back(connection_fd);
+      }
+      std::thread([this, connection_fd]() -> void {
+        this->serve_connection(posix_fd_file(connection_fd));
+      }).detach();
+    }
+  }
+
+  std::unique_lock<std::mutex> lock(this->mutex_);
+  for (int connection_fd : this->connection_fds_) {
+    // Make the connection's thread see end of file.
+    ::shutdown(connection_fd, SHUT_RDWR);
+  }
+  this->connections_finished_.wait(
+      lock, [this]() -> bool { return this->connection_fds_.empty(); });
+}
+
+void lint_socket_server::stop() {
+  char8 byte = 0;
+  ::ssize_t rc;
+  do {
+    rc = ::write(this->stop_writer_->get(), &byte, 1);
+  } while (rc == -1 && errno == EINTR);
+}
+
+void lint_socket_server::serve_connection(posix_fd_file &&connection) {
+  std::unique_ptr<lint_server_session> session = this->take_session();
+  string8 request;
+  string8 response;
+  while (read_message(connection.get(), &request)) {
+    session->handle_request(request, &response);
+    if (!write_all(connection.get(), response)) {
+      break;
+    }
+  }
+  this->return_session(std::move(session));
+
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  // Remove the fd while holding the lock so run() doesn't shut down a
+  // recycled fd.
+  this->connection_fds_.erase(std::find(this->connection_fds_.begin(),
+                                        this->connection_fds_.end(),
+                                        connection.get()));
+  this->connections_finished_.notify_all();
+}
+
+std::unique_ptr<lint_server_session> lint_socket_server::take_session() {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  if (this->idle_sessions_.empty()) {
+    return std::make_unique<lint_server_session>();
+  }
+  std::unique_ptr<lint_server_session> session =
+      std::move(this->idle_sessions_.back());
+  this->idle_sessions_.pop_back();
+  return session;
+}
+
+void lint_socket_server::return_session(
+    std::unique_ptr<lint_server_session> &&session) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  this->idle_sessions_.push_back(std::move(session));
+}
+
+lint_client::lint_client(const char *socket_path) {
+  ::sockaddr_un address;
+  if (!make_socket_address(socket_path, &address, &this->error_)) {
+    return;
+  }
+  int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd == -1) {
+    this->error_ =
+        std::string("failed to create socket: ") + std::strerror(errno);
+    return;
+  }
+  this->socket_.emplace(fd);
+  configure_socket(fd);
+  if (::connect(fd, reinterpret_cast<const ::sockaddr *>(&address),
+                sizeof(address)) == -1) {
+    this->error_ = std::string("failed to connect to ") + socket_path + ": " +
+                   std::strerror(errno);
+    return;
+  }
+}
+
+std::optional<lint_response> lint_client::send(const lint_request &request) {
+  QLJS_ASSERT(this->ok());
+  string8 encoded_request = encode_lint_request(request);
+  if (encoded_request.size() - size_field_size > max_lint_message_size) {
+    this->error_ = "request is too large";
+    return std::nullopt;
+  }
+  if (!write_all(this->socket_->get(), encoded_request)) {
+    this->error_ =
+        std::string("failed to send request: ") + std::strerror(errno);
+    return std::nullopt;
+  }
+  if (!read_message(this->socket_->get(), &this->buffer_)) {
+    this->error_ = "failed to receive response";
+    return std::nullopt;
+  }
+  std::optional<lint_response> response = decode_lint_response(this->buffer_);
+  if (!response.has_value()) {
+    this->error_ = "malformed response";
+  }
+  return response;
+}
+#endif
+}
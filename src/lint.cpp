@@ -15,6 +15,9 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
 #include <optional>
 #include <quick-lint-js/assert.h>
 #include <quick-lint-js/char8.h>
@@ -22,7 +25,9 @@
 #include <quick-lint-js/language.h>
 #include <quick-lint-js/lex.h>
 #include <quick-lint-js/lint.h>
+#include <quick-lint-js/narrow-cast.h>
 #include <quick-lint-js/optional.h>
+#include <quick-lint-js/perfect-hash.h>
 #include <vector>
 
 // The linter class implements single-pass variable lookup. A single-pass
@@ -105,119 +110,188 @@
 
 namespace quick_lint_js {
 linter::linter(error_reporter *error_reporter)
-    : error_reporter_(error_reporter) {
-  scope &global_scope = this->scopes_.global_scope();
-  scope &module_scope = this->scopes_.module_scope();
+    : arguments_symbol_(this->intern(u8"arguments")),
+      error_reporter_(error_reporter) {
+  this->scopes_.global_scope().predefined_variables =
+      predefined_variable_scope::global;
+  this->scopes_.module_scope().predefined_variables =
+      predefined_variable_scope::module;
+}
+
+const linter::declared_variable *linter::find_predefined_variable(
+    string8_view name, std::uint64_t name_hash,
+    predefined_variable_scope scope) noexcept {
+  struct predefined_variable {
+    declared_variable variable;
+    predefined_variable_scope scope;
+  };
+  static constexpr auto writable_global = [](const char8 *name) {
+    return predefined_variable{
+        declared_variable::make_global(name, variable_kind::_function),
+        predefined_variable_scope::global};
+  };
+  static constexpr auto non_writable_global = [](const char8 *name) {
+    return predefined_variable{
+        declared_variable::make_global(name, variable_kind::_const),
+        predefined_variable_scope::global};
+  };
+  static constexpr auto writable_module = [](const char8 *name) {
+    return predefined_variable{
+        declared_variable::make_global(name, variable_kind::_function),
+        predefined_variable_scope::module};
+  };
 
-  const char8 *writable_global_variables[] = {
+  static constexpr predefined_variable variables[] = {
       // ECMA-262 18.1 Value Properties of the Global Object
-      u8"globalThis",
+      writable_global(u8"globalThis"),
 
       // ECMA-262 18.2 Function Properties of the Global Object
-      u8"decodeURI",
-      u8"decodeURIComponent",
-      u8"encodeURI",
-      u8"encodeURIComponent",
-      u8"eval",
-      u8"isFinite",
-      u8"isNaN",
-      u8"parseFloat",
-      u8"parseInt",
+      writable_global(u8"decodeURI"),
+      writable_global(u8"decodeURIComponent"),
+      writable_global(u8"encodeURI"),
+      writable_global(u8"encodeURIComponent"),
+      writable_global(u8"eval"),
+      writable_global(u8"isFinite"),
+      writable_global(u8"isNaN"),
+      writable_global(u8"parseFloat"),
+      writable_global(u8"parseInt"),
 
       // ECMA-262 18.3 Constructor Properties of the Global Object
-      u8"Array",
-      u8"ArrayBuffer",
-      u8"BigInt",
-      u8"BigInt64Array",
-      u8"BigUint64Array",
-      u8"Boolean",
-      u8"DataView",
-      u8"Date",
-      u8"Error",
-      u8"EvalError",
-      u8"Float32Array",
-      u8"Float64Array",
-      u8"Function",
-      u8"Int16Array",
-      u8"Int32Array",
-      u8"Int8Array",
-      u8"Map",
-      u8"Number",
-      u8"Object",
-      u8"Promise",
-      u8"Proxy",
-      u8"RangeError",
-      u8"ReferenceError",
-      u8"RegExp",
-      u8"Set",
-      u8"SharedArrayBuffer",
-      u8"String",
-      u8"Symbol",
-      u8"SyntaxError",
-      u8"TypeError",
-      u8"URIError",
-      u8"Uint16Array",
-      u8"Uint32Array",
-      u8"Uint8Array",
-      u8"Uint8ClampedArray",
-      u8"WeakMap",
-      u8"WeakSet",
+      writable_global(u8"Array"),
+      writable_global(u8"ArrayBuffer"),
+      writable_global(u8"BigInt"),
+      writable_global(u8"BigInt64Array"),
+      writable_global(u8"BigUint64Array"),
+      writable_global(u8"Boolean"),
+      writable_global(u8"DataView"),
+      writable_global(u8"Date"),
+      writable_global(u8"Error"),
+      writable_global(u8"EvalError"),
+      writable_global(u8"Float32Array"),
+      writable_global(u8"Float64Array"),
+      writable_global(u8"Function"),
+      writable_global(u8"Int16Array"),
+      writable_global(u8"Int32Array"),
+      writable_global(u8"Int8Array"),
+      writable_global(u8"Map"),
+      writable_global(u8"Number"),
+      writable_global(u8"Object"),
+      writable_global(u8"Promise"),
+      writable_global(u8"Proxy"),
+      writable_global(u8"RangeError"),
+      writable_global(u8"ReferenceError"),
+      writable_global(u8"RegExp"),
+      writable_global(u8"Set"),
+      writable_global(u8"SharedArrayBuffer"),
+      writable_global(u8"String"),
+      writable_global(u8"Symbol"),
+      writable_global(u8"SyntaxError"),
+      writable_global(u8"TypeError"),
+      writable_global(u8"URIError"),
+      writable_global(u8"Uint16Array"),
+      writable_global(u8"Uint32Array"),
+      writable_global(u8"Uint8Array"),
+      writable_global(u8"Uint8ClampedArray"),
+      writable_global(u8"WeakMap"),
+      writable_global(u8"WeakSet"),
 
       // ECMA-262 18.4 Other Properties of the Global Object
-      u8"Atomics",
-      u8"JSON",
-      u8"Math",
-      u8"Reflect",
+      writable_global(u8"Atomics"),
+      writable_global(u8"JSON"),
+      writable_global(u8"Math"),
+      writable_global(u8"Reflect"),
 
       // Node.js
-      u8"Buffer",
-      u8"GLOBAL",
-      u8"Intl",
-      u8"TextDecoder",
-      u8"TextEncoder",
-      u8"URL",
-      u8"URLSearchParams",
-      u8"WebAssembly",
-      u8"clearImmediate",
-      u8"clearInterval",
-      u8"clearTimeout",
-      u8"console",
-      u8"escape",
-      u8"global",
-      u8"process",
-      u8"queueMicrotask",
-      u8"root",
-      u8"setImmediate",
-      u8"setInterval",
-      u8"setTimeout",
-      u8"unescape",
-  };
+      writable_global(u8"Buffer"),
+      writable_global(u8"GLOBAL"),
+      writable_global(u8"Intl"),
+      writable_global(u8"TextDecoder"),
+      writable_global(u8"TextEncoder"),
+      writable_global(u8"URL"),
+      writable_global(u8"URLSearchParams"),
+      writable_global(u8"WebAssembly"),
+      writable_global(u8"clearImmediate"),
+      writable_global(u8"clearInterval"),
+      writable_global(u8"clearTimeout"),
+      writable_global(u8"console"),
+      writable_global(u8"escape"),
+      writable_global(u8"global"),
+      writable_global(u8"process"),
+      writable_global(u8"queueMicrotask"),
+      writable_global(u8"root"),
+      writable_global(u8"setImmediate"),
+      writable_global(u8"setInterval"),
+      writable_global(u8"setTimeout"),
+      writable_global(u8"unescape"),
 
-  for (const char8 *global_variable : writable_global_variables) {
-    global_scope.add_predefined_variable_declaration(global_variable,
-                                                     variable_kind::_function);
-  }
-
-  const char8 *non_writable_global_variables[] = {
       // ECMA-262 18.1 Value Properties of the Global Object
-      u8"Infinity",
-      u8"NaN",
-      u8"undefined",
-  };
-  for (const char8 *global_variable : non_writable_global_variables) {
-    global_scope.add_predefined_variable_declaration(global_variable,
-                                                     variable_kind::_const);
-  }
+      non_writable_global(u8"Infinity"),
+      non_writable_global(u8"NaN"),
+      non_writable_global(u8"undefined"),
 
-  const char8 *writable_module_variables[] = {
       // Node.js
-      u8"__dirname", u8"__filename", u8"exports", u8"module", u8"require",
+      writable_module(u8"__dirname"),
+      writable_module(u8"__filename"),
+      writable_module(u8"exports"),
+      writable_module(u8"module"),
+      writable_module(u8"require"),
   };
+  static constexpr std::size_t variable_count = std::size(variables);
+
+  // The table is built at compile time and shared by all linters, so creating
+  // a linter does not allocate anything for predefined variables.
+  static constexpr perfect_hash_table<variable_count, 10> table(
+      []() constexpr {
+        std::array<string8_view, variable_count> names{};
+        for (std::size_t i = 0; i < variable_count; ++i) {
+          names[i] = variables[i].variable.name();
+        }
+        return names;
+      }());
+
+  int index = table.find(name, name_hash);
+  if (index == -1) {
+    return nullptr;
+  }
+  std::size_t i = narrow_cast<std::size_t>(index);
+  if (variables[i].scope != scope) {
+    return nullptr;
+  }
+  return &variables[i].variable;
+}
 
-  for (const char8 *module_variable : writable_module_variables) {
-    module_scope.add_predefined_variable_declaration(module_variable,
-                                                     variable_kind::_function);
+symbol_id linter::intern(string8_view name) {
+  symbol_id symbol = this->symbols_.intern(name);
+  if (symbol == this->predefined_variables_.size()) {
+    // This is the first time we have seen this name.
+    std::uint64_t name_hash = this->symbols_.hash(symbol);
+    this->predefined_variables_.push_back(predefined_variables_for_symbol{
+        .global = find_predefined_variable(name, name_hash,
+                                           predefined_variable_scope::global),
+        .module = find_predefined_variable(name, name_hash,
+                                           predefined_variable_scope::module),
+    });
+  }
+  return symbol;
+}
+
+const linter::declared_variable *linter::find_declared_variable(
+    const scope &scope, symbol_id symbol) const noexcept {
+  const declared_variable *predefined_variable = nullptr;
+  switch (scope.predefined_variables) {
+  case predefined_variable_scope::none:
+    break;
+  case predefined_variable_scope::global:
+    predefined_variable = this->predefined_variables_[symbol].global;
+    break;
+  case predefined_variable_scope::module:
+    predefined_variable = this->predefined_variables_[symbol].module;
+    break;
+  }
+  if (predefined_variable) {
+    return predefined_variable;
   }
+  return scope.find_local_variable(symbol);
 }
 
 void linter::visit_enter_block_scope() { this->scopes_.push(); }
@@ -237,7 +311,8 @@ void linter::visit_enter_function_scope_body() {
 void linter::visit_enter_named_function_scope(identifier function_name) {
   scope &current_scope = this->scopes_.push();
   current_scope.function_expression_declaration = declared_variable::make_local(
-      function_name, variable_kind::_function,
+      function_name, this->intern(function_name.normalized_name()),
+      variable_kind::_function,
       declared_variable_scope::declared_in_current_scope);
 }
 
@@ -275,11 +350,13 @@ void linter::visit_variable_declaration(identifier name, variable_kind kind) {
   this->declare_variable(
       /*scope=*/this->current_scope(),
       /*name=*/name,
+      /*symbol=*/this->intern(name.normalized_name()),
       /*kind=*/kind,
       /*declared_scope=*/declared_variable_scope::declared_in_current_scope);
 }
 
-void linter::declare_variable(scope &scope, identifier name, variable_kind kind,
+void linter::declare_variable(scope &scope, identifier name, symbol_id symbol,
+                              variable_kind kind,
                               declared_variable_scope declared_scope) {
   if (declared_scope == declared_variable_scope::declared_in_descendant_scope) {
     QLJS_ASSERT(kind == variable_kind::_function ||
@@ -287,10 +364,10 @@ void linter::declare_variable(scope &scope, identifier name, variable_kind kind,
   }
 
   this->report_error_if_variable_declaration_conflicts_in_scope(
-      scope, name, kind, declared_scope);
+      scope, name, symbol, kind, declared_scope);
 
   const declared_variable *declared =
-      scope.add_variable_declaration(name, kind, declared_scope);
+      scope.add_variable_declaration(name, symbol, kind, declared_scope);
 
   auto erase_if = [](auto &variables, auto predicate) {
     variables.erase(
@@ -298,7 +375,7 @@ void linter::declare_variable(scope &scope, identifier name, variable_kind kind,
         variables.end());
   };
   erase_if(scope.variables_used, [&](const used_variable &used_var) {
-    if (name.normalized_name() == used_var.name.normalized_name()) {
+    if (used_var.symbol == symbol) {
       if (kind == variable_kind::_class || kind == variable_kind::_const ||
           kind == variable_kind::_let) {
         switch (used_var.kind) {
@@ -331,19 +408,21 @@ void linter::declare_variable(scope &scope, identifier name, variable_kind kind,
              case used_variable_kind::use:
                break;
              }
-             return name.normalized_name() == used_var.name.normalized_name();
+             return used_var.symbol == symbol;
            });
 }
 
 void linter::visit_variable_assignment(identifier name) {
   QLJS_ASSERT(!this->scopes_.empty());
   scope &current_scope = this->current_scope();
-  const declared_variable *var = current_scope.find_declared_variable(name);
+  symbol_id symbol = this->intern(name.normalized_name());
+  const declared_variable *var =
+      this->find_declared_variable(current_scope, symbol);
   if (var) {
     this->report_error_if_assignment_is_illegal(
         var, name, /*is_assigned_before_declaration=*/false);
   } else {
-    current_scope.variables_used.emplace_back(name,
+    current_scope.variables_used.emplace_back(name, symbol,
                                               used_variable_kind::assignment);
   }
 }
@@ -359,10 +438,11 @@ void linter::visit_variable_use(identifier name) {
 void linter::visit_variable_use(identifier name, used_variable_kind use_kind) {
   QLJS_ASSERT(!this->scopes_.empty());
   scope &current_scope = this->current_scope();
+  symbol_id symbol = this->intern(name.normalized_name());
   bool variable_is_declared =
-      current_scope.find_declared_variable(name) != nullptr;
+      this->find_declared_variable(current_scope, symbol) != nullptr;
   if (!variable_is_declared) {
-    current_scope.variables_used.emplace_back(name, use_kind);
+    current_scope.variables_used.emplace_back(name, symbol, use_kind);
   }
 }
 
@@ -375,28 +455,23 @@ void linter::visit_end_of_module() {
   QLJS_ASSERT(this->scopes_.size() == 1);
   scope &global_scope = this->current_scope();
 
-  std::vector<identifier> typeof_variables;
+  // Indexed by symbol_id.
+  std::vector<bool> is_typeof_variable(
+      narrow_cast<std::size_t>(this->symbols_.size()), false);
   for (const used_variable &used_var : global_scope.variables_used) {
     if (used_var.kind == used_variable_kind::_typeof) {
-      typeof_variables.emplace_back(used_var.name);
+      is_typeof_variable[used_var.symbol] = true;
     }
   }
   for (const used_variable &used_var :
        global_scope.variables_used_in_descendant_scope) {
     if (used_var.kind == used_variable_kind::_typeof) {
-      typeof_variables.emplace_back(used_var.name);
+      is_typeof_variable[used_var.symbol] = true;
     }
   }
-  auto is_variable_declared_by_typeof = [&](const used_variable &var) -> bool {
-    return std::find_if(typeof_variables.begin(), typeof_variables.end(),
-                        [&](const identifier &typeof_variable) {
-                          return typeof_variable.normalized_name() ==
-                                 var.name.normalized_name();
-                        }) != typeof_variables.end();
-  };
   auto is_variable_declared = [&](const used_variable &var) -> bool {
-    return global_scope.find_declared_variable(var.name) ||
-           is_variable_declared_by_typeof(var);
+    return this->find_declared_variable(global_scope, var.symbol) ||
+           is_typeof_variable[var.symbol];
   };
 
   for (const used_variable &used_var : global_scope.variables_used) {
@@ -434,14 +509,14 @@ void linter::propagate_variable_uses_to_parent_scope(
 
   auto is_current_scope_function_name = [&](const used_variable &var) {
     return current_scope.function_expression_declaration.has_value() &&
-           current_scope.function_expression_declaration->name() ==
-               var.name.normalized_name();
+           current_scope.function_expression_declaration->symbol() ==
+               var.symbol;
   };
 
   for (const used_variable &used_var : current_scope.variables_used) {
-    QLJS_ASSERT(!current_scope.find_declared_variable(used_var.name));
+    QLJS_ASSERT(!this->find_declared_variable(current_scope, used_var.symbol));
     const declared_variable *var =
-        parent_scope.find_declared_variable(used_var.name);
+        this->find_declared_variable(parent_scope, used_var.symbol);
     if (var) {
       // This variable was declared in the parent scope. Don't propagate.
       if (used_var.kind == used_variable_kind::assignment) {
@@ -449,7 +524,7 @@ void linter::propagate_variable_uses_to_parent_scope(
             var, used_var.name, /*is_assigned_before_declaration=*/false);
       }
     } else if (consume_arguments &&
-               used_var.name.normalized_name() == u8"arguments") {
+               used_var.symbol == this->arguments_symbol_) {
       // Treat this variable as declared in the current scope.
     } else if (is_current_scope_function_name(used_var)) {
       // Treat this variable as declared in the current scope.
@@ -465,7 +540,7 @@ void linter::propagate_variable_uses_to_parent_scope(
   for (const used_variable &used_var :
        current_scope.variables_used_in_descendant_scope) {
     const declared_variable *var =
-        parent_scope.find_declared_variable(used_var.name);
+        this->find_declared_variable(parent_scope, used_var.symbol);
     if (var) {
       // This variable was declared in the parent scope. Don't propagate.
       if (used_var.kind == used_variable_kind::assignment) {
@@ -492,6 +567,7 @@ void linter::propagate_variable_declarations_to_parent_scope() {
       this->declare_variable(
           /*scope=*/parent_scope,
           /*name=*/var.declaration(),
+          /*symbol=*/var.symbol(),
           /*kind=*/var.kind(),
           /*declared_scope=*/
           declared_variable_scope::declared_in_descendant_scope);
@@ -535,10 +611,11 @@ void linter::report_error_if_assignment_is_illegal(
 }
 
 void linter::report_error_if_variable_declaration_conflicts_in_scope(
-    const linter::scope &scope, identifier name, variable_kind kind,
+    const linter::scope &scope, identifier name, symbol_id symbol,
+    variable_kind kind,
     linter::declared_variable_scope declaration_scope) const {
   const declared_variable *already_declared_variable =
-      scope.find_declared_variable(name);
+      this->find_declared_variable(scope, symbol);
   if (already_declared_variable) {
     using vk = variable_kind;
     vk other_kind = already_declared_variable->kind();
@@ -593,28 +670,80 @@ void linter::report_error_if_variable_declaration_conflicts_in_scope(
 }
 
 const linter::declared_variable *linter::scope::add_variable_declaration(
-    identifier name, variable_kind kind,
+    identifier name, symbol_id symbol, variable_kind kind,
     declared_variable_scope declared_scope) {
   this->declared_variables.emplace_back(
-      declared_variable::make_local(name, kind, declared_scope));
+      declared_variable::make_local(name, symbol, kind, declared_scope));
+  this->add_to_index(this->declared_variables.size() - 1);
   return &this->declared_variables.back();
 }
 
-void linter::scope::add_predefined_variable_declaration(const char8 *name,
-                                                        variable_kind kind) {
-  this->declared_variables.emplace_back(
-      declared_variable::make_global(name, kind));
+const linter::declared_variable *linter::scope::find_local_variable(
+    symbol_id symbol) const noexcept {
+  if (this->index_.empty()) {
+    for (const declared_variable &var : this->declared_variables) {
+      if (var.symbol() == symbol) {
+        return &var;
+      }
+    }
+    return nullptr;
+  }
+
+  std::size_t mask = this->index_.size() - 1;
+  for (std::size_t i = symbol & mask;; i = (i + 1) & mask) {
+    const index_entry &entry = this->index_[i];
+    if (entry.declared_variable_index == -1) {
+      return nullptr;
+    }
+    if (entry.symbol == symbol) {
+      return &this->declared_variables[narrow_cast<std::size_t>(
+          entry.declared_variable_index)];
+    }
+  }
 }
 
-const linter::declared_variable *linter::scope::find_declared_variable(
-    identifier name) const noexcept {
-  string8_view name_view = name.normalized_name();
-  for (const declared_variable &var : this->declared_variables) {
-    if (var.name() == name_view) {
-      return &var;
+void linter::scope::add_to_index(std::size_t declared_variable_index) {
+  std::size_t variable_count = this->declared_variables.size();
+  if (variable_count <= max_linear_scan_size) {
+    return;
+  }
+  // Keep the load factor at or below 1/2.
+  if (this->index_.size() < variable_count * 2) {
+    std::size_t capacity = 32;
+    while (capacity < variable_count * 2) {
+      capacity *= 2;
+    }
+    // rebuild_index indexes every variable, including the new one.
+    this->rebuild_index(capacity);
+    return;
+  }
+
+  symbol_id symbol = this->declared_variables[declared_variable_index].symbol();
+  std::size_t mask = this->index_.size() - 1;
+  for (std::size_t i = symbol & mask;; i = (i + 1) & mask) {
+    index_entry &entry = this->index_[i];
+    if (entry.declared_variable_index == -1) {
+      entry = index_entry{
+          .symbol = symbol,
+          .declared_variable_index =
+              narrow_cast<int>(declared_variable_index),
+      };
+      return;
+    }
+    if (entry.symbol == symbol) {
+      // Keep the earlier declaration, matching the linear scan.
+      return;
     }
   }
-  return nullptr;
+}
+
+void linter::scope::rebuild_index(std::size_t capacity) {
+  QLJS_ASSERT((capacity & (capacity - 1)) == 0);
+  this->index_.assign(capacity, index_entry{.symbol = 0,
+                                            .declared_variable_index = -1});
+  for (std::size_t i = 0; i < this->declared_variables.size(); ++i) {
+    this->add_to_index(i);
+  }
 }
 
 void linter::scope::clear() {
@@ -622,6 +751,8 @@ void linter::scope::clear() {
   this->variables_used.clear();
   this->variables_used_in_descendant_scope.clear();
   this->function_expression_declaration.reset();
+  this->predefined_variables = predefined_variable_scope::none;
+  this->index_.clear();
 }
 
 linter::scopes::scopes() {
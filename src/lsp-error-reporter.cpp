@@ -0,0 +1,150 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/error.h>
+#include <quick-lint-js/json.h>
+#include <quick-lint-js/location.h>
+#include <quick-lint-js/lsp-error-reporter.h>
+#include <quick-lint-js/lsp-location.h>
+#include <quick-lint-js/output-stream.h>
+#include <quick-lint-js/padded-string.h>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+using namespace std::literals::string_view_literals;
+
+namespace quick_lint_js {
+lsp_error_reporter::lsp_error_reporter(output_stream *output,
+                                       padded_string_view input)
+    : output_(*output), locator_(input) {
+  this->output_.append_copy(u8'[');
+}
+
+void lsp_error_reporter::finish() { this->output_.append_copy(u8']'); }
+
+#define QLJS_ERROR_TYPE(name, struct_body, format_call) \
+  void lsp_error_reporter::report(name e) {             \
+    if (this->need_comma_) {                            \
+      this->output_.append_copy(u8',');                 \
+    }                                                   \
+    this->need_comma_ = true;                           \
+    format_error(e, this->format());                    \
+  }
+QLJS_X_ERROR_TYPES
+#undef QLJS_ERROR_TYPE
+
+void lsp_error_reporter::report_fatal_error_unimplemented_character(
+    const char *qljs_file_name, int qljs_line, const char *qljs_function_name,
+    const char8 *character) {
+  std::ostringstream message;
+  error_reporter::write_fatal_error_unimplemented_character(
+      /*qljs_file_name=*/qljs_file_name,
+      /*qljs_line=*/qljs_line,
+      /*qljs_function_name=*/qljs_function_name,
+      /*character=*/character,
+      /*locator=*/nullptr,
+      /*out=*/message);
+  this->report_fatal_error(character, std::move(message).str());
+}
+
+void lsp_error_reporter::report_fatal_error_unimplemented_token(
+    const char *qljs_file_name, int qljs_line, const char *qljs_function_name,
+    token_type type, const char8 *token_begin) {
+  std::ostringstream message;
+  error_reporter::write_fatal_error_unimplemented_token(
+      /*qljs_file_name=*/qljs_file_name,
+      /*qljs_line=*/qljs_line,
+      /*qljs_function_name=*/qljs_function_name,
+      /*type=*/type,
+      /*token_begin=*/token_begin,
+      /*locator=*/nullptr,
+      /*out=*/message);
+  this->report_fatal_error(token_begin, std::move(message).str());
+}
+
+void lsp_error_reporter::report_fatal_error(const char8 *where,
+                                            std::string message) {
+  // The caller does not crash (see catch_fatal_parse_errors). Tell the client
+  // why the rest of the document has no diagnostics.
+  if (!message.empty() && message.back() == '\n') {
+    message.pop_back();
+  }
+  if (this->need_comma_) {
+    this->output_.append_copy(u8',');
+  }
+  this->need_comma_ = true;
+  constexpr auto error = lsp_error_formatter::severity::error;
+  source_code_span span(where, where);
+  lsp_error_formatter formatter = this->format();
+  formatter.write_before_message(error, span);
+  formatter.write_message_part(
+      error, string8_view(reinterpret_cast<const char8 *>(message.data()),
+                          message.size()));
+  formatter.write_after_message(error, span);
+}
+
+lsp_error_formatter lsp_error_reporter::format() {
+  return lsp_error_formatter(/*output=*/&this->output_,
+                             /*locator=*/this->locator_);
+}
+
+lsp_error_formatter::lsp_error_formatter(output_stream *output,
+                                         lsp_locator &locator)
+    : output_(*output), locator_(locator) {}
+
+void lsp_error_formatter::write_before_message(
+    severity sev, const source_code_span &origin) {
+  if (sev == severity::note) {
+    // Don't write notes. Only write the main message.
+    return;
+  }
+
+  lsp_range r = this->locator_.range(origin);
+  this->output_.append_copy(u8"{\"range\":{\"start\":{\"line\":"sv);
+  this->output_.append_decimal_integer(r.start.line);
+  this->output_.append_copy(u8",\"character\":"sv);
+  this->output_.append_decimal_integer(r.start.character);
+  this->output_.append_copy(u8"},\"end\":{\"line\":"sv);
+  this->output_.append_decimal_integer(r.end.line);
+  this->output_.append_copy(u8",\"character\":"sv);
+  this->output_.append_decimal_integer(r.end.character);
+  this->output_.append_copy(
+      u8"}},\"severity\":1,\"source\":\"quick-lint-js\",\"message\":\""sv);
+}
+
+void lsp_error_formatter::write_message_part(severity sev,
+                                             string8_view message) {
+  if (sev == severity::note) {
+    // Don't write notes. Only write the main message.
+    return;
+  }
+
+  write_json_escaped_string(this->output_, message);
+}
+
+void lsp_error_formatter::write_after_message(severity sev,
+                                              const source_code_span &) {
+  if (sev == severity::note) {
+    // Don't write notes. Only write the main message.
+    return;
+  }
+
+  this->output_.append_copy(u8"\"}"sv);
+}
+}
@@ -0,0 +1,129 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cstddef>
+#include <ostream>
+#include <quick-lint-js/assert.h>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/location.h>
+#include <quick-lint-js/lsp-location.h>
+#include <quick-lint-js/narrow-cast.h>
+#include <quick-lint-js/padded-string.h>
+
+namespace quick_lint_js {
+namespace {
+// Returns the number of bytes in the UTF-8 sequence starting at c. Invalid
+// bytes are treated as one-byte sequences.
+int utf_8_sequence_size(const char8 *c) noexcept {
+  auto byte = static_cast<unsigned char>(*c);
+  if (byte < 0xc0) {
+    return 1;
+  } else if (byte < 0xe0) {
+    return 2;
+  } else if (byte < 0xf0) {
+    return 3;
+  } else if (byte < 0xf8) {
+    return 4;
+  } else {
+    return 1;
+  }
+}
+
+int utf_16_code_units(int utf_8_sequence_size) noexcept {
+  return utf_8_sequence_size == 4 ? 2 : 1;
+}
+}
+
+std::ostream &operator<<(std::ostream &out, const lsp_position &p) {
+  out << "lsp_position{" << p.line << ',' << p.character << '}';
+  return out;
+}
+
+lsp_locator::lsp_locator(padded_string_view input) : input_(input) {
+  this->line_begins_.push_back(input.data());
+  for (const char8 *c = input.data(); c != input.null_terminator();) {
+    if (*c == u8'\n') {
+      c += 1;
+      this->line_begins_.push_back(c);
+    } else if (*c == u8'\r') {
+      c += c[1] == u8'\n' ? 2 : 1;
+      this->line_begins_.push_back(c);
+    } else {
+      c += 1;
+    }
+  }
+}
+
+lsp_range lsp_locator::range(source_code_span span) const {
+  return lsp_range{
+      .start = this->position(span.begin()),
+      .end = this->position(span.end()),
+  };
+}
+
+lsp_position lsp_locator::position(const char8 *source) const noexcept {
+  auto line_it = std::upper_bound(this->line_begins_.begin() + 1,
+                                  this->line_begins_.end(), source) -
+                 1;
+  int character = 0;
+  for (const char8 *c = *line_it; c < source;) {
+    int size = utf_8_sequence_size(c);
+    character += utf_16_code_units(size);
+    c += size;
+  }
+  return lsp_position{
+      .line = narrow_cast<int>(line_it - this->line_begins_.begin()),
+      .character = character,
+  };
+}
+
+const char8 *lsp_locator::from_position(lsp_position position) const
+    noexcept {
+  if (position.line < 0) {
+    return this->input_.data();
+  }
+  if (position.line >= narrow_cast<int>(this->line_begins_.size())) {
+    return this->input_.null_terminator();
+  }
+  const char8 *c =
+      this->line_begins_[narrow_cast<std::size_t>(position.line)];
+  const char8 *line_end = this->end_of_line(position.line);
+  int character = 0;
+  while (c < line_end && character < position.character) {
+    int size = utf_8_sequence_size(c);
+    character += utf_16_code_units(size);
+    c += size;
+  }
+  return std::min(c, line_end);
+}
+
+const char8 *lsp_locator::end_of_line(int line) const noexcept {
+  std::size_t next_line = narrow_cast<std::size_t>(line) + 1;
+  if (next_line == this->line_begins_.size()) {
+    return this->input_.null_terminator();
+  }
+  const char8 *end = this->line_begins_[next_line];
+  // Exclude the line terminator.
+  if (end[-1] == u8'\n') {
+    end -= 1;
+  }
+  if (end > this->line_begins_[next_line - 1] && end[-1] == u8'\r') {
+    end -= 1;
+  }
+  return end;
+}
+}
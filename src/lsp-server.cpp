@@ -0,0 +1,394 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cstddef>
+#include <json/reader.h>
+#include <json/value.h>
+#include <json/writer.h>
+#include <memory>
+#include <optional>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/json.h>
+#include <quick-lint-js/lint.h>
+#include <quick-lint-js/lsp-error-reporter.h>
+#include <quick-lint-js/lsp-location.h>
+#include <quick-lint-js/lsp-server.h>
+#include <quick-lint-js/narrow-cast.h>
+#include <quick-lint-js/output-stream.h>
+#include <quick-lint-js/padded-string.h>
+#include <quick-lint-js/parse.h>
+#include <string>
+#include <string_view>
+#include <utility>
+
+using namespace std::literals::string_view_literals;
+
+namespace quick_lint_js {
+namespace {
+// JSON-RPC error codes.
+constexpr int error_parse_error = -32700;
+constexpr int error_invalid_request = -32600;
+constexpr int error_method_not_found = -32601;
+
+string8_view to_string8_view(std::string_view s) noexcept {
+  return string8_view(reinterpret_cast<const char8 *>(s.data()), s.size());
+}
+
+bool equals_ignoring_ascii_case(string8_view a, std::string_view b) noexcept {
+  auto lower = [](char c) -> char {
+    return 'A' <= c && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+  };
+  return a.size() == b.size() &&
+         std::equal(a.begin(), a.end(), b.begin(), [&](char8 x, char y) {
+           return lower(static_cast<char>(x)) == lower(y);
+         });
+}
+
+std::optional<std::size_t> parse_content_length(string8_view headers) {
+  while (!headers.empty()) {
+    std::size_t line_end = headers.find(u8"\r\n"sv);
+    string8_view line = headers.substr(0, line_end);
+    headers = line_end == headers.npos ? string8_view()
+                                       : headers.substr(line_end + 2);
+
+    std::size_t colon = line.find(u8':');
+    if (colon == line.npos ||
+        !equals_ignoring_ascii_case(line.substr(0, colon), "content-length")) {
+      continue;
+    }
+    string8_view value = line.substr(colon + 1);
+    while (!value.empty() && value.front() == u8' ') {
+      value.remove_prefix(1);
+    }
+    if (value.empty()) {
+      return std::nullopt;
+    }
+    std::size_t length = 0;
+    for (char8 c : value) {
+      if (c < u8'0' || c > u8'9') {
+        return std::nullopt;
+      }
+      length = length * 10 + narrow_cast<std::size_t>(c - u8'0');
+    }
+    return length;
+  }
+  return std::nullopt;
+}
+
+// Returns nullopt if the value is not a string.
+std::optional<string8_view> get_string(const Json::Value &value) {
+  const char *begin;
+  const char *end;
+  if (!value.isString() || !value.getString(&begin, &end)) {
+    return std::nullopt;
+  }
+  return string8_view(reinterpret_cast<const char8 *>(begin),
+                      narrow_cast<std::size_t>(end - begin));
+}
+
+std::optional<int> get_int(const Json::Value &value) {
+  if (!value.isInt()) {
+    return std::nullopt;
+  }
+  return value.asInt();
+}
+
+std::optional<lsp_position> get_position(const Json::Value &value) {
+  if (!value.isObject()) {
+    return std::nullopt;
+  }
+  std::optional<int> line = get_int(value["line"]);
+  std::optional<int> character = get_int(value["character"]);
+  if (!line.has_value() || !character.has_value()) {
+    return std::nullopt;
+  }
+  return lsp_position{.line = *line, .character = *character};
+}
+
+void set_text(padded_string *text, string8_view new_text) {
+  // Reuse text's allocation if possible.
+  text->resize(narrow_cast<int>(new_text.size()));
+  std::copy(new_text.begin(), new_text.end(), text->data());
+}
+
+std::string to_json(const Json::Value &value) {
+  Json::StreamWriterBuilder builder;
+  builder["indentation"] = "";
+  return Json::writeString(builder, value);
+}
+}
+
+void lsp_message_parser::append(string8_view data) {
+  if (this->consumed_ > 0) {
+    this->buffer_.erase(0, this->consumed_);
+    this->consumed_ = 0;
+  }
+  this->buffer_.append(data);
+}
+
+std::optional<string8_view> lsp_message_parser::next_message() {
+  for (;;) {
+    string8_view unconsumed =
+        string8_view(this->buffer_).substr(this->consumed_);
+    std::size_t headers_end = unconsumed.find(u8"\r\n\r\n"sv);
+    if (headers_end == unconsumed.npos) {
+      return std::nullopt;
+    }
+    std::size_t body_begin = headers_end + 4;
+    std::optional<std::size_t> content_length =
+        parse_content_length(unconsumed.substr(0, headers_end));
+    if (!content_length.has_value()) {
+      // Skip the malformed message's header and hope for the best.
+      this->consumed_ += body_begin;
+      continue;
+    }
+    if (unconsumed.size() - body_begin < *content_length) {
+      return std::nullopt;
+    }
+    this->consumed_ += body_begin + *content_length;
+    return unconsumed.substr(body_begin, *content_length);
+  }
+}
+
+lsp_server::lsp_server()
+    : json_reader_(Json::CharReaderBuilder().newCharReader()) {}
+
+lsp_server::~lsp_server() = default;
+
+void lsp_server::handle_message(string8_view body, string8 *out) {
+  Json::Value message;
+  Json::String errors;
+  const char *json_begin = reinterpret_cast<const char *>(body.data());
+  if (!this->json_reader_->parse(json_begin, json_begin + body.size(),
+                                 &message, &errors)) {
+    this->write_error_response(Json::Value(Json::nullValue),
+                               error_parse_error, u8"parse error"sv, out);
+    return;
+  }
+  if (!message.isObject()) {
+    this->write_error_response(Json::Value(Json::nullValue),
+                               error_invalid_request, u8"invalid request"sv,
+                               out);
+    return;
+  }
+
+  const Json::Value &const_message = message;
+  std::optional<string8_view> method = get_string(const_message["method"]);
+  if (!method.has_value()) {
+    // This is a response to a request. We never send requests, so ignore it.
+    return;
+  }
+  std::string_view method_name(reinterpret_cast<const char *>(method->data()),
+                               method->size());
+  if (message.isMember("id")) {
+    this->handle_request(message, method_name, out);
+  } else {
+    this->handle_notification(message, method_name, out);
+  }
+}
+
+void lsp_server::handle_request(const Json::Value &request,
+                                std::string_view method, string8 *out) {
+  const Json::Value &id = request["id"];
+  if (this->shutdown_requested_) {
+    this->write_error_response(id, error_invalid_request,
+                               u8"server is shutting down"sv, out);
+  } else if (method == "initialize") {
+    this->write_response(
+        id,
+        u8"{\"capabilities\":{\"textDocumentSync\":"
+        u8"{\"openClose\":true,\"change\":2}},"
+        u8"\"serverInfo\":{\"name\":\"quick-lint-js\"}}"sv,
+        out);
+  } else if (method == "shutdown") {
+    this->shutdown_requested_ = true;
+    this->write_response(id, u8"null"sv, out);
+  } else {
+    this->write_error_response(id, error_method_not_found,
+                               u8"method not found"sv, out);
+  }
+}
+
+void lsp_server::handle_notification(const Json::Value &notification,
+                                     std::string_view method, string8 *out) {
+  const Json::Value &params = notification["params"];
+  if (method == "textDocument/didOpen") {
+    this->handle_did_open(params);
+  } else if (method == "textDocument/didChange") {
+    this->handle_did_change(params);
+  } else if (method == "textDocument/didClose") {
+    this->handle_did_close(params, out);
+  } else if (method == "exit") {
+    this->exit_requested_ = true;
+  } else {
+    // Ignore other notifications, such as 'initialized' and
+    // '$/cancelRequest'.
+  }
+}
+
+void lsp_server::handle_did_open(const Json::Value &params) {
+  const Json::Value &text_document = params["textDocument"];
+  std::optional<string8_view> uri = get_string(text_document["uri"]);
+  std::optional<string8_view> text = get_string(text_document["text"]);
+  if (!uri.has_value() || !text.has_value()) {
+    return;
+  }
+  document &doc = this->documents_[text_document["uri"].asString()];
+  set_text(&doc.text, *text);
+  doc.version = get_int(text_document["version"]);
+  doc.need_lint = true;
+}
+
+void lsp_server::handle_did_change(const Json::Value &params) {
+  const Json::Value &text_document = params["textDocument"];
+  if (!text_document["uri"].isString()) {
+    return;
+  }
+  auto doc_it = this->documents_.find(text_document["uri"].asString());
+  if (doc_it == this->documents_.end()) {
+    // The client didn't open the document first.
+    return;
+  }
+  document &doc = doc_it->second;
+
+  const Json::Value &changes = params["contentChanges"];
+  if (!changes.isArray()) {
+    return;
+  }
+  for (const Json::Value &change : changes) {
+    std::optional<string8_view> text = get_string(change["text"]);
+    if (!text.has_value()) {
+      continue;
+    }
+    const Json::Value &range = change["range"];
+    if (range.isNull()) {
+      set_text(&doc.text, *text);
+      continue;
+    }
+    std::optional<lsp_position> start = get_position(range["start"]);
+    std::optional<lsp_position> end = get_position(range["end"]);
+    if (!start.has_value() || !end.has_value()) {
+      continue;
+    }
+    lsp_locator locator(&doc.text);
+    const char8 *start_pointer = locator.from_position(*start);
+    const char8 *end_pointer =
+        std::max(start_pointer, locator.from_position(*end));
+    doc.text.replace_text(
+        /*begin=*/narrow_cast<int>(start_pointer - doc.text.data()),
+        /*end=*/narrow_cast<int>(end_pointer - doc.text.data()),
+        /*replacement=*/*text);
+  }
+  doc.version = get_int(text_document["version"]);
+  doc.need_lint = true;
+}
+
+void lsp_server::handle_did_close(const Json::Value &params, string8 *out) {
+  const Json::Value &uri = params["textDocument"]["uri"];
+  if (!uri.isString()) {
+    return;
+  }
+  std::string uri_string = uri.asString();
+  if (this->documents_.erase(uri_string) == 0) {
+    return;
+  }
+  // Clear the document's diagnostics.
+  this->write_diagnostics(uri_string, /*doc=*/nullptr, out);
+}
+
+void lsp_server::publish_pending_diagnostics(string8 *out) {
+  for (auto &[uri, doc] : this->documents_) {
+    if (doc.need_lint) {
+      this->write_diagnostics(uri, &doc, out);
+      doc.need_lint = false;
+    }
+  }
+}
+
+void lsp_server::write_diagnostics(const std::string &uri, document *doc,
+                                   string8 *out) {
+  this->message_body_.clear();
+  {
+    string8_output_stream body(&this->message_body_);
+    body.append_copy(
+        u8"{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/publishDiagnostics\","
+        u8"\"params\":{\"uri\":\""sv);
+    write_json_escaped_string(body, to_string8_view(uri));
+    body.append_copy(u8"\","sv);
+    if (doc && doc->version.has_value()) {
+      body.append_copy(u8"\"version\":"sv);
+      body.append_decimal_integer(*doc->version);
+      body.append_copy(u8","sv);
+    }
+    body.append_copy(u8"\"diagnostics\":"sv);
+    if (doc) {
+      // The lexer modifies its input, so lint a copy of the document.
+      set_text(&this->lint_buffer_,
+               string8_view(doc->text.data(),
+                            narrow_cast<std::size_t>(doc->text.size())));
+      lsp_error_reporter reporter(&body, &this->lint_buffer_);
+      // NOTE(strager): Unimplemented syntax would crash the server. The
+      // reporter turns the fatal error into a diagnostic instead.
+      catch_fatal_parse_errors([&]() -> void {
+        parser p(&this->lint_buffer_, &reporter);
+        linter l(&reporter);
+        p.parse_and_visit_module(l);
+      });
+      reporter.finish();
+    } else {
+      body.append_copy(u8"[]"sv);
+    }
+    body.append_copy(u8"}}"sv);
+  }
+  this->write_message(out);
+}
+
+void lsp_server::write_response(const Json::Value &id,
+                                string8_view result_json, string8 *out) {
+  this->message_body_.clear();
+  this->message_body_ += u8"{\"jsonrpc\":\"2.0\",\"id\":"sv;
+  this->message_body_ += to_string8_view(to_json(id));
+  this->message_body_ += u8",\"result\":"sv;
+  this->message_body_ += result_json;
+  this->message_body_ += u8'}';
+  this->write_message(out);
+}
+
+void lsp_server::write_error_response(const Json::Value &id, int code,
+                                      string8_view message, string8 *out) {
+  this->message_body_.clear();
+  {
+    string8_output_stream body(&this->message_body_);
+    body.append_copy(u8"{\"jsonrpc\":\"2.0\",\"id\":"sv);
+    body.append_copy(to_string8_view(to_json(id)));
+    body.append_copy(u8",\"error\":{\"code\":"sv);
+    body.append_decimal_integer(code);
+    body.append_copy(u8",\"message\":\""sv);
+    write_json_escaped_string(body, message);
+    body.append_copy(u8"\"}}"sv);
+  }
+  this->write_message(out);
+}
+
+void lsp_server::write_message(string8 *out) {
+  std::string content_length = std::to_string(this->message_body_.size());
+  *out += u8"Content-Length: "sv;
+  *out += to_string8_view(content_length);
+  *out += u8"\r\n\r\n"sv;
+  *out += this->message_body_;
+}
+}
@@ -15,19 +15,35 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <cerrno>
+#include <condition_variable>
+#include <csignal>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <quick-lint-js/buffering-error-reporter.h>
 #include <quick-lint-js/char8.h>
 #include <quick-lint-js/error.h>
+#include <quick-lint-js/file-handle.h>
 #include <quick-lint-js/file.h>
+#include <quick-lint-js/have.h>
 #include <quick-lint-js/language.h>
 #include <quick-lint-js/lex.h>
+#include <quick-lint-js/lint-cache.h>
+#include <quick-lint-js/lint-server.h>
 #include <quick-lint-js/lint.h>
 #include <quick-lint-js/location.h>
+#include <quick-lint-js/lsp-server.h>
+#include <quick-lint-js/narrow-cast.h>
 #include <quick-lint-js/options.h>
+#include <quick-lint-js/output-stream.h>
 #include <quick-lint-js/padded-string.h>
+#include <quick-lint-js/parallel.h>
+#include <quick-lint-js/parse-parallel.h>
 #include <quick-lint-js/parse-visitor.h>
 #include <quick-lint-js/parse.h>
 #include <quick-lint-js/text-error-reporter.h>
@@ -36,6 +52,15 @@
 #include <quick-lint-js/vim-qflist-json-error-reporter.h>
 #include <string>
 #include <variant>
+#include <vector>
+
+#if QLJS_HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#if QLJS_HAVE_WINDOWS_H
+#include <Windows.h>
+#endif
 
 namespace quick_lint_js {
 namespace {
@@ -44,9 +69,11 @@ class any_error_reporter {
   static any_error_reporter make(output_format format) {
     switch (format) {
     case output_format::gnu_like:
-      return any_error_reporter(text_error_reporter(std::cerr));
+      return any_error_reporter(
+          text_error_reporter(file_output_stream::get_stderr()));
     case output_format::vim_qflist_json:
-      return any_error_reporter(vim_qflist_json_error_reporter(std::cout));
+      return any_error_reporter(
+          vim_qflist_json_error_reporter(file_output_stream::get_stdout()));
     }
     QLJS_UNREACHABLE();
   }
@@ -69,6 +96,10 @@ class any_error_reporter {
     return std::visit([](error_reporter &r) { return &r; }, this->reporter_);
   }
 
+  void flush() {
+    std::visit([](auto &r) { r.flush(); }, this->reporter_);
+  }
+
   void finish() {
     std::visit(
         [&](auto &r) {
@@ -76,6 +107,8 @@ class any_error_reporter {
           if constexpr (std::is_base_of_v<vim_qflist_json_error_reporter,
                                           reporter_type>) {
             r.finish();
+          } else {
+            r.flush();
           }
         },
         this->reporter_);
@@ -92,7 +125,17 @@ class any_error_reporter {
 };
 
 void process_file(padded_string_view input, error_reporter *,
-                  bool print_parser_visits);
+                  bool print_parser_visits, int jobs);
+void process_file_with_cache(padded_string_view input, error_reporter *,
+                             lint_cache *, int jobs);
+void process_files_in_parallel(const std::vector<file_to_lint> &, int jobs,
+                               any_error_reporter &, lint_cache *);
+
+int run_server(const char *socket_path);
+int run_client(const options &);
+int run_lsp_server();
+
+bool flush_output_streams();
 
 void print_help_message();
 }
@@ -112,23 +155,69 @@ int main(int argc, char **argv) {
     }
     return 1;
   }
+  if (o.lsp_server) {
+    return quick_lint_js::run_lsp_server();
+  }
+  if (o.server_socket_path) {
+    return quick_lint_js::run_server(o.server_socket_path);
+  }
   if (o.files_to_lint.empty()) {
     std::cerr << "error: expected file name\n";
     return 1;
   }
+  if (o.client_socket_path) {
+    return quick_lint_js::run_client(o);
+  }
 
   quick_lint_js::any_error_reporter reporter =
       quick_lint_js::any_error_reporter::make(o.output_format);
-  for (const quick_lint_js::file_to_lint &file : o.files_to_lint) {
-    quick_lint_js::read_file_result source =
-        quick_lint_js::read_file(file.path);
-    source.exit_if_not_ok();
-    reporter.set_source(&source.content, file);
-    quick_lint_js::process_file(&source.content, reporter.get(),
-                                o.print_parser_visits);
+  // Cache hits skip parsing, so they would have no --debug-parser-visits
+  // output. Ignore --cache-dir in that case.
+  std::optional<quick_lint_js::lint_cache> cache;
+  if (o.cache_directory && !o.print_parser_visits) {
+    cache.emplace(o.cache_directory);
+  }
+  // --debug-parser-visits output would be interleaved between threads, so
+  // do not lint files in parallel in that case. Instead, use --jobs for the
+  // functions inside each file, which does not reorder output.
+  if (o.jobs > 1 && !o.print_parser_visits && o.files_to_lint.size() > 1) {
+    quick_lint_js::process_files_in_parallel(
+        o.files_to_lint, o.jobs, reporter,
+        /*cache=*/cache.has_value() ? &*cache : nullptr);
+  } else {
+    for (const quick_lint_js::file_to_lint &file : o.files_to_lint) {
+      quick_lint_js::read_file_result source =
+          quick_lint_js::read_file(file.path);
+      if (!source.ok()) {
+        // Print errors for earlier files before the read error.
+        reporter.flush();
+      }
+      source.exit_if_not_ok();
+      reporter.set_source(source.content.view(), file);
+      if (cache.has_value()) {
+        quick_lint_js::process_file_with_cache(
+            source.content.view(), reporter.get(), &*cache, o.jobs);
+      } else {
+        quick_lint_js::process_file(source.content.view(), reporter.get(),
+                                    o.print_parser_visits, o.jobs);
+      }
+      if (o.print_parser_visits) {
+        // Keep errors near the --debug-parser-visits output (which is not
+        // buffered).
+        reporter.flush();
+      }
+    }
   }
   reporter.finish();
 
+  if (o.print_cache_stats && cache.has_value()) {
+    std::cerr << "cache: " << cache->hit_count() << " hits, "
+              << cache->miss_count() << " misses\n";
+  }
+
+  if (!quick_lint_js::flush_output_streams()) {
+    return 1;
+  }
   return 0;
 }
 
@@ -280,16 +369,314 @@ class multi_visitor {
 };
 
 void process_file(padded_string_view input, error_reporter *error_reporter,
-                  bool print_parser_visits) {
-  parser p(input, error_reporter);
+                  bool print_parser_visits, int jobs) {
   linter l(error_reporter);
   if (print_parser_visits) {
     debug_visitor logger;
     multi_visitor visitor(&logger, &l);
-    p.parse_and_visit_module(visitor);
+    parse_and_visit_module_in_parallel(input, error_reporter, visitor,
+                                       /*thread_count=*/jobs);
   } else {
-    p.parse_and_visit_module(l);
+    parse_and_visit_module_in_parallel(input, error_reporter, l,
+                                       /*thread_count=*/jobs);
+  }
+}
+
+void process_file_with_cache(padded_string_view input,
+                             error_reporter *error_reporter,
+                             lint_cache *cache, int jobs) {
+  // NOTE(strager): Compute the key before linting, because the lexer modifies
+  // the input.
+  lint_cache_key key(string8_view(
+      input.data(),
+      narrow_cast<std::size_t>(input.null_terminator() - input.data())));
+  if (cache->load(key, input, error_reporter)) {
+    return;
+  }
+  lint_cache_recording_error_reporter recorder(error_reporter, input);
+  process_file(input, &recorder, /*print_parser_visits=*/false, jobs);
+  cache->store(key, recorder);
+}
+
+// Buffers errors for a file linted on a worker thread.
+//
+// The caller crashes after reporting a fatal error, so a worker cannot return
+// its buffered errors after a fatal error. Instead, take_over_reporting() is
+// called. It reports the buffered errors itself and returns the error_reporter
+// which should receive the fatal error.
+template <class TakeOverReportingFunc>
+class worker_error_reporter final : public error_reporter {
+ public:
+  explicit worker_error_reporter(buffering_error_reporter *errors,
+                                 TakeOverReportingFunc take_over_reporting)
+      : errors_(errors), take_over_reporting_(take_over_reporting) {}
+
+#define QLJS_ERROR_TYPE(name, struct_body, format) \
+  void report(name e) override { this->errors_->report(std::move(e)); }
+  QLJS_X_ERROR_TYPES
+#undef QLJS_ERROR_TYPE
+
+  void report_fatal_error_unimplemented_character(
+      const char *qljs_file_name, int qljs_line, const char *qljs_function_name,
+      const char8 *character) override {
+    this->take_over_reporting_()->report_fatal_error_unimplemented_character(
+        /*qljs_file_name=*/qljs_file_name,
+        /*qljs_line=*/qljs_line,
+        /*qljs_function_name=*/qljs_function_name,
+        /*character=*/character);
+  }
+
+  void report_fatal_error_unimplemented_token(
+      const char *qljs_file_name, int qljs_line, const char *qljs_function_name,
+      token_type type, const char8 *token_begin) override {
+    this->take_over_reporting_()->report_fatal_error_unimplemented_token(
+        /*qljs_file_name=*/qljs_file_name,
+        /*qljs_line=*/qljs_line,
+        /*qljs_function_name=*/qljs_function_name,
+        /*type=*/type,
+        /*token_begin=*/token_begin);
+  }
+
+ private:
+  buffering_error_reporter *errors_;
+  TakeOverReportingFunc take_over_reporting_;
+};
+
+void process_files_in_parallel(const std::vector<file_to_lint> &files,
+                               int jobs, any_error_reporter &reporter,
+                               lint_cache *cache) {
+  // Each file is read, parsed, and linted on a worker thread. Errors are
+  // buffered per file, then given to the real reporter on the main thread in
+  // the order the files were given on the command line. This makes the
+  // output identical to the output of --jobs=1.
+  //
+  // A worker which hits a fatal error never returns its file. It waits until
+  // every earlier file has been reported, then reports its own file and the
+  // fatal error. Meanwhile, the main thread is waiting for the worker's file,
+  // so only one thread uses the real reporter at a time.
+  struct linted_file {
+    read_file_result source;
+    buffering_error_reporter errors;
+  };
+
+  std::mutex mutex;
+  std::condition_variable file_reported;
+  int reported_file_count = 0;   // Guarded by mutex.
+  bool read_file_failed = false;  // Guarded by mutex.
+
+  // Call with mutex locked.
+  auto report_file = [&](int i, linted_file &file) -> void {
+    if (read_file_failed) {
+      // --jobs=1 would have exited before linting this file.
+      return;
+    }
+    if (!file.source.ok()) {
+      // Print errors for earlier files before the read error.
+      reporter.flush();
+      std::fprintf(stderr, "error: %s\n", file.source.error.c_str());
+      read_file_failed = true;
+      return;
+    }
+    reporter.set_source(file.source.content.view(),
+                        files[narrow_cast<std::size_t>(i)]);
+    file.errors.move_into(reporter.get());
+  };
+
+  for_each_in_parallel_in_order<std::unique_ptr<linted_file>>(
+      /*item_count=*/narrow_cast<int>(files.size()),
+      /*thread_count=*/jobs,
+      /*produce=*/
+      [&](int i) -> std::unique_ptr<linted_file> {
+        // NOTE(strager): linted_file is heap-allocated because errors point
+        // into source.content, and moving a file_content might move its
+        // characters.
+        auto result = std::make_unique<linted_file>();
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (read_file_failed) {
+            // We are about to exit. Don't bother with this file. (report_file
+            // ignores it.)
+            return result;
+          }
+        }
+        result->source = read_file(files[narrow_cast<std::size_t>(i)].path);
+        if (result->source.ok()) {
+          result->errors.set_source(result->source.content.view());
+          worker_error_reporter worker_errors(
+              &result->errors, [&, i]() -> error_reporter * {
+                std::unique_lock<std::mutex> lock(mutex);
+                file_reported.wait(
+                    lock, [&] { return reported_file_count == i; });
+                report_file(i, *result);
+                if (read_file_failed) {
+                  // The read error was printed already. Don't run exit
+                  // handlers, because other threads are still running.
+                  std::_Exit(1);
+                }
+                // We are about to crash. Keep mutex locked so no other thread
+                // reports anything.
+                lock.release();
+                return reporter.get();
+              });
+          if (cache) {
+            process_file_with_cache(result->source.content.view(),
+                                    &worker_errors, cache, /*jobs=*/1);
+          } else {
+            process_file(result->source.content.view(), &worker_errors,
+                         /*print_parser_visits=*/false, /*jobs=*/1);
+          }
+        }
+        return result;
+      },
+      /*consume=*/
+      [&](int i, std::unique_ptr<linted_file> &&result) -> void {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          report_file(i, *result);
+          reported_file_count = i + 1;
+        }
+        file_reported.notify_all();
+      });
+
+  if (read_file_failed) {
+    std::exit(1);
+  }
+}
+
+#if QLJS_HAVE_UNIX_DOMAIN_SOCKETS
+lint_socket_server *running_server = nullptr;
+
+extern "C" void stop_running_server(int) {
+  if (running_server) {
+    running_server->stop();
+  }
+}
+#endif
+
+int run_server(const char *socket_path) {
+#if QLJS_HAVE_UNIX_DOMAIN_SOCKETS
+  lint_socket_server server(socket_path);
+  if (!server.ok()) {
+    std::cerr << "error: " << server.error() << '\n';
+    return 1;
+  }
+  // Delete the socket file when interrupted.
+  running_server = &server;
+  std::signal(SIGINT, stop_running_server);
+  std::signal(SIGTERM, stop_running_server);
+  server.run();
+  running_server = nullptr;
+  return 0;
+#else
+  std::cerr << "error: --server is not supported on this platform: "
+            << socket_path << '\n';
+  return 1;
+#endif
+}
+
+int run_client(const options &o) {
+#if QLJS_HAVE_UNIX_DOMAIN_SOCKETS
+  // Send file contents instead of paths so the server doesn't need to share
+  // our working directory.
+  lint_request request;
+  request.output_format = o.output_format;
+  for (const file_to_lint &file : o.files_to_lint) {
+    read_file_result source = read_file(file.path);
+    source.exit_if_not_ok();
+    request.files.push_back(lint_request_file{
+        .path = file.path,
+        .vim_bufnr = file.vim_bufnr,
+        .content = string8(source.content.string_view()),
+    });
+  }
+
+  lint_client client(o.client_socket_path);
+  std::optional<lint_response> response;
+  if (client.ok()) {
+    response = client.send(request);
+  }
+  if (!response.has_value()) {
+    std::cerr << "error: " << client.error() << '\n';
+    return 1;
+  }
+  if (response->status == lint_response_status::error) {
+    std::cerr << "error: " << out_string8(response->output) << '\n';
+    return 1;
+  }
+
+  file_output_stream *output = nullptr;
+  switch (o.output_format) {
+  case output_format::gnu_like:
+    output = file_output_stream::get_stderr();
+    break;
+  case output_format::vim_qflist_json:
+    output = file_output_stream::get_stdout();
+    break;
+  }
+  output->append_copy(response->output);
+  return flush_output_streams() ? 0 : 1;
+#else
+  std::cerr << "error: --client is not supported on this platform: "
+            << o.client_socket_path << '\n';
+  return 1;
+#endif
+}
+
+int run_lsp_server() {
+#if QLJS_HAVE_WINDOWS_H
+  windows_handle_file input(::GetStdHandle(STD_INPUT_HANDLE));
+#else
+  posix_fd_file input(STDIN_FILENO);
+#endif
+  file_output_stream *output = file_output_stream::get_stdout();
+
+  lsp_server server;
+  lsp_message_parser parser;
+  string8 responses;
+  auto buffer = std::make_unique<char8[]>(64 * 1024);
+  for (;;) {
+    std::optional<int> read_size = input.read(buffer.get(), 64 * 1024);
+    if (!read_size.has_value() || *read_size == 0) {
+      // The client disconnected without telling us to exit.
+      return 1;
+    }
+    parser.append(
+        string8_view(buffer.get(), narrow_cast<std::size_t>(*read_size)));
+    while (std::optional<string8_view> message = parser.next_message()) {
+      server.handle_message(*message, &responses);
+      if (server.should_exit()) {
+        output->append_copy(responses);
+        if (!flush_output_streams()) {
+          return 1;
+        }
+        return server.exit_code();
+      }
+    }
+    // Lint once per batch of messages, not once per message, so we don't fall
+    // behind a fast typist.
+    server.publish_pending_diagnostics(&responses);
+    output->append_copy(responses);
+    if (!flush_output_streams()) {
+      // The client went away.
+      return 1;
+    }
+    responses.clear();
+  }
+}
+
+bool flush_output_streams() {
+  bool ok = true;
+  for (file_output_stream *stream :
+       {file_output_stream::get_stdout(), file_output_stream::get_stderr()}) {
+    stream->flush();
+    if (!stream->ok()) {
+      // If stderr is the broken stream, this message is lost, but we still
+      // exit with an error.
+      std::fprintf(stderr, "error: %s\n", stream->error().c_str());
+      ok = false;
+    }
   }
+  return ok;
 }
 
 void print_help_message() {
@@ -306,6 +693,18 @@ void print_help_message() {
   print_option("", "gnu-like (default if omitted), vim-qflist-json");
   print_option("--vim-file-bufnr=[NUMBER]",
                "Select a vim buffer for outputting feedback");
+  print_option("--jobs=[NUMBER]",
+               "Lint up to NUMBER files or functions at the same time "
+               "(default: 1)");
+  print_option("--cache-dir=[DIRECTORY]",
+               "Reuse results for unchanged files from DIRECTORY");
+  print_option("--cache-stats", "Print cache hit and miss counts");
+  print_option("--server=[SOCKET]",
+               "Lint files for --client on Unix domain socket SOCKET");
+  print_option("--client=[SOCKET]",
+               "Lint files using the --server listening on SOCKET");
+  print_option("--lsp",
+               "Run a Language Server Protocol server on stdin and stdout");
   print_option("--h, --help", "Print help message");
 }
 }
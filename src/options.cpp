@@ -180,6 +180,29 @@ options parse_options(int argc, char** argv) {
       } else {
         next_vim_file_bufnr = bufnr;
       }
+    } else if (const char* arg_value =
+                   parser.match_option_with_value("--jobs"sv)) {
+      int jobs;
+      from_chars_result result =
+          from_chars(&arg_value[0], &arg_value[std::strlen(arg_value)], jobs);
+      if (*result.ptr != '\0' || result.ec != std::errc{} || jobs < 1) {
+        o.error_unrecognized_options.emplace_back(arg_value);
+      } else {
+        o.jobs = jobs;
+      }
+    } else if (const char* arg_value =
+                   parser.match_option_with_value("--server"sv)) {
+      o.server_socket_path = arg_value;
+    } else if (const char* arg_value =
+                   parser.match_option_with_value("--client"sv)) {
+      o.client_socket_path = arg_value;
+    } else if (const char* arg_value =
+                   parser.match_option_with_value("--cache-dir"sv)) {
+      o.cache_directory = arg_value;
+    } else if (parser.match_flag_option("--cache-stats"sv, "--cache-s"sv)) {
+      o.print_cache_stats = true;
+    } else if (parser.match_flag_option("--lsp"sv, "--lsp"sv)) {
+      o.lsp_server = true;
     } else if (parser.match_flag_option("--help"sv, "--h"sv)) {
       o.help = true;
     } else {
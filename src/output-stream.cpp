@@ -0,0 +1,179 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <quick-lint-js/assert.h>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/file-handle.h>
+#include <quick-lint-js/have.h>
+#include <quick-lint-js/narrow-cast.h>
+#include <quick-lint-js/output-stream.h>
+#include <string>
+#include <string_view>
+
+#if QLJS_HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#if QLJS_HAVE_WINDOWS_H
+#include <Windows.h>
+#endif
+
+namespace quick_lint_js {
+output_stream::output_stream() : buffer_(new char8[buffer_size]) {}
+
+output_stream::~output_stream() = default;
+
+void output_stream::append_copy(string8_view data) {
+  if (data.size() > buffer_size - this->buffer_used_) {
+    this->flush();
+    if (data.size() >= buffer_size) {
+      // Don't bother copying into the buffer.
+      this->flush_impl(data);
+      return;
+    }
+  }
+  std::memcpy(&this->buffer_[this->buffer_used_], data.data(), data.size());
+  this->buffer_used_ += data.size();
+}
+
+void output_stream::append_copy(char8 c) {
+  if (this->buffer_used_ == buffer_size) {
+    this->flush();
+  }
+  this->buffer_[this->buffer_used_] = c;
+  this->buffer_used_ += 1;
+}
+
+#if QLJS_HAVE_CHAR8_T
+void output_stream::append_copy(std::string_view data) {
+  this->append_copy(
+      string8_view(reinterpret_cast<const char8 *>(data.data()), data.size()));
+}
+
+void output_stream::append_copy(char c) {
+  this->append_copy(static_cast<char8>(c));
+}
+#endif
+
+void output_stream::append_decimal_integer(int value) {
+  // Enough for "-2147483648".
+  char8 digits[16];
+  char8 *end = &digits[sizeof(digits)];
+  char8 *begin = end;
+  // Compute with negative numbers so INT_MIN does not overflow.
+  int negative_value = value < 0 ? value : -value;
+  do {
+    --begin;
+    *begin = static_cast<char8>(u8'0' - negative_value % 10);
+    negative_value /= 10;
+  } while (negative_value != 0);
+  if (value < 0) {
+    --begin;
+    *begin = u8'-';
+  }
+  this->append_copy(
+      string8_view(begin, narrow_cast<std::size_t>(end - begin)));
+}
+
+void output_stream::flush() {
+  if (this->buffer_used_ == 0) {
+    return;
+  }
+  this->flush_impl(string8_view(this->buffer_.get(), this->buffer_used_));
+  this->buffer_used_ = 0;
+}
+
+file_output_stream::file_output_stream(native_handle_type handle) noexcept
+    : handle_(handle) {}
+
+file_output_stream::~file_output_stream() { this->flush(); }
+
+file_output_stream *file_output_stream::get_stdout() {
+#if QLJS_HAVE_WINDOWS_H
+  static file_output_stream stream(::GetStdHandle(STD_OUTPUT_HANDLE));
+#else
+  static file_output_stream stream(STDOUT_FILENO);
+#endif
+  return &stream;
+}
+
+file_output_stream *file_output_stream::get_stderr() {
+#if QLJS_HAVE_WINDOWS_H
+  static file_output_stream stream(::GetStdHandle(STD_ERROR_HANDLE));
+#else
+  static file_output_stream stream(STDERR_FILENO);
+#endif
+  return &stream;
+}
+
+void file_output_stream::flush_impl(string8_view data) {
+  if (!this->ok()) {
+    // Don't write a partial message after the output was cut short.
+    return;
+  }
+
+  // Other code might have written to std::cout or std::cerr. Keep the output
+  // in order.
+  std::fflush(nullptr);
+
+  while (!data.empty()) {
+#if QLJS_HAVE_WINDOWS_H
+    DWORD write_size;
+    if (!::WriteFile(this->handle_, data.data(),
+                     narrow_cast<DWORD>(data.size()), &write_size,
+                     /*lpOverlapped=*/nullptr)) {
+      this->error_ =
+          "failed to write output: " + windows_error_message(::GetLastError());
+      return;
+    }
+    data = data.substr(write_size);
+#else
+    ::ssize_t write_size = ::write(this->handle_, data.data(), data.size());
+    if (write_size == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      this->error_ =
+          std::string("failed to write output: ") + std::strerror(errno);
+      return;
+    }
+    data = data.substr(narrow_cast<std::size_t>(write_size));
+#endif
+  }
+}
+
+string8_output_stream::string8_output_stream(string8 *out) noexcept
+    : out_(out) {}
+
+string8_output_stream::~string8_output_stream() { this->flush(); }
+
+void string8_output_stream::flush_impl(string8_view data) {
+  this->out_->append(data);
+}
+
+memory_output_stream::~memory_output_stream() = default;
+
+string8 memory_output_stream::get_flushed_string8() const {
+  return this->data_;
+}
+
+void memory_output_stream::flush_impl(string8_view data) {
+  this->data_.append(data);
+}
+}
@@ -15,6 +15,7 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <ostream>
+#include <quick-lint-js/assert.h>
 #include <quick-lint-js/char8.h>
 #include <quick-lint-js/narrow-cast.h>
 #include <quick-lint-js/padded-string.h>
@@ -41,6 +42,15 @@ void padded_string::resize(int new_size) {
             u8'\0');
 }
 
+void padded_string::replace_text(int begin, int end,
+                                 string8_view replacement) {
+  QLJS_ASSERT(0 <= begin);
+  QLJS_ASSERT(begin <= end);
+  QLJS_ASSERT(end <= this->size());
+  this->data_.replace(narrow_cast<std::size_t>(begin),
+                      narrow_cast<std::size_t>(end - begin), replacement);
+}
+
 bool operator==(string8_view x, const padded_string& y) noexcept {
   return y == x;
 }
@@ -0,0 +1,364 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <quick-lint-js/buffering-error-reporter.h>
+#include <quick-lint-js/buffering-visitor.h>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/error.h>
+#include <quick-lint-js/language.h>
+#include <quick-lint-js/lex-token-stream.h>
+#include <quick-lint-js/lex.h>
+#include <quick-lint-js/location.h>
+#include <quick-lint-js/narrow-cast.h>
+#include <quick-lint-js/null-visitor.h>
+#include <quick-lint-js/padded-string.h>
+#include <quick-lint-js/parallel.h>
+#include <quick-lint-js/parse-parallel.h>
+#include <quick-lint-js/parse.h>
+#include <utility>
+#include <vector>
+
+namespace quick_lint_js {
+namespace {
+// Each worker thread task parses consecutive function bodies spanning about
+// this many bytes. Bigger tasks need fewer parsers and less synchronization.
+// Smaller tasks spread work across threads more evenly.
+constexpr std::uint32_t task_size = 64 * 1024;
+
+// The chunk_size given to token_stream::lex_in_parallel.
+constexpr int lex_chunk_size = 64 * 1024;
+
+// Records a function body's visits and errors into a parsed_function_body,
+// keeping the order between visits and errors.
+class parsed_function_body_recorder final : public error_reporter {
+ public:
+  void begin_body(parsed_function_body *body) {
+    this->body_ = body;
+    this->body_->chunks.emplace_back();
+  }
+
+  void visit_end_of_module() { this->visits().visit_end_of_module(); }
+
+  void visit_enter_block_scope() { this->visits().visit_enter_block_scope(); }
+
+  void visit_enter_class_scope() { this->visits().visit_enter_class_scope(); }
+
+  void visit_enter_for_scope() { this->visits().visit_enter_for_scope(); }
+
+  void visit_enter_function_scope() {
+    this->visits().visit_enter_function_scope();
+  }
+
+  void visit_enter_function_scope_body() {
+    this->visits().visit_enter_function_scope_body();
+  }
+
+  void visit_enter_named_function_scope(identifier name) {
+    this->visits().visit_enter_named_function_scope(name);
+  }
+
+  void visit_exit_block_scope() { this->visits().visit_exit_block_scope(); }
+
+  void visit_exit_class_scope() { this->visits().visit_exit_class_scope(); }
+
+  void visit_exit_for_scope() { this->visits().visit_exit_for_scope(); }
+
+  void visit_exit_function_scope() {
+    this->visits().visit_exit_function_scope();
+  }
+
+  void visit_property_declaration(identifier name) {
+    this->visits().visit_property_declaration(name);
+  }
+
+  void visit_variable_assignment(identifier name) {
+    this->visits().visit_variable_assignment(name);
+  }
+
+  void visit_variable_declaration(identifier name, variable_kind kind) {
+    this->visits().visit_variable_declaration(name, kind);
+  }
+
+  void visit_variable_typeof_use(identifier name) {
+    this->visits().visit_variable_typeof_use(name);
+  }
+
+  void visit_variable_use(identifier name) {
+    this->visits().visit_variable_use(name);
+  }
+
+#define QLJS_ERROR_TYPE(name, struct_body, format) \
+  void report(name e) override { this->body_->chunks.back().errors.report(e); }
+  QLJS_X_ERROR_TYPES
+#undef QLJS_ERROR_TYPE
+
+  // The body is dropped after a fatal error, and the main thread parses the
+  // body itself. The main thread reports the fatal error in order, after the
+  // errors before it.
+  void report_fatal_error_unimplemented_character(const char *, int,
+                                                  const char *,
+                                                  const char8 *) override {}
+  void report_fatal_error_unimplemented_token(const char *, int, const char *,
+                                              token_type,
+                                              const char8 *) override {}
+
+ private:
+  // Start a new chunk if errors were reported since the last visit.
+  buffering_visitor &visits() {
+    if (!this->body_->chunks.back().errors.empty()) {
+      this->body_->chunks.emplace_back();
+    }
+    return this->body_->chunks.back().visits;
+  }
+
+  parsed_function_body *body_ = nullptr;
+};
+
+// The offsets of a function body's '{' and '}' tokens.
+struct function_body_offsets {
+  std::uint32_t left_curly_begin;
+  std::uint32_t right_curly_end;
+};
+
+// Find the bodies of functions which are not inside other functions.
+//
+// A '{' begins a function body if it follows '=>' or if it follows the ')' of a
+// parameter list. A '(' begins a parameter list if it follows 'function',
+// 'function*', or an identifier. This mistakes a call followed by a block
+// statement ('f(x)\n{ g(); }') for a function. The mistake is harmless: the
+// block's statements are parsed the same way either way, and the parser never
+// asks for the "function"'s body.
+//
+// token_stream guesses whether each '/' begins a regular expression. After a
+// ')' which closes an 'if (...)'-like condition and after a '}', the guess is
+// unreliable, and so are the tokens after it. Stop looking for bodies there.
+std::vector<function_body_offsets> find_function_bodies(
+    const token_stream &tokens) {
+  enum class paren_kind : std::uint8_t {
+    condition,
+    parameter_list,
+    other,
+  };
+
+  std::vector<function_body_offsets> bodies;
+  std::vector<paren_kind> parens;
+  // For each unclosed '{' and template substitution, whether it begins a
+  // function body.
+  std::vector<bool> curly_is_function_body;
+  int function_body_depth = 0;
+  std::uint32_t function_body_begin = 0;
+  paren_kind last_closed_paren = paren_kind::other;
+  // The parens.size() at the 'class' keyword whose body has not begun yet, if
+  // any. The body's '{' might follow a ')', as in 'class C extends f(x) {}'.
+  std::optional<std::size_t> class_paren_depth = std::nullopt;
+
+  token_type previous_type = token_type::semicolon;
+  token_type previous_previous_type = token_type::semicolon;
+  for (int i = 0; i < tokens.size(); ++i) {
+    token_type type = tokens.type(i);
+    switch (type) {
+    case token_type::kw_class:
+      class_paren_depth = parens.size();
+      break;
+
+    case token_type::left_paren:
+      switch (previous_type) {
+      case token_type::kw_for:
+      case token_type::kw_if:
+      case token_type::kw_while:
+      case token_type::kw_with:
+        parens.push_back(paren_kind::condition);
+        break;
+      case token_type::identifier:
+      case token_type::kw_function:
+        parens.push_back(paren_kind::parameter_list);
+        break;
+      case token_type::star:
+        parens.push_back(previous_previous_type == token_type::kw_function
+                             ? paren_kind::parameter_list
+                             : paren_kind::other);
+        break;
+      default:
+        parens.push_back(paren_kind::other);
+        break;
+      }
+      break;
+
+    case token_type::right_paren:
+      if (parens.empty()) {
+        return bodies;
+      }
+      last_closed_paren = parens.back();
+      parens.pop_back();
+      break;
+
+    case token_type::incomplete_template:
+      curly_is_function_body.push_back(false);
+      break;
+
+    case token_type::left_curly: {
+      bool is_function_body =
+          previous_type == token_type::equal_greater ||
+          (previous_type == token_type::right_paren &&
+           last_closed_paren == paren_kind::parameter_list);
+      if (class_paren_depth == parens.size()) {
+        is_function_body = false;
+        class_paren_depth = std::nullopt;
+      }
+      if (is_function_body) {
+        if (function_body_depth == 0) {
+          function_body_begin = tokens.begin_offset(i);
+        }
+        function_body_depth += 1;
+      }
+      curly_is_function_body.push_back(is_function_body);
+      break;
+    }
+
+    case token_type::right_curly:
+      if (curly_is_function_body.empty()) {
+        return bodies;
+      }
+      if (curly_is_function_body.back()) {
+        function_body_depth -= 1;
+        if (function_body_depth == 0) {
+          bodies.push_back(function_body_offsets{
+              .left_curly_begin = function_body_begin,
+              .right_curly_end = tokens.end_offset(i),
+          });
+        }
+      }
+      curly_is_function_body.pop_back();
+      break;
+
+    case token_type::slash:
+    case token_type::slash_equal:
+      if (previous_type == token_type::right_curly ||
+          (previous_type == token_type::right_paren &&
+           last_closed_paren == paren_kind::condition)) {
+        return bodies;
+      }
+      break;
+
+    default:
+      break;
+    }
+    previous_previous_type = previous_type;
+    previous_type = type;
+  }
+  return bodies;
+}
+}
+
+std::vector<parsed_function_body> parse_function_bodies_in_parallel(
+    padded_string_view input, int thread_count) {
+  std::ptrdiff_t input_size = input.null_terminator() - input.data();
+
+  // NOTE(strager): Find the bodies in a copy of the input. Lexing might rewrite
+  // identifiers containing escape sequences, and the real input must not be
+  // rewritten before the parser which reports errors for those identifiers
+  // sees it.
+  std::vector<function_body_offsets> body_offsets;
+  {
+    padded_string scan_input(
+        string8(input.data(), narrow_cast<std::size_t>(input_size)));
+    token_stream tokens = token_stream::lex_in_parallel(
+        &scan_input, &null_error_reporter::instance, thread_count,
+        /*chunk_size=*/lex_chunk_size);
+    body_offsets = find_function_bodies(tokens);
+  }
+
+  // task_begins[i] is the index in body_offsets of task i's first body.
+  std::vector<std::size_t> task_begins;
+  for (std::size_t i = 0; i < body_offsets.size(); ++i) {
+    if (task_begins.empty() ||
+        body_offsets[i].right_curly_end -
+                body_offsets[task_begins.back()].left_curly_begin >=
+            task_size) {
+      task_begins.push_back(i);
+    }
+  }
+  task_begins.push_back(body_offsets.size());
+
+  std::vector<parsed_function_body> bodies;
+  bodies.reserve(body_offsets.size());
+  for_each_in_parallel_in_order<std::vector<parsed_function_body>>(
+      /*item_count=*/narrow_cast<int>(task_begins.size() - 1),
+      /*thread_count=*/thread_count,
+      /*produce=*/
+      [&](int task) -> std::vector<parsed_function_body> {
+        std::size_t begin = task_begins[narrow_cast<std::size_t>(task)];
+        std::size_t end = task_begins[narrow_cast<std::size_t>(task) + 1];
+        std::vector<parsed_function_body> task_bodies;
+        task_bodies.reserve(end - begin);
+
+        parsed_function_body_recorder recorder;
+        std::optional<parser> p;
+        // NOTE(strager): Start lexing at a body's '{'. Several threads lex
+        // the input at the same time, so the lexer must not rewrite
+        // identifiers in the input (see lexer::set_read_only_input). Bodies
+        // which need rewrites are dropped, and the main thread parses them
+        // itself. (parse_and_visit_function_body_at doesn't lex past the
+        // body's '}', so lexing the '{' token here is safe.)
+        auto make_parser = [&](char8 *left_curly) -> void {
+          p.emplace(padded_string_view(
+                        left_curly, narrow_cast<int>(input.null_terminator() -
+                                                     left_curly)),
+                    &recorder, lexer_strategy::direct);
+          p->lexer().set_read_only_input(true);
+        };
+        make_parser(input.data() + body_offsets[begin].left_curly_begin);
+        for (std::size_t i = begin; i < end; ++i) {
+          char8 *left_curly = input.data() + body_offsets[i].left_curly_begin;
+          parsed_function_body &body =
+              task_bodies.emplace_back(parsed_function_body{
+                  .span = source_code_span(left_curly, left_curly),
+                  .chunks = {},
+              });
+          recorder.begin_body(&body);
+          const char8 *right_curly_end = nullptr;
+          bool ok = catch_fatal_parse_errors([&]() -> void {
+            // NOTE(strager): The body might not end where find_function_bodies
+            // thinks it does, so ask the parser.
+            right_curly_end =
+                p->parse_and_visit_function_body_at(left_curly, recorder);
+          });
+          if (!ok) {
+            // The parser hit unimplemented syntax or an identifier which needs
+            // rewriting. Let the main thread parse this body, and start over
+            // with a fresh parser.
+            task_bodies.pop_back();
+            if (i + 1 < end) {
+              make_parser(input.data() + body_offsets[i + 1].left_curly_begin);
+            }
+            continue;
+          }
+          body.span = source_code_span(left_curly, right_curly_end);
+        }
+        return task_bodies;
+      },
+      /*consume=*/
+      [&](int, std::vector<parsed_function_body> &&task_bodies) -> void {
+        for (parsed_function_body &body : task_bodies) {
+          bodies.emplace_back(std::move(body));
+        }
+      });
+  return bodies;
+}
+}
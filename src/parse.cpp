@@ -21,10 +21,13 @@
 #include <quick-lint-js/assert.h>
 #include <quick-lint-js/buffering-visitor.h>
 #include <quick-lint-js/char8.h>
+#include <quick-lint-js/error.h>
 #include <quick-lint-js/lex.h>
 #include <quick-lint-js/parse.h>
 #include <quick-lint-js/vector.h>
 #include <quick-lint-js/warning.h>
+#include <utility>
+#include <vector>
 
 // parser is a recursive-descent parser.
 //
@@ -613,7 +616,7 @@ expression_ptr parser::parse_arrow_function_body(
     Args &&... args) {
   if (this->peek().type == token_type::left_curly) {
     buffering_visitor *v = this->expressions_.make_buffering_visitor();
-    this->parse_and_visit_statement_block_no_scope(*v);
+    this->parse_and_visit_function_body(*v);
     const char8 *span_end = this->lexer_.end_of_previous_token();
     return this->make_expression<expression::arrow_function_with_statements>(
         attributes, std::forward<Args>(args)..., v, parameter_list_begin,
@@ -901,6 +904,141 @@ void parser::consume_semicolon() {
   }
 }
 
+bool parser::skip_function_body() {
+  QLJS_ASSERT(this->peek().type == token_type::left_curly);
+  const char8 *body_begin = this->peek().begin;
+
+  struct template_substitution {
+    const char8 *template_begin;
+    // The number of unclosed '{' tokens inside the substitution.
+    int curly_depth;
+  };
+  std::vector<template_substitution> substitutions;
+  // For each unclosed '(', whether the '(' follows 'if', 'for', 'while', or
+  // 'with'. A '/' after the matching ')' probably begins a regular expression.
+  std::vector<bool> paren_is_condition;
+  // The number of unclosed '{' tokens outside template substitutions.
+  int curly_depth = 0;
+  token_type previous_type = token_type::left_curly;
+  bool continues_template = false;
+
+  // Errors inside the body are reported when the body is parsed. Parsing the
+  // body needs the original bytes of identifiers the lexer rewrites (e.g. to
+  // report escape sequences in keywords), so undo the rewrites.
+  error_reporter *old_error_reporter =
+      this->lexer_.exchange_error_reporter(&null_error_reporter::instance);
+  this->lexer_.remember_rewritten_identifiers();
+  auto stop_skipping = [&]() -> void {
+    this->lexer_.restore_rewritten_identifiers();
+    this->lexer_.exchange_error_reporter(old_error_reporter);
+  };
+  auto give_up = [&]() -> bool {
+    stop_skipping();
+    this->lexer_.seek(body_begin);
+    return false;
+  };
+
+  for (;;) {
+    const token &t = this->peek();
+    token_type type = t.type;
+    bool previous_ends_expression = ends_expression(type);
+    // Whether a '/' after this token might begin either a division or a
+    // regular expression, depending on how the code would be parsed.
+    bool slash_is_ambiguous = false;
+    switch (type) {
+    case token_type::end_of_file:
+      return give_up();
+
+    case token_type::identifier:
+      if (t.normalized_identifier_end != t.end) {
+        // The lexer rewrote the identifier's escape sequences. Be
+        // conservative and parse the body now.
+        return give_up();
+      }
+      break;
+
+    case token_type::incomplete_template:
+      if (!continues_template) {
+        substitutions.push_back(
+            template_substitution{.template_begin = t.begin, .curly_depth = 0});
+      }
+      break;
+
+    case token_type::left_curly:
+      if (substitutions.empty()) {
+        curly_depth += 1;
+      } else {
+        substitutions.back().curly_depth += 1;
+      }
+      break;
+
+    case token_type::left_paren:
+      paren_is_condition.push_back(previous_type == token_type::kw_for ||
+                                   previous_type == token_type::kw_if ||
+                                   previous_type == token_type::kw_while ||
+                                   previous_type == token_type::kw_with);
+      break;
+
+    case token_type::right_paren:
+      if (!paren_is_condition.empty()) {
+        slash_is_ambiguous = paren_is_condition.back();
+        paren_is_condition.pop_back();
+      }
+      break;
+
+    case token_type::right_curly:
+      if (!substitutions.empty()) {
+        template_substitution &s = substitutions.back();
+        if (s.curly_depth == 0) {
+          this->lexer_.skip_in_template(s.template_begin);
+          if (this->peek().type == token_type::complete_template) {
+            substitutions.pop_back();
+          }
+          continues_template = true;
+          continue;
+        }
+        s.curly_depth -= 1;
+        break;
+      }
+      curly_depth -= 1;
+      if (curly_depth == 0) {
+        stop_skipping();
+        this->skip();
+        this->skipped_function_bodies_.push_back(skipped_function_body{
+            .span = source_code_span(body_begin,
+                                     this->lexer_.end_of_previous_token()),
+        });
+        return true;
+      }
+      // The '}' might end a block ('{} /re/') or an object literal
+      // ('({} / 2)').
+      slash_is_ambiguous = true;
+      break;
+
+    default:
+      break;
+    }
+    previous_type = type;
+    continues_template = false;
+    this->skip();
+
+    switch (this->peek().type) {
+    case token_type::slash:
+    case token_type::slash_equal:
+      if (slash_is_ambiguous) {
+        // Guessing wrong could make us miss the body's '}'.
+        return give_up();
+      }
+      if (!previous_ends_expression) {
+        this->lexer_.reparse_as_regexp();
+      }
+      break;
+    default:
+      break;
+    }
+  }
+}
+
 void parser::crash_on_unimplemented_token(const char *qljs_file_name,
                                           int qljs_line,
                                           const char *qljs_function_name) {
@@ -910,7 +1048,7 @@ void parser::crash_on_unimplemented_token(const char *qljs_file_name,
       /*qljs_function_name=*/qljs_function_name,
       /*type=*/this->peek().type,
       /*token_begin=*/this->peek().begin);
-  QLJS_CRASH_DISALLOWING_CORE_DUMP();
+  stop_after_fatal_error();
 }
 
 namespace {
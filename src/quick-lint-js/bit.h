@@ -38,6 +38,23 @@ inline int countr_zero(std::uint32_t x) noexcept {
 #endif
 }
 
+inline int countr_zero(std::uint64_t x) noexcept {
+#if defined(__GNUC__)
+  if (x == 0) {
+    return 64;
+  }
+  return __builtin_ctzll(x);
+#else
+  std::uint64_t i;
+  for (i = 0; i < 64; ++i) {
+    if ((x & (std::uint64_t(1) << i)) != 0) {
+      break;
+    }
+  }
+  return static_cast<int>(i);
+#endif
+}
+
 // TODO(strager): Use std::countr_one if available.
 inline int countr_one(std::uint32_t x) noexcept {
 #if defined(__GNUC__)
@@ -52,6 +69,8 @@ inline int countr_one(std::uint32_t x) noexcept {
   return i;
 #endif
 }
+
+inline int countr_one(std::uint64_t x) noexcept { return countr_zero(~x); }
 }
 
 #endif
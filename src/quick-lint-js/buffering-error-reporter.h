@@ -0,0 +1,73 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef QUICK_LINT_JS_BUFFERING_ERROR_REPORTER_H
+#define QUICK_LINT_JS_BUFFERING_ERROR_REPORTER_H
+
+#include <optional>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/error.h>
+#include <quick-lint-js/lex.h>
+#include <quick-lint-js/location.h>
+#include <quick-lint-js/padded-string.h>
+#include <variant>
+#include <vector>
+
+namespace quick_lint_js {
+// A buffering_error_reporter remembers reported errors so they can be given to
+// another error_reporter later (with move_into).
+//
+// Reported errors refer to the linted source code. Keep the source code alive
+// until move_into is called.
+//
+// Fatal errors are written to std::cerr immediately, because the caller
+// crashes after reporting a fatal error.
+class buffering_error_reporter final : public error_reporter {
+ public:
+  void set_source(padded_string_view input);
+
+#define QLJS_ERROR_TYPE(name, struct_body, format) void report(name) override;
+  QLJS_X_ERROR_TYPES
+#undef QLJS_ERROR_TYPE
+
+  void report_fatal_error_unimplemented_character(
+      const char *qljs_file_name, int qljs_line, const char *qljs_function_name,
+      const char8 *character) override;
+  void report_fatal_error_unimplemented_token(
+      const char *qljs_file_name, int qljs_line, const char *qljs_function_name,
+      token_type, const char8 *token_begin) override;
+
+  // Report all buffered errors to other, in the order they were reported to
+  // this buffering_error_reporter.
+  void move_into(error_reporter *other);
+
+  bool empty() const noexcept;
+
+ private:
+  // HACK(strager): std::monostate allows us to use QLJS_X_ERROR_TYPES. Without
+  // std::monostate, we would have a dangling leading or trailing comma.
+  using error = std::variant<std::monostate
+#define QLJS_ERROR_TYPE(name, struct_body, format_call) , name
+                                 QLJS_X_ERROR_TYPES
+#undef QLJS_ERROR_TYPE
+                             >;
+
+  std::vector<error> errors_;
+  std::optional<locator> locator_;
+};
+}
+
+#endif
@@ -17,8 +17,16 @@
 #ifndef QUICK_LINT_JS_BUFFERING_VISITOR_H
 #define QUICK_LINT_JS_BUFFERING_VISITOR_H
 
+#include <array>
+#include <boost/container/pmr/memory_resource.hpp>
+#include <boost/container/pmr/polymorphic_allocator.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <quick-lint-js/char8.h>
 #include <quick-lint-js/language.h>
 #include <quick-lint-js/lex.h>
+#include <quick-lint-js/location.h>
 #include <quick-lint-js/parse-visitor.h>
 #include <quick-lint-js/warning.h>
 #include <utility>
@@ -28,12 +36,45 @@ QLJS_WARNING_PUSH
 QLJS_WARNING_IGNORE_MSVC(26495)  // Variable is uninitialized.
 
 namespace quick_lint_js {
+// A buffering_visitor records visits so they can be replayed later into
+// another visitor with move_into.
+//
+// Visits are stored in a compact byte encoding. Each visit is a one-byte
+// opcode in opcodes_. Visits with an identifier also store the identifier in
+// payloads_, followed by a variable_kind byte for visit_variable_declaration.
+// Keeping opcodes separate lets move_into find each visit's payload without
+// decoding the previous payload.
+//
+// An identifier is usually stored as two 32-bit integers: the offset of its
+// beginning relative to the first identifier this visitor recorded, and its
+// size. If its normalized size differs from its size, the normalized size is
+// stored too. If the offset does not fit in 32 bits (e.g. because the
+// identifiers come from different strings), the identifier's pointers are
+// stored in full instead.
 class buffering_visitor {
  public:
+  // Allocate visits on the heap.
+  explicit buffering_visitor() = default;
+
+  // Allocate visits from the given memory resource, which must outlive this
+  // buffering_visitor.
+  explicit buffering_visitor(boost::container::pmr::memory_resource *memory)
+      : opcodes_(byte_allocator(memory)), payloads_(byte_allocator(memory)) {}
+
+  // Forget all buffered visits. Allocated memory is kept for reuse.
+  void clear() noexcept {
+    this->opcodes_.clear();
+    this->payloads_.clear();
+    this->identifier_base_ = nullptr;
+  }
+
   template <QLJS_PARSE_VISITOR Visitor>
   void move_into(Visitor &target) {
-    for (auto &v : this->visits_) {
-      switch (v.kind) {
+    const std::uint8_t *payload = this->payloads_.data();
+    for (std::uint8_t opcode : this->opcodes_) {
+      const std::uint8_t *p = payload;
+      payload += payload_sizes[opcode];
+      switch (static_cast<visit_kind>(opcode & opcode_kind_mask)) {
       case visit_kind::end_of_module:
         target.visit_end_of_module();
         break;
@@ -53,7 +94,8 @@ class buffering_visitor {
         target.visit_enter_function_scope_body();
         break;
       case visit_kind::enter_named_function_scope:
-        target.visit_enter_named_function_scope(v.name);
+        target.visit_enter_named_function_scope(
+            this->decode_identifier(opcode, p));
         break;
       case visit_kind::exit_block_scope:
         target.visit_exit_block_scope();
@@ -68,90 +110,89 @@ class buffering_visitor {
         target.visit_exit_function_scope();
         break;
       case visit_kind::property_declaration:
-        target.visit_property_declaration(v.name);
+        target.visit_property_declaration(this->decode_identifier(opcode, p));
         break;
       case visit_kind::variable_assignment:
-        target.visit_variable_assignment(v.name);
+        target.visit_variable_assignment(this->decode_identifier(opcode, p));
         break;
       case visit_kind::variable_use:
-        target.visit_variable_use(v.name);
+        target.visit_variable_use(this->decode_identifier(opcode, p));
         break;
       case visit_kind::variable_typeof_use:
-        target.visit_variable_typeof_use(v.name);
+        target.visit_variable_typeof_use(this->decode_identifier(opcode, p));
         break;
       case visit_kind::variable_declaration:
-        target.visit_variable_declaration(v.name, v.var_kind);
+        // The variable_kind is the payload's last byte.
+        target.visit_variable_declaration(
+            this->decode_identifier(opcode, p),
+            static_cast<variable_kind>(payload[-1]));
         break;
       }
     }
   }
 
-  void visit_end_of_module() {
-    this->visits_.emplace_back(visit_kind::end_of_module);
-  }
+  void visit_end_of_module() { this->append(visit_kind::end_of_module); }
 
   void visit_enter_block_scope() {
-    this->visits_.emplace_back(visit_kind::enter_block_scope);
+    this->append(visit_kind::enter_block_scope);
   }
 
   void visit_enter_class_scope() {
-    this->visits_.emplace_back(visit_kind::enter_class_scope);
+    this->append(visit_kind::enter_class_scope);
   }
 
-  void visit_enter_for_scope() {
-    this->visits_.emplace_back(visit_kind::enter_for_scope);
-  }
+  void visit_enter_for_scope() { this->append(visit_kind::enter_for_scope); }
 
   void visit_enter_function_scope() {
-    this->visits_.emplace_back(visit_kind::enter_function_scope);
+    this->append(visit_kind::enter_function_scope);
   }
 
   void visit_enter_function_scope_body() {
-    this->visits_.emplace_back(visit_kind::enter_function_scope_body);
+    this->append(visit_kind::enter_function_scope_body);
   }
 
   void visit_enter_named_function_scope(identifier name) {
-    this->visits_.emplace_back(visit_kind::enter_named_function_scope, name);
+    this->append(visit_kind::enter_named_function_scope, name);
   }
 
-  void visit_exit_block_scope() {
-    this->visits_.emplace_back(visit_kind::exit_block_scope);
-  }
+  void visit_exit_block_scope() { this->append(visit_kind::exit_block_scope); }
 
-  void visit_exit_class_scope() {
-    this->visits_.emplace_back(visit_kind::exit_class_scope);
-  }
+  void visit_exit_class_scope() { this->append(visit_kind::exit_class_scope); }
 
-  void visit_exit_for_scope() {
-    this->visits_.emplace_back(visit_kind::exit_for_scope);
-  }
+  void visit_exit_for_scope() { this->append(visit_kind::exit_for_scope); }
 
   void visit_exit_function_scope() {
-    this->visits_.emplace_back(visit_kind::exit_function_scope);
+    this->append(visit_kind::exit_function_scope);
   }
 
   void visit_property_declaration(identifier name) {
-    this->visits_.emplace_back(visit_kind::property_declaration, name);
+    this->append(visit_kind::property_declaration, name);
   }
 
   void visit_variable_assignment(identifier name) {
-    this->visits_.emplace_back(visit_kind::variable_assignment, name);
+    this->append(visit_kind::variable_assignment, name);
   }
 
   void visit_variable_declaration(identifier name, variable_kind kind) {
-    this->visits_.emplace_back(visit_kind::variable_declaration, name, kind);
+    this->append(visit_kind::variable_declaration, name);
+    *grow(this->payloads_, 1) = static_cast<std::uint8_t>(kind);
   }
 
   void visit_variable_use(identifier name) {
-    this->visits_.emplace_back(visit_kind::variable_use, name);
+    this->append(visit_kind::variable_use, name);
   }
 
   void visit_variable_typeof_use(identifier name) {
-    this->visits_.emplace_back(visit_kind::variable_typeof_use, name);
+    this->append(visit_kind::variable_typeof_use, name);
+  }
+
+  // The number of bytes used to store the buffered visits.
+  std::size_t encoded_size() const noexcept {
+    return this->opcodes_.size() + this->payloads_.size();
   }
 
  private:
-  enum class visit_kind {
+  enum class visit_kind : std::uint8_t {
     end_of_module,
     enter_block_scope,
     enter_class_scope,
@@ -170,34 +211,165 @@ class buffering_visitor {
     variable_declaration,
   };
 
-  struct visit {
-    explicit visit(visit_kind kind) noexcept : kind(kind) {}
+  // Opcode layout:
+  //
+  // * Bits 0-4: visit_kind
+  // * Bit 5 (opcode_escaped_identifier_bit): the identifier's normalized size
+  //   differs from its size and is stored separately
+  // * Bit 6 (opcode_wide_identifier_bit): the identifier is stored as three
+  //   pointers instead of 32-bit integers
+  static constexpr std::uint8_t opcode_kind_mask = 0x1f;
+  static constexpr std::uint8_t opcode_escaped_identifier_bit = 0x20;
+  static constexpr std::uint8_t opcode_wide_identifier_bit = 0x40;
 
-    explicit visit(visit_kind kind, identifier name) noexcept
-        : kind(kind), name(name) {}
+  static_assert(static_cast<std::uint8_t>(visit_kind::variable_declaration) <=
+                opcode_kind_mask);
 
-    explicit visit(visit_kind kind, identifier name,
-                   variable_kind var_kind) noexcept
-        : kind(kind), name(name), var_kind(var_kind) {}
+  void append(visit_kind kind) {
+    this->opcodes_.push_back(static_cast<std::uint8_t>(kind));
+  }
+
+  void append(visit_kind kind, identifier name) {
+    const char8 *begin = name.span().begin();
+    const char8 *end = name.span().end();
+    const char8 *normalized_end = begin + name.normalized_name().size();
+    if (!this->identifier_base_) {
+      this->identifier_base_ = begin;
+    }
+    std::intptr_t offset =
+        reinterpret_cast<std::intptr_t>(begin) -
+        reinterpret_cast<std::intptr_t>(this->identifier_base_);
+    std::uint32_t size = static_cast<std::uint32_t>(end - begin);
+    std::uint32_t normalized_size =
+        static_cast<std::uint32_t>(normalized_end - begin);
 
-    visit_kind kind;
+    std::uint8_t opcode = static_cast<std::uint8_t>(kind);
+    if (offset < INT32_MIN || offset > INT32_MAX ||
+        end - begin > INT32_MAX) {
+      opcode |= opcode_wide_identifier_bit;
+      std::uint8_t *out = grow(this->payloads_, wide_identifier_size);
+      out = write(out, begin);
+      out = write(out, end);
+      write(out, normalized_end);
+    } else if (normalized_size != size) {
+      opcode |= opcode_escaped_identifier_bit;
+      std::uint8_t *out = grow(this->payloads_, escaped_identifier_size);
+      out = write(out, static_cast<std::int32_t>(offset));
+      out = write(out, size);
+      write(out, normalized_size);
+    } else {
+      std::uint8_t *out = grow(this->payloads_, identifier_size);
+      out = write(out, static_cast<std::int32_t>(offset));
+      write(out, size);
+    }
+    this->opcodes_.push_back(opcode);
+  }
 
-    union {
-      // enter_named_function_scope, property_declaration, variable_assignment,
-      // variable_declaration, variable_use
-      identifier name;
-      static_assert(std::is_trivially_destructible_v<identifier>);
-    };
+  static constexpr bool has_identifier(visit_kind kind) noexcept {
+    switch (kind) {
+    case visit_kind::enter_named_function_scope:
+    case visit_kind::property_declaration:
+    case visit_kind::variable_assignment:
+    case visit_kind::variable_use:
+    case visit_kind::variable_typeof_use:
+    case visit_kind::variable_declaration:
+      return true;
+    default:
+      return false;
+    }
+  }
 
-    union {
-      // variable_declaration
-      variable_kind var_kind;
-      static_assert(std::is_trivially_destructible_v<variable_kind>);
-    };
-  };
+  static constexpr std::size_t identifier_size = 2 * sizeof(std::uint32_t);
+  static constexpr std::size_t escaped_identifier_size =
+      3 * sizeof(std::uint32_t);
+  static constexpr std::size_t wide_identifier_size = 3 * sizeof(const char8 *);
 
-  std::vector<visit> visits_;
+  // The number of bytes a visit uses in payloads_.
+  static constexpr std::uint8_t payload_size(std::uint8_t opcode) noexcept {
+    visit_kind kind = static_cast<visit_kind>(opcode & opcode_kind_mask);
+    std::size_t size = 0;
+    if (has_identifier(kind)) {
+      if (opcode & opcode_wide_identifier_bit) {
+        size += wide_identifier_size;
+      } else if (opcode & opcode_escaped_identifier_bit) {
+        size += escaped_identifier_size;
+      } else {
+        size += identifier_size;
+      }
+    }
+    if (kind == visit_kind::variable_declaration) {
+      size += 1;
+    }
+    return static_cast<std::uint8_t>(size);
+  }
+
+  static constexpr std::array<std::uint8_t, 256> make_payload_sizes() noexcept {
+    std::array<std::uint8_t, 256> sizes{};
+    for (std::size_t opcode = 0; opcode < sizes.size(); ++opcode) {
+      sizes[opcode] = payload_size(static_cast<std::uint8_t>(opcode));
+    }
+    return sizes;
+  }
+
+  // payload_sizes[opcode] == payload_size(opcode).
+  static const std::array<std::uint8_t, 256> payload_sizes;
+
+  identifier decode_identifier(std::uint8_t opcode,
+                               const std::uint8_t *p) const noexcept {
+    if (opcode & opcode_wide_identifier_bit) {
+      const char8 *begin = read<const char8 *>(p);
+      const char8 *end = read<const char8 *>(p);
+      const char8 *normalized_end = read<const char8 *>(p);
+      return identifier(source_code_span(begin, end), normalized_end);
+    }
+    std::int32_t offset = read<std::int32_t>(p);
+    std::uint32_t size = read<std::uint32_t>(p);
+    std::uint32_t normalized_size = (opcode & opcode_escaped_identifier_bit)
+                                        ? read<std::uint32_t>(p)
+                                        : size;
+    // NOTE(strager): Identifiers recorded by one buffering_visitor might not
+    // point into the same array, so avoid pointer arithmetic.
+    const char8 *begin = reinterpret_cast<const char8 *>(
+        reinterpret_cast<std::intptr_t>(this->identifier_base_) + offset);
+    return identifier(source_code_span(begin, begin + size),
+                      begin + normalized_size);
+  }
+
+  // Append size bytes and return a pointer to them.
+  template <class Vector>
+  static std::uint8_t *grow(Vector &bytes, std::size_t size) {
+    std::size_t old_size = bytes.size();
+    bytes.resize(old_size + size);
+    return bytes.data() + old_size;
+  }
+
+  template <class T>
+  static std::uint8_t *write(std::uint8_t *out, T value) noexcept {
+    std::memcpy(out, &value, sizeof(value));
+    return out + sizeof(value);
+  }
+
+  template <class T>
+  static T read(const std::uint8_t *&p) noexcept {
+    T value;
+    std::memcpy(&value, p, sizeof(value));
+    p += sizeof(value);
+    return value;
+  }
+
+  using byte_allocator =
+      boost::container::pmr::polymorphic_allocator<std::uint8_t>;
+
+  std::vector<std::uint8_t, byte_allocator> opcodes_;
+  std::vector<std::uint8_t, byte_allocator> payloads_;
+
+  // Identifiers' offsets are relative to this pointer. Set when the first
+  // identifier is recorded.
+  const char8 *identifier_base_ = nullptr;
 };
+
+inline constexpr std::array<std::uint8_t, 256>
+    buffering_visitor::payload_sizes = buffering_visitor::make_payload_sizes();
 }
 
 QLJS_WARNING_POP
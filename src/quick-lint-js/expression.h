@@ -27,6 +27,7 @@
 #include <quick-lint-js/buffering-visitor.h>
 #include <quick-lint-js/char8.h>
 #include <quick-lint-js/lex.h>
+#include <quick-lint-js/linked-bump-allocator.h>
 #include <quick-lint-js/location.h>
 #include <quick-lint-js/narrow-cast.h>
 #include <quick-lint-js/parse-visitor.h>
@@ -129,13 +130,39 @@ class expression_arena {
   array_ptr<T> make_array(T *begin, T *end);
 
   buffering_visitor_ptr make_buffering_visitor() {
-    // See matching 'delete' in delete_buffering_visitor.
-    return new buffering_visitor();
+    if (!this->free_buffering_visitors_.empty()) {
+      buffering_visitor_ptr visitor = this->free_buffering_visitors_.back();
+      this->free_buffering_visitors_.pop_back();
+      return visitor;
+    }
+    // NOTE(strager): buffering_visitor is not trivially destructible, but it
+    // allocates only from buffering_visitor_memory_, so never destroying it
+    // leaks nothing.
+    boost::container::pmr::polymorphic_allocator<buffering_visitor> allocator(
+        &this->buffering_visitor_memory_);
+    buffering_visitor *visitor = allocator.allocate(1);
+    return new (visitor) buffering_visitor(&this->buffering_visitor_memory_);
+  }
+
+  // Make the visitor available for reuse by make_buffering_visitor. The
+  // visitor keeps its storage for visits, so reusing it usually allocates
+  // nothing.
+  void delete_buffering_visitor(buffering_visitor_ptr visitor) {
+    visitor->clear();
+    this->free_buffering_visitors_.push_back(visitor);
   }
 
-  void delete_buffering_visitor(buffering_visitor_ptr visitor) {
-    // See matching 'new' in make_buffering_visitor.
-    delete visitor;
+  using rewind_state = linked_bump_allocator::rewind_state;
+
+  // Free all expressions made after prepare_for_rewind returned state.
+  //
+  // Buffering visitors are not affected by rewinding.
+  rewind_state prepare_for_rewind() noexcept {
+    return this->memory_.prepare_for_rewind();
+  }
+
+  void rewind(rewind_state &&state) noexcept {
+    this->memory_.rewind(std::move(state));
   }
 
  private:
@@ -157,7 +184,19 @@ class expression_arena {
     return result;
   }
 
-  boost::container::pmr::monotonic_buffer_resource memory_;
+  // Holds expressions and arrays. Rewound by the parser between statements.
+  linked_bump_allocator memory_;
+
+  // Holds buffering visitors and their visits. A buffering visitor can
+  // outlive the statement which made it (e.g. the body of a function
+  // expression is buffered while parsing the body's statements), so
+  // buffering_visitor_memory_ is never rewound.
+  boost::container::pmr::monotonic_buffer_resource buffering_visitor_memory_;
+  // Visitors given to delete_buffering_visitor, ready for reuse.
+  std::vector<
+      buffering_visitor_ptr,
+      boost::container::pmr::polymorphic_allocator<buffering_visitor_ptr>>
+      free_buffering_visitors_{&this->buffering_visitor_memory_};
 };
 
 class expression {
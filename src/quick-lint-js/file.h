@@ -14,12 +14,65 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
+#include <cstddef>
+#include <iosfwd>
+#include <quick-lint-js/char8.h>
 #include <quick-lint-js/padded-string.h>
 #include <string>
 
 namespace quick_lint_js {
+// The bytes of a file, followed by padded_string::padding_size null bytes.
+//
+// The bytes live either in a padded_string or in a private (copy-on-write)
+// memory mapping of the file. Either way, the bytes can be modified (e.g. by
+// the lexer) without modifying the file.
+class file_content {
+ public:
+  explicit file_content() noexcept;
+  explicit file_content(padded_string &&) noexcept;
+
+  // Take ownership of a memory mapping created with mmap.
+  //
+  // mapping[size] through mapping[mapping_size - 1] must be null bytes, and
+  // mapping_size - size must be at least padded_string::padding_size.
+  static file_content adopt_memory_mapping(char8 *mapping,
+                                           std::size_t mapping_size,
+                                           int size) noexcept;
+
+  file_content(const file_content &) = delete;
+  file_content &operator=(const file_content &) = delete;
+
+  file_content(file_content &&) noexcept;
+  file_content &operator=(file_content &&) noexcept;
+
+  ~file_content();
+
+  padded_string_view view() noexcept;
+  string8_view string_view() const noexcept;
+  int size() const noexcept;
+
+  bool is_memory_mapped() const noexcept { return this->mapping_ != nullptr; }
+
+  friend std::ostream &operator<<(std::ostream &, const file_content &);
+
+  friend bool operator==(string8_view, const file_content &) noexcept;
+  friend bool operator!=(string8_view, const file_content &) noexcept;
+  friend bool operator==(const file_content &, string8_view) noexcept;
+  friend bool operator!=(const file_content &, string8_view) noexcept;
+
+ private:
+  void unmap() noexcept;
+
+  // Used if mapping_ is null.
+  padded_string string_;
+
+  char8 *mapping_ = nullptr;
+  std::size_t mapping_size_ = 0;
+  int mapping_content_size_ = 0;
+};
+
 struct read_file_result {
-  padded_string content;
+  file_content content;
   std::string error;
 
   bool ok() const noexcept { return this->error.empty(); }
@@ -28,5 +81,16 @@ struct read_file_result {
   static read_file_result failure(const std::string &error);
 };
 
+enum class read_file_strategy {
+  // Pick the fastest strategy based on the file's type and size.
+  automatic,
+  // Copy the file into a padded_string with read().
+  read,
+  // Memory-map regular files if the platform supports it. Falls back to
+  // read().
+  memory_map,
+};
+
 read_file_result read_file(const char *path);
+read_file_result read_file(const char *path, read_file_strategy);
 }
@@ -79,6 +79,20 @@
 #define QLJS_HAVE_UNISTD_H 0
 #endif
 
+#if defined(QLJS_HAVE_SYS_MMAN_H) && QLJS_HAVE_SYS_MMAN_H
+#elif defined(__EMSCRIPTEN__)
+// Emscripten's mmap does not support MAP_FIXED file mappings.
+#elif defined(__has_include)
+#if __has_include(<sys/mman.h>)
+#define QLJS_HAVE_SYS_MMAN_H 1
+#endif
+#elif defined(__unix__)
+#define QLJS_HAVE_SYS_MMAN_H 1
+#endif
+#if !defined(QLJS_HAVE_SYS_MMAN_H)
+#define QLJS_HAVE_SYS_MMAN_H 0
+#endif
+
 #if !defined(QLJS_HAVE_WINDOWS_H)
 #if defined(_WIN32)
 #define QLJS_HAVE_WINDOWS_H 1
@@ -149,6 +163,14 @@
 #endif
 #endif
 
+#if !defined(QLJS_HAVE_GETRUSAGE)
+#if defined(_POSIX_VERSION) && _POSIX_VERSION >= 200112L
+#define QLJS_HAVE_GETRUSAGE 1
+#else
+#define QLJS_HAVE_GETRUSAGE 0
+#endif
+#endif
+
 #if !defined(QLJS_HAVE_UNAME)
 #if (defined(_POSIX_VERSION) && _POSIX_VERSION >= 198808L)
 #define QLJS_HAVE_UNAME 1
@@ -157,6 +179,15 @@
 #endif
 #endif
 
+#if !defined(QLJS_HAVE_UNIX_DOMAIN_SOCKETS)
+#if defined(_POSIX_VERSION) && _POSIX_VERSION >= 200112L && \
+    !defined(__EMSCRIPTEN__)
+#define QLJS_HAVE_UNIX_DOMAIN_SOCKETS 1
+#else
+#define QLJS_HAVE_UNIX_DOMAIN_SOCKETS 0
+#endif
+#endif
+
 #if !defined(QLJS_HAVE_CHARCONV_HEADER) && defined(__has_include)
 #if __has_include(<charconv>)
 #define QLJS_HAVE_CHARCONV_HEADER 1
@@ -184,6 +215,31 @@
 #endif
 #endif
 
+#if !defined(QLJS_HAVE_X86_AVX2)
+#if defined(__AVX2__)
+#define QLJS_HAVE_X86_AVX2 1
+#else
+#define QLJS_HAVE_X86_AVX2 0
+#endif
+#endif
+
+#if !defined(QLJS_HAVE_X86_AVX512BW)
+#if defined(__AVX512BW__)
+#define QLJS_HAVE_X86_AVX512BW 1
+#else
+#define QLJS_HAVE_X86_AVX512BW 0
+#endif
+#endif
+
+#if !defined(QLJS_HAVE_BUILTIN_CPU_SUPPORTS)
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define QLJS_HAVE_BUILTIN_CPU_SUPPORTS 1
+#else
+#define QLJS_HAVE_BUILTIN_CPU_SUPPORTS 0
+#endif
+#endif
+
 #if !defined(QLJS_HAVE_CHAR8_T)
 #if defined(__cpp_char8_t) && __cpp_char8_t >= 201803L
 #define QLJS_HAVE_CHAR8_T 1
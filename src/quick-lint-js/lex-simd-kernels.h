@@ -0,0 +1,253 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef QUICK_LINT_JS_LEX_SIMD_KERNELS_H
+#define QUICK_LINT_JS_LEX_SIMD_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <quick-lint-js/bit.h>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/force-inline.h>
+#include <quick-lint-js/lex-simd.h>
+#include <quick-lint-js/lex-structural-index.h>
+
+// Implementations of lex_simd_routines, generic over the vector types in
+// <quick-lint-js/simd.h>.
+//
+// Include this file only from the per-instruction-set lex-simd*.cpp files.
+// Each of those files is compiled with different code generation flags, and
+// instantiates these templates with a different vector type.
+
+namespace quick_lint_js {
+template <class CharVector>
+QLJS_FORCE_INLINE inline auto classify_ascii_identifier_characters(
+    CharVector chars) noexcept {
+  constexpr std::uint8_t upper_to_lower_mask = u8'a' - u8'A';
+  static_assert((u8'A' | upper_to_lower_mask) == u8'a');
+
+  CharVector lower_cased_characters =
+      chars | CharVector::repeated(upper_to_lower_mask);
+  auto is_alpha = (lower_cased_characters > CharVector::repeated(u8'a' - 1)) &
+                  (lower_cased_characters < CharVector::repeated(u8'z' + 1));
+  auto is_digit = (chars > CharVector::repeated(u8'0' - 1)) &
+                  (chars < CharVector::repeated(u8'9' + 1));
+  return is_alpha | is_digit |  //
+         (chars == CharVector::repeated(u8'$')) |
+         (chars == CharVector::repeated(u8'_'));
+}
+
+template <class CharVector>
+char8 *skip_ascii_identifier_characters_generic(char8 *input) noexcept {
+  for (;;) {
+    CharVector chars = CharVector::load(input);
+    int identifier_character_count =
+        classify_ascii_identifier_characters(chars).find_first_false();
+    input += identifier_character_count;
+    if (identifier_character_count != CharVector::size) {
+      return input;
+    }
+  }
+}
+
+template <class CharVector>
+QLJS_FORCE_INLINE inline auto classify_decimal_digits(
+    CharVector chars) noexcept {
+  return (chars > CharVector::repeated(u8'0' - 1)) &
+         (chars < CharVector::repeated(u8'9' + 1));
+}
+
+template <class CharVector>
+QLJS_FORCE_INLINE inline auto classify_hex_digits(CharVector chars) noexcept {
+  constexpr std::uint8_t upper_to_lower_mask = u8'a' - u8'A';
+  CharVector lower_cased_characters =
+      chars | CharVector::repeated(upper_to_lower_mask);
+  return classify_decimal_digits(chars) |
+         ((lower_cased_characters > CharVector::repeated(u8'a' - 1)) &
+          (lower_cased_characters < CharVector::repeated(u8'f' + 1)));
+}
+
+template <class CharVector>
+QLJS_FORCE_INLINE inline auto classify_binary_digits(
+    CharVector chars) noexcept {
+  return (chars == CharVector::repeated(u8'0')) |
+         (chars == CharVector::repeated(u8'1'));
+}
+
+template <class CharVector, class Classifier>
+QLJS_FORCE_INLINE inline char8 *skip_matches_generic(
+    char8 *input, Classifier &&classifier) noexcept {
+  for (;;) {
+    CharVector chars = CharVector::load(input);
+    int match_count = classifier(chars).find_first_false();
+    input += match_count;
+    if (match_count != CharVector::size) {
+      return input;
+    }
+  }
+}
+
+template <class CharVector>
+char8 *skip_decimal_digits_generic(char8 *input) noexcept {
+  return skip_matches_generic<CharVector>(input, [](CharVector chars) {
+    return classify_decimal_digits(chars);
+  });
+}
+
+template <class CharVector>
+char8 *skip_hex_digits_generic(char8 *input) noexcept {
+  return skip_matches_generic<CharVector>(
+      input, [](CharVector chars) { return classify_hex_digits(chars); });
+}
+
+template <class CharVector>
+char8 *skip_binary_digits_generic(char8 *input) noexcept {
+  return skip_matches_generic<CharVector>(input, [](CharVector chars) {
+    return classify_binary_digits(chars);
+  });
+}
+
+template <class CharVector, class Matcher>
+QLJS_FORCE_INLINE inline char8 *find_first_match_generic(
+    char8 *input, Matcher &&matcher) noexcept {
+  for (;;) {
+    CharVector chars = CharVector::load(input);
+    auto mask = matcher(chars).mask();
+    if (mask != 0) {
+      return input + countr_zero(mask);
+    }
+    input += CharVector::size;
+  }
+}
+
+template <class CharVector>
+char8 *find_block_comment_special_character_generic(char8 *input) noexcept {
+  return find_first_match_generic<CharVector>(
+      input, [](CharVector chars) {
+        return (chars == CharVector::repeated(u8'*')) |
+               (chars == CharVector::repeated(u8'\0')) |
+               (chars == CharVector::repeated(u8'\n')) |
+               (chars == CharVector::repeated(u8'\r')) |
+               (chars == CharVector::repeated(0xe2));
+      });
+}
+
+template <class CharVector>
+char8 *find_star_or_null_generic(char8 *input) noexcept {
+  return find_first_match_generic<CharVector>(
+      input, [](CharVector chars) {
+        return (chars == CharVector::repeated(u8'*')) |
+               (chars == CharVector::repeated(u8'\0'));
+      });
+}
+
+template <class CharVector>
+char8 *find_line_comment_special_character_generic(char8 *input) noexcept {
+  return find_first_match_generic<CharVector>(
+      input, [](CharVector chars) {
+        return (chars == CharVector::repeated(u8'\0')) |
+               (chars == CharVector::repeated(u8'\n')) |
+               (chars == CharVector::repeated(u8'\r')) |
+               (chars == CharVector::repeated(0xe2));
+      });
+}
+
+template <class CharVector>
+char8 *find_string_special_character_generic(char8 *input,
+                                             char8 quote) noexcept {
+  return find_first_match_generic<CharVector>(
+      input, [quote](CharVector chars) {
+        return (chars ==
+                CharVector::repeated(static_cast<std::uint8_t>(quote))) |
+               (chars == CharVector::repeated(u8'\\')) |
+               (chars == CharVector::repeated(u8'\n')) |
+               (chars == CharVector::repeated(u8'\r')) |
+               (chars == CharVector::repeated(u8'\0'));
+      });
+}
+
+template <class CharVector>
+char8 *find_template_special_character_generic(char8 *input) noexcept {
+  return find_first_match_generic<CharVector>(
+      input, [](CharVector chars) {
+        return (chars == CharVector::repeated(u8'`')) |
+               (chars == CharVector::repeated(u8'\\')) |
+               (chars == CharVector::repeated(u8'$')) |
+               (chars == CharVector::repeated(u8'\0'));
+      });
+}
+
+template <class CharVector>
+void build_structural_index_generic(const char8 *input,
+                                    std::size_t block_count,
+                                    lex_structural_index_block *out) noexcept {
+  static_assert(64 % CharVector::size == 0);
+  using block = lex_structural_index_block;
+  for (std::size_t block_index = 0; block_index < block_count;
+       ++block_index) {
+    std::uint64_t bits[block::bitmap_count] = {};
+    for (int i = 0; i < 64; i += CharVector::size) {
+      CharVector chars = CharVector::load(input + i);
+      auto is = [&](std::uint8_t c) {
+        return chars == CharVector::repeated(c);
+      };
+      auto null = is(u8'\0');
+      auto newline = is(u8'\n') | is(u8'\r');
+      auto backslash = is(u8'\\');
+      auto maybe_unicode_newline = is(0xe2);
+      auto to_bits = [&](auto mask) -> std::uint64_t {
+        return std::uint64_t(mask.mask()) << i;
+      };
+      bits[block::string] |=
+          to_bits(is(u8'"') | is(u8'\'') | backslash | newline | null);
+      bits[block::template_body] |=
+          to_bits(is(u8'`') | backslash | is(u8'$') | null);
+      bits[block::block_comment] |=
+          to_bits(is(u8'*') | newline | null | maybe_unicode_newline);
+      bits[block::line_comment] |=
+          to_bits(newline | null | maybe_unicode_newline);
+    }
+    for (int b = 0; b < block::bitmap_count; ++b) {
+      out[block_index].bits[b] = bits[b];
+    }
+    input += 64;
+  }
+}
+
+template <class CharVector>
+constexpr lex_simd_routines make_lex_simd_routines(const char *name) noexcept {
+  return lex_simd_routines{
+      .name = name,
+      .skip_ascii_identifier_characters =
+          skip_ascii_identifier_characters_generic<CharVector>,
+      .skip_decimal_digits = skip_decimal_digits_generic<CharVector>,
+      .skip_hex_digits = skip_hex_digits_generic<CharVector>,
+      .skip_binary_digits = skip_binary_digits_generic<CharVector>,
+      .find_block_comment_special_character =
+          find_block_comment_special_character_generic<CharVector>,
+      .find_star_or_null = find_star_or_null_generic<CharVector>,
+      .find_line_comment_special_character =
+          find_line_comment_special_character_generic<CharVector>,
+      .find_string_special_character =
+          find_string_special_character_generic<CharVector>,
+      .find_template_special_character =
+          find_template_special_character_generic<CharVector>,
+      .build_structural_index = build_structural_index_generic<CharVector>,
+  };
+}
+}
+
+#endif
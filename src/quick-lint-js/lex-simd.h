@@ -0,0 +1,83 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef QUICK_LINT_JS_LEX_SIMD_H
+#define QUICK_LINT_JS_LEX_SIMD_H
+
+#include <cstddef>
+#include <quick-lint-js/char8.h>
+#include <vector>
+
+namespace quick_lint_js {
+struct lex_structural_index_block;
+
+// Character-scanning loops used by the lexer, compiled once per instruction
+// set.
+//
+// Each routine may read up to 64 bytes past the returned pointer. Callers must
+// pass a pointer into a padded_string.
+struct lex_simd_routines {
+  const char *name;
+
+  // Returns a pointer to the first character which is not [A-Za-z0-9$_].
+  char8 *(*skip_ascii_identifier_characters)(char8 *) noexcept;
+
+  // Returns a pointer to the first character which is not [0-9].
+  char8 *(*skip_decimal_digits)(char8 *) noexcept;
+
+  // Returns a pointer to the first character which is not [0-9A-Fa-f].
+  char8 *(*skip_hex_digits)(char8 *) noexcept;
+
+  // Returns a pointer to the first character which is not [01].
+  char8 *(*skip_binary_digits)(char8 *) noexcept;
+
+  // Returns a pointer to the first '*', '\0', '\n', '\r', or 0xe2 (which might
+  // begin U+2028 or U+2029).
+  char8 *(*find_block_comment_special_character)(char8 *) noexcept;
+
+  // Returns a pointer to the first '*' or '\0'.
+  char8 *(*find_star_or_null)(char8 *) noexcept;
+
+  // Returns a pointer to the first '\0', '\n', '\r', or 0xe2 (which might
+  // begin U+2028 or U+2029).
+  char8 *(*find_line_comment_special_character)(char8 *) noexcept;
+
+  // Returns a pointer to the first quote, '\\', '\n', '\r', or '\0'.
+  char8 *(*find_string_special_character)(char8 *, char8 quote) noexcept;
+
+  // Returns a pointer to the first '`', '\\', '$', or '\0'.
+  char8 *(*find_template_special_character)(char8 *) noexcept;
+
+  // Classify block_count * 64 bytes starting at input. See
+  // lex_structural_index.
+  //
+  // Unlike the other routines, this routine does not read past
+  // input + block_count * 64.
+  void (*build_structural_index)(const char8 *input, std::size_t block_count,
+                                 lex_structural_index_block *out) noexcept;
+};
+
+// Returns the fastest routines supported by the running CPU.
+//
+// The choice is made once, on the first call.
+const lex_simd_routines &lex_simd() noexcept;
+
+// Returns every set of routines supported by the running CPU, slowest first.
+// Useful for testing and benchmarking.
+std::vector<const lex_simd_routines *> supported_lex_simd_routines();
+}
+
+#endif
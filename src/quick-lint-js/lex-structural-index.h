@@ -0,0 +1,102 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef QUICK_LINT_JS_LEX_STRUCTURAL_INDEX_H
+#define QUICK_LINT_JS_LEX_STRUCTURAL_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <quick-lint-js/bit.h>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/force-inline.h>
+#include <quick-lint-js/narrow-cast.h>
+#include <quick-lint-js/padded-string.h>
+#include <vector>
+
+namespace quick_lint_js {
+struct lex_simd_routines;
+
+// Bitmaps of the characters the lexer's inner loops stop at, for 64 bytes of
+// input. Bit i of each bitmap describes the i-th byte of the block.
+struct lex_structural_index_block {
+  enum bitmap {
+    // '"', '\'', '\\', '\n', '\r', '\0'
+    string,
+    // '`', '\\', '$', '\0'
+    template_body,
+    // '*', '\n', '\r', '\0', 0xe2 (which might begin U+2028 or U+2029)
+    block_comment,
+    // '\n', '\r', '\0', 0xe2 (which might begin U+2028 or U+2029)
+    line_comment,
+
+    bitmap_count,
+  };
+
+  std::uint64_t bits[bitmap_count];
+};
+
+// A structural index classifies every byte of an input up front, like stage 1
+// of simdjson. Instead of classifying bytes one at a time, the lexer's inner
+// loops ask the index for the next byte they care about.
+//
+// JavaScript cannot be tokenized without parsing (is '/' division or the
+// beginning of a regular expression?), so the index does not know where
+// tokens begin or end. It only knows which bytes are interesting in each
+// context (in a string literal, in a comment, etc.).
+//
+// The index covers the input's null terminator, and every bitmap includes the
+// null terminator, so every search stops at or before the null terminator.
+class lex_structural_index {
+ public:
+  using bitmap = lex_structural_index_block::bitmap;
+
+  explicit lex_structural_index(padded_string_view input);
+  explicit lex_structural_index(padded_string_view input,
+                                const lex_simd_routines &);
+
+  // Returns a pointer to the first byte at or after c which is in the given
+  // bitmap.
+  //
+  // c must point into the input, at or before the null terminator.
+  QLJS_FORCE_INLINE char8 *find_next(bitmap b, const char8 *c) const noexcept {
+    std::size_t offset = narrow_cast<std::size_t>(c - this->input_);
+    std::size_t block_index = offset / 64;
+    std::uint64_t bits =
+        this->blocks_[block_index].bits[b] >> (offset % 64);
+    if (bits != 0) {
+      return const_cast<char8 *>(c) + countr_zero(bits);
+    }
+    for (;;) {
+      block_index += 1;
+      bits = this->blocks_[block_index].bits[b];
+      if (bits != 0) {
+        return this->input_ + block_index * 64 + countr_zero(bits);
+      }
+    }
+  }
+
+  // Reclassify the bytes in [begin, end). Call this after modifying the
+  // input.
+  void refresh(const char8 *begin, const char8 *end) noexcept;
+
+ private:
+  char8 *input_;
+  const lex_simd_routines &routines_;
+  std::vector<lex_structural_index_block> blocks_;
+};
+}
+
+#endif
@@ -0,0 +1,120 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef QUICK_LINT_JS_LEX_TOKEN_STREAM_H
+#define QUICK_LINT_JS_LEX_TOKEN_STREAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <quick-lint-js/lex.h>
+#include <quick-lint-js/narrow-cast.h>
+#include <quick-lint-js/padded-string.h>
+#include <vector>
+
+namespace quick_lint_js {
+class error_reporter;
+struct speculative_token;
+
+// Every token of an input, lexed up front and stored as parallel arrays.
+//
+// A token takes a little over 9 bytes: a 1-byte token_type, 32-bit begin and
+// end offsets, and one bit of has_leading_newline. (A lexer's token takes 40
+// bytes on 64-bit platforms.) Tools which do not parse, such as syntax
+// highlighters, can use a token_stream instead of pulling tokens from a lexer.
+//
+// Lexing JavaScript correctly requires a parser, so token_stream guesses in
+// the two places where the parser steers the lexer:
+//
+// * '/' and '/=' begin a regular expression literal unless the previous token
+//   ends an expression (an identifier, a literal, this, super, ')', ']', '}',
+//   '++', or '--').
+// * A '}' closes a template substitution if it matches the substitution's
+//   '${'. The '}' is a right_curly token, and the rest of the template is the
+//   next token, as with lexer::skip_in_template.
+//
+// Like lexer, token_stream rewrites identifiers containing escape sequences
+// in place. Offsets always refer to the original token boundaries.
+//
+// The end_of_file token is not stored.
+class token_stream {
+ public:
+  static token_stream lex(padded_string_view input, error_reporter *);
+
+  // Like token_stream::lex, but split the input into chunks of roughly
+  // chunk_size bytes and lex the chunks on thread_count threads. Chunks begin
+  // at the beginning of a line, so an input with very long lines (such as
+  // minified code) is split into fewer chunks.
+  //
+  // A worker cannot know whether its chunk begins in code, in a string, in a
+  // comment, or in a template, so it guesses code. The calling thread then
+  // lexes from the start of the input and, whenever its token and state match
+  // a worker's token and state, adopts the worker's following tokens instead
+  // of lexing them. Where a guess was wrong (such as a chunk beginning inside
+  // a template literal or a multi-line comment), or where a worker reported
+  // errors, the calling thread lexes the tokens itself. The result is the
+  // same as token_stream::lex's, and errors are reported to error_reporter in
+  // the same order.
+  //
+  // Unlike token_stream::lex, identifiers containing escape sequences might
+  // or might not be rewritten in place.
+  static token_stream lex_in_parallel(padded_string_view input,
+                                      error_reporter *, int thread_count,
+                                      int chunk_size);
+
+  int size() const noexcept { return narrow_cast<int>(this->size_); }
+
+  token_type type(int index) const noexcept {
+    return static_cast<token_type>(
+        this->types_[narrow_cast<std::size_t>(index)]);
+  }
+
+  std::uint32_t begin_offset(int index) const noexcept {
+    return this->begin_offsets_[narrow_cast<std::size_t>(index)];
+  }
+
+  std::uint32_t end_offset(int index) const noexcept {
+    return this->end_offsets_[narrow_cast<std::size_t>(index)];
+  }
+
+  bool has_leading_newline(int index) const noexcept {
+    std::size_t i = narrow_cast<std::size_t>(index);
+    return (this->leading_newline_bits_[i / 64] >> (i % 64)) & 1;
+  }
+
+  // The number of bytes used to store the tokens (excluding unused capacity).
+  std::size_t storage_size() const noexcept;
+
+ private:
+  void add(const token &, const char8 *input_begin);
+  void add_speculative_tokens(const speculative_token *begin,
+                              const speculative_token *end);
+
+  // Resize every array so at least new_capacity tokens fit. While lexing, the
+  // arrays are larger than size_ so add does not need to check each array's
+  // capacity.
+  void grow(std::size_t new_capacity);
+  void shrink_to_size();
+
+  std::size_t size_ = 0;
+  std::vector<std::uint8_t> types_;
+  std::vector<std::uint32_t> begin_offsets_;
+  std::vector<std::uint32_t> end_offsets_;
+  // Bit (i % 64) of word (i / 64) is token i's has_leading_newline.
+  std::vector<std::uint64_t> leading_newline_bits_;
+};
+}
+
+#endif
@@ -18,11 +18,16 @@
 #define QUICK_LINT_JS_LEX_H
 
 #include <cassert>
+#include <csetjmp>
 #include <cstddef>
 #include <iosfwd>
+#include <optional>
 #include <quick-lint-js/char8.h>
+#include <quick-lint-js/lex-structural-index.h>
 #include <quick-lint-js/location.h>
 #include <quick-lint-js/padded-string.h>
+#include <quick-lint-js/vector.h>
+#include <vector>
 
 #define QLJS_CASE_KEYWORD_EXCEPT_GET_AND_SET       \
   case ::quick_lint_js::token_type::kw_as:         \
@@ -192,6 +197,13 @@ enum class token_type {
 
 std::ostream& operator<<(std::ostream&, token_type);
 
+// Whether a '/' after a token of the given type is division (rather than the
+// beginning of a regular expression literal).
+//
+// This is a guess. For example, ')' ends an expression in '(a) / b' but not in
+// 'if (a) /b/.test(c)'.
+bool ends_expression(token_type) noexcept;
+
 class identifier {
  public:
   // For tests only.
@@ -234,6 +246,15 @@ struct token {
   const char8* normalized_identifier_end;
 };
 
+enum class lexer_strategy {
+  // Pick the fastest strategy based on the input's size.
+  automatic,
+  // Classify characters as they are lexed.
+  direct,
+  // Classify all characters up front with a lex_structural_index.
+  structural_index,
+};
+
 // A lexer reads JavaScript source code one token at a time.
 //
 // A token is (roughly) either a keyword (if, function, let, etc.), an operator
@@ -244,9 +265,22 @@ struct token {
 //
 // lexer can modify the input string in some cases. For example, the identifier
 // w\u0061t is rewritten to wat (followed by padding spaces).
+// After a fatal error is reported (such as
+// error_reporter::report_fatal_error_unimplemented_character), longjmp to
+// the given jmp_buf instead of crashing. This applies to every lexer and parser
+// on the calling thread. If the jmp_buf is null, crash. Return the old jmp_buf.
+//
+// See catch_fatal_parse_errors.
+std::jmp_buf* exchange_fatal_error_jmp_buf(std::jmp_buf*) noexcept;
+
+// Crash, or longjmp to the jmp_buf given to exchange_fatal_error_jmp_buf.
+// Call this after reporting a fatal error.
+[[noreturn]] void stop_after_fatal_error();
+
 class lexer {
  public:
-  explicit lexer(padded_string_view input, error_reporter*) noexcept;
+  explicit lexer(padded_string_view input, error_reporter*);
+  explicit lexer(padded_string_view input, error_reporter*, lexer_strategy);
 
   // Return information about the current token.
   const token& peek() const noexcept { return this->last_token_; }
@@ -283,6 +317,34 @@ class lexer {
 
   void insert_semicolon();
 
+  // Forget the current token and lex the token at the given position instead.
+  //
+  // Precondition: position is the beginning of a token (or of whitespace or a
+  //               comment before a token) returned by this->peek().
+  void seek(const char8* position);
+
+  // Report future errors to the given error_reporter. Return the old
+  // error_reporter.
+  error_reporter* exchange_error_reporter(error_reporter*) noexcept;
+
+  // The lexer rewrites identifiers containing escape sequences in place (see
+  // parsed_identifier). After remember_rewritten_identifiers is called, the
+  // lexer keeps a copy of each identifier's original bytes before rewriting
+  // it.
+  //
+  // restore_rewritten_identifiers undoes the remembered rewrites and stops
+  // remembering. Tokens lexed since remember_rewritten_identifiers was called
+  // might refer to the restored bytes, so don't use them afterwards.
+  void remember_rewritten_identifiers();
+  void restore_rewritten_identifiers();
+
+  // If true, never modify the input. Instead of rewriting an identifier (see
+  // parsed_identifier), stop like after a fatal error, without reporting
+  // anything. Use this only inside catch_fatal_parse_errors.
+  //
+  // Several threads can lex the same read-only input at the same time.
+  void set_read_only_input(bool read_only) noexcept;
+
   // Do not call this after calling insert_semicolon, unless skip has been
   // called after.
   const char8* end_of_previous_token() const noexcept;
@@ -309,12 +371,16 @@ class lexer {
   // identifier.
   //
   // Invariant:
-  // if (escape_sequences.empty()) end == after;
+  // if (!escape_sequences) end == after;
   struct parsed_identifier {
     char8* end;    // End of the identifier.
     char8* after;  // Where to continue parsing.
 
-    std::vector<source_code_span> escape_sequences;
+    // The identifier's escape sequences, or nullptr if it has none.
+    //
+    // Points to lexer::escape_sequences_, so the next call to
+    // parse_identifier invalidates it.
+    const vector<source_code_span>* escape_sequences;
   };
 
   void parse_current_token();
@@ -328,15 +394,18 @@ class lexer {
   char8* check_garbage_in_number_literal(char8* input);
   void parse_number();
 
+  // skip_digits(input) returns a pointer to the first non-digit character at
+  // or after input.
   template <class Func>
-  char8* parse_digits_and_underscores(Func&& is_valid_digit,
+  char8* parse_digits_and_underscores(Func&& skip_digits,
                                       char8* input) noexcept;
 
   char8* parse_decimal_digits_and_underscores(char8* input) noexcept;
   char8* parse_hex_digits_and_underscores(char8* input) noexcept;
 
   parsed_identifier parse_identifier(char8*);
-  parsed_identifier parse_identifier_slow(char8*);
+  parsed_identifier parse_identifier_slow(char8* input,
+                                          const char8* identifier_begin);
 
   void skip_whitespace();
   void skip_block_comment();
@@ -347,10 +416,18 @@ class lexer {
   static bool is_binary_digit(char8);
   static bool is_digit(char8);
   static bool is_hex_digit(char8);
-  static bool is_identifier_character(int code_point);
+  // Returns true for ASCII identifier characters and for '\\' (which might
+  // begin an escape sequence). Returns false for non-ASCII bytes.
+  static bool is_ascii_identifier_byte(char8);
+  static bool is_initial_identifier_character(char32_t code_point);
+  static bool is_identifier_character(char32_t code_point);
 
   static int newline_character_size(const char8*);
 
+  // Returns the keyword's token_type, or token_type::identifier.
+  //
+  // The identifier must be followed by at least 16 readable bytes (e.g. the
+  // identifier is inside a padded_string).
   static token_type identifier_token_type(string8_view) noexcept;
 
   token last_token_;
@@ -358,6 +435,24 @@ class lexer {
   char8* input_;
   error_reporter* error_reporter_;
   padded_string_view original_input_;
+  std::optional<lex_structural_index> structural_index_;
+
+  // Reused by each call to parse_identifier_slow so that lexing identifiers
+  // does not allocate.
+  vector<source_code_span> escape_sequences_{"lexer::escape_sequences_"};
+  string8 normalized_identifier_;
+
+  struct rewritten_identifier {
+    char8* begin;
+    string8 original;
+  };
+
+  // See remember_rewritten_identifiers.
+  bool remember_rewritten_identifiers_ = false;
+  std::vector<rewritten_identifier> rewritten_identifiers_;
+
+  // See set_read_only_input.
+  bool read_only_input_ = false;
 };
 }
 
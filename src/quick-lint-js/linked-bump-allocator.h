@@ -0,0 +1,108 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef QUICK_LINT_JS_LINKED_BUMP_ALLOCATOR_H
+#define QUICK_LINT_JS_LINKED_BUMP_ALLOCATOR_H
+
+#include <boost/container/pmr/memory_resource.hpp>
+#include <cstddef>
+
+namespace quick_lint_js {
+// A linked_bump_allocator allocates by bumping a pointer within a chunk of
+// memory, like boost::container::pmr::monotonic_buffer_resource. Individual
+// deallocations do nothing.
+//
+// Unlike monotonic_buffer_resource, a linked_bump_allocator can rewind: free
+// everything allocated since a call to prepare_for_rewind. Rewinds must be
+// nested: rewinding to a state also discards every state prepared after it.
+//
+// Rewound chunks are kept and reused by later allocations, so code which
+// rewinds regularly (e.g. after each statement) uses about as much memory as
+// it needs between rewinds, no matter how long it runs.
+class linked_bump_allocator : public boost::container::pmr::memory_resource {
+ private:
+  struct chunk;
+
+ public:
+  class rewind_state {
+   private:
+    explicit rewind_state(chunk *c, char *next_allocation,
+                          char *chunk_end) noexcept
+        : chunk_(c), next_allocation_(next_allocation), chunk_end_(chunk_end) {}
+
+    chunk *chunk_;
+    char *next_allocation_;
+    char *chunk_end_;
+
+    friend class linked_bump_allocator;
+  };
+
+  explicit linked_bump_allocator() noexcept;
+
+  linked_bump_allocator(const linked_bump_allocator &) = delete;
+  linked_bump_allocator &operator=(const linked_bump_allocator &) = delete;
+
+  ~linked_bump_allocator() override;
+
+  rewind_state prepare_for_rewind() noexcept;
+
+  // Free everything allocated since state was prepared.
+  void rewind(rewind_state &&state) noexcept;
+
+  // Free all chunks, including chunks kept for reuse.
+  void release() noexcept;
+
+  // The number of bytes in chunks owned by this allocator, including chunks
+  // kept for reuse.
+  std::size_t reserved_size() const noexcept { return this->reserved_size_; }
+
+  static constexpr std::size_t default_chunk_size = 16 * 1024;
+
+ protected:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void *p, std::size_t bytes,
+                     std::size_t alignment) override;
+  bool do_is_equal(const boost::container::pmr::memory_resource &other) const
+      noexcept override;
+
+ private:
+  // A chunk's data immediately follows its header.
+  struct chunk {
+    chunk *previous;
+    std::size_t size;
+
+    char *begin() noexcept { return reinterpret_cast<char *>(this + 1); }
+    char *end() noexcept { return this->begin() + this->size; }
+  };
+
+  void use_new_chunk(std::size_t minimum_size);
+
+  static void free_chunks(chunk *) noexcept;
+
+  // The chunk holding next_allocation_, or nullptr if nothing has been
+  // allocated. Earlier chunks are linked through chunk::previous.
+  chunk *chunk_ = nullptr;
+  char *next_allocation_ = nullptr;
+  char *chunk_end_ = nullptr;
+
+  // Chunks freed by rewind, ready for reuse.
+  chunk *spare_chunks_ = nullptr;
+
+  std::size_t reserved_size_ = 0;
+};
+}
+
+#endif
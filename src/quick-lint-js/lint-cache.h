@@ -0,0 +1,114 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef QUICK_LINT_JS_LINT_CACHE_H
+#define QUICK_LINT_JS_LINT_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/error.h>
+#include <quick-lint-js/lex.h>
+#include <quick-lint-js/padded-string.h>
+#include <string>
+
+namespace quick_lint_js {
+// Identifies a cache entry. Two inputs have the same key if they have the
+// same content and are linted by the same version of quick-lint-js.
+//
+// Compute the key before linting the input, because the lexer modifies the
+// input.
+class lint_cache_key {
+ public:
+  explicit lint_cache_key(string8_view input) noexcept;
+
+  // 32 hexadecimal digits.
+  std::string to_string() const;
+
+  std::uint64_t hash[2];
+};
+
+// Records the errors reported for one input so they can be stored in a
+// lint_cache. Errors are also forwarded to another error_reporter.
+class lint_cache_recording_error_reporter final : public error_reporter {
+ public:
+  explicit lint_cache_recording_error_reporter(error_reporter *target,
+                                               padded_string_view input);
+
+#define QLJS_ERROR_TYPE(name, struct_body, format) void report(name) override;
+  QLJS_X_ERROR_TYPES
+#undef QLJS_ERROR_TYPE
+
+  void report_fatal_error_unimplemented_character(
+      const char *qljs_file_name, int qljs_line, const char *qljs_function_name,
+      const char8 *character) override;
+  void report_fatal_error_unimplemented_token(
+      const char *qljs_file_name, int qljs_line, const char *qljs_function_name,
+      token_type, const char8 *token_begin) override;
+
+  // The serialized errors, in the format read by lint_cache::load.
+  const string8 &entry() const noexcept { return this->entry_; }
+
+ private:
+  error_reporter *target_;
+  padded_string_view input_;
+  string8 entry_;
+};
+
+// An on-disk cache of lint results (--cache-dir).
+//
+// A cache entry records the errors reported for an input, with source
+// locations stored as offsets into the input. Loading an entry reports the
+// same errors to an error_reporter as linting would, so output is identical
+// on cache hits and misses regardless of the output format.
+//
+// The cache is best-effort: an entry which cannot be read is treated as a
+// miss, and an entry which cannot be written is not cached.
+//
+// lint_cache is thread-safe.
+class lint_cache {
+ public:
+  explicit lint_cache(const char *directory);
+
+  lint_cache(const lint_cache &) = delete;
+  lint_cache &operator=(const lint_cache &) = delete;
+
+  // If the cache has an entry for key, report its errors and return true.
+  // Otherwise, report nothing and return false.
+  //
+  // input must be the content key was computed from. load might modify input
+  // (like the lexer would).
+  bool load(const lint_cache_key &key, padded_string_view input,
+            error_reporter *);
+
+  void store(const lint_cache_key &key,
+             const lint_cache_recording_error_reporter &);
+
+  int hit_count() const noexcept { return this->hit_count_; }
+  int miss_count() const noexcept { return this->miss_count_; }
+
+ private:
+  std::string entry_path(const lint_cache_key &) const;
+
+  std::string directory_;
+  std::uint64_t temp_file_prefix_;
+  std::atomic<std::uint64_t> temp_file_counter_ = 0;
+  std::atomic<int> hit_count_ = 0;
+  std::atomic<int> miss_count_ = 0;
+};
+}
+
+#endif
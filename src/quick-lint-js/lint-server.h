@@ -0,0 +1,178 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef QUICK_LINT_JS_LINT_SERVER_H
+#define QUICK_LINT_JS_LINT_SERVER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/have.h>
+#include <quick-lint-js/options.h>
+#include <quick-lint-js/padded-string.h>
+#include <string>
+#include <vector>
+
+#if QLJS_HAVE_UNIX_DOMAIN_SOCKETS
+#include <quick-lint-js/file-handle.h>
+#endif
+
+namespace quick_lint_js {
+// quick-lint-js --server protocol
+//
+// A client connects to the server's Unix domain socket and sends requests.
+// The server answers each request with one response, in order. A connection
+// can be used for any number of requests.
+//
+// Integers are little endian. Each message starts with its size in bytes,
+// not counting the size field itself. A message's size must not exceed
+// max_lint_message_size; the server disconnects clients which send bigger
+// messages.
+//
+// Request:
+//   u32 size
+//   u8  output format (0: gnu-like; 1: vim-qflist-json)
+//   u32 file count
+//   For each file:
+//     u32 path size
+//         path bytes
+//     i32 vim buffer number (-1 if none)
+//     u32 content size (0xffffffff: the server reads the file at path)
+//         content bytes
+//
+// Response:
+//   u32 size
+//   u8  status (0: ok; 1: error)
+//       output bytes: what quick-lint-js would print for the files (if ok),
+//       or an error message (if error)
+inline constexpr std::uint32_t max_lint_message_size = 256 * 1024 * 1024;
+
+struct lint_request_file {
+  std::string path;
+  std::optional<int> vim_bufnr;
+  // If nullopt, the server reads the file at path.
+  std::optional<string8> content;
+};
+
+struct lint_request {
+  quick_lint_js::output_format output_format =
+      quick_lint_js::output_format::gnu_like;
+  std::vector<lint_request_file> files;
+};
+
+enum class lint_response_status : std::uint8_t {
+  ok = 0,
+  error = 1,
+};
+
+struct lint_response {
+  lint_response_status status;
+  string8 output;
+};
+
+// Encode a request, including its size field.
+string8 encode_lint_request(const lint_request &);
+
+// Decode a response, excluding its size field.
+std::optional<lint_response> decode_lint_response(string8_view);
+
+// Answers requests.
+//
+// A session keeps its buffers between requests, so a warmed-up session
+// allocates little memory.
+class lint_server_session {
+ public:
+  // request excludes the size field. response receives the entire response,
+  // including the size field.
+  //
+  // If a file has syntax which quick-lint-js does not implement, the request
+  // fails with lint_response_status::error and the fatal error message. The
+  // session remains usable.
+  void handle_request(string8_view request, string8 *response);
+
+ private:
+  padded_string source_;
+};
+
+#if QLJS_HAVE_UNIX_DOMAIN_SOCKETS
+// Serves lint_server_session-s over a Unix domain socket.
+class lint_socket_server {
+ public:
+  // Create and listen on the socket. Check ok() afterwards.
+  explicit lint_socket_server(const char *socket_path);
+
+  lint_socket_server(const lint_socket_server &) = delete;
+  lint_socket_server &operator=(const lint_socket_server &) = delete;
+
+  // Deletes the socket file.
+  ~lint_socket_server();
+
+  bool ok() const noexcept { return this->error_.empty(); }
+  const std::string &error() const noexcept { return this->error_; }
+
+  // Accept connections until stop() is called. Each connection is served on
+  // its own thread.
+  //
+  // After stop() is called, run() disconnects all clients and waits for
+  // their threads to finish.
+  void run();
+
+  // Make run() return. Thread-safe.
+  void stop();
+
+ private:
+  void serve_connection(posix_fd_file &&connection);
+
+  std::unique_ptr<lint_server_session> take_session();
+  void return_session(std::unique_ptr<lint_server_session> &&);
+
+  std::string socket_path_;
+  std::string error_;
+  std::optional<posix_fd_file> listener_;
+  std::optional<posix_fd_file> stop_reader_;
+  std::optional<posix_fd_file> stop_writer_;
+
+  std::mutex mutex_;
+  // Protected by mutex_:
+  std::vector<std::unique_ptr<lint_server_session>> idle_sessions_;
+  std::vector<int> connection_fds_;
+  std::condition_variable connections_finished_;
+};
+
+// Sends requests to a lint_socket_server.
+class lint_client {
+ public:
+  // Connect to the socket. Check ok() afterwards.
+  explicit lint_client(const char *socket_path);
+
+  bool ok() const noexcept { return this->error_.empty(); }
+  const std::string &error() const noexcept { return this->error_; }
+
+  // On failure, returns nullopt and sets error().
+  std::optional<lint_response> send(const lint_request &);
+
+ private:
+  std::optional<posix_fd_file> socket_;
+  std::string error_;
+  string8 buffer_;
+};
+#endif
+}
+
+#endif
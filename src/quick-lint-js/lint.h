@@ -17,10 +17,13 @@
 #ifndef QUICK_LINT_JS_LINT_H
 #define QUICK_LINT_JS_LINT_H
 
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <quick-lint-js/char8.h>
 #include <quick-lint-js/language.h>
 #include <quick-lint-js/lex.h>
+#include <quick-lint-js/symbol-table.h>
 #include <string>
 #include <vector>
 
@@ -33,7 +36,9 @@ namespace quick_lint_js {
 // * Assignments to let-declared variables before their initialization
 // * Use of undeclared variables
 //
-// The linter class implements variable lookup internally.
+// The linter class implements variable lookup internally. Each variable name
+// is interned into a per-linter symbol_table when it is visited, so lookups
+// compare symbol_id-s instead of strings.
 class linter {
  public:
   explicit linter(error_reporter *error_reporter);
@@ -63,13 +68,13 @@ class linter {
 
   struct declared_variable {
     static declared_variable make_local(
-        identifier name, variable_kind kind,
+        identifier name, symbol_id symbol, variable_kind kind,
         declared_variable_scope declaration_scope) noexcept {
-      return declared_variable(name, kind, declaration_scope);
+      return declared_variable(name, symbol, kind, declaration_scope);
     }
 
-    static declared_variable make_global(string8_view global_variable_name,
-                                         variable_kind kind) noexcept {
+    static constexpr declared_variable make_global(
+        string8_view global_variable_name, variable_kind kind) noexcept {
       return declared_variable(global_variable_name, kind);
     }
 
@@ -78,7 +83,7 @@ class linter {
       return this->declaration_;
     }
 
-    string8_view name() const noexcept {
+    constexpr string8_view name() const noexcept {
       if (this->is_global_variable()) {
         return this->global_variable_name_;
       } else {
@@ -86,36 +91,46 @@ class linter {
       }
     }
 
+    symbol_id symbol() const noexcept {
+      QLJS_ASSERT(!this->is_global_variable());
+      return this->symbol_;
+    }
+
     variable_kind kind() const noexcept { return this->kind_; }
 
     declared_variable_scope declaration_scope() const noexcept {
       return this->declaration_scope_;
     }
 
-    bool is_global_variable() const noexcept {
+    constexpr bool is_global_variable() const noexcept {
       return this->is_global_variable_;
     }
 
    private:
-    explicit declared_variable(string8_view global_variable_name,
-                               variable_kind kind) noexcept
+    constexpr explicit declared_variable(string8_view global_variable_name,
+                                         variable_kind kind) noexcept
         : kind_(kind),
           declaration_scope_(
               declared_variable_scope::declared_in_current_scope),
           is_global_variable_(true),
+          symbol_(symbol_table::invalid_symbol),
           global_variable_name_(global_variable_name) {}
 
     explicit declared_variable(
-        identifier name, variable_kind kind,
+        identifier name, symbol_id symbol, variable_kind kind,
         declared_variable_scope declaration_scope) noexcept
         : kind_(kind),
           declaration_scope_(declaration_scope),
           is_global_variable_(false),
+          symbol_(symbol),
           declaration_(name) {}
 
     variable_kind kind_;
     declared_variable_scope declaration_scope_;
     bool is_global_variable_;
+    // If is_global_variable_ is false: the interned name of declaration_.
+    // Global variables are looked up by predefined_variables_for_symbol.
+    symbol_id symbol_;
     union {
       // If is_global_variable_ is false:
       identifier declaration_;
@@ -131,13 +146,35 @@ class linter {
   };
 
   struct used_variable {
-    explicit used_variable(identifier name, used_variable_kind kind) noexcept
-        : name(name), kind(kind) {}
+    explicit used_variable(identifier name, symbol_id symbol,
+                           used_variable_kind kind) noexcept
+        : name(name), symbol(symbol), kind(kind) {}
 
     identifier name;
+    // The interned name.normalized_name().
+    symbol_id symbol;
     used_variable_kind kind;
   };
 
+  // Variables which are declared before the program starts, such as 'Array'
+  // and 'require'.
+  enum class predefined_variable_scope : unsigned char {
+    none,
+    global,  // See scopes::global_scope.
+    module,  // See scopes::module_scope.
+  };
+
+  static const declared_variable *find_predefined_variable(
+      string8_view name, std::uint64_t name_hash,
+      predefined_variable_scope) noexcept;
+
+  // The result of find_predefined_variable for one symbol, computed once when
+  // the symbol is first interned.
+  struct predefined_variables_for_symbol {
+    const declared_variable *global;
+    const declared_variable *module;
+  };
+
   // A scope tracks variable declarations and references in a lexical JavaScript
   // scope.
   //
@@ -154,14 +191,44 @@ class linter {
     std::optional<declared_variable> function_expression_declaration;
 
     const declared_variable *add_variable_declaration(identifier name,
+                                                      symbol_id symbol,
                                                       variable_kind,
                                                       declared_variable_scope);
-    void add_predefined_variable_declaration(const char8 *name, variable_kind);
 
-    const declared_variable *find_declared_variable(identifier name) const
+    // Find a variable in declared_variables. Does not look at
+    // predefined_variables; see linter::find_declared_variable.
+    const declared_variable *find_local_variable(symbol_id symbol) const
         noexcept;
 
     void clear();
+
+    // Predefined variables behave as if they were declared before
+    // declared_variables.
+    predefined_variable_scope predefined_variables =
+        predefined_variable_scope::none;
+
+   private:
+    // Scopes with at most this many declared variables are searched linearly.
+    // Most scopes are tiny, and a linear scan beats hashing for them.
+    static constexpr std::size_t max_linear_scan_size = 8;
+
+    struct index_entry {
+      symbol_id symbol;
+      // Index into declared_variables, or -1 if this entry is unused.
+      int declared_variable_index;
+    };
+
+    void add_to_index(std::size_t declared_variable_index);
+    void rebuild_index(std::size_t capacity);
+
+    // Open-addressing hash table (with linear probing) of declared_variables,
+    // keyed by symbol. symbol_id-s are dense, so the symbol is used as its own
+    // hash. Empty if declared_variables.size() <=
+    // max_linear_scan_size.
+    //
+    // If a name is declared more than once, only the first declaration is
+    // indexed.
+    std::vector<index_entry> index_;
   };
 
   // A stack of scope objects.
@@ -203,7 +270,16 @@ class linter {
     std::vector<scope> scopes_;
   };
 
-  void declare_variable(scope &, identifier name, variable_kind kind,
+  symbol_id intern(string8_view name);
+
+  // Find a variable declared in the given scope, including predefined
+  // variables.
+  const declared_variable *find_declared_variable(const scope &,
+                                                  symbol_id symbol) const
+      noexcept;
+
+  void declare_variable(scope &, identifier name, symbol_id symbol,
+                        variable_kind kind,
                         declared_variable_scope declared_scope);
   void visit_variable_use(identifier name, used_variable_kind);
 
@@ -216,12 +292,17 @@ class linter {
       const declared_variable *var, const identifier &assignment,
       bool is_assigned_before_declaration) const;
   void report_error_if_variable_declaration_conflicts_in_scope(
-      const scope &scope, identifier name, variable_kind kind,
+      const scope &scope, identifier name, symbol_id symbol, variable_kind kind,
       declared_variable_scope declaration_scope) const;
 
   scope &current_scope() noexcept { return this->scopes_.current_scope(); }
   scope &parent_scope() noexcept { return this->scopes_.parent_scope(); }
 
+  symbol_table symbols_;
+  // Indexed by symbol_id.
+  std::vector<predefined_variables_for_symbol> predefined_variables_;
+  symbol_id arguments_symbol_;
+
   scopes scopes_;
   error_reporter *error_reporter_;
 };
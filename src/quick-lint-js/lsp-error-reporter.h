@@ -0,0 +1,79 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef QUICK_LINT_JS_LSP_ERROR_REPORTER_H
+#define QUICK_LINT_JS_LSP_ERROR_REPORTER_H
+
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/error-formatter.h>
+#include <quick-lint-js/error.h>
+#include <quick-lint-js/lex.h>
+#include <quick-lint-js/location.h>
+#include <quick-lint-js/lsp-location.h>
+#include <quick-lint-js/output-stream.h>
+#include <quick-lint-js/padded-string.h>
+#include <string>
+
+namespace quick_lint_js {
+class lsp_error_formatter;
+
+// Writes a JSON array of LSP Diagnostic objects.
+//
+// A fatal error (see catch_fatal_parse_errors) is written as a Diagnostic
+// too.
+class lsp_error_reporter final : public error_reporter {
+ public:
+  explicit lsp_error_reporter(output_stream *output, padded_string_view input);
+
+  // Write the end of the JSON array.
+  void finish();
+
+#define QLJS_ERROR_TYPE(name, struct_body, format) void report(name) override;
+  QLJS_X_ERROR_TYPES
+#undef QLJS_ERROR_TYPE
+
+  void report_fatal_error_unimplemented_character(
+      const char *qljs_file_name, int qljs_line, const char *qljs_function_name,
+      const char8 *character) override;
+  void report_fatal_error_unimplemented_token(
+      const char *qljs_file_name, int qljs_line, const char *qljs_function_name,
+      token_type, const char8 *token_begin) override;
+
+ private:
+  void report_fatal_error(const char8 *where, std::string message);
+
+  lsp_error_formatter format();
+
+  output_stream &output_;
+  lsp_locator locator_;
+  bool need_comma_ = false;
+};
+
+class lsp_error_formatter : public error_formatter<lsp_error_formatter> {
+ public:
+  explicit lsp_error_formatter(output_stream *output, lsp_locator &);
+
+  void write_before_message(severity, const source_code_span &origin);
+  void write_message_part(severity, string8_view);
+  void write_after_message(severity, const source_code_span &origin);
+
+ private:
+  output_stream &output_;
+  lsp_locator &locator_;
+};
+}
+
+#endif
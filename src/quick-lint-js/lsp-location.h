@@ -0,0 +1,71 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef QUICK_LINT_JS_LSP_LOCATION_H
+#define QUICK_LINT_JS_LSP_LOCATION_H
+
+#include <iosfwd>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/location.h>
+#include <quick-lint-js/padded-string.h>
+#include <vector>
+
+namespace quick_lint_js {
+// A position in a document as understood by the Language Server Protocol.
+//
+// line and character are zero-based. character counts UTF-16 code units, not
+// bytes. Only "\n", "\r\n", and "\r" end lines.
+struct lsp_position {
+  int line;
+  int character;
+
+  bool operator==(const lsp_position &other) const noexcept {
+    return this->line == other.line && this->character == other.character;
+  }
+
+  bool operator!=(const lsp_position &other) const noexcept {
+    return !(*this == other);
+  }
+};
+
+std::ostream &operator<<(std::ostream &, const lsp_position &);
+
+struct lsp_range {
+  lsp_position start;
+  lsp_position end;
+};
+
+class lsp_locator {
+ public:
+  explicit lsp_locator(padded_string_view input);
+
+  lsp_range range(source_code_span) const;
+  lsp_position position(const char8 *) const noexcept;
+
+  // If position is past the end of its line, returns the end of the line. If
+  // position is past the end of the document, returns the end of the
+  // document.
+  const char8 *from_position(lsp_position) const noexcept;
+
+ private:
+  const char8 *end_of_line(int line) const noexcept;
+
+  padded_string_view input_;
+  std::vector<const char8 *> line_begins_;
+};
+}
+
+#endif
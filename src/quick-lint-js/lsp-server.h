@@ -0,0 +1,115 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef QUICK_LINT_JS_LSP_SERVER_H
+#define QUICK_LINT_JS_LSP_SERVER_H
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/padded-string.h>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Json {
+class CharReader;
+class Value;
+}
+
+namespace quick_lint_js {
+// Splits a stream of bytes from an LSP client into messages.
+//
+// Each message is a header (containing Content-Length) followed by a JSON
+// body.
+class lsp_message_parser {
+ public:
+  void append(string8_view);
+
+  // Returns the body of the next complete message, or nullopt if more data
+  // is needed. The returned view is valid until the next call to append or
+  // next_message.
+  std::optional<string8_view> next_message();
+
+ private:
+  string8 buffer_;
+  std::size_t consumed_ = 0;
+};
+
+// Implements the Language Server Protocol for quick-lint-js --lsp.
+//
+// Documents are kept in memory and updated by edits sent by the client. They
+// are never read from disk.
+class lsp_server {
+ public:
+  explicit lsp_server();
+
+  lsp_server(const lsp_server &) = delete;
+  lsp_server &operator=(const lsp_server &) = delete;
+
+  ~lsp_server();
+
+  // Handle one message from the client. Responses are appended to out as
+  // complete LSP messages (including headers).
+  void handle_message(string8_view body, string8 *out);
+
+  // Lint documents changed since the last call. Diagnostics are appended to
+  // out as textDocument/publishDiagnostics notifications.
+  //
+  // Call this after handling all available messages so that a burst of edits
+  // causes only one lint.
+  void publish_pending_diagnostics(string8 *out);
+
+  bool should_exit() const noexcept { return this->exit_requested_; }
+  // The process's exit code after an exit notification.
+  int exit_code() const noexcept { return this->shutdown_requested_ ? 0 : 1; }
+
+ private:
+  struct document {
+    padded_string text;
+    std::optional<int> version;
+    bool need_lint = true;
+  };
+
+  void handle_request(const Json::Value &request, std::string_view method,
+                      string8 *out);
+  void handle_notification(const Json::Value &notification,
+                           std::string_view method, string8 *out);
+
+  void handle_did_open(const Json::Value &params);
+  void handle_did_change(const Json::Value &params);
+  void handle_did_close(const Json::Value &params, string8 *out);
+
+  void write_response(const Json::Value &id, string8_view result_json,
+                      string8 *out);
+  void write_error_response(const Json::Value &id, int code,
+                            string8_view message, string8 *out);
+  void write_diagnostics(const std::string &uri, document *, string8 *out);
+  void write_message(string8 *out);
+
+  std::unique_ptr<Json::CharReader> json_reader_;
+  std::unordered_map<std::string, document> documents_;
+  bool shutdown_requested_ = false;
+  bool exit_requested_ = false;
+
+  // Reused between messages:
+  string8 message_body_;
+  padded_string lint_buffer_;
+};
+}
+
+#endif
@@ -34,6 +34,16 @@ struct file_to_lint {
 struct options {
   bool help = false;
   bool print_parser_visits = false;
+  bool lsp_server = false;
+  int jobs = 1;
+  // If non-null, run a lint server listening on this Unix domain socket.
+  const char *server_socket_path = nullptr;
+  // If non-null, ask the lint server listening on this Unix domain socket to
+  // lint files_to_lint.
+  const char *client_socket_path = nullptr;
+  // If non-null, cache lint results in this directory.
+  const char *cache_directory = nullptr;
+  bool print_cache_stats = false;
   quick_lint_js::output_format output_format =
       quick_lint_js::output_format::gnu_like;
   std::vector<file_to_lint> files_to_lint;
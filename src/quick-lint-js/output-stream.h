@@ -0,0 +1,129 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef QUICK_LINT_JS_OUTPUT_STREAM_H
+#define QUICK_LINT_JS_OUTPUT_STREAM_H
+
+#include <cstddef>
+#include <memory>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/have.h>
+#include <string>
+#include <string_view>
+
+namespace quick_lint_js {
+// An output_stream is a buffered sink of bytes.
+//
+// Appended bytes are collected in a large in-memory buffer. The buffer is
+// handed to the destination (see flush_impl) only when it fills up or when
+// flush() is called. Unlike std::ostream, output_stream does no locale or
+// format-flag work.
+class output_stream {
+ public:
+  static constexpr std::size_t buffer_size = 64 * 1024;
+
+  explicit output_stream();
+
+  output_stream(const output_stream &) = delete;
+  output_stream &operator=(const output_stream &) = delete;
+
+  virtual ~output_stream();
+
+  void append_copy(string8_view);
+  void append_copy(char8);
+#if QLJS_HAVE_CHAR8_T
+  void append_copy(std::string_view);
+  void append_copy(char);
+#endif
+  void append_decimal_integer(int);
+
+  // Write all buffered bytes to the destination.
+  void flush();
+
+ protected:
+  virtual void flush_impl(string8_view) = 0;
+
+ private:
+  std::unique_ptr<char8[]> buffer_;
+  std::size_t buffer_used_ = 0;
+};
+
+// Writes to a file descriptor (POSIX) or file handle (Windows).
+//
+// file_output_stream flushes itself when destroyed.
+//
+// If writing fails (e.g. because the disk is full or because the reader of a
+// pipe went away), the error is remembered and later output is discarded.
+// Check ok() after flushing.
+class file_output_stream final : public output_stream {
+ public:
+  ~file_output_stream() override;
+
+  static file_output_stream *get_stdout();
+  static file_output_stream *get_stderr();
+
+  bool ok() const noexcept { return this->error_.empty(); }
+  const std::string &error() const noexcept { return this->error_; }
+
+ protected:
+  void flush_impl(string8_view) override;
+
+ private:
+#if QLJS_HAVE_WINDOWS_H
+  using native_handle_type = void *;
+#else
+  using native_handle_type = int;
+#endif
+
+  explicit file_output_stream(native_handle_type) noexcept;
+
+  native_handle_type handle_;
+  std::string error_;
+};
+
+// Appends to a caller-owned string8.
+class string8_output_stream final : public output_stream {
+ public:
+  explicit string8_output_stream(string8 *out) noexcept;
+
+  // Flushes.
+  ~string8_output_stream() override;
+
+ protected:
+  void flush_impl(string8_view) override;
+
+ private:
+  string8 *out_;
+};
+
+// Collects output in memory. Useful for testing.
+class memory_output_stream final : public output_stream {
+ public:
+  ~memory_output_stream() override;
+
+  // Returns the bytes written so far, excluding bytes which have not been
+  // flushed.
+  string8 get_flushed_string8() const;
+
+ protected:
+  void flush_impl(string8_view) override;
+
+ private:
+  string8 data_;
+};
+}
+
+#endif
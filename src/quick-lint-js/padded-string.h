@@ -29,7 +29,9 @@ namespace quick_lint_js {
 // padded_string enables using SIMD instructions without extra bounds checking.
 class padded_string {
  public:
-  static constexpr int padding_size = 16;
+  // Large enough for one AVX-512 load (64 bytes) starting at the null
+  // terminator.
+  static constexpr int padding_size = 64;
 
   explicit padded_string();
   explicit padded_string(string8 &&);
@@ -52,6 +54,9 @@ class padded_string {
 
   void resize(int new_size);
 
+  // Replace the characters at offsets [begin, end) with replacement.
+  void replace_text(int begin, int end, string8_view replacement);
+
   char8 *begin() noexcept { return this->data(); }
   char8 *end() noexcept { return this->data() + this->size(); }
 
@@ -75,6 +80,11 @@ class padded_string_view {
   /*implicit*/ padded_string_view(padded_string *string)
       : data_(string->data()), length_(string->size()) {}
 
+  // data[length] through data[length + padded_string::padding_size - 1]
+  // must be null bytes.
+  explicit padded_string_view(char8 *data, int length) noexcept
+      : data_(data), length_(length) {}
+
   padded_string_view(const padded_string_view &) noexcept = default;
   padded_string_view &operator=(const padded_string_view &) noexcept = default;
 
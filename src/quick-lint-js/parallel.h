@@ -0,0 +1,111 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef QUICK_LINT_JS_PARALLEL_H
+#define QUICK_LINT_JS_PARALLEL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <quick-lint-js/narrow-cast.h>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace quick_lint_js {
+// Call produce(i) for each i in [0, item_count) using thread_count worker
+// threads, and call consume(i, std::move(result)) for each result on the
+// calling thread in increasing order of i.
+//
+// Workers pull the next unclaimed item from a shared counter, so a worker
+// which finishes a cheap item immediately takes more work. At most
+// max_items_in_flight results are buffered waiting to be consumed; workers
+// which get too far ahead of consume wait.
+//
+// If thread_count <= 1, produce and consume are called on the calling thread
+// without creating any threads.
+template <class Result, class ProduceFunc, class ConsumeFunc>
+void for_each_in_parallel_in_order(int item_count, int thread_count,
+                                   ProduceFunc &&produce,
+                                   ConsumeFunc &&consume) {
+  if (thread_count <= 1) {
+    for (int i = 0; i < item_count; ++i) {
+      consume(i, produce(i));
+    }
+    return;
+  }
+
+  int max_items_in_flight = thread_count * 4;
+  std::vector<std::unique_ptr<Result>> results(
+      narrow_cast<std::size_t>(item_count));
+  std::atomic<int> next_item_to_produce = 0;
+  int next_item_to_consume = 0;  // Guarded by mutex.
+  std::mutex mutex;
+  std::condition_variable result_produced;
+  std::condition_variable result_consumed;
+
+  auto work = [&]() -> void {
+    for (;;) {
+      int i = next_item_to_produce.fetch_add(1);
+      if (i >= item_count) {
+        break;
+      }
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        result_consumed.wait(lock, [&] {
+          return i < next_item_to_consume + max_items_in_flight;
+        });
+      }
+      auto result = std::make_unique<Result>(produce(i));
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        results[narrow_cast<std::size_t>(i)] = std::move(result);
+      }
+      result_produced.notify_all();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(narrow_cast<std::size_t>(thread_count));
+  for (int t = 0; t < thread_count; ++t) {
+    threads.emplace_back(work);
+  }
+
+  for (int i = 0; i < item_count; ++i) {
+    std::unique_ptr<Result> result;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      result_produced.wait(lock, [&] {
+        return results[narrow_cast<std::size_t>(i)] != nullptr;
+      });
+      result = std::move(results[narrow_cast<std::size_t>(i)]);
+    }
+    consume(i, std::move(*result));
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      next_item_to_consume = i + 1;
+    }
+    result_consumed.notify_all();
+  }
+
+  for (std::thread &t : threads) {
+    t.join();
+  }
+}
+}
+
+#endif
@@ -0,0 +1,69 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef QUICK_LINT_JS_PARSE_PARALLEL_H
+#define QUICK_LINT_JS_PARSE_PARALLEL_H
+
+#include <quick-lint-js/error.h>
+#include <quick-lint-js/padded-string.h>
+#include <quick-lint-js/parse-visitor.h>
+#include <quick-lint-js/parse.h>
+#include <vector>
+
+namespace quick_lint_js {
+// Find the bodies of functions which are not inside other functions, then
+// parse the bodies using thread_count worker threads.
+//
+// A function nested inside another function is parsed as part of the outer
+// function's body. The returned bodies are in source order. Some functions
+// might be missing, such as functions after a regular expression literal which
+// token_stream might have mistaken for division.
+//
+// Bodies which the workers can't parse are missing too, such as bodies with
+// unimplemented syntax or with escape sequences in identifiers (which the lexer
+// would rewrite in place). input is not modified.
+std::vector<parsed_function_body> parse_function_bodies_in_parallel(
+    padded_string_view input, int thread_count);
+
+// Like parser::parse_and_visit_module, but parse the bodies of functions
+// using thread_count worker threads.
+//
+// The visitor and the error_reporter are called only on the calling thread.
+// They see the same visits and errors in the same order as they would with
+// parser::parse_and_visit_module.
+//
+// The whole input is lexed twice: once with token_stream::lex_in_parallel to
+// find function bodies, and once by the parser. Code outside functions is
+// parsed on the calling thread, so this only pays off if most code is inside
+// functions which are not wrapped in a single IIFE.
+template <QLJS_PARSE_VISITOR Visitor>
+void parse_and_visit_module_in_parallel(padded_string_view input,
+                                        error_reporter *error_reporter,
+                                        Visitor &v, int thread_count) {
+  if (thread_count <= 1) {
+    parser p(input, error_reporter);
+    p.parse_and_visit_module(v);
+    return;
+  }
+  std::vector<parsed_function_body> bodies =
+      parse_function_bodies_in_parallel(input, thread_count);
+  parser p(input, error_reporter);
+  p.set_parsed_function_bodies(bodies.data(), bodies.data() + bodies.size());
+  p.parse_and_visit_module(v);
+}
+}
+
+#endif
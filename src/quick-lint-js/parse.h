@@ -17,9 +17,11 @@
 #ifndef QUICK_LINT_JS_PARSE_H
 #define QUICK_LINT_JS_PARSE_H
 
+#include <csetjmp>
 #include <cstdlib>
 #include <optional>
 #include <quick-lint-js/assert.h>
+#include <quick-lint-js/buffering-error-reporter.h>
 #include <quick-lint-js/buffering-visitor.h>
 #include <quick-lint-js/char8.h>
 #include <quick-lint-js/error.h>
@@ -30,6 +32,8 @@
 #include <quick-lint-js/null-visitor.h>
 #include <quick-lint-js/padded-string.h>
 #include <quick-lint-js/parse-visitor.h>
+#include <utility>
+#include <vector>
 
 #define QLJS_PARSER_UNIMPLEMENTED()                                   \
   do {                                                                \
@@ -44,6 +48,28 @@
   } while (false)
 
 namespace quick_lint_js {
+// A function body which the parser matched '{' and '}' for but did not parse.
+// See parser::set_skip_function_bodies.
+struct skipped_function_body {
+  // The body, including its '{' and '}'.
+  source_code_span span;
+};
+
+// The visits and errors of a function body which was parsed ahead of time,
+// such as on another thread. See parser::set_parsed_function_bodies.
+struct parsed_function_body {
+  // Visits and errors in the order they happened: all of chunks[0].visits,
+  // then all of chunks[0].errors, then all of chunks[1].visits, etc.
+  struct chunk {
+    buffering_visitor visits;
+    buffering_error_reporter errors;
+  };
+
+  // The body, including its '{' and '}'.
+  source_code_span span;
+  std::vector<chunk> chunks;
+};
+
 // A parser reads JavaScript source code and calls the member functions of a
 // parse_visitor (visit_variable_declaration, visit_enter_function_scope, etc.).
 class parser {
@@ -51,6 +77,11 @@ class parser {
   explicit parser(padded_string_view input, error_reporter *error_reporter)
       : lexer_(input, error_reporter), error_reporter_(error_reporter) {}
 
+  explicit parser(padded_string_view input, error_reporter *error_reporter,
+                  lexer_strategy strategy)
+      : lexer_(input, error_reporter, strategy),
+        error_reporter_(error_reporter) {}
+
   quick_lint_js::lexer &lexer() noexcept { return this->lexer_; }
 
   // For testing only.
@@ -58,14 +89,96 @@ class parser {
     return this->expressions_;
   }
 
+  // If skip is true, do not parse function bodies. Instead, match the body's
+  // '{' and '}' with the lexer, visit an empty body, and record the body in
+  // this->skipped_function_bodies(). Use
+  // this->parse_and_visit_skipped_function_body to parse the body later.
+  //
+  // Skipping bodies makes module-level diagnostics available sooner for big
+  // scripts. Errors inside a skipped body, including lexer errors, are not
+  // reported until the body is parsed.
+  //
+  // NOTE(strager): Only parsing is deferred. A skipped body is not linted
+  // inside its enclosing scopes; linting it correctly would need the
+  // linter's scope chain at the point where the body was skipped. For full
+  // diagnostics, parse the module again without skipping.
+  //
+  // Some bodies are parsed anyway, such as bodies containing identifiers with
+  // escape sequences and bodies with a '/' which might begin either a regular
+  // expression or a division.
+  void set_skip_function_bodies(bool skip) noexcept {
+    this->skip_function_bodies_ = skip;
+  }
+
+  const std::vector<skipped_function_body> &skipped_function_bodies() const
+      noexcept {
+    return this->skipped_function_bodies_;
+  }
+
+  // Instead of parsing the function bodies in [begin, end), give their visits
+  // to the visitor and their errors to the error_reporter. The bodies must be
+  // in source order. A body's visits and errors are moved out when the parser
+  // reaches the body. Bodies which don't begin where the parser finds a
+  // function body are ignored.
+  void set_parsed_function_bodies(parsed_function_body *begin,
+                                  parsed_function_body *end) noexcept {
+    this->next_parsed_function_body_ = begin;
+    this->parsed_function_bodies_end_ = end;
+  }
+
+  // Parse and visit the statements of the function body which begins with the
+  // '{' at left_curly. Function bodies inside it are parsed too. Return the
+  // end of the body's '}'. Code after the '}' is not lexed.
+  //
+  // Afterwards, the parser continues where it was before the call.
+  template <QLJS_PARSE_VISITOR Visitor>
+  const char8 *parse_and_visit_function_body_at(const char8 *left_curly,
+                                                Visitor &v) {
+    const char8 *resume = this->peek().begin;
+    bool skip_function_bodies = std::exchange(this->skip_function_bodies_,
+                                              /*new_value=*/false);
+    this->lexer_.seek(left_curly);
+    QLJS_PARSER_UNIMPLEMENTED_IF_NOT_TOKEN(token_type::left_curly);
+    this->parse_and_visit_statements_until_right_curly(v);
+    const char8 *end = this->peek().end;
+    this->skip_function_bodies_ = skip_function_bodies;
+    this->lexer_.seek(resume);
+    return end;
+  }
+
+  // Parse and visit the statements of a body recorded in
+  // this->skipped_function_bodies(). Function bodies inside the skipped body
+  // are parsed too.
+  //
+  // Afterwards, the parser continues where it was before the call.
+  template <QLJS_PARSE_VISITOR Visitor>
+  void parse_and_visit_skipped_function_body(const skipped_function_body &body,
+                                             Visitor &v) {
+    [[maybe_unused]] const char8 *end =
+        this->parse_and_visit_function_body_at(body.span.begin(), v);
+    QLJS_ASSERT(end == body.span.end());
+  }
+
   template <QLJS_PARSE_VISITOR Visitor>
   void parse_and_visit_module(Visitor &v) {
     while (this->peek().type != token_type::end_of_file) {
-      this->parse_and_visit_statement(v);
+      this->parse_and_visit_statement_and_free_expressions(v);
     }
     v.visit_end_of_module();
   }
 
+  // Like parse_and_visit_statement, but afterwards free the memory of the
+  // statement's expressions. Expressions are dead once their statement has
+  // been visited, so this keeps memory usage proportional to the biggest
+  // statement instead of to the whole module.
+  template <QLJS_PARSE_VISITOR Visitor>
+  void parse_and_visit_statement_and_free_expressions(Visitor &v) {
+    expression_arena::rewind_state rewind =
+        this->expressions_.prepare_for_rewind();
+    this->parse_and_visit_statement(v);
+    this->expressions_.rewind(std::move(rewind));
+  }
+
   template <QLJS_PARSE_VISITOR Visitor>
   void parse_and_visit_statement(Visitor &v) {
   parse_statement:
@@ -531,12 +644,19 @@ class parser {
 
   template <QLJS_PARSE_VISITOR Visitor>
   void parse_and_visit_statement_block_no_scope(Visitor &v) {
+    this->parse_and_visit_statements_until_right_curly(v);
+    this->skip();
+  }
+
+  // Parse a '{' and the statements after it. Stop at the matching '}' without
+  // skipping it.
+  template <QLJS_PARSE_VISITOR Visitor>
+  void parse_and_visit_statements_until_right_curly(Visitor &v) {
     QLJS_ASSERT(this->peek().type == token_type::left_curly);
     this->skip();
     for (;;) {
-      this->parse_and_visit_statement(v);
+      this->parse_and_visit_statement_and_free_expressions(v);
       if (this->peek().type == token_type::right_curly) {
-        this->skip();
         break;
       }
       if (this->peek().type == token_type::end_of_file) {
@@ -626,6 +746,31 @@ class parser {
 
     v.visit_enter_function_scope_body();
 
+    this->parse_and_visit_function_body(v);
+  }
+
+  template <QLJS_PARSE_VISITOR Visitor>
+  void parse_and_visit_function_body(Visitor &v) {
+    while (this->next_parsed_function_body_ !=
+               this->parsed_function_bodies_end_ &&
+           this->next_parsed_function_body_->span.begin() <
+               this->peek().begin) {
+      // We parsed past this body without finding a function body there.
+      ++this->next_parsed_function_body_;
+    }
+    if (this->next_parsed_function_body_ != this->parsed_function_bodies_end_ &&
+        this->next_parsed_function_body_->span.begin() == this->peek().begin) {
+      parsed_function_body &body = *this->next_parsed_function_body_++;
+      for (parsed_function_body::chunk &c : body.chunks) {
+        c.visits.move_into(v);
+        c.errors.move_into(this->error_reporter_);
+      }
+      this->lexer_.seek(body.span.end());
+      return;
+    }
+    if (this->skip_function_bodies_ && this->skip_function_body()) {
+      return;
+    }
     this->parse_and_visit_statement_block_no_scope(v);
   }
 
@@ -922,7 +1067,7 @@ class parser {
       [[fallthrough]];
     case token_type::kw_var: {
       token_type variable_token = this->peek().type;
-      buffering_visitor lhs;
+      buffering_visitor &lhs = *this->expressions_.make_buffering_visitor();
       this->parse_and_visit_let_bindings(lhs, this->peek().type,
                                          /*allow_in_operator=*/false);
       switch (this->peek().type) {
@@ -960,6 +1105,7 @@ class parser {
         QLJS_PARSER_UNIMPLEMENTED();
         break;
       }
+      this->expressions_.delete_buffering_visitor(&lhs);
       break;
     }
 
@@ -1342,6 +1488,12 @@ class parser {
 
   void consume_semicolon();
 
+  // Match the '{' of a function body with its '}' without parsing, and record
+  // the body in this->skipped_function_bodies_.
+  //
+  // If the body has no matching '}', return false without skipping anything.
+  bool skip_function_body();
+
   const token &peek() const noexcept { return this->lexer_.peek(); }
   void skip() noexcept { this->lexer_.skip(); }
 
@@ -1358,7 +1510,36 @@ class parser {
   quick_lint_js::lexer lexer_;
   error_reporter *error_reporter_;
   quick_lint_js::expression_arena expressions_;
+  bool skip_function_bodies_ = false;
+  std::vector<skipped_function_body> skipped_function_bodies_;
+  parsed_function_body *next_parsed_function_body_ = nullptr;
+  parsed_function_body *parsed_function_bodies_end_ = nullptr;
 };
+
+// Call f(). If f hits unimplemented syntax (such as with parser or lexer), the
+// fatal error is reported to the error_reporter as usual, but instead of
+// crashing the process, f is abandoned and catch_fatal_parse_errors returns
+// false. Otherwise, catch_fatal_parse_errors returns true.
+//
+// A parser which hit a fatal error is in an unspecified state, so construct
+// the parser inside f (the lexer reads the first token in its constructor).
+// Visitors used by f might have seen only part of the input.
+//
+// NOTE(strager): Fatal errors longjmp out of f. Objects created since f was
+// called are not destroyed, so their memory leaks.
+template <class Func>
+bool catch_fatal_parse_errors(Func &&f) {
+  std::jmp_buf fatal_error_jmp_buf;
+  std::jmp_buf *old_fatal_error_jmp_buf =
+      exchange_fatal_error_jmp_buf(&fatal_error_jmp_buf);
+  if (setjmp(fatal_error_jmp_buf) != 0) {
+    exchange_fatal_error_jmp_buf(old_fatal_error_jmp_buf);
+    return false;
+  }
+  f();
+  exchange_fatal_error_jmp_buf(old_fatal_error_jmp_buf);
+  return true;
+}
 }
 
 #undef QLJS_PARSER_UNIMPLEMENTED
@@ -0,0 +1,126 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef QUICK_LINT_JS_PERFECT_HASH_H
+#define QUICK_LINT_JS_PERFECT_HASH_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <quick-lint-js/assert.h>
+#include <quick-lint-js/char8.h>
+#include <type_traits>
+
+namespace quick_lint_js {
+// 64-bit FNV-1a.
+constexpr std::uint64_t hash_fnv_1a_64(string8_view s) noexcept {
+  std::uint64_t hash = 0xcbf29ce484222325ULL;
+  for (char8 c : s) {
+    hash ^= static_cast<std::uint8_t>(c);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+// A perfect hash table of strings, built at compile time.
+//
+// perfect_hash_table maps each of KeyCount keys to its index in the key array
+// given to the constructor. Each key is hashed with hash_fnv_1a_64, then the
+// hash is mapped to one of 2^SlotBits slots with a multiply-shift. The
+// constructor searches for a multiplier which gives every key its own slot, so
+// lookups compare at most one string.
+//
+// If the constructor cannot find a multiplier, it fails to compile. If that
+// happens, increase SlotBits.
+template <std::size_t KeyCount, int SlotBits>
+class perfect_hash_table {
+ public:
+  static constexpr std::size_t slot_count = std::size_t(1) << SlotBits;
+
+  constexpr explicit perfect_hash_table(
+      const std::array<string8_view, KeyCount> &keys) noexcept
+      : keys_(keys) {
+    std::array<std::uint64_t, KeyCount> key_hashes{};
+    for (std::size_t i = 0; i < KeyCount; ++i) {
+      key_hashes[i] = hash_fnv_1a_64(keys[i]);
+    }
+
+    constexpr int max_attempts = 100'000;
+    for (int attempt = 0; attempt < max_attempts; ++attempt) {
+      this->multiplier_ =
+          (static_cast<std::uint64_t>(attempt) * 0x9e3779b97f4a7c15ULL +
+           0x632be59bd9b4e019ULL) |
+          1;
+      if (this->try_fill_slots(key_hashes)) {
+        return;
+      }
+    }
+    // No collision-free multiplier exists. Increase SlotBits.
+    QLJS_ALWAYS_ASSERT(false);
+  }
+
+  // Returns the index of key in the constructor's key array, or -1 if key is
+  // not in the table.
+  //
+  // key_hash must be hash_fnv_1a_64(key).
+  constexpr int find(string8_view key, std::uint64_t key_hash) const noexcept {
+    slot_type slot = this->slots_[this->slot_index(key_hash)];
+    if (slot == empty_slot) {
+      return -1;
+    }
+    if (this->keys_[slot] != key) {
+      return -1;
+    }
+    return static_cast<int>(slot);
+  }
+
+  constexpr int find(string8_view key) const noexcept {
+    return this->find(key, hash_fnv_1a_64(key));
+  }
+
+ private:
+  using slot_type = std::conditional_t<(KeyCount < 0xff), std::uint8_t,
+                                       std::uint16_t>;
+  static_assert(KeyCount < 0xffff);
+  static constexpr slot_type empty_slot = static_cast<slot_type>(-1);
+
+  constexpr std::size_t slot_index(std::uint64_t key_hash) const noexcept {
+    return static_cast<std::size_t>((key_hash * this->multiplier_) >>
+                                    (64 - SlotBits));
+  }
+
+  constexpr bool try_fill_slots(
+      const std::array<std::uint64_t, KeyCount> &key_hashes) noexcept {
+    for (slot_type &slot : this->slots_) {
+      slot = empty_slot;
+    }
+    for (std::size_t i = 0; i < KeyCount; ++i) {
+      slot_type &slot = this->slots_[this->slot_index(key_hashes[i])];
+      if (slot != empty_slot) {
+        return false;
+      }
+      slot = static_cast<slot_type>(i);
+    }
+    return true;
+  }
+
+  std::uint64_t multiplier_ = 0;
+  std::array<string8_view, KeyCount> keys_;
+  std::array<slot_type, slot_count> slots_{};
+};
+}
+
+#endif
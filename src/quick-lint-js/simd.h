@@ -17,6 +17,8 @@
 #ifndef QUICK_LINT_JS_SIMD_H
 #define QUICK_LINT_JS_SIMD_H
 
+#include <cstdint>
+#include <cstring>
 #include <quick-lint-js/bit.h>
 #include <quick-lint-js/char8.h>
 #include <quick-lint-js/force-inline.h>
@@ -28,6 +30,10 @@
 #include <emmintrin.h>
 #endif
 
+#if QLJS_HAVE_X86_AVX2 || QLJS_HAVE_X86_AVX512BW
+#include <immintrin.h>
+#endif
+
 namespace quick_lint_js {
 #if QLJS_HAVE_X86_SSE2
 class bool_vector_16_sse2 {
@@ -109,6 +115,153 @@ class char_vector_16_sse2 {
 };
 #endif
 
+#if QLJS_HAVE_X86_AVX2
+class bool_vector_32_avx2 {
+ public:
+  static constexpr int size = 32;
+
+  QLJS_FORCE_INLINE explicit bool_vector_32_avx2(__m256i data) noexcept
+      : data_(data) {}
+
+  QLJS_FORCE_INLINE friend bool_vector_32_avx2 operator|(
+      bool_vector_32_avx2 x, bool_vector_32_avx2 y) noexcept {
+    return bool_vector_32_avx2(_mm256_or_si256(x.data_, y.data_));
+  }
+
+  QLJS_FORCE_INLINE friend bool_vector_32_avx2 operator&(
+      bool_vector_32_avx2 x, bool_vector_32_avx2 y) noexcept {
+    return bool_vector_32_avx2(_mm256_and_si256(x.data_, y.data_));
+  }
+
+  QLJS_FORCE_INLINE int find_first_false() const noexcept {
+    // NOTE(strager): Unlike bool_vector_16_sse2, every bit of the mask is
+    // meaningful, so the mask can legitimately be all ones.
+    return countr_one(this->mask());
+  }
+
+  QLJS_FORCE_INLINE std::uint32_t mask() const noexcept {
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(this->data_));
+  }
+
+ private:
+  __m256i data_;
+};
+
+class char_vector_32_avx2 {
+ public:
+  static constexpr int size = 32;
+
+  QLJS_FORCE_INLINE explicit char_vector_32_avx2(__m256i data) noexcept
+      : data_(data) {}
+
+  QLJS_FORCE_INLINE static char_vector_32_avx2 load(const char8* data) {
+    __m256i vector;
+    std::memcpy(&vector, data, sizeof(vector));
+    return char_vector_32_avx2(vector);
+  }
+
+  QLJS_FORCE_INLINE static char_vector_32_avx2 repeated(std::uint8_t c) {
+    return char_vector_32_avx2(_mm256_set1_epi8(static_cast<char>(c)));
+  }
+
+  QLJS_FORCE_INLINE friend char_vector_32_avx2 operator|(
+      char_vector_32_avx2 x, char_vector_32_avx2 y) noexcept {
+    return char_vector_32_avx2(_mm256_or_si256(x.data_, y.data_));
+  }
+
+  QLJS_FORCE_INLINE friend bool_vector_32_avx2 operator==(
+      char_vector_32_avx2 x, char_vector_32_avx2 y) noexcept {
+    return bool_vector_32_avx2(_mm256_cmpeq_epi8(x.data_, y.data_));
+  }
+
+  QLJS_FORCE_INLINE friend bool_vector_32_avx2 operator<(
+      char_vector_32_avx2 x, char_vector_32_avx2 y) noexcept {
+    // AVX2 has no cmplt instruction; swap the operands of cmpgt instead.
+    return bool_vector_32_avx2(_mm256_cmpgt_epi8(y.data_, x.data_));
+  }
+
+  QLJS_FORCE_INLINE friend bool_vector_32_avx2 operator>(
+      char_vector_32_avx2 x, char_vector_32_avx2 y) noexcept {
+    return bool_vector_32_avx2(_mm256_cmpgt_epi8(x.data_, y.data_));
+  }
+
+ private:
+  __m256i data_;
+};
+#endif
+
+#if QLJS_HAVE_X86_AVX512BW
+class bool_vector_64_avx512bw {
+ public:
+  static constexpr int size = 64;
+
+  QLJS_FORCE_INLINE explicit bool_vector_64_avx512bw(__mmask64 data) noexcept
+      : data_(data) {}
+
+  QLJS_FORCE_INLINE friend bool_vector_64_avx512bw operator|(
+      bool_vector_64_avx512bw x, bool_vector_64_avx512bw y) noexcept {
+    return bool_vector_64_avx512bw(x.data_ | y.data_);
+  }
+
+  QLJS_FORCE_INLINE friend bool_vector_64_avx512bw operator&(
+      bool_vector_64_avx512bw x, bool_vector_64_avx512bw y) noexcept {
+    return bool_vector_64_avx512bw(x.data_ & y.data_);
+  }
+
+  QLJS_FORCE_INLINE int find_first_false() const noexcept {
+    return countr_one(this->mask());
+  }
+
+  QLJS_FORCE_INLINE std::uint64_t mask() const noexcept {
+    return static_cast<std::uint64_t>(this->data_);
+  }
+
+ private:
+  __mmask64 data_;
+};
+
+class char_vector_64_avx512bw {
+ public:
+  static constexpr int size = 64;
+
+  QLJS_FORCE_INLINE explicit char_vector_64_avx512bw(__m512i data) noexcept
+      : data_(data) {}
+
+  QLJS_FORCE_INLINE static char_vector_64_avx512bw load(const char8* data) {
+    __m512i vector;
+    std::memcpy(&vector, data, sizeof(vector));
+    return char_vector_64_avx512bw(vector);
+  }
+
+  QLJS_FORCE_INLINE static char_vector_64_avx512bw repeated(std::uint8_t c) {
+    return char_vector_64_avx512bw(_mm512_set1_epi8(static_cast<char>(c)));
+  }
+
+  QLJS_FORCE_INLINE friend char_vector_64_avx512bw operator|(
+      char_vector_64_avx512bw x, char_vector_64_avx512bw y) noexcept {
+    return char_vector_64_avx512bw(_mm512_or_si512(x.data_, y.data_));
+  }
+
+  QLJS_FORCE_INLINE friend bool_vector_64_avx512bw operator==(
+      char_vector_64_avx512bw x, char_vector_64_avx512bw y) noexcept {
+    return bool_vector_64_avx512bw(_mm512_cmpeq_epi8_mask(x.data_, y.data_));
+  }
+
+  QLJS_FORCE_INLINE friend bool_vector_64_avx512bw operator<(
+      char_vector_64_avx512bw x, char_vector_64_avx512bw y) noexcept {
+    return bool_vector_64_avx512bw(_mm512_cmplt_epi8_mask(x.data_, y.data_));
+  }
+
+  QLJS_FORCE_INLINE friend bool_vector_64_avx512bw operator>(
+      char_vector_64_avx512bw x, char_vector_64_avx512bw y) noexcept {
+    return bool_vector_64_avx512bw(_mm512_cmpgt_epi8_mask(x.data_, y.data_));
+  }
+
+ private:
+  __m512i data_;
+};
+#endif
+
 class bool_vector_1 {
  public:
   static constexpr int size = 1;
@@ -0,0 +1,91 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef QUICK_LINT_JS_SYMBOL_TABLE_H
+#define QUICK_LINT_JS_SYMBOL_TABLE_H
+
+#include <boost/container/pmr/monotonic_buffer_resource.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <quick-lint-js/char8.h>
+#include <vector>
+
+namespace quick_lint_js {
+// Identifies an interned name within one symbol_table.
+//
+// IDs are dense: a symbol_table with N symbols uses IDs 0 through N-1, so
+// callers can index arrays by symbol_id.
+using symbol_id = std::uint32_t;
+
+// A symbol_table maps names (such as the normalized name of an identifier) to
+// small integers. Interning the same name twice gives the same symbol_id, so
+// names can be compared by comparing their symbol_id-s.
+//
+// Interned names are copied into an arena owned by the symbol_table, so they
+// outlive the string given to intern.
+class symbol_table {
+ public:
+  explicit symbol_table();
+
+  symbol_table(const symbol_table &) = delete;
+  symbol_table &operator=(const symbol_table &) = delete;
+
+  symbol_id intern(string8_view name);
+
+  // Returns the symbol_id of name, or invalid_symbol if name was not interned.
+  symbol_id find(string8_view name) const noexcept;
+
+  string8_view name(symbol_id) const noexcept;
+
+  // hash_fnv_1a_64(this->name(symbol)), computed by intern.
+  std::uint64_t hash(symbol_id) const noexcept;
+
+  int size() const noexcept { return static_cast<int>(this->symbols_.size()); }
+
+  // Forget every symbol. Previously-returned symbol_id-s and names become
+  // invalid.
+  //
+  // clear frees the arena holding names, but keeps the capacity of the lookup
+  // arrays, so a symbol_table reused for another file rarely reallocates them.
+  void clear();
+
+  static constexpr symbol_id invalid_symbol = ~symbol_id(0);
+
+ private:
+  struct symbol {
+    const char8 *name_begin;
+    std::uint32_t name_size;
+    std::uint64_t hash;
+  };
+
+  symbol_id find(string8_view name, std::uint64_t hash) const noexcept;
+  void grow_index();
+
+  string8_view copy_name(string8_view name);
+
+  std::vector<symbol> symbols_;
+
+  // Open-addressing hash table (with linear probing) of symbols_, keyed by
+  // name. Each entry is an index into symbols_, or invalid_symbol if the entry
+  // is unused.
+  std::vector<symbol_id> index_;
+
+  // Holds the characters of every interned name.
+  boost::container::pmr::monotonic_buffer_resource name_memory_;
+};
+}
+
+#endif
@@ -17,7 +17,6 @@
 #ifndef QUICK_LINT_JS_TEXT_ERROR_REPORTER_H
 #define QUICK_LINT_JS_TEXT_ERROR_REPORTER_H
 
-#include <iosfwd>
 #include <optional>
 #include <quick-lint-js/char8.h>
 #include <quick-lint-js/error-formatter.h>
@@ -25,6 +24,7 @@
 #include <quick-lint-js/language.h>
 #include <quick-lint-js/lex.h>
 #include <quick-lint-js/location.h>
+#include <quick-lint-js/output-stream.h>
 #include <quick-lint-js/padded-string.h>
 
 namespace quick_lint_js {
@@ -32,10 +32,13 @@ class text_error_formatter;
 
 class text_error_reporter final : public error_reporter {
  public:
-  explicit text_error_reporter(std::ostream &output);
+  explicit text_error_reporter(output_stream *output);
 
   void set_source(padded_string_view input, const char *file_name);
 
+  // Write buffered errors to the output_stream.
+  void flush();
+
 #define QLJS_ERROR_TYPE(name, struct_body, format) void report(name) override;
   QLJS_X_ERROR_TYPES
 #undef QLJS_ERROR_TYPE
@@ -50,14 +53,14 @@ class text_error_reporter final : public error_reporter {
  private:
   text_error_formatter format();
 
-  std::ostream &output_;
+  output_stream &output_;
   std::optional<locator> locator_;
   const char *file_path_;
 };
 
 class text_error_formatter : public error_formatter<text_error_formatter> {
  public:
-  explicit text_error_formatter(std::ostream &output, const char *file_path,
+  explicit text_error_formatter(output_stream *output, const char *file_path,
                                 quick_lint_js::locator &locator);
 
   void write_before_message(severity, const source_code_span &origin);
@@ -65,7 +68,7 @@ class text_error_formatter : public error_formatter<text_error_formatter> {
   void write_after_message(severity, const source_code_span &origin);
 
  private:
-  std::ostream &output_;
+  output_stream &output_;
   const char *file_path_;
   locator &locator_;
 };
@@ -0,0 +1,70 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef QUICK_LINT_JS_UNICODE_IDENTIFIER_TABLE_H
+#define QUICK_LINT_JS_UNICODE_IDENTIFIER_TABLE_H
+
+#include <cstdint>
+
+namespace quick_lint_js {
+// A two-stage table of Unicode's ID_Start and ID_Continue properties (UAX #31).
+// The table is generated by tools/generate-unicode-identifier-table.
+//
+// unicode_identifier_stage_1[code_point / 256] indexes into
+// unicode_identifier_blocks. Many 256-code-point blocks (e.g. unassigned
+// planes and CJK ideographs) share a unicode_identifier_block.
+struct unicode_identifier_block {
+  // Bit (code_point % 64) of word ((code_point % 256) / 64) is set if
+  // code_point has the property.
+  std::uint64_t id_start[4];
+  std::uint64_t id_continue[4];
+};
+
+extern const std::uint8_t unicode_identifier_stage_1[0x110000 / 256];
+extern const unicode_identifier_block unicode_identifier_blocks[];
+
+inline const unicode_identifier_block& unicode_identifier_block_for(
+    char32_t code_point) noexcept {
+  return unicode_identifier_blocks[unicode_identifier_stage_1[code_point >> 8]];
+}
+
+inline bool unicode_identifier_bit(const std::uint64_t* words,
+                                   char32_t code_point) noexcept {
+  char32_t offset = code_point & 0xff;
+  return (words[offset / 64] >> (offset % 64)) & 1;
+}
+
+// These functions do not know about JavaScript's additions (such as '$' and
+// U+200D Zero Width Joiner); see lexer::is_initial_identifier_character and
+// lexer::is_identifier_character.
+inline bool is_unicode_id_start(char32_t code_point) noexcept {
+  if (code_point >= 0x110000) {
+    return false;
+  }
+  return unicode_identifier_bit(
+      unicode_identifier_block_for(code_point).id_start, code_point);
+}
+
+inline bool is_unicode_id_continue(char32_t code_point) noexcept {
+  if (code_point >= 0x110000) {
+    return false;
+  }
+  return unicode_identifier_bit(
+      unicode_identifier_block_for(code_point).id_continue, code_point);
+}
+}
+
+#endif
@@ -0,0 +1,122 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef QUICK_LINT_JS_UTF_8_H
+#define QUICK_LINT_JS_UTF_8_H
+
+#include <cstdint>
+#include <quick-lint-js/char8.h>
+
+namespace quick_lint_js {
+struct decode_utf_8_result {
+  // Number of bytes consumed. If ok is false, size is 1.
+  int size;
+  char32_t code_point;
+  bool ok;
+};
+
+// Decode one UTF-8 sequence starting at input.
+//
+// input must be followed by at least 3 readable bytes (e.g. input is inside a
+// padded_string). A truncated sequence is reported as invalid because the
+// padding bytes are not continuation bytes.
+//
+// Overlong sequences, surrogates, and code points above U+10FFFF are invalid.
+inline decode_utf_8_result decode_utf_8(const char8* input) noexcept {
+  auto byte = [input](int index) -> std::uint8_t {
+    return static_cast<std::uint8_t>(input[index]);
+  };
+  auto is_continuation = [&](int index) -> bool {
+    return (byte(index) & 0xc0) == 0x80;
+  };
+  auto continuation_bits = [&](int index) -> char32_t {
+    return byte(index) & 0x3f;
+  };
+  constexpr decode_utf_8_result invalid = {
+      .size = 1, .code_point = 0, .ok = false};
+
+  std::uint8_t lead = byte(0);
+  if (lead < 0x80) {
+    return decode_utf_8_result{.size = 1, .code_point = lead, .ok = true};
+  }
+  if (lead < 0xc2) {
+    // Continuation byte or overlong two-byte sequence.
+    return invalid;
+  }
+  if (lead < 0xe0) {
+    if (!is_continuation(1)) {
+      return invalid;
+    }
+    return decode_utf_8_result{
+        .size = 2,
+        .code_point = (char32_t(lead & 0x1f) << 6) | continuation_bits(1),
+        .ok = true};
+  }
+  if (lead < 0xf0) {
+    if (!is_continuation(1) || !is_continuation(2)) {
+      return invalid;
+    }
+    char32_t code_point = (char32_t(lead & 0x0f) << 12) |
+                          (continuation_bits(1) << 6) | continuation_bits(2);
+    bool is_surrogate = code_point >= 0xd800 && code_point <= 0xdfff;
+    if (code_point < 0x800 || is_surrogate) {
+      return invalid;
+    }
+    return decode_utf_8_result{.size = 3, .code_point = code_point, .ok = true};
+  }
+  if (lead < 0xf5) {
+    if (!is_continuation(1) || !is_continuation(2) || !is_continuation(3)) {
+      return invalid;
+    }
+    char32_t code_point = (char32_t(lead & 0x07) << 18) |
+                          (continuation_bits(1) << 12) |
+                          (continuation_bits(2) << 6) | continuation_bits(3);
+    if (code_point < 0x10000 || code_point >= 0x110000) {
+      return invalid;
+    }
+    return decode_utf_8_result{.size = 4, .code_point = code_point, .ok = true};
+  }
+  return invalid;
+}
+
+// Write code_point as UTF-8 to out. Returns a pointer past the last byte
+// written (at most 4 bytes).
+//
+// code_point must be at most U+10FFFF.
+inline char8* encode_utf_8(char32_t code_point, char8* out) noexcept {
+  auto put = [&out](char32_t byte) -> void {
+    *out++ = static_cast<char8>(byte);
+  };
+  if (code_point < 0x80) {
+    put(code_point);
+  } else if (code_point < 0x800) {
+    put(0xc0 | (code_point >> 6));
+    put(0x80 | (code_point & 0x3f));
+  } else if (code_point < 0x10000) {
+    put(0xe0 | (code_point >> 12));
+    put(0x80 | ((code_point >> 6) & 0x3f));
+    put(0x80 | (code_point & 0x3f));
+  } else {
+    put(0xf0 | (code_point >> 18));
+    put(0x80 | ((code_point >> 12) & 0x3f));
+    put(0x80 | ((code_point >> 6) & 0x3f));
+    put(0x80 | (code_point & 0x3f));
+  }
+  return out;
+}
+}
+
+#endif
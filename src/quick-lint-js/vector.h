@@ -132,6 +132,14 @@ class vector {
   }
 
   QLJS_FORCE_INLINE T *data() noexcept { return this->data_.data(); }
+  QLJS_FORCE_INLINE const T *data() const noexcept {
+    return this->data_.data();
+  }
+
+  QLJS_FORCE_INLINE const T *begin() const noexcept { return this->data(); }
+  QLJS_FORCE_INLINE const T *end() const noexcept {
+    return this->data() + this->size();
+  }
 
   QLJS_FORCE_INLINE std::size_t size() const noexcept {
     return this->data_.size();
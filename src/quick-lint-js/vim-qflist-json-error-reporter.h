@@ -17,12 +17,12 @@
 #ifndef QUICK_LINT_JS_VIM_QFLIST_JSON_ERROR_REPORTER_H
 #define QUICK_LINT_JS_VIM_QFLIST_JSON_ERROR_REPORTER_H
 
-#include <iosfwd>
 #include <optional>
 #include <quick-lint-js/error-formatter.h>
 #include <quick-lint-js/error.h>
 #include <quick-lint-js/lex.h>
 #include <quick-lint-js/location.h>
+#include <quick-lint-js/output-stream.h>
 #include <quick-lint-js/padded-string.h>
 #include <string>
 
@@ -31,7 +31,7 @@ class vim_qflist_json_error_formatter;
 
 class vim_qflist_json_error_reporter final : public error_reporter {
  public:
-  explicit vim_qflist_json_error_reporter(std::ostream &output);
+  explicit vim_qflist_json_error_reporter(output_stream *output);
 
   void set_source(padded_string_view input, const char *file_name,
                   int vim_bufnr);
@@ -40,6 +40,10 @@ class vim_qflist_json_error_reporter final : public error_reporter {
   void set_source(padded_string_view input, const char *file_name);
   void set_source(padded_string_view input, int vim_bufnr);
 
+  // Write buffered errors to the output_stream.
+  void flush();
+
+  // Write the end of the JSON document and flush the output_stream.
   void finish();
 
 #define QLJS_ERROR_TYPE(name, struct_body, format) void report(name) override;
@@ -57,7 +61,7 @@ class vim_qflist_json_error_reporter final : public error_reporter {
   void begin_error();
   vim_qflist_json_error_formatter format();
 
-  std::ostream &output_;
+  output_stream &output_;
   std::optional<locator> locator_;
   std::string bufnr_;
   std::string file_name_;
@@ -67,7 +71,7 @@ class vim_qflist_json_error_reporter final : public error_reporter {
 class vim_qflist_json_error_formatter
     : public error_formatter<vim_qflist_json_error_formatter> {
  public:
-  explicit vim_qflist_json_error_formatter(std::ostream &output,
+  explicit vim_qflist_json_error_formatter(output_stream *output,
                                            quick_lint_js::locator &locator,
                                            std::string_view file_name,
                                            std::string_view bufnr);
@@ -76,7 +80,7 @@ class vim_qflist_json_error_formatter
   void write_after_message(severity, const source_code_span &origin);
 
  private:
-  std::ostream &output_;
+  output_stream &output_;
   quick_lint_js::locator &locator_;
   std::string_view file_name_;
   std::string_view bufnr_;
@@ -0,0 +1,133 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <boost/container/pmr/polymorphic_allocator.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <quick-lint-js/assert.h>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/narrow-cast.h>
+#include <quick-lint-js/perfect-hash.h>
+#include <quick-lint-js/symbol-table.h>
+
+namespace quick_lint_js {
+namespace {
+constexpr std::size_t initial_index_size = 256;
+}
+
+symbol_table::symbol_table() {
+  this->index_.assign(initial_index_size, invalid_symbol);
+}
+
+symbol_id symbol_table::intern(string8_view name) {
+  std::uint64_t hash = hash_fnv_1a_64(name);
+  symbol_id existing = this->find(name, hash);
+  if (existing != invalid_symbol) {
+    return existing;
+  }
+
+  // Keep the load factor at or below 1/2.
+  if ((this->symbols_.size() + 1) * 2 > this->index_.size()) {
+    this->grow_index();
+  }
+
+  symbol_id id = narrow_cast<symbol_id>(this->symbols_.size());
+  QLJS_ASSERT(id != invalid_symbol);
+  string8_view copied_name = this->copy_name(name);
+  this->symbols_.push_back(symbol{
+      .name_begin = copied_name.data(),
+      .name_size = narrow_cast<std::uint32_t>(copied_name.size()),
+      .hash = hash,
+  });
+
+  std::size_t mask = this->index_.size() - 1;
+  for (std::size_t i = static_cast<std::size_t>(hash) & mask;;
+       i = (i + 1) & mask) {
+    if (this->index_[i] == invalid_symbol) {
+      this->index_[i] = id;
+      break;
+    }
+  }
+  return id;
+}
+
+symbol_id symbol_table::find(string8_view name) const noexcept {
+  return this->find(name, hash_fnv_1a_64(name));
+}
+
+symbol_id symbol_table::find(string8_view name, std::uint64_t hash) const
+    noexcept {
+  std::size_t mask = this->index_.size() - 1;
+  for (std::size_t i = static_cast<std::size_t>(hash) & mask;;
+       i = (i + 1) & mask) {
+    symbol_id id = this->index_[i];
+    if (id == invalid_symbol) {
+      return invalid_symbol;
+    }
+    const symbol &s = this->symbols_[id];
+    if (s.hash == hash && s.name_size == name.size() &&
+        std::memcmp(s.name_begin, name.data(), name.size()) == 0) {
+      return id;
+    }
+  }
+}
+
+string8_view symbol_table::name(symbol_id id) const noexcept {
+  QLJS_ASSERT(id < this->symbols_.size());
+  const symbol &s = this->symbols_[id];
+  return string8_view(s.name_begin, s.name_size);
+}
+
+std::uint64_t symbol_table::hash(symbol_id id) const noexcept {
+  QLJS_ASSERT(id < this->symbols_.size());
+  return this->symbols_[id].hash;
+}
+
+void symbol_table::clear() {
+  this->symbols_.clear();
+  std::fill(this->index_.begin(), this->index_.end(), invalid_symbol);
+  this->name_memory_.release();
+}
+
+void symbol_table::grow_index() {
+  std::size_t new_size = this->index_.size() * 2;
+  this->index_.assign(new_size, invalid_symbol);
+  std::size_t mask = new_size - 1;
+  for (std::size_t id = 0; id < this->symbols_.size(); ++id) {
+    std::uint64_t hash = this->symbols_[id].hash;
+    for (std::size_t i = static_cast<std::size_t>(hash) & mask;;
+         i = (i + 1) & mask) {
+      if (this->index_[i] == invalid_symbol) {
+        this->index_[i] = narrow_cast<symbol_id>(id);
+        break;
+      }
+    }
+  }
+}
+
+string8_view symbol_table::copy_name(string8_view name) {
+  if (name.empty()) {
+    return string8_view();
+  }
+  boost::container::pmr::polymorphic_allocator<char8> allocator(
+      &this->name_memory_);
+  char8 *copy = allocator.allocate(name.size());
+  std::memcpy(copy, name.data(), name.size());
+  return string8_view(copy, name.size());
+}
+}
@@ -14,16 +14,21 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
-#include <ostream>
 #include <quick-lint-js/char8.h>
 #include <quick-lint-js/location.h>
 #include <quick-lint-js/optional.h>
+#include <quick-lint-js/output-stream.h>
 #include <quick-lint-js/padded-string.h>
 #include <quick-lint-js/text-error-reporter.h>
+#include <sstream>
+#include <string_view>
+#include <utility>
+
+using namespace std::literals::string_view_literals;
 
 namespace quick_lint_js {
-text_error_reporter::text_error_reporter(std::ostream &output)
-    : output_(output) {}
+text_error_reporter::text_error_reporter(output_stream *output)
+    : output_(*output) {}
 
 void text_error_reporter::set_source(padded_string_view input,
                                      const char *file_path) {
@@ -31,6 +36,8 @@ void text_error_reporter::set_source(padded_string_view input,
   this->file_path_ = file_path;
 }
 
+void text_error_reporter::flush() { this->output_.flush(); }
+
 #define QLJS_ERROR_TYPE(name, struct_body, format_call) \
   void text_error_reporter::report(name e) { format_error(e, this->format()); }
 QLJS_X_ERROR_TYPES
@@ -39,18 +46,26 @@ QLJS_X_ERROR_TYPES
 void text_error_reporter::report_fatal_error_unimplemented_character(
     const char *qljs_file_name, int qljs_line, const char *qljs_function_name,
     const char8 *character) {
+  // The caller crashes after reporting a fatal error, so write everything
+  // now.
+  std::ostringstream message;
   error_reporter::write_fatal_error_unimplemented_character(
       /*qljs_file_name=*/qljs_file_name,
       /*qljs_line=*/qljs_line,
       /*qljs_function_name=*/qljs_function_name,
       /*character=*/character,
       /*locator=*/get(this->locator_),
-      /*out=*/this->output_);
+      /*out=*/message);
+  this->output_.append_copy(std::move(message).str());
+  this->output_.flush();
 }
 
 void text_error_reporter::report_fatal_error_unimplemented_token(
     const char *qljs_file_name, int qljs_line, const char *qljs_function_name,
     token_type type, const char8 *token_begin) {
+  // The caller crashes after reporting a fatal error, so write everything
+  // now.
+  std::ostringstream message;
   error_reporter::write_fatal_error_unimplemented_token(
       /*qljs_file_name=*/qljs_file_name,
       /*qljs_line=*/qljs_line,
@@ -58,44 +73,50 @@ void text_error_reporter::report_fatal_error_unimplemented_token(
       /*type=*/type,
       /*token_begin=*/token_begin,
       /*locator=*/get(this->locator_),
-      /*out=*/this->output_);
+      /*out=*/message);
+  this->output_.append_copy(std::move(message).str());
+  this->output_.flush();
 }
 
 text_error_formatter text_error_reporter::format() {
   QLJS_ASSERT(this->file_path_);
   QLJS_ASSERT(this->locator_.has_value());
-  return text_error_formatter(/*output=*/this->output_,
+  return text_error_formatter(/*output=*/&this->output_,
                               /*file_path=*/this->file_path_,
                               /*locator=*/*this->locator_);
 }
 
-text_error_formatter::text_error_formatter(std::ostream &output,
+text_error_formatter::text_error_formatter(output_stream *output,
                                            const char *file_path,
                                            quick_lint_js::locator &locator)
-    : output_(output), file_path_(file_path), locator_(locator) {}
+    : output_(*output), file_path_(file_path), locator_(locator) {}
 
 void text_error_formatter::write_before_message(
     severity sev, const source_code_span &origin) {
   source_range r = this->locator_.range(origin);
   source_position p = r.begin();
-  this->output_ << this->file_path_ << ":" << p.line_number << ":"
-                << p.column_number << ": ";
+  this->output_.append_copy(std::string_view(this->file_path_));
+  this->output_.append_copy(u8':');
+  this->output_.append_decimal_integer(p.line_number);
+  this->output_.append_copy(u8':');
+  this->output_.append_decimal_integer(p.column_number);
+  this->output_.append_copy(u8": "sv);
   switch (sev) {
   case severity::error:
-    this->output_ << "error: ";
+    this->output_.append_copy(u8"error: "sv);
     break;
   case severity::note:
-    this->output_ << "note: ";
+    this->output_.append_copy(u8"note: "sv);
     break;
   }
 }
 
 void text_error_formatter::write_message_part(severity, string8_view message) {
-  this->output_ << out_string8(message);
+  this->output_.append_copy(message);
 }
 
 void text_error_formatter::write_after_message(severity,
                                                const source_code_span &) {
-  this->output_ << '\n';
+  this->output_.append_copy(u8'\n');
 }
 }
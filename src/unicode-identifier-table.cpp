@@ -0,0 +1,1734 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// Code generated by tools/generate-unicode-identifier-table. DO NOT EDIT.
+// Unicode version: 14.0.0
+
+#include <cstdint>
+#include <quick-lint-js/unicode-identifier-table.h>
+
+namespace quick_lint_js {
+const std::uint8_t unicode_identifier_stage_1[4352] = {
+      0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,
+     12,  13,  14,  15,  16,   1,  17,  18,  19,   1,  20,  21,
+     22,  23,  24,  25,  26,  27,   1,  28,  29,  30,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  32,  33,  31,  31,
+     34,  35,  31,  31,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,  36,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,  37,   1,  38,  39,
+     40,  41,  42,  43,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,  44,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,   1,  45,  46,
+      1,  47,  48,  49,  50,  51,  52,  53,  54,  55,   1,  56,
+     57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,
+     69,  70,  71,  72,  73,  74,  75,  31,  76,  77,  78,  79,
+      1,   1,   1,  80,  81,  82,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  83,   1,   1,   1,   1,  84,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+      1,   1,  85,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+      1,   1,  86,  87,  31,  31,  88,  89,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,  90,   1,   1,   1,   1,
+     91,  92,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  93,
+      1,  94,  95,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     96,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  97,  31,  98,  99,  31,
+    100, 101, 102, 103,  31,  31, 104,  31,  31,  31,  31, 105,
+    106, 107, 108,  31,  31,  31,  31, 109, 110, 111,  31,  31,
+     31,  31, 112,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31, 113,  31,  31,  31,  31,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1, 114,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1, 115,
+    116,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1, 117,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1, 118,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,   1,   1, 119,  31,  31,  31,  31,  31,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1, 120,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31, 121,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,
+};
+
+const unicode_identifier_block unicode_identifier_blocks[122] = {
+    // 0
+    {
+        {
+            0x0000000000000000ULL, 0x07fffffe07fffffeULL,
+            0x0420040000000000ULL, 0xff7fffffff7fffffULL,
+        },
+        {
+            0x03ff000000000000ULL, 0x07fffffe87fffffeULL,
+            0x04a0040000000000ULL, 0xff7fffffff7fffffULL,
+        },
+    },
+    // 1
+    {
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+        },
+    },
+    // 2
+    {
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0x0000501f0003ffc3ULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0x0000501f0003ffc3ULL,
+        },
+    },
+    // 3
+    {
+        {
+            0x0000000000000000ULL, 0xbcdf000000000000ULL,
+            0xfffffffbffffd740ULL, 0xffbfffffffffffffULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xbcdfffffffffffffULL,
+            0xfffffffbffffd7c0ULL, 0xffbfffffffffffffULL,
+        },
+    },
+    // 4
+    {
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xfffffffffffffc03ULL, 0xffffffffffffffffULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xfffffffffffffcfbULL, 0xffffffffffffffffULL,
+        },
+    },
+    // 5
+    {
+        {
+            0xfffeffffffffffffULL, 0xffffffff027fffffULL,
+            0x00000000000001ffULL, 0x000787ffffff0000ULL,
+        },
+        {
+            0xfffeffffffffffffULL, 0xffffffff027fffffULL,
+            0xbffffffffffe01ffULL, 0x000787ffffff00b6ULL,
+        },
+    },
+    // 6
+    {
+        {
+            0xffffffff00000000ULL, 0xfffec000000007ffULL,
+            0xffffffffffffffffULL, 0x9c00c060002fffffULL,
+        },
+        {
+            0xffffffff07ff0000ULL, 0xffffc3ffffffffffULL,
+            0xffffffffffffffffULL, 0x9ffffdff9fefffffULL,
+        },
+    },
+    // 7
+    {
+        {
+            0x0000fffffffd0000ULL, 0xffffffffffffe000ULL,
+            0x0002003fffffffffULL, 0x043007fffffffc00ULL,
+        },
+        {
+            0xffffffffffff0000ULL, 0xffffffffffffe7ffULL,
+            0x0003ffffffffffffULL, 0x243fffffffffffffULL,
+        },
+    },
+    // 8
+    {
+        {
+            0x00000110043fffffULL, 0xffff07ff01ffffffULL,
+            0xffffffff00007effULL, 0x00000000000003ffULL,
+        },
+        {
+            0x00003fffffffffffULL, 0xffff07ff0fffffffULL,
+            0xffffffffff007effULL, 0xfffffffbffffffffULL,
+        },
+    },
+    // 9
+    {
+        {
+            0x23fffffffffffff0ULL, 0xfffe0003ff010000ULL,
+            0x23c5fdfffff99fe1ULL, 0x10030003b0004000ULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xfffeffcfffffffffULL,
+            0xf3c5fdfffff99fefULL, 0x5003ffcfb080799fULL,
+        },
+    },
+    // 10
+    {
+        {
+            0x036dfdfffff987e0ULL, 0x001c00005e000000ULL,
+            0x23edfdfffffbbfe0ULL, 0x0200000300010000ULL,
+        },
+        {
+            0xd36dfdfffff987eeULL, 0x003fffc05e023987ULL,
+            0xf3edfdfffffbbfeeULL, 0xfe00ffcf00013bbfULL,
+        },
+    },
+    // 11
+    {
+        {
+            0x23edfdfffff99fe0ULL, 0x00020003b0000000ULL,
+            0x03ffc718d63dc7e8ULL, 0x0000000000010000ULL,
+        },
+        {
+            0xf3edfdfffff99feeULL, 0x0002ffcfb0e0399fULL,
+            0xc3ffc718d63dc7ecULL, 0x0000ffc000813dc7ULL,
+        },
+    },
+    // 12
+    {
+        {
+            0x23fffdfffffddfe0ULL, 0x0000000327000000ULL,
+            0x23effdfffffddfe1ULL, 0x0006000360000000ULL,
+        },
+        {
+            0xf3fffdfffffddfffULL, 0x0000ffcf27603ddfULL,
+            0xf3effdfffffddfefULL, 0x0006ffcf60603ddfULL,
+        },
+    },
+    // 13
+    {
+        {
+            0x27fffffffffddff0ULL, 0xfc00000380704000ULL,
+            0x2ffbfffffc7fffe0ULL, 0x000000000000007fULL,
+        },
+        {
+            0xfffffffffffddfffULL, 0xfc00ffcf80f07ddfULL,
+            0x2ffbfffffc7fffeeULL, 0x000cffc0ff5f847fULL,
+        },
+    },
+    // 14
+    {
+        {
+            0x000dfffffffffffeULL, 0x000000000000007fULL,
+            0x200dffaffffff7d6ULL, 0x00000000f000005fULL,
+        },
+        {
+            0x07fffffffffffffeULL, 0x0000000003ff7fffULL,
+            0x3fffffaffffff7d6ULL, 0x00000000f3ff3f5fULL,
+        },
+    },
+    // 15
+    {
+        {
+            0x0000000000000001ULL, 0x00001ffffffffeffULL,
+            0x0000000000001f00ULL, 0x0000000000000000ULL,
+        },
+        {
+            0xc2a003ff03000001ULL, 0xfffe1ffffffffeffULL,
+            0x1ffffffffeffffdfULL, 0x0000000000000040ULL,
+        },
+    },
+    // 16
+    {
+        {
+            0x800007ffffffffffULL, 0xffe1c0623c3f0000ULL,
+            0xffffffff00004003ULL, 0xf7ffffffffff20bfULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffffffffffff03ffULL,
+            0xffffffff3fffffffULL, 0xf7ffffffffff20bfULL,
+        },
+    },
+    // 17
+    {
+        {
+            0xffffffffffffffffULL, 0xffffffff3d7f3dffULL,
+            0x7f3dffffffff3dffULL, 0xffffffffff7fff3dULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffffffff3d7f3dffULL,
+            0x7f3dffffffff3dffULL, 0xffffffffff7fff3dULL,
+        },
+    },
+    // 18
+    {
+        {
+            0xffffffffff3dffffULL, 0x0000000007ffffffULL,
+            0xffffffff0000ffffULL, 0x3f3fffffffffffffULL,
+        },
+        {
+            0xffffffffff3dffffULL, 0x0003fe00e7ffffffULL,
+            0xffffffff0000ffffULL, 0x3f3fffffffffffffULL,
+        },
+    },
+    // 19
+    {
+        {
+            0xfffffffffffffffeULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+        },
+        {
+            0xfffffffffffffffeULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+        },
+    },
+    // 20
+    {
+        {
+            0xffffffffffffffffULL, 0xffff9fffffffffffULL,
+            0xffffffff07fffffeULL, 0x01ffc7ffffffffffULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffff9fffffffffffULL,
+            0xffffffff07fffffeULL, 0x01ffc7ffffffffffULL,
+        },
+    },
+    // 21
+    {
+        {
+            0x0003ffff8003ffffULL, 0x0001dfff0003ffffULL,
+            0x000fffffffffffffULL, 0x0000000010800000ULL,
+        },
+        {
+            0x001fffff803fffffULL, 0x000ddfff000fffffULL,
+            0xffffffffffffffffULL, 0x000003ff308fffffULL,
+        },
+    },
+    // 22
+    {
+        {
+            0xffffffff00000000ULL, 0x01ffffffffffffffULL,
+            0xffff05ffffffffffULL, 0x003fffffffffffffULL,
+        },
+        {
+            0xffffffff03ffb800ULL, 0x01ffffffffffffffULL,
+            0xffff07ffffffffffULL, 0x003fffffffffffffULL,
+        },
+    },
+    // 23
+    {
+        {
+            0x000000007fffffffULL, 0x001f3fffffff0000ULL,
+            0xffff0fffffffffffULL, 0x00000000000003ffULL,
+        },
+        {
+            0x0fff0fff7fffffffULL, 0x001f3fffffffffc0ULL,
+            0xffff0fffffffffffULL, 0x0000000007ff03ffULL,
+        },
+    },
+    // 24
+    {
+        {
+            0xffffffff007fffffULL, 0x00000000001fffffULL,
+            0x0000008000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0xffffffff0fffffffULL, 0x9fffffff7fffffffULL,
+            0xbfff008003ff03ffULL, 0x0000000000007fffULL,
+        },
+    },
+    // 25
+    {
+        {
+            0x000fffffffffffe0ULL, 0x0000000000001fe0ULL,
+            0xfc00c001fffffff8ULL, 0x0000003fffffffffULL,
+        },
+        {
+            0xffffffffffffffffULL, 0x000ff80003ff1fffULL,
+            0xffffffffffffffffULL, 0x000fffffffffffffULL,
+        },
+    },
+    // 26
+    {
+        {
+            0x0000000fffffffffULL, 0x3ffffffffc00e000ULL,
+            0xe7ffffffffff01ffULL, 0x046fde0000000000ULL,
+        },
+        {
+            0x00ffffffffffffffULL, 0x3fffffffffffe3ffULL,
+            0xe7ffffffffff01ffULL, 0x07fffffffff70000ULL,
+        },
+    },
+    // 27
+    {
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0x0000000000000000ULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+        },
+    },
+    // 28
+    {
+        {
+            0xffffffff3f3fffffULL, 0x3fffffffaaff3f3fULL,
+            0x5fdfffffffffffffULL, 0x1fdc1fff0fcf1fdcULL,
+        },
+        {
+            0xffffffff3f3fffffULL, 0x3fffffffaaff3f3fULL,
+            0x5fdfffffffffffffULL, 0x1fdc1fff0fcf1fdcULL,
+        },
+    },
+    // 29
+    {
+        {
+            0x0000000000000000ULL, 0x8002000000000000ULL,
+            0x000000001fff0000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0x8000000000000000ULL, 0x8002000000100001ULL,
+            0x000000001fff0000ULL, 0x0001ffe21fff0000ULL,
+        },
+    },
+    // 30
+    {
+        {
+            0xf3fffd503f2ffc84ULL, 0xffffffff000043e0ULL,
+            0x00000000000001ffULL, 0x0000000000000000ULL,
+        },
+        {
+            0xf3fffd503f2ffc84ULL, 0xffffffff000043e0ULL,
+            0x00000000000001ffULL, 0x0000000000000000ULL,
+        },
+    },
+    // 31
+    {
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+    },
+    // 32
+    {
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0x000c781fffffffffULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0x000ff81fffffffffULL,
+        },
+    },
+    // 33
+    {
+        {
+            0xffff20bfffffffffULL, 0x000080ffffffffffULL,
+            0x7f7f7f7f007fffffULL, 0x000000007f7f7f7fULL,
+        },
+        {
+            0xffff20bfffffffffULL, 0x800080ffffffffffULL,
+            0x7f7f7f7f007fffffULL, 0xffffffff7f7f7f7fULL,
+        },
+    },
+    // 34
+    {
+        {
+            0x1f3e03fe000000e0ULL, 0xfffffffffffffffeULL,
+            0xfffffffef87fffffULL, 0xf7ffffffffffffffULL,
+        },
+        {
+            0x1f3efffe000000e0ULL, 0xfffffffffffffffeULL,
+            0xfffffffefe7fffffULL, 0xf7ffffffffffffffULL,
+        },
+    },
+    // 35
+    {
+        {
+            0xfffeffffffffffe0ULL, 0xffffffffffffffffULL,
+            0xffffffff00007fffULL, 0xffff000000000000ULL,
+        },
+        {
+            0xfffeffffffffffe0ULL, 0xffffffffffffffffULL,
+            0xffffffff00007fffULL, 0xffff000000000000ULL,
+        },
+    },
+    // 36
+    {
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0x0000000000000000ULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0x0000000000000000ULL,
+        },
+    },
+    // 37
+    {
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0x0000000000001fffULL, 0x3fffffffffff0000ULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0x0000000000001fffULL, 0x3fffffffffff0000ULL,
+        },
+    },
+    // 38
+    {
+        {
+            0x00000c00ffff1fffULL, 0x80007fffffffffffULL,
+            0xffffffff3fffffffULL, 0x0000ffffffffffffULL,
+        },
+        {
+            0x00000fffffff1fffULL, 0xbff0ffffffffffffULL,
+            0xffffffffffffffffULL, 0x0003ffffffffffffULL,
+        },
+    },
+    // 39
+    {
+        {
+            0xfffffffcff800000ULL, 0xffffffffffffffffULL,
+            0xfffffffffffff9ffULL, 0xfffc000003eb07ffULL,
+        },
+        {
+            0xfffffffcff800000ULL, 0xffffffffffffffffULL,
+            0xfffffffffffff9ffULL, 0xfffc000003eb07ffULL,
+        },
+    },
+    // 40
+    {
+        {
+            0x00000007fffff7bbULL, 0x000fffffffffffffULL,
+            0x000ffffffffffffcULL, 0x68fc000000000000ULL,
+        },
+        {
+            0x000010ffffffffffULL, 0x000fffffffffffffULL,
+            0xffffffffffffffffULL, 0xe8ffffff03ff003fULL,
+        },
+    },
+    // 41
+    {
+        {
+            0xffff003ffffffc00ULL, 0x1fffffff0000007fULL,
+            0x0007fffffffffff0ULL, 0x7c00ffdf00008000ULL,
+        },
+        {
+            0xffff3fffffffffffULL, 0x1fffffff000fffffULL,
+            0xffffffffffffffffULL, 0x7fffffff03ff8001ULL,
+        },
+    },
+    // 42
+    {
+        {
+            0x000001ffffffffffULL, 0xc47fffff00000ff7ULL,
+            0x3e62ffffffffffffULL, 0x001c07ff38000005ULL,
+        },
+        {
+            0x007fffffffffffffULL, 0xfc7fffff03ff3fffULL,
+            0xffffffffffffffffULL, 0x007cffff38000007ULL,
+        },
+    },
+    // 43
+    {
+        {
+            0xffff7f7f007e7e7eULL, 0xffff03fff7ffffffULL,
+            0xffffffffffffffffULL, 0x00000007ffffffffULL,
+        },
+        {
+            0xffff7f7f007e7e7eULL, 0xffff03fff7ffffffULL,
+            0xffffffffffffffffULL, 0x03ff37ffffffffffULL,
+        },
+    },
+    // 44
+    {
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffff000fffffffffULL, 0x0ffffffffffff87fULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffff000fffffffffULL, 0x0ffffffffffff87fULL,
+        },
+    },
+    // 45
+    {
+        {
+            0xffffffffffffffffULL, 0xffff3fffffffffffULL,
+            0xffffffffffffffffULL, 0x0000000003ffffffULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffff3fffffffffffULL,
+            0xffffffffffffffffULL, 0x0000000003ffffffULL,
+        },
+    },
+    // 46
+    {
+        {
+            0x5f7ffdffa0f8007fULL, 0xffffffffffffffdbULL,
+            0x0003ffffffffffffULL, 0xfffffffffff80000ULL,
+        },
+        {
+            0x5f7ffdffe0f8007fULL, 0xffffffffffffffdbULL,
+            0x0003ffffffffffffULL, 0xfffffffffff80000ULL,
+        },
+    },
+    // 47
+    {
+        {
+            0x3fffffffffffffffULL, 0xffffffffffff0000ULL,
+            0xfffffffffffcffffULL, 0x0fff0000000000ffULL,
+        },
+        {
+            0x3fffffffffffffffULL, 0xffffffffffff0000ULL,
+            0xfffffffffffcffffULL, 0x0fff0000000000ffULL,
+        },
+    },
+    // 48
+    {
+        {
+            0x0000000000000000ULL, 0xffdf000000000000ULL,
+            0xffffffffffffffffULL, 0x1fffffffffffffffULL,
+        },
+        {
+            0x0018ffff0000ffffULL, 0xffdf00000000e000ULL,
+            0xffffffffffffffffULL, 0x1fffffffffffffffULL,
+        },
+    },
+    // 49
+    {
+        {
+            0x07fffffe00000000ULL, 0xffffffc007fffffeULL,
+            0x7fffffffffffffffULL, 0x000000001cfcfcfcULL,
+        },
+        {
+            0x87fffffe03ff0000ULL, 0xffffffc007fffffeULL,
+            0x7fffffffffffffffULL, 0x000000001cfcfcfcULL,
+        },
+    },
+    // 50
+    {
+        {
+            0xb7ffff7fffffefffULL, 0x000000003fff3fffULL,
+            0xffffffffffffffffULL, 0x07ffffffffffffffULL,
+        },
+        {
+            0xb7ffff7fffffefffULL, 0x000000003fff3fffULL,
+            0xffffffffffffffffULL, 0x07ffffffffffffffULL,
+        },
+    },
+    // 51
+    {
+        {
+            0x0000000000000000ULL, 0x001fffffffffffffULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0x0000000000000000ULL, 0x001fffffffffffffULL,
+            0x0000000000000000ULL, 0x2000000000000000ULL,
+        },
+    },
+    // 52
+    {
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0xffffffff1fffffffULL, 0x000000000001ffffULL,
+        },
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0xffffffff1fffffffULL, 0x000000010001ffffULL,
+        },
+    },
+    // 53
+    {
+        {
+            0xffffe000ffffffffULL, 0x003fffffffff07ffULL,
+            0xffffffff3fffffffULL, 0x00000000003eff0fULL,
+        },
+        {
+            0xffffe000ffffffffULL, 0x07ffffffffff07ffULL,
+            0xffffffff3fffffffULL, 0x00000000003eff0fULL,
+        },
+    },
+    // 54
+    {
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffff00003fffffffULL, 0x0fffffffff0fffffULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffff03ff3fffffffULL, 0x0fffffffff0fffffULL,
+        },
+    },
+    // 55
+    {
+        {
+            0xffff00ffffffffffULL, 0xf7ff000fffffffffULL,
+            0x1bfbfffbffb7f7ffULL, 0x0000000000000000ULL,
+        },
+        {
+            0xffff00ffffffffffULL, 0xf7ff000fffffffffULL,
+            0x1bfbfffbffb7f7ffULL, 0x0000000000000000ULL,
+        },
+    },
+    // 56
+    {
+        {
+            0x007fffffffffffffULL, 0x000000ff003fffffULL,
+            0x07fdffffffffffbfULL, 0x0000000000000000ULL,
+        },
+        {
+            0x007fffffffffffffULL, 0x000000ff003fffffULL,
+            0x07fdffffffffffbfULL, 0x0000000000000000ULL,
+        },
+    },
+    // 57
+    {
+        {
+            0x91bffffffffffd3fULL, 0x007fffff003fffffULL,
+            0x000000007fffffffULL, 0x0037ffff00000000ULL,
+        },
+        {
+            0x91bffffffffffd3fULL, 0x007fffff003fffffULL,
+            0x000000007fffffffULL, 0x0037ffff00000000ULL,
+        },
+    },
+    // 58
+    {
+        {
+            0x03ffffff003fffffULL, 0x0000000000000000ULL,
+            0xc0ffffffffffffffULL, 0x0000000000000000ULL,
+        },
+        {
+            0x03ffffff003fffffULL, 0x0000000000000000ULL,
+            0xc0ffffffffffffffULL, 0x0000000000000000ULL,
+        },
+    },
+    // 59
+    {
+        {
+            0x003ffffffeef0001ULL, 0x1fffffff00000000ULL,
+            0x000000001fffffffULL, 0x0000001ffffffeffULL,
+        },
+        {
+            0x873ffffffeeff06fULL, 0x1fffffff00000000ULL,
+            0x000000001fffffffULL, 0x0000007ffffffeffULL,
+        },
+    },
+    // 60
+    {
+        {
+            0x003fffffffffffffULL, 0x0007ffff003fffffULL,
+            0x000000000003ffffULL, 0x0000000000000000ULL,
+        },
+        {
+            0x003fffffffffffffULL, 0x0007ffff003fffffULL,
+            0x000000000003ffffULL, 0x0000000000000000ULL,
+        },
+    },
+    // 61
+    {
+        {
+            0xffffffffffffffffULL, 0x00000000000001ffULL,
+            0x0007ffffffffffffULL, 0x0007ffffffffffffULL,
+        },
+        {
+            0xffffffffffffffffULL, 0x00000000000001ffULL,
+            0x0007ffffffffffffULL, 0x0007ffffffffffffULL,
+        },
+    },
+    // 62
+    {
+        {
+            0x0000000fffffffffULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0x03ff00ffffffffffULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+    },
+    // 63
+    {
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x000303ffffffffffULL, 0x0000000000000000ULL,
+        },
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x00031bffffffffffULL, 0x0000000000000000ULL,
+        },
+    },
+    // 64
+    {
+        {
+            0xffff00801fffffffULL, 0xffff00000000003fULL,
+            0xffff000000000003ULL, 0x007fffff0000001fULL,
+        },
+        {
+            0xffff00801fffffffULL, 0xffff00000001ffffULL,
+            0xffff00000000003fULL, 0x007fffff0000001fULL,
+        },
+    },
+    // 65
+    {
+        {
+            0x00fffffffffffff8ULL, 0x0026000000000000ULL,
+            0x0000fffffffffff8ULL, 0x000001ffffff0000ULL,
+        },
+        {
+            0xffffffffffffffffULL, 0x803fffc00000007fULL,
+            0x07ffffffffffffffULL, 0x03ff01ffffff0004ULL,
+        },
+    },
+    // 66
+    {
+        {
+            0x0000007ffffffff8ULL, 0x0047ffffffff0090ULL,
+            0x0007fffffffffff8ULL, 0x000000001400001eULL,
+        },
+        {
+            0xffdfffffffffffffULL, 0x004fffffffff00f0ULL,
+            0xffffffffffffffffULL, 0x0000000017ffde1fULL,
+        },
+    },
+    // 67
+    {
+        {
+            0x00000ffffffbffffULL, 0x0000000000000000ULL,
+            0xffff01ffbfffbd7fULL, 0x000000007fffffffULL,
+        },
+        {
+            0x40fffffffffbffffULL, 0x0000000000000000ULL,
+            0xffff01ffbfffbd7fULL, 0x03ff07ffffffffffULL,
+        },
+    },
+    // 68
+    {
+        {
+            0x23edfdfffff99fe0ULL, 0x00000003e0010000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0xfbedfdfffff99fefULL, 0x001f1fcfe081399fULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+    },
+    // 69
+    {
+        {
+            0x001fffffffffffffULL, 0x0000000380000780ULL,
+            0x0000ffffffffffffULL, 0x00000000000000b0ULL,
+        },
+        {
+            0xffffffffffffffffULL, 0x00000003c3ff07ffULL,
+            0xffffffffffffffffULL, 0x0000000003ff00bfULL,
+        },
+    },
+    // 70
+    {
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x00007fffffffffffULL, 0x000000000f000000ULL,
+        },
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0xff3fffffffffffffULL, 0x000000003f000001ULL,
+        },
+    },
+    // 71
+    {
+        {
+            0x0000ffffffffffffULL, 0x0000000000000010ULL,
+            0x010007ffffffffffULL, 0x0000000000000000ULL,
+        },
+        {
+            0xffffffffffffffffULL, 0x0000000003ff0011ULL,
+            0x01ffffffffffffffULL, 0x00000000000003ffULL,
+        },
+    },
+    // 72
+    {
+        {
+            0x0000000007ffffffULL, 0x000000000000007fULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0x03ff0fffe7ffffffULL, 0x000000000000007fULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+    },
+    // 73
+    {
+        {
+            0x00000fffffffffffULL, 0x0000000000000000ULL,
+            0xffffffff00000000ULL, 0x80000000ffffffffULL,
+        },
+        {
+            0x07ffffffffffffffULL, 0x0000000000000000ULL,
+            0xffffffff00000000ULL, 0x800003ffffffffffULL,
+        },
+    },
+    // 74
+    {
+        {
+            0x8000ffffff6ff27fULL, 0x0000000000000002ULL,
+            0xfffffcff00000000ULL, 0x0000000a0001ffffULL,
+        },
+        {
+            0xf9bfffffff6ff27fULL, 0x0000000003ff000fULL,
+            0xfffffcff00000000ULL, 0x0000001bfcffffffULL,
+        },
+    },
+    // 75
+    {
+        {
+            0x0407fffffffff801ULL, 0xfffffffff0010000ULL,
+            0xffff0000200003ffULL, 0x01ffffffffffffffULL,
+        },
+        {
+            0x7fffffffffffffffULL, 0xffffffffffff0080ULL,
+            0xffff000023ffffffULL, 0x01ffffffffffffffULL,
+        },
+    },
+    // 76
+    {
+        {
+            0x00007ffffffffdffULL, 0xfffc000000000001ULL,
+            0x000000000000ffffULL, 0x0000000000000000ULL,
+        },
+        {
+            0xff7ffffffffffdffULL, 0xfffc000003ff0001ULL,
+            0x007ffefffffcffffULL, 0x0000000000000000ULL,
+        },
+    },
+    // 77
+    {
+        {
+            0x0001fffffffffb7fULL, 0xfffffdbf00000040ULL,
+            0x00000000010003ffULL, 0x0000000000000000ULL,
+        },
+        {
+            0xb47ffffffffffb7fULL, 0xfffffdbf03ff00ffULL,
+            0x000003ff01fb7fffULL, 0x0000000000000000ULL,
+        },
+    },
+    // 78
+    {
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0007ffff00000000ULL,
+        },
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x007fffff00000000ULL,
+        },
+    },
+    // 79
+    {
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0001000000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0001000000000000ULL, 0x0000000000000000ULL,
+        },
+    },
+    // 80
+    {
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0x0000000003ffffffULL, 0x0000000000000000ULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0x0000000003ffffffULL, 0x0000000000000000ULL,
+        },
+    },
+    // 81
+    {
+        {
+            0xffffffffffffffffULL, 0x00007fffffffffffULL,
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+        },
+        {
+            0xffffffffffffffffULL, 0x00007fffffffffffULL,
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+        },
+    },
+    // 82
+    {
+        {
+            0xffffffffffffffffULL, 0x000000000000000fULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0xffffffffffffffffULL, 0x000000000000000fULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+    },
+    // 83
+    {
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0xffffffffffff0000ULL, 0x0001ffffffffffffULL,
+        },
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0xffffffffffff0000ULL, 0x0001ffffffffffffULL,
+        },
+    },
+    // 84
+    {
+        {
+            0x00007fffffffffffULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0x00007fffffffffffULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+    },
+    // 85
+    {
+        {
+            0xffffffffffffffffULL, 0x000000000000007fULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0xffffffffffffffffULL, 0x000000000000007fULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+    },
+    // 86
+    {
+        {
+            0x01ffffffffffffffULL, 0xffff00007fffffffULL,
+            0x7fffffffffffffffULL, 0x00003fffffff0000ULL,
+        },
+        {
+            0x01ffffffffffffffULL, 0xffff03ff7fffffffULL,
+            0x7fffffffffffffffULL, 0x001f3fffffff03ffULL,
+        },
+    },
+    // 87
+    {
+        {
+            0x0000ffffffffffffULL, 0xe0fffff80000000fULL,
+            0x000000000000ffffULL, 0x0000000000000000ULL,
+        },
+        {
+            0x007fffffffffffffULL, 0xe0fffff803ff000fULL,
+            0x000000000000ffffULL, 0x0000000000000000ULL,
+        },
+    },
+    // 88
+    {
+        {
+            0x0000000000000000ULL, 0xffffffffffffffffULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0x0000000000000000ULL, 0xffffffffffffffffULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+    },
+    // 89
+    {
+        {
+            0xffffffffffffffffULL, 0x00000000000107ffULL,
+            0x00000000fff80000ULL, 0x0000000b00000000ULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffffffffffff87ffULL,
+            0x00000000ffff80ffULL, 0x0003001b00000000ULL,
+        },
+    },
+    // 90
+    {
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0x00ffffffffffffffULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0x00ffffffffffffffULL,
+        },
+    },
+    // 91
+    {
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0x00000000003fffffULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0x00000000003fffffULL,
+        },
+    },
+    // 92
+    {
+        {
+            0x00000000000001ffULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0x00000000000001ffULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+    },
+    // 93
+    {
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x6fef000000000000ULL,
+        },
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x6fef000000000000ULL,
+        },
+    },
+    // 94
+    {
+        {
+            0x00000007ffffffffULL, 0xffff00f000070000ULL,
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+        },
+        {
+            0x00000007ffffffffULL, 0xffff00f000070000ULL,
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+        },
+    },
+    // 95
+    {
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0x0fffffffffffffffULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0x0fffffffffffffffULL,
+        },
+    },
+    // 96
+    {
+        {
+            0xffffffffffffffffULL, 0x1fff07ffffffffffULL,
+            0x0000000003ff01ffULL, 0x0000000000000000ULL,
+        },
+        {
+            0xffffffffffffffffULL, 0x1fff07ffffffffffULL,
+            0x0000000063ff01ffULL, 0x0000000000000000ULL,
+        },
+    },
+    // 97
+    {
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0xffff3fffffffffffULL, 0x000000000000007fULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+    },
+    // 98
+    {
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0x0000000000000000ULL, 0xf807e3e000000000ULL,
+            0x00003c0000000fe7ULL, 0x0000000000000000ULL,
+        },
+    },
+    // 99
+    {
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0x0000000000000000ULL, 0x000000000000001cULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+    },
+    // 100
+    {
+        {
+            0xffffffffffffffffULL, 0xffffffffffdfffffULL,
+            0xebffde64dfffffffULL, 0xffffffffffffffefULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffffffffffdfffffULL,
+            0xebffde64dfffffffULL, 0xffffffffffffffefULL,
+        },
+    },
+    // 101
+    {
+        {
+            0x7bffffffdfdfe7bfULL, 0xfffffffffffdfc5fULL,
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+        },
+        {
+            0x7bffffffdfdfe7bfULL, 0xfffffffffffdfc5fULL,
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+        },
+    },
+    // 102
+    {
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffff3fffffffffULL, 0xf7fffffff7fffffdULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffff3fffffffffULL, 0xf7fffffff7fffffdULL,
+        },
+    },
+    // 103
+    {
+        {
+            0xffdfffffffdfffffULL, 0xffff7fffffff7fffULL,
+            0xfffffdfffffffdffULL, 0x0000000000000ff7ULL,
+        },
+        {
+            0xffdfffffffdfffffULL, 0xffff7fffffff7fffULL,
+            0xfffffdfffffffdffULL, 0xffffffffffffcff7ULL,
+        },
+    },
+    // 104
+    {
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0xf87fffffffffffffULL, 0x00201fffffffffffULL,
+            0x0000fffef8000010ULL, 0x0000000000000000ULL,
+        },
+    },
+    // 105
+    {
+        {
+            0x000000007fffffffULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0x000000007fffffffULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+    },
+    // 106
+    {
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0x000007dbf9ffff7fULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+    },
+    // 107
+    {
+        {
+            0x3f801fffffffffffULL, 0x0000000000004000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0x3fff1fffffffffffULL, 0x00000000000043ffULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+    },
+    // 108
+    {
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x00003fffffff0000ULL, 0x00000fffffffffffULL,
+        },
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x00007fffffff0000ULL, 0x03ffffffffffffffULL,
+        },
+    },
+    // 109
+    {
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x7fff6f7f00000000ULL,
+        },
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x7fff6f7f00000000ULL,
+        },
+    },
+    // 110
+    {
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0x000000000000001fULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0x00000000007f001fULL,
+        },
+    },
+    // 111
+    {
+        {
+            0xffffffffffffffffULL, 0x000000000000080fULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0xffffffffffffffffULL, 0x0000000003ff0fffULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+    },
+    // 112
+    {
+        {
+            0x0af7fe96ffffffefULL, 0x5ef7f796aa96ea84ULL,
+            0x0ffffbee0ffffbffULL, 0x0000000000000000ULL,
+        },
+        {
+            0x0af7fe96ffffffefULL, 0x5ef7f796aa96ea84ULL,
+            0x0ffffbee0ffffbffULL, 0x0000000000000000ULL,
+        },
+    },
+    // 113
+    {
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x03ff000000000000ULL,
+        },
+    },
+    // 114
+    {
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0x00000000ffffffffULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0x00000000ffffffffULL,
+        },
+    },
+    // 115
+    {
+        {
+            0x01ffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+        },
+        {
+            0x01ffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+        },
+    },
+    // 116
+    {
+        {
+            0xffffffff3fffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+        },
+        {
+            0xffffffff3fffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+        },
+    },
+    // 117
+    {
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffff0003ffffffffULL, 0xffffffffffffffffULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffff0003ffffffffULL, 0xffffffffffffffffULL,
+        },
+    },
+    // 118
+    {
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0x00000001ffffffffULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0x00000001ffffffffULL,
+        },
+    },
+    // 119
+    {
+        {
+            0x000000003fffffffULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0x000000003fffffffULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+    },
+    // 120
+    {
+        {
+            0xffffffffffffffffULL, 0x00000000000007ffULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0xffffffffffffffffULL, 0x00000000000007ffULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+    },
+    // 121
+    {
+        {
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+            0x0000000000000000ULL, 0x0000000000000000ULL,
+        },
+        {
+            0xffffffffffffffffULL, 0xffffffffffffffffULL,
+            0xffffffffffffffffULL, 0x0000ffffffffffffULL,
+        },
+    },
+};
+}
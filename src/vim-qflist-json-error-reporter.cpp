@@ -15,47 +15,43 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <iostream>
-#include <ostream>
 #include <quick-lint-js/error.h>
 #include <quick-lint-js/lex.h>
 #include <quick-lint-js/location.h>
 #include <quick-lint-js/optional.h>
+#include <quick-lint-js/output-stream.h>
 #include <quick-lint-js/padded-string.h>
 #include <quick-lint-js/unreachable.h>
 #include <quick-lint-js/vim-qflist-json-error-reporter.h>
 #include <string>
+#include <string_view>
+
+using namespace std::literals::string_view_literals;
 
 namespace quick_lint_js {
 namespace {
 template <class Char>
-void write_escaped_string(std::ostream &output,
+void write_escaped_string(output_stream &output,
                           std::basic_string_view<Char> string) {
-  auto write_string = [&](std::basic_string_view<Char> s) {
-    if constexpr (std::is_same_v<Char, char>) {
-      output << s;
-    } else {
-      output << out_string8(s);
-    }
-  };
-
   for (;;) {
     auto special_character_index =
         string.find_first_of(reinterpret_cast<const Char *>(u8"\\\""));
     if (special_character_index == string.npos) {
       break;
     }
-    write_string(string.substr(0, special_character_index));
-    output << '\\' << static_cast<char>(string[special_character_index]);
+    output.append_copy(string.substr(0, special_character_index));
+    output.append_copy(u8'\\');
+    output.append_copy(string[special_character_index]);
     string = string.substr(special_character_index + 1);
   }
-  write_string(string);
+  output.append_copy(string);
 }
 }
 
 vim_qflist_json_error_reporter::vim_qflist_json_error_reporter(
-    std::ostream &output)
-    : output_(output) {
-  this->output_ << "{\"qflist\": [";
+    output_stream *output)
+    : output_(*output) {
+  this->output_.append_copy(u8"{\"qflist\": ["sv);
 }
 
 void vim_qflist_json_error_reporter::set_source(padded_string_view input,
@@ -85,7 +81,12 @@ void vim_qflist_json_error_reporter::set_source(padded_string_view input,
   this->bufnr_ = std::to_string(vim_bufnr);
 }
 
-void vim_qflist_json_error_reporter::finish() { this->output_ << "]}"; }
+void vim_qflist_json_error_reporter::flush() { this->output_.flush(); }
+
+void vim_qflist_json_error_reporter::finish() {
+  this->output_.append_copy(u8"]}"sv);
+  this->output_.flush();
+}
 
 #define QLJS_ERROR_TYPE(name, struct_body, format_call) \
   void vim_qflist_json_error_reporter::report(name e) { \
@@ -98,6 +99,9 @@ QLJS_X_ERROR_TYPES
 void vim_qflist_json_error_reporter::report_fatal_error_unimplemented_character(
     const char *qljs_file_name, int qljs_line, const char *qljs_function_name,
     const char8 *character) {
+  // The caller crashes after reporting a fatal error. Write what we have so
+  // far.
+  this->output_.flush();
   error_reporter::write_fatal_error_unimplemented_character(
       /*qljs_file_name=*/qljs_file_name,
       /*qljs_line=*/qljs_line,
@@ -110,6 +114,9 @@ void vim_qflist_json_error_reporter::report_fatal_error_unimplemented_character(
 void vim_qflist_json_error_reporter::report_fatal_error_unimplemented_token(
     const char *qljs_file_name, int qljs_line, const char *qljs_function_name,
     token_type type, const char8 *token_begin) {
+  // The caller crashes after reporting a fatal error. Write what we have so
+  // far.
+  this->output_.flush();
   error_reporter::write_fatal_error_unimplemented_token(
       /*qljs_file_name=*/qljs_file_name,
       /*qljs_line=*/qljs_line,
@@ -122,23 +129,23 @@ void vim_qflist_json_error_reporter::report_fatal_error_unimplemented_token(
 
 void vim_qflist_json_error_reporter::begin_error() {
   if (this->need_comma_) {
-    this->output_ << ",\n";
+    this->output_.append_copy(u8",\n"sv);
   }
   this->need_comma_ = true;
 }
 
 vim_qflist_json_error_formatter vim_qflist_json_error_reporter::format() {
   QLJS_ASSERT(this->locator_.has_value());
-  return vim_qflist_json_error_formatter(/*output=*/this->output_,
+  return vim_qflist_json_error_formatter(/*output=*/&this->output_,
                                          /*locator=*/*this->locator_,
                                          /*file_name=*/this->file_name_,
                                          /*bufnr=*/this->bufnr_);
 }
 
 vim_qflist_json_error_formatter::vim_qflist_json_error_formatter(
-    std::ostream &output, quick_lint_js::locator &locator,
+    output_stream *output, quick_lint_js::locator &locator,
     std::string_view file_name, std::string_view bufnr)
-    : output_(output),
+    : output_(*output),
       locator_(locator),
       file_name_(file_name),
       bufnr_(bufnr) {}
@@ -154,11 +161,15 @@ void vim_qflist_json_error_formatter::write_before_message(
   auto end_column_number = origin.begin() == origin.end()
                                ? r.begin().column_number
                                : (r.end().column_number - 1);
-  this->output_ << "{\"col\": " << r.begin().column_number
-                << ", \"lnum\": " << r.begin().line_number
-                << ", \"end_col\": " << end_column_number
-                << ", \"end_lnum\": " << r.end().line_number
-                << ", \"vcol\": 0, \"text\": \"";
+  this->output_.append_copy(u8"{\"col\": "sv);
+  this->output_.append_decimal_integer(r.begin().column_number);
+  this->output_.append_copy(u8", \"lnum\": "sv);
+  this->output_.append_decimal_integer(r.begin().line_number);
+  this->output_.append_copy(u8", \"end_col\": "sv);
+  this->output_.append_decimal_integer(end_column_number);
+  this->output_.append_copy(u8", \"end_lnum\": "sv);
+  this->output_.append_decimal_integer(r.end().line_number);
+  this->output_.append_copy(u8", \"vcol\": 0, \"text\": \""sv);
 }
 
 void vim_qflist_json_error_formatter::write_message_part(severity sev,
@@ -178,15 +189,16 @@ void vim_qflist_json_error_formatter::write_after_message(
     return;
   }
 
-  this->output_ << '\"';
+  this->output_.append_copy(u8'\"');
   if (!this->bufnr_.empty()) {
-    this->output_ << ", \"bufnr\": " << this->bufnr_;
+    this->output_.append_copy(u8", \"bufnr\": "sv);
+    this->output_.append_copy(this->bufnr_);
   }
   if (!this->file_name_.empty()) {
-    this->output_ << ", \"filename\": \"";
+    this->output_.append_copy(u8", \"filename\": \""sv);
     write_escaped_string(this->output_, this->file_name_);
-    this->output_ << '"';
+    this->output_.append_copy(u8'"');
   }
-  this->output_ << '}';
+  this->output_.append_copy(u8'}');
 }
 }
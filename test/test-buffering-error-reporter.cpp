@@ -0,0 +1,75 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <quick-lint-js/buffering-error-reporter.h>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/error-collector.h>
+#include <quick-lint-js/error-matcher.h>
+#include <quick-lint-js/padded-string.h>
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::VariantWith;
+
+namespace quick_lint_js {
+namespace {
+TEST(test_buffering_error_reporter, buffers_errors_in_order) {
+  padded_string input(u8"let x = y; z = 3;");
+  source_code_span x_span(&input[4], &input[5]);
+  source_code_span y_span(&input[8], &input[9]);
+  source_code_span z_span(&input[11], &input[12]);
+
+  buffering_error_reporter buffer;
+  buffer.set_source(&input);
+  buffer.report(error_use_of_undeclared_variable{identifier(y_span)});
+  buffer.report(error_assignment_to_undeclared_variable{identifier(z_span)});
+  buffer.report(error_redeclaration_of_global_variable{identifier(x_span)});
+  EXPECT_FALSE(buffer.empty());
+
+  error_collector collector;
+  buffer.move_into(&collector);
+  EXPECT_THAT(collector.errors,
+              ElementsAre(ERROR_TYPE_FIELD(error_use_of_undeclared_variable,
+                                           name, span_matcher(&input[8])),
+                          ERROR_TYPE_FIELD(
+                              error_assignment_to_undeclared_variable,
+                              assignment, span_matcher(&input[11])),
+                          ERROR_TYPE_FIELD(
+                              error_redeclaration_of_global_variable,
+                              redeclaration, span_matcher(&input[4]))));
+}
+
+TEST(test_buffering_error_reporter, move_into_forgets_errors) {
+  padded_string input(u8"x");
+  buffering_error_reporter buffer;
+  buffer.report(error_use_of_undeclared_variable{
+      identifier(source_code_span(&input[0], &input[1]))});
+
+  error_collector collector_1;
+  buffer.move_into(&collector_1);
+  EXPECT_THAT(collector_1.errors, ElementsAre(VariantWith<
+                                      error_use_of_undeclared_variable>(
+                                      ::testing::_)));
+  EXPECT_TRUE(buffer.empty());
+
+  error_collector collector_2;
+  buffer.move_into(&collector_2);
+  EXPECT_THAT(collector_2.errors, IsEmpty());
+}
+}
+}
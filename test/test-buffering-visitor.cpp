@@ -14,13 +14,18 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
+#include <boost/container/pmr/monotonic_buffer_resource.hpp>
+#include <cstdint>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <quick-lint-js/buffering-visitor.h>
 #include <quick-lint-js/char8.h>
+#include <quick-lint-js/expression.h>
 #include <quick-lint-js/language.h>
 #include <quick-lint-js/lex.h>
+#include <quick-lint-js/null-visitor.h>
 #include <quick-lint-js/spy-visitor.h>
+#include <vector>
 
 using ::testing::ElementsAre;
 
@@ -36,6 +41,28 @@ identifier identifier_of(const char8 (&name)[N]) {
   return identifier(span_of(name));
 }
 
+// Records identifiers without looking at their characters.
+struct identifier_recording_visitor : public null_visitor {
+  void visit_variable_declaration(identifier name, variable_kind) {
+    this->identifiers.push_back(name);
+  }
+
+  void visit_variable_use(identifier name) {
+    this->identifiers.push_back(name);
+  }
+
+  std::vector<identifier> identifiers;
+};
+
+void expect_same_identifier(identifier actual, identifier expected) {
+  EXPECT_EQ(actual.span().begin(), expected.span().begin());
+  EXPECT_EQ(actual.span().end(), expected.span().end());
+  EXPECT_EQ(actual.normalized_name().data(),
+            expected.normalized_name().data());
+  EXPECT_EQ(actual.normalized_name().size(),
+            expected.normalized_name().size());
+}
+
 TEST(test_buffering_visitor, buffers_all_visits) {
   const char8 function_name[] = u8"function";
   const char8 property_name[] = u8"property";
@@ -80,5 +107,90 @@ TEST(test_buffering_visitor, buffers_all_visits) {
                           "visit_variable_typeof_use",         //
                           "visit_variable_use"));
 }
+
+TEST(test_buffering_visitor, clear_forgets_visits) {
+  const char8 variable_name[] = u8"variable";
+
+  boost::container::pmr::monotonic_buffer_resource memory;
+  buffering_visitor v(&memory);
+  v.visit_variable_use(identifier_of(variable_name));
+  v.visit_end_of_module();
+  v.clear();
+  v.visit_enter_block_scope();
+
+  spy_visitor spy;
+  v.move_into(spy);
+  EXPECT_THAT(spy.visits, ElementsAre("visit_enter_block_scope"));
+}
+
+TEST(test_buffering_visitor, expression_arena_reuses_deleted_visitors) {
+  const char8 variable_name[] = u8"variable";
+
+  expression_arena arena;
+  buffering_visitor *first = arena.make_buffering_visitor();
+  first->visit_variable_use(identifier_of(variable_name));
+  arena.delete_buffering_visitor(first);
+
+  buffering_visitor *second = arena.make_buffering_visitor();
+  EXPECT_EQ(second, first);
+  buffering_visitor *third = arena.make_buffering_visitor();
+  EXPECT_NE(third, second);
+
+  spy_visitor spy;
+  second->move_into(spy);
+  EXPECT_THAT(spy.visits, ::testing::IsEmpty())
+      << "reused visitor should not have old visits";
+}
+
+TEST(test_buffering_visitor, replays_identifiers_exactly) {
+  const char8 code[] = u8"first \\u{73}econd third";
+  identifier first(source_code_span(&code[0], &code[5]));
+  // '\u{73}econd' normalized to 'second' in place.
+  identifier second(source_code_span(&code[6], &code[17]), &code[6 + 6]);
+  identifier third(source_code_span(&code[18], &code[23]));
+
+  buffering_visitor v;
+  // Record an identifier before the first recorded identifier.
+  v.visit_variable_use(second);
+  v.visit_variable_declaration(first, variable_kind::_let);
+  v.visit_variable_use(third);
+
+  identifier_recording_visitor recorder;
+  v.move_into(recorder);
+  ASSERT_EQ(recorder.identifiers.size(), 3);
+  expect_same_identifier(recorder.identifiers[0], second);
+  expect_same_identifier(recorder.identifiers[1], first);
+  expect_same_identifier(recorder.identifiers[2], third);
+}
+
+TEST(test_buffering_visitor, replays_identifiers_far_apart) {
+  const char8 code[] = u8"near";
+  // Never dereferenced.
+  const char8 *far = reinterpret_cast<const char8 *>(
+      reinterpret_cast<std::uintptr_t>(&code[0]) ^
+      (std::uintptr_t(1) << (sizeof(std::uintptr_t) * 8 - 2)));
+  identifier near_identifier(source_code_span(&code[0], &code[4]));
+  identifier far_identifier(source_code_span(far, far + 4));
+
+  buffering_visitor v;
+  v.visit_variable_use(near_identifier);
+  v.visit_variable_use(far_identifier);
+  v.visit_variable_use(near_identifier);
+
+  identifier_recording_visitor recorder;
+  v.move_into(recorder);
+  ASSERT_EQ(recorder.identifiers.size(), 3);
+  expect_same_identifier(recorder.identifiers[0], near_identifier);
+  expect_same_identifier(recorder.identifiers[1], far_identifier);
+  expect_same_identifier(recorder.identifiers[2], near_identifier);
+}
+
+TEST(test_buffering_visitor, visits_without_identifiers_take_one_byte) {
+  buffering_visitor v;
+  v.visit_enter_block_scope();
+  v.visit_exit_block_scope();
+  v.visit_enter_function_scope();
+  EXPECT_EQ(v.encoded_size(), 3);
+}
 }
 }
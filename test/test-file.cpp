@@ -91,6 +91,87 @@ TEST_F(test_file, read_regular_file) {
   EXPECT_EQ(file_content.content, string8_view(u8"hello\nworld!\n"));
 }
 
+TEST_F(test_file, read_regular_file_with_each_strategy) {
+  filesystem::path temp_file_path =
+      this->make_temporary_directory() / "temp.js";
+  // Sizes are near common page sizes, so memory-mapped reads need to copy
+  // the last page for some sizes but not others.
+  for (int size : {1, 100, 4096 - 64, 4096 - 63, 4095, 4096, 4097, 8192,
+                   16384 - 1, 65536, 65536 + 1, 1 << 20}) {
+    std::string expected_content;
+    for (int i = 0; i < size; ++i) {
+      expected_content += static_cast<char>('a' + i % 26);
+    }
+    write_file(temp_file_path, expected_content);
+
+    for (read_file_strategy strategy :
+         {read_file_strategy::automatic, read_file_strategy::read,
+          read_file_strategy::memory_map}) {
+      SCOPED_TRACE(size);
+      SCOPED_TRACE(static_cast<int>(strategy));
+      read_file_result file_content =
+          read_file(temp_file_path.string().c_str(), strategy);
+      ASSERT_TRUE(file_content.ok()) << file_content.error;
+      EXPECT_EQ(file_content.content.size(), size);
+      EXPECT_TRUE(file_content.content.string_view() ==
+                  string8_view(reinterpret_cast<const char8 *>(
+                                   expected_content.data()),
+                               expected_content.size()));
+
+      padded_string_view view = file_content.content.view();
+      for (int i = 0; i < padded_string::padding_size; ++i) {
+        EXPECT_EQ(view.data()[size + i], u8'\0') << "i=" << i;
+      }
+    }
+  }
+}
+
+#if QLJS_HAVE_SYS_MMAN_H && !QLJS_HAVE_WINDOWS_H
+TEST_F(test_file, memory_mapped_file_is_copy_on_write) {
+  filesystem::path temp_file_path =
+      this->make_temporary_directory() / "temp.js";
+  write_file(temp_file_path, "hello");
+
+  {
+    read_file_result file_content = read_file(
+        temp_file_path.string().c_str(), read_file_strategy::memory_map);
+    ASSERT_TRUE(file_content.ok()) << file_content.error;
+    EXPECT_TRUE(file_content.content.is_memory_mapped());
+    file_content.content.view().data()[0] = u8'j';
+    EXPECT_EQ(file_content.content, string8_view(u8"jello"));
+  }
+
+  read_file_result file_content = read_file(temp_file_path.string().c_str(),
+                                            read_file_strategy::memory_map);
+  EXPECT_EQ(file_content.content, string8_view(u8"hello"));
+}
+
+TEST_F(test_file, memory_mapping_empty_file_falls_back_to_reading) {
+  filesystem::path temp_file_path =
+      this->make_temporary_directory() / "empty.js";
+  write_file(temp_file_path, "");
+
+  read_file_result file_content = read_file(temp_file_path.string().c_str(),
+                                            read_file_strategy::memory_map);
+  ASSERT_TRUE(file_content.ok()) << file_content.error;
+  EXPECT_FALSE(file_content.content.is_memory_mapped());
+  EXPECT_EQ(file_content.content, string8_view(u8""));
+}
+
+TEST_F(test_file, moving_memory_mapped_content_keeps_mapping) {
+  filesystem::path temp_file_path =
+      this->make_temporary_directory() / "temp.js";
+  write_file(temp_file_path, "hello");
+
+  read_file_result result = read_file(temp_file_path.string().c_str(),
+                                      read_file_strategy::memory_map);
+  ASSERT_TRUE(result.ok()) << result.error;
+  file_content moved_content(std::move(result.content));
+  EXPECT_TRUE(moved_content.is_memory_mapped());
+  EXPECT_EQ(moved_content, string8_view(u8"hello"));
+}
+#endif
+
 TEST_F(test_file, read_non_existing_file) {
   filesystem::path temp_file_path =
       this->make_temporary_directory() / "does-not-exist.js";
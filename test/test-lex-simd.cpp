@@ -0,0 +1,213 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/lex-simd.h>
+#include <quick-lint-js/padded-string.h>
+#include <string>
+#include <vector>
+
+namespace quick_lint_js {
+namespace {
+class test_lex_simd
+    : public ::testing::TestWithParam<const lex_simd_routines *> {
+ protected:
+  const lex_simd_routines &routines() { return *this->GetParam(); }
+};
+
+TEST_P(test_lex_simd, skip_identifier_stops_at_non_identifier) {
+  for (int length = 0; length < 200; ++length) {
+    string8 identifier(static_cast<unsigned>(length), u8'a');
+    for (int i = 0; i < length; ++i) {
+      identifier[static_cast<unsigned>(i)] =
+          u8"azAZ09$_qQ"[static_cast<unsigned>(i) % 10];
+    }
+    for (char8 terminator : string8(u8" .(\\@`[{/:\x80\xe2\xff")) {
+      padded_string input(identifier + terminator + u8"abc");
+      char8 *end = this->routines().skip_ascii_identifier_characters(
+          input.data());
+      EXPECT_EQ(end - input.data(), length)
+          << "length=" << length
+          << " terminator=" << static_cast<int>(terminator);
+    }
+  }
+}
+
+TEST_P(test_lex_simd, skip_identifier_stops_at_end_of_string) {
+  for (int length = 0; length < 200; ++length) {
+    padded_string input(string8(static_cast<unsigned>(length), u8'x'));
+    char8 *end =
+        this->routines().skip_ascii_identifier_characters(input.data());
+    EXPECT_EQ(end - input.data(), length);
+  }
+}
+
+TEST_P(test_lex_simd, skip_digits_stops_at_non_digit) {
+  struct digit_kind {
+    char8 *(*const lex_simd_routines::*skip)(char8 *) noexcept;
+    const char8 *digits;
+    const char8 *terminators;
+  };
+  for (const digit_kind &kind : {
+           digit_kind{&lex_simd_routines::skip_decimal_digits, u8"0123456789",
+                      u8" ._/:aeEnxX\x80\xff"},
+           digit_kind{&lex_simd_routines::skip_hex_digits,
+                      u8"0123456789abcdefABCDEF", u8" ._/:@`gGnxX\x80\xff"},
+           digit_kind{&lex_simd_routines::skip_binary_digits, u8"01",
+                      u8" ._/:2abnxX\x80\xff"},
+       }) {
+    string8_view digits = kind.digits;
+    for (int length = 0; length < 200; ++length) {
+      string8 number;
+      for (int i = 0; i < length; ++i) {
+        number += digits[static_cast<unsigned>(i) % digits.size()];
+      }
+      for (char8 terminator : string8(kind.terminators)) {
+        padded_string input(number + terminator + u8"0");
+        char8 *end = (this->routines().*kind.skip)(input.data());
+        EXPECT_EQ(end - input.data(), length)
+            << "digits=" << out_string8(kind.digits) << " length=" << length
+            << " terminator=" << static_cast<int>(terminator);
+      }
+
+      padded_string input{string8(number)};
+      char8 *end = (this->routines().*kind.skip)(input.data());
+      EXPECT_EQ(end - input.data(), length)
+          << "digits=" << out_string8(kind.digits) << " length=" << length;
+    }
+  }
+}
+
+TEST_P(test_lex_simd, find_block_comment_special_character) {
+  for (int length = 0; length < 200; ++length) {
+    for (char8 special : string8(u8"*\n\r\xe2")) {
+      padded_string input(string8(static_cast<unsigned>(length), u8'/') +
+                          special + u8"**");
+      char8 *found =
+          this->routines().find_block_comment_special_character(input.data());
+      EXPECT_EQ(found - input.data(), length)
+          << "length=" << length << " special=" << static_cast<int>(special);
+    }
+
+    padded_string input(string8(static_cast<unsigned>(length), u8'/'));
+    char8 *found =
+        this->routines().find_block_comment_special_character(input.data());
+    EXPECT_EQ(found - input.data(), length) << "length=" << length;
+  }
+}
+
+TEST_P(test_lex_simd, find_star_or_null) {
+  for (int length = 0; length < 200; ++length) {
+    padded_string input(string8(static_cast<unsigned>(length), u8'\n') +
+                        u8"*\n*");
+    char8 *found = this->routines().find_star_or_null(input.data());
+    EXPECT_EQ(found - input.data(), length) << "length=" << length;
+
+    padded_string input_without_star(
+        string8(static_cast<unsigned>(length), u8'\r'));
+    found = this->routines().find_star_or_null(input_without_star.data());
+    EXPECT_EQ(found - input_without_star.data(), length)
+        << "length=" << length;
+  }
+}
+
+TEST_P(test_lex_simd, find_line_comment_special_character) {
+  for (int length = 0; length < 200; ++length) {
+    // '*' and '/' do not end line comments.
+    string8 body(static_cast<unsigned>(length), u8'/');
+    for (int i = 0; i < length; i += 3) {
+      body[static_cast<unsigned>(i)] = u8'*';
+    }
+
+    for (char8 special : string8(u8"\n\r\xe2")) {
+      padded_string input(body + special + u8"\n");
+      char8 *found =
+          this->routines().find_line_comment_special_character(input.data());
+      EXPECT_EQ(found - input.data(), length)
+          << "length=" << length << " special=" << static_cast<int>(special);
+    }
+
+    padded_string input{string8(body)};
+    char8 *found =
+        this->routines().find_line_comment_special_character(input.data());
+    EXPECT_EQ(found - input.data(), length) << "length=" << length;
+  }
+}
+
+TEST_P(test_lex_simd, find_string_special_character) {
+  for (int length = 0; length < 200; ++length) {
+    for (char8 quote : string8(u8"\"'")) {
+      char8 other_quote = quote == u8'"' ? u8'\'' : u8'"';
+      // Neither the other quote nor non-ASCII bytes end a string.
+      string8 body(static_cast<unsigned>(length), u8'x');
+      for (int i = 0; i < length; i += 3) {
+        body[static_cast<unsigned>(i)] = i % 2 == 0 ? other_quote : u8'\xe2';
+      }
+
+      for (char8 special : string8(u8"\\\n\r") + quote) {
+        padded_string input(body + special + quote);
+        char8 *found =
+            this->routines().find_string_special_character(input.data(), quote);
+        EXPECT_EQ(found - input.data(), length)
+            << "length=" << length << " special=" << static_cast<int>(special);
+      }
+
+      padded_string input{string8(body)};
+      char8 *found =
+          this->routines().find_string_special_character(input.data(), quote);
+      EXPECT_EQ(found - input.data(), length) << "length=" << length;
+    }
+  }
+}
+
+TEST_P(test_lex_simd, find_template_special_character) {
+  for (int length = 0; length < 200; ++length) {
+    // Quotes, newlines, and '{' without '$' do not matter in templates.
+    string8 body(static_cast<unsigned>(length), u8'x');
+    for (int i = 0; i < length; i += 3) {
+      body[static_cast<unsigned>(i)] = u8"'\"\n\r{\xe2"[i % 6];
+    }
+
+    for (char8 special : string8(u8"`\\$")) {
+      padded_string input(body + special + u8"`");
+      char8 *found =
+          this->routines().find_template_special_character(input.data());
+      EXPECT_EQ(found - input.data(), length)
+          << "length=" << length << " special=" << static_cast<int>(special);
+    }
+
+    padded_string input{string8(body)};
+    char8 *found =
+        this->routines().find_template_special_character(input.data());
+    EXPECT_EQ(found - input.data(), length) << "length=" << length;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    , test_lex_simd, ::testing::ValuesIn(supported_lex_simd_routines()),
+    [](const ::testing::TestParamInfo<const lex_simd_routines *> &info) {
+      return std::string(info.param->name);
+    });
+
+TEST(test_lex_simd_dispatch, chosen_routines_are_supported) {
+  std::vector<const lex_simd_routines *> supported =
+      supported_lex_simd_routines();
+  ASSERT_FALSE(supported.empty());
+  EXPECT_EQ(&lex_simd(), supported.back());
+}
+}
+}
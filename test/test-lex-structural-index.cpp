@@ -0,0 +1,321 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <ostream>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/error-collector.h>
+#include <quick-lint-js/lex-simd.h>
+#include <quick-lint-js/lex-structural-index.h>
+#include <quick-lint-js/lex.h>
+#include <quick-lint-js/narrow-cast.h>
+#include <quick-lint-js/padded-string.h>
+#include <quick-lint-js/unreachable.h>
+#include <string>
+#include <vector>
+
+namespace quick_lint_js {
+namespace {
+using bitmap = lex_structural_index::bitmap;
+
+bool expected_in_bitmap(bitmap b, char8 c) {
+  auto is_any_of = [c](string8_view chars) -> bool {
+    return chars.find(c) != chars.npos;
+  };
+  switch (b) {
+  case bitmap::string:
+    return is_any_of(string8_view(u8"\"'\\\n\r\0", 6));
+  case bitmap::template_body:
+    return is_any_of(string8_view(u8"`\\$\0", 4));
+  case bitmap::block_comment:
+    return is_any_of(string8_view(u8"*\n\r\0\xe2", 5));
+  case bitmap::line_comment:
+    return is_any_of(string8_view(u8"\n\r\0\xe2", 4));
+  case bitmap::bitmap_count:
+    break;
+  }
+  QLJS_UNREACHABLE();
+}
+
+const char8* expected_find_next(bitmap b, const char8* c) {
+  while (!expected_in_bitmap(b, *c)) {
+    ++c;
+  }
+  return c;
+}
+
+constexpr bitmap all_bitmaps[] = {
+    bitmap::string,
+    bitmap::template_body,
+    bitmap::block_comment,
+    bitmap::line_comment,
+};
+
+// Every byte value, in a scrambled order, repeated to cover several blocks.
+string8 interesting_bytes(int size) {
+  string8 result;
+  std::uint32_t state = 1;
+  for (int i = 0; i < size; ++i) {
+    state = state * 1103515245 + 12345;
+    char8 c = static_cast<char8>(state >> 24);
+    if (c == u8'\0') {
+      c = u8'\\';
+    }
+    result += c;
+  }
+  return result;
+}
+
+class test_lex_structural_index
+    : public ::testing::TestWithParam<const lex_simd_routines*> {
+ protected:
+  const lex_simd_routines& routines() { return *this->GetParam(); }
+
+  void check_index_matches_reference(padded_string_view input,
+                                     const lex_structural_index& index) {
+    for (bitmap b : all_bitmaps) {
+      for (const char8* c = input.data(); c <= input.null_terminator(); ++c) {
+        const char8* expected = expected_find_next(b, c);
+        ASSERT_EQ(index.find_next(b, c) - input.data(),
+                  expected - input.data())
+            << "bitmap=" << static_cast<int>(b)
+            << " offset=" << (c - input.data());
+      }
+    }
+  }
+};
+
+TEST_P(test_lex_structural_index, empty_input_finds_null_terminator) {
+  padded_string input(u8"");
+  lex_structural_index index(&input, this->routines());
+  for (bitmap b : all_bitmaps) {
+    EXPECT_EQ(index.find_next(b, input.data()) - input.data(), 0);
+  }
+}
+
+TEST_P(test_lex_structural_index, find_next_matches_reference) {
+  for (int size : {1, 15, 63, 64, 65, 127, 128, 200, 1000}) {
+    SCOPED_TRACE(size);
+    padded_string input(interesting_bytes(size));
+    lex_structural_index index(&input, this->routines());
+    check_index_matches_reference(&input, index);
+  }
+}
+
+TEST_P(test_lex_structural_index, find_next_skips_many_uninteresting_blocks) {
+  padded_string input(string8(1000, u8'x') + u8"\"" + string8(1000, u8'x'));
+  lex_structural_index index(&input, this->routines());
+  EXPECT_EQ(index.find_next(bitmap::string, input.data()) - input.data(),
+            1000);
+  EXPECT_EQ(index.find_next(bitmap::string, input.data() + 1001) -
+                input.data(),
+            input.size());
+}
+
+TEST_P(test_lex_structural_index, refresh_reclassifies_modified_bytes) {
+  for (int size : {10, 64, 130}) {
+    for (int begin = 0; begin < size; begin += 7) {
+      for (int end = begin; end <= size; end += 5) {
+        SCOPED_TRACE(::testing::Message() << "size=" << size
+                                          << " begin=" << begin
+                                          << " end=" << end);
+        padded_string input(string8(static_cast<unsigned>(size), u8'"'));
+        lex_structural_index index(&input, this->routines());
+        for (int i = begin; i < end; ++i) {
+          input.data()[i] = u8' ';
+        }
+        index.refresh(input.data() + begin, input.data() + end);
+        check_index_matches_reference(&input, index);
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    , test_lex_structural_index,
+    ::testing::ValuesIn(supported_lex_simd_routines()),
+    [](const ::testing::TestParamInfo<const lex_simd_routines*>& info) {
+      return std::string(info.param->name);
+    });
+
+struct lexed_token {
+  token_type type;
+  std::ptrdiff_t begin;
+  std::ptrdiff_t end;
+  bool has_leading_newline;
+
+  friend bool operator==(const lexed_token& lhs,
+                         const lexed_token& rhs) noexcept {
+    return lhs.type == rhs.type && lhs.begin == rhs.begin &&
+           lhs.end == rhs.end &&
+           lhs.has_leading_newline == rhs.has_leading_newline;
+  }
+
+  friend std::ostream& operator<<(std::ostream& out, const lexed_token& t) {
+    return out << "token{type=" << static_cast<int>(t.type)
+               << ", begin=" << t.begin << ", end=" << t.end
+               << ", has_leading_newline=" << t.has_leading_newline << "}";
+  }
+};
+
+struct lex_result {
+  std::vector<lexed_token> tokens;
+  std::vector<std::size_t> error_types;
+  string8 lexed_input;
+};
+
+// Lex the input like the parser would, including template literals and
+// (simple) regular expression literals.
+lex_result lex_all(string8_view code, lexer_strategy strategy) {
+  padded_string input(string8{code});
+  error_collector errors;
+  lexer l(&input, &errors, strategy);
+  lex_result result;
+  std::vector<int> template_curly_depths;
+  token_type previous_type = token_type::left_paren;
+  for (;;) {
+    const token& t = l.peek();
+    if ((t.type == token_type::slash || t.type == token_type::slash_equal) &&
+        (previous_type == token_type::left_paren ||
+         previous_type == token_type::equal ||
+         previous_type == token_type::comma)) {
+      l.reparse_as_regexp();
+    }
+    if (t.type == token_type::right_curly && !template_curly_depths.empty() &&
+        template_curly_depths.back() == 0) {
+      template_curly_depths.pop_back();
+      l.skip_in_template(t.begin);
+    }
+    result.tokens.push_back(lexed_token{
+        .type = t.type,
+        .begin = t.begin - input.data(),
+        .end = t.end - input.data(),
+        .has_leading_newline = t.has_leading_newline,
+    });
+    if (t.type == token_type::end_of_file) {
+      break;
+    }
+    switch (t.type) {
+    case token_type::incomplete_template:
+      template_curly_depths.push_back(0);
+      break;
+    case token_type::left_curly:
+      if (!template_curly_depths.empty()) {
+        template_curly_depths.back() += 1;
+      }
+      break;
+    case token_type::right_curly:
+      if (!template_curly_depths.empty()) {
+        template_curly_depths.back() -= 1;
+      }
+      break;
+    default:
+      break;
+    }
+    previous_type = t.type;
+    l.skip();
+  }
+  for (const error_collector::error& e : errors.errors) {
+    result.error_types.push_back(e.index());
+  }
+  result.lexed_input =
+      string8(input.data(), narrow_cast<std::size_t>(input.size()));
+  return result;
+}
+
+void check_strategies_agree(string8_view code) {
+  lex_result direct = lex_all(code, lexer_strategy::direct);
+  lex_result indexed = lex_all(code, lexer_strategy::structural_index);
+  EXPECT_EQ(indexed.tokens, direct.tokens);
+  EXPECT_EQ(indexed.error_types, direct.error_types);
+  EXPECT_EQ(indexed.lexed_input, direct.lexed_input);
+}
+
+const char8* const differential_snippets[] = {
+    u8"hello world",
+    u8"let x = 42;\nconsole.log(x);",
+    u8"a\n\n  \t b\r\nc\v\fd",
+    u8"\"string\" 'string' \"esc\\\"aped\" 'line\\\ncontinuation'",
+    u8"\"unterminated\nx",
+    u8"'unterminated",
+    u8"`template` `with ${sub} stitution` `nested ${`inner ${x}`} end`",
+    u8"`multi\nline\\` template ${ {a: 1} } $ $x`",
+    u8"`unterminated ${x",
+    u8"/* block */ x /* multi\nline */ y /** stars **/ z /*/ */",
+    u8"/* unterminated block comment",
+    u8"// line comment\nx // another\r\ny",
+    u8"x y z /*   */ w //   v",
+    u8"x y﻿z",
+    u8"\\u{61}bc \\u0061bc abc\\u{64} \\u{62}\\u{63}",
+    u8"\\u{61}\\u{61}\\u{61}\\u{61}\\u{61}\\u{61}\\u{61}\\u{61}\\u{61} x",
+    u8"a\u00a0b\u2028c\u2029d\u3000e",
+    u8"// comment with \u2028 line separator\nx /* \u2029 */ y",
+    u8"x = /regexp[/]/g; y = /=/;",
+    u8"a.b?.c ?? d => e ** f >>>= g",
+    u8"0x1234 1_000 .5e10 123abc",
+    u8"<!-- html comment\n--> also comment\nx",
+    u8"#!/usr/bin/env node",
+};
+
+TEST(test_lex_structural_index_lexer, strategies_agree_on_snippets) {
+  for (const char8* snippet : differential_snippets) {
+    SCOPED_TRACE(out_string8(snippet));
+    check_strategies_agree(snippet);
+  }
+}
+
+TEST(test_lex_structural_index_lexer,
+     strategies_agree_on_snippets_at_every_alignment) {
+  for (const char8* snippet : differential_snippets) {
+    for (int padding = 0; padding < 70; ++padding) {
+      SCOPED_TRACE(::testing::Message()
+                   << out_string8(snippet) << " padding=" << padding);
+      check_strategies_agree(string8(static_cast<unsigned>(padding), u8' ') +
+                             snippet);
+    }
+  }
+}
+
+TEST(test_lex_structural_index_lexer, strategies_agree_on_minified_code) {
+  string8 code;
+  for (int i = 0; i < 50; ++i) {
+    for (const char8* snippet : differential_snippets) {
+      string8_view s(snippet);
+      if (s.find(u8"unterminated") != s.npos || s.find(u8"#!") != s.npos ||
+          s.find(u8"<!--") != s.npos) {
+        continue;
+      }
+      code += snippet;
+      code += u8';';
+    }
+  }
+  check_strategies_agree(code);
+}
+
+TEST(test_lex_structural_index_lexer, automatic_strategy_agrees_with_direct) {
+  string8 code;
+  while (code.size() < 100'000) {
+    code += u8"function f(\\u{78}) { return `${x}` + 'y' /* z */; }\n";
+  }
+  lex_result direct = lex_all(code, lexer_strategy::direct);
+  lex_result automatic = lex_all(code, lexer_strategy::automatic);
+  EXPECT_EQ(automatic.tokens, direct.tokens);
+  EXPECT_EQ(automatic.error_types, direct.error_types);
+}
+}
+}
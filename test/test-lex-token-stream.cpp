@@ -0,0 +1,275 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/error-collector.h>
+#include <quick-lint-js/error-matcher.h>
+#include <quick-lint-js/error.h>
+#include <quick-lint-js/lex-token-stream.h>
+#include <quick-lint-js/lex.h>
+#include <quick-lint-js/padded-string.h>
+#include <string>
+#include <vector>
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+
+namespace quick_lint_js {
+namespace {
+token_stream lex(padded_string_view input) {
+  return token_stream::lex(input, &null_error_reporter::instance);
+}
+
+void expect_same_tokens(const token_stream& actual,
+                        const token_stream& expected) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (int i = 0; i < expected.size(); ++i) {
+    SCOPED_TRACE(i);
+    EXPECT_EQ(actual.type(i), expected.type(i));
+    EXPECT_EQ(actual.begin_offset(i), expected.begin_offset(i));
+    EXPECT_EQ(actual.end_offset(i), expected.end_offset(i));
+    EXPECT_EQ(actual.has_leading_newline(i), expected.has_leading_newline(i));
+  }
+}
+
+std::vector<token_type> token_types(const token_stream& tokens) {
+  std::vector<token_type> types;
+  for (int i = 0; i < tokens.size(); ++i) {
+    types.push_back(tokens.type(i));
+  }
+  return types;
+}
+
+TEST(test_lex_token_stream, empty_input_has_no_tokens) {
+  padded_string input(u8"");
+  token_stream tokens = lex(&input);
+  EXPECT_EQ(tokens.size(), 0);
+}
+
+TEST(test_lex_token_stream, tokens_have_offsets) {
+  padded_string input(u8"let x = 42;");
+  token_stream tokens = lex(&input);
+  ASSERT_EQ(tokens.size(), 5);
+  EXPECT_EQ(tokens.type(0), token_type::kw_let);
+  EXPECT_EQ(tokens.begin_offset(0), 0);
+  EXPECT_EQ(tokens.end_offset(0), 3);
+  EXPECT_EQ(tokens.type(1), token_type::identifier);
+  EXPECT_EQ(tokens.begin_offset(1), 4);
+  EXPECT_EQ(tokens.end_offset(1), 5);
+  EXPECT_EQ(tokens.type(2), token_type::equal);
+  EXPECT_EQ(tokens.type(3), token_type::number);
+  EXPECT_EQ(tokens.begin_offset(3), 8);
+  EXPECT_EQ(tokens.end_offset(3), 10);
+  EXPECT_EQ(tokens.type(4), token_type::semicolon);
+  EXPECT_EQ(tokens.begin_offset(4), 10);
+  EXPECT_EQ(tokens.end_offset(4), 11);
+}
+
+TEST(test_lex_token_stream, matches_pull_lexer) {
+  string8 source;
+  for (int i = 0; i < 50; ++i) {
+    source += u8"function f(a, b) {\n  return a.b + \"str\" * 3.14; // hi\n}\n";
+  }
+  padded_string stream_input{string8(source)};
+  token_stream tokens = lex(&stream_input);
+
+  padded_string pull_input{string8(source)};
+  lexer l(&pull_input, &null_error_reporter::instance);
+  int i = 0;
+  for (; l.peek().type != token_type::end_of_file; l.skip(), ++i) {
+    ASSERT_LT(i, tokens.size());
+    SCOPED_TRACE(i);
+    EXPECT_EQ(tokens.type(i), l.peek().type);
+    EXPECT_EQ(tokens.begin_offset(i), l.peek().begin - pull_input.data());
+    EXPECT_EQ(tokens.end_offset(i), l.peek().end - pull_input.data());
+    EXPECT_EQ(tokens.has_leading_newline(i), l.peek().has_leading_newline);
+  }
+  EXPECT_EQ(i, tokens.size());
+  EXPECT_GT(i, 64) << "test should cover several newline bitmap words";
+}
+
+TEST(test_lex_token_stream, leading_newlines) {
+  padded_string input(u8"a\nb c /* \n */ d");
+  token_stream tokens = lex(&input);
+  ASSERT_EQ(tokens.size(), 4);
+  EXPECT_FALSE(tokens.has_leading_newline(0));
+  EXPECT_TRUE(tokens.has_leading_newline(1));
+  EXPECT_FALSE(tokens.has_leading_newline(2));
+  EXPECT_TRUE(tokens.has_leading_newline(3));
+}
+
+TEST(test_lex_token_stream, slash_after_expression_is_division) {
+  for (const char8* input_text : {
+           u8"a / b / c",
+           u8"1 / 2 / 3",
+           u8"(a) / b / c",
+           u8"a[0] / b / c",
+           u8"this / b / c",
+           u8"a++ / b / c",
+       }) {
+    SCOPED_TRACE(out_string8(input_text));
+    padded_string input(input_text);
+    token_stream tokens = lex(&input);
+    std::vector<token_type> types = token_types(tokens);
+    EXPECT_EQ(std::count(types.begin(), types.end(), token_type::slash), 2);
+    EXPECT_EQ(std::count(types.begin(), types.end(), token_type::regexp), 0);
+  }
+}
+
+TEST(test_lex_token_stream, slash_not_after_expression_is_regexp) {
+  {
+    padded_string input(u8"x = /'/g;");
+    token_stream tokens = lex(&input);
+    EXPECT_THAT(token_types(tokens),
+                ElementsAre(token_type::identifier, token_type::equal,
+                            token_type::regexp, token_type::semicolon));
+    EXPECT_EQ(tokens.begin_offset(2), 4);
+    EXPECT_EQ(tokens.end_offset(2), 8);
+  }
+
+  {
+    padded_string input(u8"/=/.test(s)");
+    token_stream tokens = lex(&input);
+    EXPECT_EQ(tokens.type(0), token_type::regexp);
+    EXPECT_EQ(tokens.end_offset(0), 3);
+  }
+
+  {
+    padded_string input(u8"return /x/");
+    token_stream tokens = lex(&input);
+    EXPECT_THAT(token_types(tokens),
+                ElementsAre(token_type::kw_return, token_type::regexp));
+  }
+}
+
+TEST(test_lex_token_stream, template_substitutions) {
+  padded_string input(u8"`a${b}c${ {d} }e` + `f${`g${h}`}`");
+  token_stream tokens = lex(&input);
+  EXPECT_THAT(token_types(tokens),
+              ElementsAreArray({
+                  token_type::incomplete_template,  // `a${
+                  token_type::identifier,           // b
+                  token_type::right_curly,          // }
+                  token_type::incomplete_template,  // c${
+                  token_type::left_curly,           // {
+                  token_type::identifier,           // d
+                  token_type::right_curly,          // }
+                  token_type::right_curly,          // }
+                  token_type::complete_template,    // e`
+                  token_type::plus,                 // +
+                  token_type::incomplete_template,  // `f${
+                  token_type::incomplete_template,  // `g${
+                  token_type::identifier,           // h
+                  token_type::right_curly,          // }
+                  token_type::complete_template,    // `
+                  token_type::right_curly,          // }
+                  token_type::complete_template,    // `
+              }));
+}
+
+TEST(test_lex_token_stream, lexer_errors_are_reported) {
+  padded_string input(u8"'unterminated");
+  error_collector errors;
+  token_stream tokens = token_stream::lex(&input, &errors);
+  EXPECT_THAT(token_types(tokens), ElementsAre(token_type::string));
+  EXPECT_THAT(errors.errors, ElementsAre(ERROR_TYPE_FIELD(
+                                 error_unclosed_string_literal, string_literal,
+                                 offsets_matcher(&input, 0, 13))));
+}
+
+TEST(test_lex_token_stream, parallel_lexing_matches_sequential_lexing) {
+  // Many of these lines trick a chunk which begins inside them into guessing
+  // the wrong state.
+  string8 source =
+      u8"#!/usr/bin/env node\n"
+      u8"let caf\u00e9 = 'it\\'s /* not */ a comment';\n"
+      u8"/* a = 'b\n"
+      u8"   c = `d */ x = a / b / c;\n"
+      u8"y = /'/g.test(\"/*\") ? `line\n"
+      u8"${ {k: `in${ner}`}.k }\n"
+      u8"'quoted' ${x}` : 1e+3;\n"
+      u8"// \u2603 snowman \u00a0 nbsp\n"
+      u8"s = '\u2603 \\\n"
+      u8"continued';\n"
+      u8"if (a) /re/.exec(b); else a++ / 2;\n"
+      u8"unclosed = 'string\n"
+      u8"bad = @ \\u0030x + \u00e9t\u00e9;\n"
+      u8"z = `\n"
+      u8"#!not a shebang ${a#!b}\n"
+      u8"`;\n";
+  for (int chunk_size : {1, 2, 3, 5, 8, 13, 64}) {
+    for (int thread_count : {1, 3}) {
+      SCOPED_TRACE(chunk_size);
+      SCOPED_TRACE(thread_count);
+
+      padded_string sequential_input{string8(source)};
+      error_collector sequential_errors;
+      token_stream expected =
+          token_stream::lex(&sequential_input, &sequential_errors);
+
+      padded_string parallel_input{string8(source)};
+      error_collector parallel_errors;
+      token_stream actual = token_stream::lex_in_parallel(
+          &parallel_input, &parallel_errors, thread_count, chunk_size);
+
+      expect_same_tokens(actual, expected);
+      ASSERT_EQ(parallel_errors.errors.size(),
+                sequential_errors.errors.size());
+      for (std::size_t i = 0; i < sequential_errors.errors.size(); ++i) {
+        EXPECT_EQ(parallel_errors.errors[i].index(),
+                  sequential_errors.errors[i].index())
+            << "error " << i;
+      }
+    }
+  }
+}
+
+TEST(test_lex_token_stream, parallel_lexing_adopts_tokens_from_workers) {
+  string8 source;
+  for (int i = 0; i < 200; ++i) {
+    source += u8"x = \\u0061 / b + `t${c}` - /re/g;\n";
+  }
+  padded_string sequential_input{string8(source)};
+  token_stream expected = lex(&sequential_input);
+  padded_string parallel_input{string8(source)};
+  token_stream actual = token_stream::lex_in_parallel(
+      &parallel_input, &null_error_reporter::instance, /*thread_count=*/2,
+      /*chunk_size=*/500);
+  expect_same_tokens(actual, expected);
+  // Lexing rewrites identifiers containing escape sequences, but tokens
+  // adopted from workers were lexed from a copy.
+  EXPECT_NE(string8_view(parallel_input.data(), parallel_input.size()),
+            string8_view(sequential_input.data(), sequential_input.size()))
+      << "no tokens were adopted from workers";
+}
+
+TEST(test_lex_token_stream, storage_is_about_nine_bytes_per_token) {
+  string8 source;
+  for (int i = 0; i < 100; ++i) {
+    source += u8"a+b;";
+  }
+  padded_string input{string8(source)};
+  token_stream tokens = lex(&input);
+  ASSERT_EQ(tokens.size(), 400);
+  EXPECT_LE(tokens.storage_size(), 400 * 9 + (400 / 64 + 1) * 8);
+}
+}
+}
@@ -25,10 +25,12 @@
 #include <quick-lint-js/characters.h>
 #include <quick-lint-js/error-collector.h>
 #include <quick-lint-js/error-matcher.h>
+#include <quick-lint-js/feature.h>
 #include <quick-lint-js/lex.h>
 #include <quick-lint-js/location.h>
 #include <quick-lint-js/narrow-cast.h>
 #include <quick-lint-js/padded-string.h>
+#include <quick-lint-js/vector.h>
 #include <string_view>
 #include <type_traits>
 
@@ -91,6 +93,24 @@ TEST(test_lex, lex_line_comments) {
                {token_type::identifier, token_type::identifier});
 }
 
+TEST(test_lex, lex_long_line_comments) {
+  for (int length = 0; length < 150; ++length) {
+    string8 comment_body(narrow_cast<std::size_t>(length), u8'x');
+    for (int i = 0; i < length; i += 5) {
+      // '\xe2' might begin U+2028 or U+2029, but U+2026 is not a newline.
+      comment_body.replace(narrow_cast<std::size_t>(i), 1, u8"\u2026");
+    }
+    SCOPED_TRACE(length);
+    for (string8_view line_terminator : line_terminators) {
+      check_single_token(
+          u8"//" + comment_body + string8(line_terminator) + u8"world",
+          u8"world");
+    }
+    padded_string unterminated(u8"//" + comment_body);
+    check_single_token(&unterminated, token_type::end_of_file);
+  }
+}
+
 TEST(test_lex, lex_line_comments_with_control_characters) {
   for (string8_view control_character :
        control_characters_except_line_terminators) {
@@ -152,6 +172,19 @@ TEST(test_lex, lex_numbers) {
 
   check_tokens(u8"1.2.3", {token_type::number, token_type::number});
   check_tokens(u8".2.3", {token_type::number, token_type::number});
+
+  // Long digit runs are scanned in vector-sized blocks.
+  check_single_token(u8"12345678901234567890123456789012345678901234567890",
+                     token_type::number);
+  check_single_token(u8"3.14159265358979323846264338327950288419716939937510e-"
+                     u8"1234567890123456789",
+                     token_type::number);
+  check_single_token(u8"1_000_000_000_000_000_000_000_000_000_000",
+                     token_type::number);
+  check_single_token(u8"12345678901234567890_12345678901234567890",
+                     token_type::number);
+  check_tokens(u8"1234567890123456789012345678901234567890,x",
+               {token_type::number, token_type::comma, token_type::identifier});
 }
 
 TEST(test_lex, lex_binary_numbers) {
@@ -159,6 +192,8 @@ TEST(test_lex, lex_binary_numbers) {
   check_single_token(u8"0b1", token_type::number);
   check_single_token(u8"0b010101010101010", token_type::number);
   check_single_token(u8"0B010101010101010", token_type::number);
+  check_single_token(u8"0b0101010101010101010101010101010101010101",
+                     token_type::number);
 }
 
 TEST(test_lex, lex_hex_numbers) {
@@ -166,9 +201,21 @@ TEST(test_lex, lex_hex_numbers) {
   check_single_token(u8"0x123456789abcdef", token_type::number);
   check_single_token(u8"0X123456789ABCDEF", token_type::number);
   check_single_token(u8"0X123_4567_89AB_CDEF", token_type::number);
+  check_single_token(u8"0x0123456789abcdefABCDEF0123456789abcdefABCDEF",
+                     token_type::number);
+  check_single_token(u8"0xffff_ffff_ffff_ffff_ffff_ffff_ffff_ffff",
+                     token_type::number);
 }
 
 TEST(test_lex, lex_number_with_trailing_garbage) {
+  check_tokens_with_errors(
+      u8"0x0123456789abcdef0123ghijklmnopqrstuvwxyz0123_$ + 1",
+      {token_type::number, token_type::plus, token_type::number},
+      [](padded_string_view input, const auto& errors) {
+        EXPECT_THAT(errors, ElementsAre(ERROR_TYPE_FIELD(
+                                error_unexpected_characters_in_number,
+                                characters, offsets_matcher(input, 22, 48))));
+      });
   check_tokens_with_errors(
       u8"123abcd", {token_type::number},
       [](padded_string_view input, const auto& errors) {
@@ -205,6 +252,20 @@ TEST(test_lex, lex_number_with_trailing_garbage) {
                                 error_unexpected_characters_in_number,
                                 characters, offsets_matcher(input, 3, 8))));
       });
+  check_tokens_with_errors(
+      u8"0b2", {token_type::number},
+      [](padded_string_view input, const auto& errors) {
+        EXPECT_THAT(errors, ElementsAre(ERROR_TYPE_FIELD(
+                                error_unexpected_characters_in_number,
+                                characters, offsets_matcher(input, 1, 3))));
+      });
+  check_tokens_with_errors(
+      u8"0x;", {token_type::number, token_type::semicolon},
+      [](padded_string_view input, const auto& errors) {
+        EXPECT_THAT(errors, ElementsAre(ERROR_TYPE_FIELD(
+                                error_unexpected_characters_in_number,
+                                characters, offsets_matcher(input, 1, 2))));
+      });
   check_tokens_with_errors(
       u8"0xabjjw", {token_type::number},
       [](padded_string_view input, const auto& errors) {
@@ -282,6 +343,17 @@ TEST(test_lex, lex_number_with_double_underscore) {
       });
 }
 
+TEST(test_lex, lex_long_number_with_double_underscore) {
+  check_tokens_with_errors(
+      u8"12345678901234567890__123", {token_type::number},
+      [](padded_string_view input, const auto& errors) {
+        EXPECT_THAT(errors,
+                    ElementsAre(ERROR_TYPE_FIELD(
+                        error_number_literal_contains_consecutive_underscores,
+                        underscores, offsets_matcher(input, 20, 22))));
+      });
+}
+
 TEST(test_lex, lex_number_with_many_underscores) {
   check_tokens_with_errors(
       u8"123_____000", {token_type::number},
@@ -392,6 +464,32 @@ TEST(test_lex, lex_strings) {
   // TODO(strager): Report invalid octal escape sequences in non-strict mode.
 }
 
+TEST(test_lex, lex_long_strings) {
+  for (int length = 0; length < 150; ++length) {
+    string8 body(narrow_cast<std::size_t>(length), u8'x');
+    SCOPED_TRACE(length);
+    for (const string8& code : {
+             u8"'" + body + u8"' x",
+             u8"'" + body + u8"\\'" + body + u8"' x",
+             u8"'" + body + u8"\"" + body + u8"' x",
+             u8"\"" + body + u8"\xe2\x80\xa8" + body + u8"\" x",
+         }) {
+      check_tokens(code.c_str(),
+                   {token_type::string, token_type::identifier});
+    }
+
+    error_collector v;
+    padded_string input(u8"'" + body + u8"\nhello");
+    lexer l(&input, &v);
+    EXPECT_EQ(l.peek().type, token_type::string);
+    l.skip();
+    EXPECT_EQ(l.peek().type, token_type::identifier);
+    EXPECT_THAT(v.errors, ElementsAre(ERROR_TYPE_FIELD(
+                              error_unclosed_string_literal, string_literal,
+                              offsets_matcher(&input, 0, length + 1))));
+  }
+}
+
 TEST(test_lex, lex_string_with_ascii_control_characters) {
   for (string8_view control_character :
        concat(control_characters_except_line_terminators, ls_and_ps)) {
@@ -517,6 +615,36 @@ world`)",
   // literals.
 }
 
+TEST(test_lex, lex_long_templates) {
+  for (int length = 0; length < 150; ++length) {
+    string8 body(narrow_cast<std::size_t>(length), u8'x');
+    SCOPED_TRACE(length);
+    for (const string8& code : {
+             u8"`" + body + u8"` x",
+             u8"`" + body + u8"\\`" + body + u8"` x",
+             u8"`" + body + u8"$}" + body + u8"{` x",
+             u8"`" + body + u8"\\${" + body + u8"` x",
+             u8"`" + body + u8"\n'\"" + body + u8"` x",
+         }) {
+      check_tokens(code.c_str(),
+                   {token_type::complete_template, token_type::identifier});
+    }
+
+    padded_string code(u8"`" + body + u8"${x}" + body + u8"`");
+    lexer l(&code, &null_error_reporter::instance);
+    EXPECT_EQ(l.peek().type, token_type::incomplete_template);
+    EXPECT_EQ(l.peek().end - code.data(), length + 3);
+    const char8* template_begin = l.peek().begin;
+    l.skip();
+    EXPECT_EQ(l.peek().type, token_type::identifier);
+    l.skip();
+    EXPECT_EQ(l.peek().type, token_type::right_curly);
+    l.skip_in_template(template_begin);
+    EXPECT_EQ(l.peek().type, token_type::complete_template);
+    EXPECT_EQ(l.peek().end - code.data(), code.size());
+  }
+}
+
 TEST(test_lex, lex_template_literal_with_ascii_control_characters) {
   for (string8_view control_character :
        concat(control_characters_except_line_terminators, line_terminators)) {
@@ -698,7 +826,46 @@ TEST(test_lex, lex_identifier_with_escape_sequence) {
   check_single_token(u8"\\u0077\\u0061\\u0074", u8"wat");
   check_single_token(u8"\\u{77}\\u{61}\\u{74}", u8"wat");
 
-  // TODO(strager): Support code points above U+007F.
+  check_single_token(u8"\\u00e9t\\u00e9", u8"\u00e9t\u00e9");
+  check_single_token(u8"\\u65e5\\u672c", u8"\u65e5\u672c");
+  check_single_token(u8"\\u{1d400}", u8"\U0001d400");
+  check_single_token(u8"e\\u0301", u8"e\u0301");
+}
+
+TEST(test_lex, lex_non_ascii_identifiers) {
+  check_single_token(u8"\u00e9t\u00e9", u8"\u00e9t\u00e9");
+  check_single_token(u8"caf\u00e9", u8"caf\u00e9");
+  check_single_token(u8"\u65e5\u672c\u8a9e", u8"\u65e5\u672c\u8a9e");
+  check_single_token(u8"\u0434\u0430\u043d\u043d\u044b\u0435",
+                     u8"\u0434\u0430\u043d\u043d\u044b\u0435");
+  check_single_token(u8"\U0001d400", u8"\U0001d400");  // Mathematical Bold A
+
+  // Characters which can continue but not start an identifier.
+  check_single_token(u8"e\u0301", u8"e\u0301");  // Combining Acute Accent
+  check_single_token(u8"x\u0663", u8"x\u0663");  // Arabic-Indic Digit Three
+  check_single_token(u8"a\u200cb", u8"a\u200cb");  // Zero Width Non-Joiner
+  check_single_token(u8"a\u200db", u8"a\u200db");  // Zero Width Joiner
+  check_single_token(u8"a\u00b7b", u8"a\u00b7b");  // Middle Dot
+
+  // Other_ID_Start characters.
+  check_single_token(u8"\u2118", u8"\u2118");  // Script Capital P
+  check_single_token(u8"\u309b", u8"\u309b");  // Katakana-Hiragana Voiced
+
+  check_single_token(u8"\u00e9t\u00e9 ", u8"\u00e9t\u00e9");
+  check_tokens(u8"\u00e9t\u00e9+\u65e5",
+               {token_type::identifier, token_type::plus,
+                token_type::identifier});
+  check_tokens(u8"caf\u00e9\u3000\u00e9t\u00e9",  // Ideographic Space
+               {token_type::identifier, token_type::identifier});
+}
+
+TEST(test_lex, non_ascii_identifier_does_not_change_input) {
+  padded_string input(u8"caf\u00e9 = \u65e5\u672c;");
+  lexer l(&input, &null_error_reporter::instance);
+  while (l.peek().type != token_type::end_of_file) {
+    l.skip();
+  }
+  EXPECT_THAT(input, u8"caf\u00e9 = \u65e5\u672c;");
 }
 
 TEST(test_lex, identifier_with_escape_sequences_source_code_span_is_in_place) {
@@ -709,6 +876,25 @@ TEST(test_lex, identifier_with_escape_sequences_source_code_span_is_in_place) {
   EXPECT_EQ(span.end(), &input[input.size()]);
 }
 
+#if QLJS_FEATURE_VECTOR_PROFILING
+TEST(test_lex, lexing_identifiers_without_escapes_does_not_touch_vectors) {
+  vector_instrumentation::instance.clear();
+  padded_string input(
+      u8"for (let i = 0; i < elems.length; i++) { \u00e9t\u00e9(i); }");
+  lexer l(&input, &null_error_reporter::instance);
+  while (l.peek().type != token_type::end_of_file) {
+    l.skip();
+  }
+
+  std::vector<vector_instrumentation::entry> entries =
+      vector_instrumentation::instance.entries();
+  ASSERT_EQ(entries.size(), 1)
+      << "lexer's constructor should create its only vector, and lexing "
+         "tokens should not add entries";
+  EXPECT_EQ(entries[0].event, vector_instrumentation::event::create);
+}
+#endif
+
 TEST(test_lex, lex_identifier_with_escape_sequences_change_input) {
   padded_string input(u8"hell\\u{6F} = \\u{77}orld;");
 
@@ -874,11 +1060,70 @@ TEST(test_lex, lex_identifier_with_out_of_range_escaped_character) {
                         error_escaped_character_disallowed_in_identifiers,
                         escape_sequence, offsets_matcher(input, 7, 15))));
       });
+  // U+2E2F Vertical Tilde is a letter (Lm) but is also Pattern_Syntax.
+  check_single_token_with_errors(
+      u8"illegal\\u{2e2f}", u8"illegal\\u{2e2f}",
+      [](padded_string_view input, const auto& errors) {
+        EXPECT_THAT(errors,
+                    ElementsAre(ERROR_TYPE_FIELD(
+                        error_escaped_character_disallowed_in_identifiers,
+                        escape_sequence, offsets_matcher(input, 7, 15))));
+      });
+
+  // Digits and combining marks can continue but not start an identifier.
+  check_single_token_with_errors(
+      u8"\\u0030illegal", u8"\\u0030illegal",
+      [](padded_string_view input, const auto& errors) {
+        EXPECT_THAT(errors,
+                    ElementsAre(ERROR_TYPE_FIELD(
+                        error_escaped_character_disallowed_in_identifiers,
+                        escape_sequence, offsets_matcher(input, 0, 6))));
+      });
+  check_single_token_with_errors(
+      u8"\\u{301}illegal", u8"\\u{301}illegal",
+      [](padded_string_view input, const auto& errors) {
+        EXPECT_THAT(errors,
+                    ElementsAre(ERROR_TYPE_FIELD(
+                        error_escaped_character_disallowed_in_identifiers,
+                        escape_sequence, offsets_matcher(input, 0, 7))));
+      });
 }
 
 TEST(test_lex, lex_identifiers_which_look_like_keywords) {
   check_single_token(u8"ifelse", token_type::identifier);
   check_single_token(u8"IF", token_type::identifier);
+
+  for (string8_view keyword : {
+           u8"as"sv, u8"async"sv, u8"await"sv, u8"break"sv, u8"case"sv,
+           u8"catch"sv, u8"class"sv, u8"const"sv, u8"continue"sv,
+           u8"debugger"sv, u8"default"sv, u8"delete"sv, u8"do"sv, u8"else"sv,
+           u8"export"sv, u8"extends"sv, u8"false"sv, u8"finally"sv, u8"for"sv,
+           u8"from"sv, u8"function"sv, u8"get"sv, u8"if"sv, u8"import"sv,
+           u8"in"sv, u8"instanceof"sv, u8"let"sv, u8"new"sv, u8"null"sv,
+           u8"of"sv, u8"return"sv, u8"set"sv, u8"static"sv, u8"super"sv,
+           u8"switch"sv, u8"this"sv, u8"throw"sv, u8"true"sv, u8"try"sv,
+           u8"typeof"sv, u8"var"sv, u8"void"sv, u8"while"sv, u8"with"sv,
+           u8"yield"sv,
+       }) {
+    SCOPED_TRACE(out_string8(keyword));
+    string8 k(keyword);
+    check_single_token(k + u8"x", k + u8"x");
+    check_single_token(k + u8"_", k + u8"_");
+    check_single_token(u8"$" + k, u8"$" + k);
+    string8 prefix = k.substr(0, k.size() - 1);
+    if (!prefix.empty()) {
+      check_single_token(prefix, prefix);
+    }
+    for (std::size_t i = 0; i < k.size(); ++i) {
+      // Change one character, keeping the size, the first two characters,
+      // and the last character the same where possible.
+      string8 changed = k;
+      changed[i] = changed[i] == u8'z' ? u8'y' : u8'z';
+      check_single_token(changed, changed);
+      changed[i] = static_cast<char8>(changed[i] - (u8'a' - u8'A'));
+      check_single_token(changed, changed);
+    }
+  }
 }
 
 TEST(test_lex, lex_keywords) {
@@ -941,6 +1186,23 @@ TEST(test_lex, lex_keywords_cannot_contain_escape_sequences) {
                         escape_sequence, offsets_matcher(input, 0, 6))));
       });
 
+  // Each identifier reports only its own escape sequences.
+  check_tokens_with_errors(
+      u8"\\u{69}f w\\u{61}t \\u{65}lse",
+      {token_type::identifier, token_type::identifier,
+       token_type::identifier},
+      [](padded_string_view input, const auto& errors) {
+        EXPECT_THAT(
+            errors,
+            ElementsAre(
+                ERROR_TYPE_FIELD(error_keywords_cannot_contain_escape_sequences,
+                                 escape_sequence,
+                                 offsets_matcher(input, 0, 6)),
+                ERROR_TYPE_FIELD(error_keywords_cannot_contain_escape_sequences,
+                                 escape_sequence,
+                                 offsets_matcher(input, 17, 23))));
+      });
+
   // TODO(strager): Allow escape sequences in contextual keywords. (They should
   // be interpreted as identifiers, not keywords.)
   //
@@ -1166,6 +1428,32 @@ TEST(test_lex, lex_token_notes_leading_newline) {
   }
 }
 
+TEST(test_lex, lex_token_notes_leading_newline_in_long_whitespace) {
+  for (int spaces_before = 1; spaces_before < 70; ++spaces_before) {
+    for (int spaces_after = 0; spaces_after < 70; spaces_after += 7) {
+      for (string8_view line_terminator : line_terminators) {
+        SCOPED_TRACE(::testing::Message()
+                     << "spaces_before=" << spaces_before
+                     << " spaces_after=" << spaces_after);
+        padded_string code(
+            u8"a" + string8(narrow_cast<std::size_t>(spaces_before), u8' ') +
+            u8"b" + string8(narrow_cast<std::size_t>(spaces_before), u8'\t') +
+            string8(line_terminator) +
+            string8(narrow_cast<std::size_t>(spaces_after), u8' ') + u8"c");
+        lexer l(&code, &null_error_reporter::instance);
+        EXPECT_FALSE(l.peek().has_leading_newline);  // a
+        l.skip();
+        EXPECT_EQ(l.peek().type, token_type::identifier);
+        EXPECT_FALSE(l.peek().has_leading_newline);  // b
+        l.skip();
+        EXPECT_EQ(l.peek().type, token_type::identifier);
+        EXPECT_TRUE(l.peek().has_leading_newline);  // c
+        EXPECT_EQ(l.peek().end - code.data(), code.size());
+      }
+    }
+  }
+}
+
 TEST(test_lex, lex_token_notes_leading_newline_after_comment_with_newline) {
   for (string8_view line_terminator : line_terminators) {
     padded_string code(u8"a /*" + string8(line_terminator) + u8"*/ b");
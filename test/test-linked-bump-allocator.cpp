@@ -0,0 +1,111 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <quick-lint-js/linked-bump-allocator.h>
+#include <utility>
+
+namespace quick_lint_js {
+namespace {
+bool is_aligned(void *p, std::size_t alignment) {
+  return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+TEST(test_linked_bump_allocator, allocations_are_aligned_and_distinct) {
+  linked_bump_allocator alloc;
+  char *a = static_cast<char *>(alloc.allocate(1, 1));
+  std::uint64_t *b =
+      static_cast<std::uint64_t *>(alloc.allocate(8, alignof(std::uint64_t)));
+  char *c = static_cast<char *>(alloc.allocate(3, 1));
+  void *d = alloc.allocate(32, 32);
+  EXPECT_TRUE(is_aligned(b, alignof(std::uint64_t)));
+  EXPECT_TRUE(is_aligned(d, 32));
+
+  *a = 'a';
+  *b = 0x0123456789abcdefULL;
+  std::memcpy(c, "xyz", 3);
+  EXPECT_EQ(*a, 'a');
+  EXPECT_EQ(*b, 0x0123456789abcdefULL);
+  EXPECT_EQ(std::memcmp(c, "xyz", 3), 0);
+}
+
+TEST(test_linked_bump_allocator, allocation_bigger_than_chunk) {
+  linked_bump_allocator alloc;
+  std::size_t size = linked_bump_allocator::default_chunk_size * 3;
+  char *big = static_cast<char *>(alloc.allocate(size, 1));
+  std::memset(big, 'x', size);
+  char *small = static_cast<char *>(alloc.allocate(1, 1));
+  *small = 'y';
+  EXPECT_EQ(big[size - 1], 'x');
+}
+
+TEST(test_linked_bump_allocator, rewind_reuses_memory) {
+  linked_bump_allocator alloc;
+  alloc.allocate(10, 1);
+  linked_bump_allocator::rewind_state state = alloc.prepare_for_rewind();
+  void *first = alloc.allocate(100, 8);
+  alloc.rewind(std::move(state));
+  void *second = alloc.allocate(100, 8);
+  EXPECT_EQ(second, first);
+}
+
+TEST(test_linked_bump_allocator, rewind_before_first_allocation) {
+  linked_bump_allocator alloc;
+  linked_bump_allocator::rewind_state state = alloc.prepare_for_rewind();
+  void *first = alloc.allocate(100, 8);
+  alloc.rewind(std::move(state));
+  void *second = alloc.allocate(100, 8);
+  EXPECT_EQ(second, first);
+}
+
+TEST(test_linked_bump_allocator, rewinding_many_chunks_keeps_memory_bounded) {
+  linked_bump_allocator alloc;
+  std::size_t chunk_size = linked_bump_allocator::default_chunk_size;
+  for (int i = 0; i < 100; ++i) {
+    linked_bump_allocator::rewind_state state = alloc.prepare_for_rewind();
+    for (int j = 0; j < 5; ++j) {
+      alloc.allocate(chunk_size / 2, 1);
+    }
+    alloc.rewind(std::move(state));
+  }
+  EXPECT_LE(alloc.reserved_size(), 3 * chunk_size);
+}
+
+TEST(test_linked_bump_allocator, nested_rewinds) {
+  linked_bump_allocator alloc;
+  char *outer = static_cast<char *>(alloc.allocate(4, 1));
+  std::memcpy(outer, "keep", 4);
+
+  linked_bump_allocator::rewind_state outer_state = alloc.prepare_for_rewind();
+  char *middle = static_cast<char *>(alloc.allocate(6, 1));
+  std::memcpy(middle, "middle", 6);
+  {
+    linked_bump_allocator::rewind_state inner_state =
+        alloc.prepare_for_rewind();
+    alloc.allocate(linked_bump_allocator::default_chunk_size, 1);
+    alloc.rewind(std::move(inner_state));
+  }
+  EXPECT_EQ(std::memcmp(middle, "middle", 6), 0);
+  alloc.rewind(std::move(outer_state));
+
+  EXPECT_EQ(std::memcmp(outer, "keep", 4), 0);
+  EXPECT_EQ(alloc.allocate(6, 1), middle);
+}
+}
+}
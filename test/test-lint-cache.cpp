@@ -0,0 +1,199 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cstdlib>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/have.h>
+#include <quick-lint-js/lint-cache.h>
+#include <quick-lint-js/lint.h>
+#include <quick-lint-js/narrow-cast.h>
+#include <quick-lint-js/output-stream.h>
+#include <quick-lint-js/padded-string.h>
+#include <quick-lint-js/parse.h>
+#include <quick-lint-js/std-filesystem.h>
+#include <quick-lint-js/text-error-reporter.h>
+#include <quick-lint-js/vim-qflist-json-error-reporter.h>
+#include <string>
+
+#if QLJS_HAVE_MKDTEMP
+#include <stdlib.h>
+#endif
+
+namespace quick_lint_js {
+namespace {
+TEST(test_lint_cache_key, same_content_has_same_key) {
+  lint_cache_key a(u8"let x = 42;");
+  lint_cache_key b(u8"let x = 42;");
+  EXPECT_EQ(a.to_string(), b.to_string());
+  EXPECT_EQ(a.to_string().size(), 32);
+}
+
+TEST(test_lint_cache_key, different_content_has_different_key) {
+  string8 code = u8"let x = 42; // a long line which spans multiple blocks";
+  std::string original_key = lint_cache_key(code).to_string();
+  for (std::size_t i = 0; i < code.size(); ++i) {
+    string8 changed_code = code;
+    changed_code[i] = u8'!';
+    EXPECT_NE(lint_cache_key(changed_code).to_string(), original_key)
+        << "changed byte " << i;
+  }
+  EXPECT_NE(lint_cache_key(code.substr(0, code.size() - 1)).to_string(),
+            original_key);
+  EXPECT_NE(lint_cache_key(code + u8'\0').to_string(), original_key);
+}
+
+#if QLJS_HAVE_MKDTEMP
+class test_lint_cache : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    std::string temp_directory_name =
+        (filesystem::temp_directory_path() / "quick-lint-js.XXXXXX").string();
+    if (!::mkdtemp(temp_directory_name.data())) {
+      std::cerr << "failed to create temporary directory\n";
+      std::abort();
+    }
+    this->temp_directory_ = temp_directory_name;
+    this->cache_directory_ = (this->temp_directory_ / "cache").string();
+  }
+
+  void TearDown() override { filesystem::remove_all(this->temp_directory_); }
+
+  std::string lint_with_text_reporter(lint_cache &cache, string8_view code) {
+    padded_string input{string8(code)};
+    memory_output_stream stream;
+    text_error_reporter reporter(&stream);
+    reporter.set_source(&input, "hello.js");
+    lint_with_cache(cache, &input, &reporter);
+    return flush_and_get_string(stream);
+  }
+
+  std::string lint_with_vim_reporter(lint_cache &cache, string8_view code) {
+    padded_string input{string8(code)};
+    memory_output_stream stream;
+    vim_qflist_json_error_reporter reporter(&stream);
+    reporter.set_source(&input, "hello.js", /*vim_bufnr=*/3);
+    lint_with_cache(cache, &input, &reporter);
+    reporter.finish();
+    return flush_and_get_string(stream);
+  }
+
+  static void lint_with_cache(lint_cache &cache, padded_string *input,
+                              error_reporter *reporter) {
+    lint_cache_key key(string8_view(input->data(),
+                                     narrow_cast<std::size_t>(input->size())));
+    if (cache.load(key, input, reporter)) {
+      return;
+    }
+    lint_cache_recording_error_reporter recorder(reporter, input);
+    parser p(input, &recorder);
+    linter l(&recorder);
+    p.parse_and_visit_module(l);
+    cache.store(key, recorder);
+  }
+
+  static std::string flush_and_get_string(memory_output_stream &stream) {
+    stream.flush();
+    string8 output = stream.get_flushed_string8();
+    return std::string(reinterpret_cast<const char *>(output.data()),
+                       output.size());
+  }
+
+  filesystem::path temp_directory_;
+  std::string cache_directory_;
+};
+
+TEST_F(test_lint_cache, hit_reproduces_output_of_miss) {
+  // Cover each kind of error field, including identifiers containing escape
+  // sequences (which the lexer rewrites).
+  string8_view code =
+      u8"const c = 1;\n"
+      u8"c = 2;\n"
+      u8"\\u{61}bc;\n"
+      u8"let x = 0123n;\n"
+      u8"x = y;\n";
+  lint_cache cache(this->cache_directory_.c_str());
+
+  std::string text_output = this->lint_with_text_reporter(cache, code);
+  EXPECT_EQ(cache.hit_count(), 0);
+  EXPECT_EQ(cache.miss_count(), 1);
+  EXPECT_EQ(this->lint_with_text_reporter(cache, code), text_output);
+  EXPECT_EQ(cache.hit_count(), 1);
+  EXPECT_EQ(cache.miss_count(), 1);
+
+  // Entries do not depend on the output format.
+  lint_cache uncached_cache((this->cache_directory_ + "-other").c_str());
+  std::string vim_output =
+      this->lint_with_vim_reporter(uncached_cache, code);
+  EXPECT_EQ(this->lint_with_vim_reporter(cache, code), vim_output);
+  EXPECT_EQ(cache.hit_count(), 2);
+  EXPECT_EQ(cache.miss_count(), 1);
+}
+
+TEST_F(test_lint_cache, file_without_errors_is_cached) {
+  lint_cache cache(this->cache_directory_.c_str());
+  EXPECT_EQ(this->lint_with_text_reporter(cache, u8"let x;"), "");
+  EXPECT_EQ(this->lint_with_text_reporter(cache, u8"let x;"), "");
+  EXPECT_EQ(cache.hit_count(), 1);
+  EXPECT_EQ(cache.miss_count(), 1);
+}
+
+TEST_F(test_lint_cache, different_content_misses) {
+  lint_cache cache(this->cache_directory_.c_str());
+  EXPECT_EQ(this->lint_with_text_reporter(cache, u8"let x; x;"), "");
+  EXPECT_EQ(this->lint_with_text_reporter(cache, u8"let x; y;"),
+            "hello.js:1:8: error: use of undeclared variable: y\n");
+  EXPECT_EQ(cache.hit_count(), 0);
+  EXPECT_EQ(cache.miss_count(), 2);
+}
+
+TEST_F(test_lint_cache, cache_persists_between_instances) {
+  string8_view code = u8"undeclaredVariable;";
+  std::string miss_output;
+  {
+    lint_cache cache(this->cache_directory_.c_str());
+    miss_output = this->lint_with_text_reporter(cache, code);
+  }
+  lint_cache cache(this->cache_directory_.c_str());
+  EXPECT_EQ(this->lint_with_text_reporter(cache, code), miss_output);
+  EXPECT_EQ(cache.hit_count(), 1);
+  EXPECT_EQ(cache.miss_count(), 0);
+}
+
+TEST_F(test_lint_cache, corrupt_entry_is_a_miss) {
+  string8_view code = u8"undeclaredVariable;";
+  lint_cache cache(this->cache_directory_.c_str());
+  std::string miss_output = this->lint_with_text_reporter(cache, code);
+
+  std::string entry_path =
+      this->cache_directory_ + "/" + lint_cache_key(code).to_string();
+  std::ofstream(entry_path, std::ios::binary | std::ios::trunc)
+      << "qljs-lint-cache\n"
+      << "garbage";
+
+  EXPECT_EQ(this->lint_with_text_reporter(cache, code), miss_output);
+  EXPECT_EQ(cache.hit_count(), 0);
+  EXPECT_EQ(cache.miss_count(), 2);
+
+  // The corrupt entry was replaced.
+  EXPECT_EQ(this->lint_with_text_reporter(cache, code), miss_output);
+  EXPECT_EQ(cache.hit_count(), 1);
+}
+#endif
+}
+}
@@ -0,0 +1,390 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cstdint>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <optional>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/have.h>
+#include <quick-lint-js/lint-server.h>
+#include <quick-lint-js/options.h>
+#include <string>
+#include <thread>
+
+#if QLJS_HAVE_UNIX_DOMAIN_SOCKETS
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <quick-lint-js/std-filesystem.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace quick_lint_js {
+namespace {
+std::string to_string(string8_view s) {
+  return std::string(reinterpret_cast<const char *>(s.data()), s.size());
+}
+
+// Send a request through a lint_server_session, without a socket.
+lint_response handle(lint_server_session &session,
+                     const lint_request &request) {
+  string8 encoded_request = encode_lint_request(request);
+  string8 response;
+  session.handle_request(string8_view(encoded_request).substr(4), &response);
+  EXPECT_GE(response.size(), 4);
+  std::optional<lint_response> decoded =
+      decode_lint_response(string8_view(response).substr(4));
+  EXPECT_TRUE(decoded.has_value());
+  return *decoded;
+}
+
+TEST(test_lint_server_session, lint_content_with_gnu_like_output) {
+  lint_server_session session;
+  lint_request request;
+  request.files.push_back(lint_request_file{
+      .path = "hello.js",
+      .vim_bufnr = std::nullopt,
+      .content = string8(u8"let x; x; y;"),
+  });
+  lint_response response = handle(session, request);
+  EXPECT_EQ(response.status, lint_response_status::ok);
+  EXPECT_EQ(to_string(response.output),
+            "hello.js:1:11: error: use of undeclared variable: y\n");
+}
+
+TEST(test_lint_server_session, lint_multiple_files_with_vim_output) {
+  lint_server_session session;
+  lint_request request;
+  request.output_format = output_format::vim_qflist_json;
+  request.files.push_back(lint_request_file{
+      .path = "a.js",
+      .vim_bufnr = 7,
+      .content = string8(u8"a;"),
+  });
+  request.files.push_back(lint_request_file{
+      .path = "b.js",
+      .vim_bufnr = std::nullopt,
+      .content = string8(u8"b;"),
+  });
+  lint_response response = handle(session, request);
+  EXPECT_EQ(response.status, lint_response_status::ok);
+  EXPECT_EQ(to_string(response.output),
+            "{\"qflist\": [{\"col\": 1, \"lnum\": 1, \"end_col\": 1, "
+            "\"end_lnum\": 1, \"vcol\": 0, \"text\": \"use of undeclared "
+            "variable: a\", \"bufnr\": 7, \"filename\": \"a.js\"},\n"
+            "{\"col\": 1, \"lnum\": 1, \"end_col\": 1, \"end_lnum\": 1, "
+            "\"vcol\": 0, \"text\": \"use of undeclared variable: b\", "
+            "\"filename\": \"b.js\"}]}");
+}
+
+TEST(test_lint_server_session, session_can_be_reused) {
+  lint_server_session session;
+  for (const char8 *code : {u8"longVariableName;", u8"x;", u8""}) {
+    lint_request request;
+    request.files.push_back(lint_request_file{
+        .path = "file.js",
+        .vim_bufnr = std::nullopt,
+        .content = string8(code),
+    });
+    lint_response response = handle(session, request);
+    EXPECT_EQ(response.status, lint_response_status::ok);
+    string8 expected;
+    if (*code != u8'\0') {
+      string8 name(code, strlen(code) - 1);
+      expected = u8"file.js:1:1: error: use of undeclared variable: " + name +
+                 u8"\n";
+    }
+    EXPECT_EQ(response.output, expected);
+  }
+}
+
+TEST(test_lint_server_session, missing_file_is_an_error) {
+  lint_server_session session;
+  lint_request request;
+  request.files.push_back(lint_request_file{
+      .path = "/this/file/does/not/exist.js",
+      .vim_bufnr = std::nullopt,
+      .content = std::nullopt,
+  });
+  lint_response response = handle(session, request);
+  EXPECT_EQ(response.status, lint_response_status::error);
+  EXPECT_NE(to_string(response.output).find("/this/file/does/not/exist.js"),
+            std::string::npos)
+      << to_string(response.output);
+}
+
+TEST(test_lint_server_session, unimplemented_syntax_is_an_error) {
+  lint_server_session session;
+  for (const char8 *code : {u8"if (", u8"\u20ac"}) {
+    lint_request request;
+    request.files.push_back(lint_request_file{
+        .path = "unimplemented.js",
+        .vim_bufnr = std::nullopt,
+        .content = string8(code),
+    });
+    lint_response response = handle(session, request);
+    EXPECT_EQ(response.status, lint_response_status::error);
+    EXPECT_NE(to_string(response.output).find("unimplemented.js: "),
+              std::string::npos)
+        << to_string(response.output);
+    EXPECT_NE(to_string(response.output).find(" not implemented in "),
+              std::string::npos)
+        << to_string(response.output);
+  }
+
+  // The session can be used again.
+  lint_request request;
+  request.files.push_back(lint_request_file{
+      .path = "file.js",
+      .vim_bufnr = std::nullopt,
+      .content = string8(u8"x;"),
+  });
+  lint_response response = handle(session, request);
+  EXPECT_EQ(response.status, lint_response_status::ok);
+  EXPECT_EQ(to_string(response.output),
+            "file.js:1:1: error: use of undeclared variable: x\n");
+}
+
+TEST(test_lint_server_session, truncated_request_is_an_error) {
+  lint_request request;
+  request.files.push_back(lint_request_file{
+      .path = "file.js",
+      .vim_bufnr = std::nullopt,
+      .content = string8(u8"x;"),
+  });
+  string8 encoded_request = encode_lint_request(request);
+  string8_view request_body = string8_view(encoded_request).substr(4);
+
+  lint_server_session session;
+  for (std::size_t size = 0; size < request_body.size(); ++size) {
+    SCOPED_TRACE(size);
+    string8 response;
+    session.handle_request(request_body.substr(0, size), &response);
+    std::optional<lint_response> decoded =
+        decode_lint_response(string8_view(response).substr(4));
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->status, lint_response_status::error);
+  }
+}
+
+#if QLJS_HAVE_UNIX_DOMAIN_SOCKETS
+class test_lint_socket_server : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    std::string temp_directory_name =
+        (filesystem::temp_directory_path() / "quick-lint-js.XXXXXX").string();
+    if (!::mkdtemp(temp_directory_name.data())) {
+      std::cerr << "failed to create temporary directory\n";
+      std::abort();
+    }
+    this->temp_directory_ = temp_directory_name;
+  }
+
+  void TearDown() override { filesystem::remove_all(this->temp_directory_); }
+
+  filesystem::path temp_directory_;
+};
+
+TEST_F(test_lint_socket_server, lint_over_socket) {
+  std::string socket_path = (this->temp_directory_ / "server.sock").string();
+  std::string js_path = (this->temp_directory_ / "on-disk.js").string();
+  std::ofstream(js_path) << "onDisk;";
+
+  lint_socket_server server(socket_path.c_str());
+  ASSERT_TRUE(server.ok()) << server.error();
+  std::thread server_thread([&]() -> void { server.run(); });
+
+  {
+    lint_client client(socket_path.c_str());
+    ASSERT_TRUE(client.ok()) << client.error();
+
+    lint_request content_request;
+    content_request.files.push_back(lint_request_file{
+        .path = "in-memory.js",
+        .vim_bufnr = std::nullopt,
+        .content = string8(u8"inMemory;"),
+    });
+    std::optional<lint_response> response = client.send(content_request);
+    ASSERT_TRUE(response.has_value()) << client.error();
+    EXPECT_EQ(to_string(response->output),
+              "in-memory.js:1:1: error: use of undeclared variable: "
+              "inMemory\n");
+
+    // The same connection can be used again.
+    lint_request path_request;
+    path_request.files.push_back(lint_request_file{
+        .path = js_path,
+        .vim_bufnr = std::nullopt,
+        .content = std::nullopt,
+    });
+    response = client.send(path_request);
+    ASSERT_TRUE(response.has_value()) << client.error();
+    EXPECT_EQ(to_string(response->output),
+              js_path + ":1:1: error: use of undeclared variable: onDisk\n");
+  }
+
+  // stop() should disconnect clients which are still connected.
+  lint_client idle_client(socket_path.c_str());
+  ASSERT_TRUE(idle_client.ok()) << idle_client.error();
+
+  server.stop();
+  server_thread.join();
+}
+
+TEST_F(test_lint_socket_server, unimplemented_syntax_fails_only_its_request) {
+  std::string socket_path = (this->temp_directory_ / "server.sock").string();
+  lint_socket_server server(socket_path.c_str());
+  ASSERT_TRUE(server.ok()) << server.error();
+  std::thread server_thread([&]() -> void { server.run(); });
+
+  {
+    lint_client client(socket_path.c_str());
+    ASSERT_TRUE(client.ok()) << client.error();
+
+    lint_request unimplemented_request;
+    unimplemented_request.files.push_back(lint_request_file{
+        .path = "unimplemented.js",
+        .vim_bufnr = std::nullopt,
+        // The lexer does not implement this character.
+        .content = string8(u8"\u20ac"),
+    });
+    std::optional<lint_response> response = client.send(unimplemented_request);
+    ASSERT_TRUE(response.has_value()) << client.error();
+    EXPECT_EQ(response->status, lint_response_status::error);
+
+    // The same connection can be used again.
+    lint_request request;
+    request.files.push_back(lint_request_file{
+        .path = "file.js",
+        .vim_bufnr = std::nullopt,
+        .content = string8(u8"x;"),
+    });
+    response = client.send(request);
+    ASSERT_TRUE(response.has_value()) << client.error();
+    EXPECT_EQ(response->status, lint_response_status::ok);
+    EXPECT_EQ(to_string(response->output),
+              "file.js:1:1: error: use of undeclared variable: x\n");
+  }
+
+  server.stop();
+  server_thread.join();
+}
+
+TEST_F(test_lint_socket_server, oversized_message_disconnects_client) {
+  std::string socket_path = (this->temp_directory_ / "server.sock").string();
+  lint_socket_server server(socket_path.c_str());
+  ASSERT_TRUE(server.ok()) << server.error();
+  std::thread server_thread([&]() -> void { server.run(); });
+
+  {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_NE(fd, -1) << std::strerror(errno);
+    ::sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, socket_path.c_str());
+    ASSERT_EQ(::connect(fd, reinterpret_cast<const ::sockaddr *>(&address),
+                        sizeof(address)),
+              0)
+        << std::strerror(errno);
+    std::uint32_t size = max_lint_message_size + 1;
+    unsigned char size_field[4] = {
+        static_cast<unsigned char>(size & 0xff),
+        static_cast<unsigned char>((size >> 8) & 0xff),
+        static_cast<unsigned char>((size >> 16) & 0xff),
+        static_cast<unsigned char>((size >> 24) & 0xff),
+    };
+    ASSERT_EQ(::write(fd, size_field, sizeof(size_field)), 4);
+    char byte;
+    EXPECT_EQ(::read(fd, &byte, 1), 0) << "server should disconnect";
+    ::close(fd);
+  }
+
+  // The server should still serve other clients.
+  lint_client client(socket_path.c_str());
+  ASSERT_TRUE(client.ok()) << client.error();
+  lint_request request;
+  request.files.push_back(lint_request_file{
+      .path = "file.js",
+      .vim_bufnr = std::nullopt,
+      .content = string8(u8"x;"),
+  });
+  std::optional<lint_response> response = client.send(request);
+  ASSERT_TRUE(response.has_value()) << client.error();
+  EXPECT_EQ(response->status, lint_response_status::ok);
+
+  server.stop();
+  server_thread.join();
+}
+
+TEST_F(test_lint_socket_server, second_server_on_same_socket_fails) {
+  std::string socket_path = (this->temp_directory_ / "server.sock").string();
+  lint_socket_server server_1(socket_path.c_str());
+  ASSERT_TRUE(server_1.ok()) << server_1.error();
+  lint_socket_server server_2(socket_path.c_str());
+  EXPECT_FALSE(server_2.ok());
+}
+
+TEST_F(test_lint_socket_server, stale_socket_file_is_replaced) {
+  std::string socket_path = (this->temp_directory_ / "server.sock").string();
+  {
+    lint_socket_server server(socket_path.c_str());
+    ASSERT_TRUE(server.ok()) << server.error();
+  }
+  // Simulate a server which crashed without deleting its socket file.
+  {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_NE(fd, -1) << std::strerror(errno);
+    ::sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, socket_path.c_str());
+    ASSERT_EQ(::bind(fd, reinterpret_cast<const ::sockaddr *>(&address),
+                     sizeof(address)),
+              0)
+        << std::strerror(errno);
+    ::close(fd);
+  }
+  lint_socket_server server(socket_path.c_str());
+  EXPECT_TRUE(server.ok()) << server.error();
+}
+
+TEST_F(test_lint_socket_server, non_socket_file_is_not_replaced) {
+  std::string path = (this->temp_directory_ / "notes.txt").string();
+  std::ofstream(path) << "important";
+  lint_socket_server server(path.c_str());
+  EXPECT_FALSE(server.ok());
+  EXPECT_NE(server.error().find("not a socket"), std::string::npos)
+      << server.error();
+
+  std::string content;
+  std::ifstream(path) >> content;
+  EXPECT_EQ(content, "important");
+}
+
+TEST_F(test_lint_socket_server, client_fails_if_no_server_is_listening) {
+  std::string socket_path = (this->temp_directory_ / "nobody.sock").string();
+  lint_client client(socket_path.c_str());
+  EXPECT_FALSE(client.ok());
+}
+#endif
+}
+}
@@ -23,6 +23,8 @@
 #include <quick-lint-js/language.h>
 #include <quick-lint-js/lex.h>
 #include <quick-lint-js/lint.h>
+#include <string>
+#include <vector>
 
 using ::testing::IsEmpty;
 using ::testing::UnorderedElementsAre;
@@ -37,6 +39,12 @@ identifier identifier_of(const char8 *name) {
   return identifier(span_of(name));
 }
 
+// Returns u8"v0", u8"v1", etc.
+string8 numbered_variable_name(int i) {
+  std::string digits = std::to_string(i);
+  return u8"v" + string8(digits.begin(), digits.end());
+}
+
 constexpr const char8 *writable_global_variables[] = {
     // ECMA-262 18.1 Value Properties of the Global Object
     u8"globalThis",
@@ -1487,6 +1495,70 @@ TEST(test_lint, declaring_variable_twice_is_an_error) {
                       original_declaration, span_matcher(declaration))));
 }
 
+TEST(test_lint, declaring_variable_twice_in_scope_with_many_variables) {
+  std::vector<string8> names;
+  for (int i = 0; i < 100; ++i) {
+    names.push_back(numbered_variable_name(i));
+  }
+  const char8 declaration[] = u8"v42";
+  const char8 second_declaration[] = u8"v42";
+
+  // let v0, v1, /* ... */, v99;
+  // let v42;  // ERROR
+  error_collector v;
+  linter l(&v);
+  for (const string8 &name : names) {
+    if (name == declaration) {
+      l.visit_variable_declaration(identifier_of(declaration),
+                                   variable_kind::_let);
+    } else {
+      l.visit_variable_declaration(identifier_of(name.c_str()),
+                                   variable_kind::_let);
+    }
+  }
+  l.visit_variable_declaration(identifier_of(second_declaration),
+                               variable_kind::_let);
+  l.visit_end_of_module();
+
+  EXPECT_THAT(v.errors,
+              ElementsAre(ERROR_TYPE_2_FIELDS(
+                  error_redeclaration_of_variable,                  //
+                  redeclaration, span_matcher(second_declaration),  //
+                  original_declaration, span_matcher(declaration))));
+}
+
+TEST(test_lint, uses_of_variables_in_scope_with_many_variables) {
+  std::vector<string8> names;
+  for (int i = 0; i < 100; ++i) {
+    names.push_back(numbered_variable_name(i));
+  }
+  const char8 undeclared_use[] = u8"v100";
+
+  // let v0, v1, /* ... */, v99;
+  // (() => {
+  //   v0; v1; /* ... */; v99;
+  //   v100;  // ERROR
+  // });
+  error_collector v;
+  linter l(&v);
+  for (const string8 &name : names) {
+    l.visit_variable_declaration(identifier_of(name.c_str()),
+                                 variable_kind::_let);
+  }
+  l.visit_enter_function_scope();
+  l.visit_enter_function_scope_body();
+  for (const string8 &name : names) {
+    l.visit_variable_use(identifier_of(name.c_str()));
+  }
+  l.visit_variable_use(identifier_of(undeclared_use));
+  l.visit_exit_function_scope();
+  l.visit_end_of_module();
+
+  EXPECT_THAT(v.errors, ElementsAre(ERROR_TYPE_FIELD(
+                            error_use_of_undeclared_variable, name,
+                            span_matcher(undeclared_use))));
+}
+
 TEST(test_lint, declaring_variable_twice_with_var_is_okay) {
   const char8 declaration[] = u8"x";
   const char8 second_declaration[] = u8"x";
@@ -0,0 +1,73 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/lsp-location.h>
+#include <quick-lint-js/padded-string.h>
+
+namespace quick_lint_js {
+namespace {
+TEST(test_lsp_location, positions_on_first_line) {
+  padded_string code(u8"hello world");
+  lsp_locator l(&code);
+  EXPECT_EQ(l.position(&code[0]), (lsp_position{0, 0}));
+  EXPECT_EQ(l.position(&code[6]), (lsp_position{0, 6}));
+  EXPECT_EQ(l.position(code.data() + code.size()), (lsp_position{0, 11}));
+}
+
+TEST(test_lsp_location, lines_end_with_lf_crlf_or_cr) {
+  padded_string code(u8"a\nb\r\nc\rd");
+  lsp_locator l(&code);
+  EXPECT_EQ(l.position(&code[0]), (lsp_position{0, 0}));
+  EXPECT_EQ(l.position(&code[2]), (lsp_position{1, 0}));
+  EXPECT_EQ(l.position(&code[5]), (lsp_position{2, 0}));
+  EXPECT_EQ(l.position(&code[7]), (lsp_position{3, 0}));
+}
+
+TEST(test_lsp_location, unicode_line_separators_do_not_end_lines) {
+  padded_string code(u8"a b");
+  lsp_locator l(&code);
+  EXPECT_EQ(l.position(&code[4]), (lsp_position{0, 2}));
+}
+
+TEST(test_lsp_location, characters_count_utf_16_code_units) {
+  // U+00E9 is 2 UTF-8 bytes and 1 UTF-16 code unit.
+  // U+1F600 is 4 UTF-8 bytes and 2 UTF-16 code units.
+  padded_string code(u8"é\U0001f600x");
+  lsp_locator l(&code);
+  EXPECT_EQ(l.position(&code[2]), (lsp_position{0, 1}));
+  EXPECT_EQ(l.position(&code[6]), (lsp_position{0, 3}));
+}
+
+TEST(test_lsp_location, from_position_is_inverse_of_position) {
+  padded_string code(u8"one\né\U0001f600two\r\nthree");
+  lsp_locator l(&code);
+  for (int offset : {0, 2, 4, 6, 10, 15, code.size()}) {
+    const char8 *c = code.data() + offset;
+    EXPECT_EQ(l.from_position(l.position(c)) - code.data(), offset);
+  }
+}
+
+TEST(test_lsp_location, from_position_clamps_to_end_of_line) {
+  padded_string code(u8"abc\r\ndef");
+  lsp_locator l(&code);
+  EXPECT_EQ(l.from_position(lsp_position{0, 100}) - code.data(), 3);
+  EXPECT_EQ(l.from_position(lsp_position{1, 100}) - code.data(), code.size());
+  EXPECT_EQ(l.from_position(lsp_position{100, 0}) - code.data(), code.size());
+}
+}
+}
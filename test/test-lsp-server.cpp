@@ -0,0 +1,259 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+#include <json/reader.h>
+#include <json/value.h>
+#include <optional>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/lsp-server.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace quick_lint_js {
+namespace {
+string8 make_message(std::string_view body) {
+  std::string message = "Content-Length: " + std::to_string(body.size()) +
+                        "\r\n\r\n" + std::string(body);
+  return string8(message.begin(), message.end());
+}
+
+std::vector<::Json::Value> parse_messages(const string8 &out) {
+  lsp_message_parser parser;
+  parser.append(out);
+  std::vector<::Json::Value> messages;
+  while (std::optional<string8_view> body = parser.next_message()) {
+    std::istringstream stream(std::string(
+        reinterpret_cast<const char *>(body->data()), body->size()));
+    ::Json::Value root;
+    ::Json::CharReaderBuilder builder;
+    builder.strictMode(&builder.settings_);
+    ::Json::String errors;
+    bool ok = ::Json::parseFromStream(builder, stream, &root, &errors);
+    EXPECT_TRUE(ok) << errors;
+    messages.push_back(root);
+  }
+  return messages;
+}
+
+class test_lsp_server : public ::testing::Test {
+ protected:
+  // Handle messages, then publish diagnostics. Returns all messages sent to
+  // the client.
+  std::vector<::Json::Value> send(std::vector<std::string_view> bodies) {
+    string8 out;
+    for (std::string_view body : bodies) {
+      string8 message = make_message(body);
+      this->parser_.append(message);
+      while (std::optional<string8_view> m = this->parser_.next_message()) {
+        this->server_.handle_message(*m, &out);
+      }
+    }
+    this->server_.publish_pending_diagnostics(&out);
+    return parse_messages(out);
+  }
+
+  lsp_server server_;
+  lsp_message_parser parser_;
+};
+
+TEST(test_lsp_message_parser, message_split_across_appends) {
+  string8 message = make_message("{\"hello\":1}");
+  lsp_message_parser parser;
+  for (std::size_t i = 0; i < message.size(); ++i) {
+    EXPECT_FALSE(parser.next_message().has_value()) << i;
+    parser.append(string8_view(&message[i], 1));
+  }
+  std::optional<string8_view> body = parser.next_message();
+  ASSERT_TRUE(body.has_value());
+  EXPECT_EQ(*body, string8_view(u8"{\"hello\":1}"));
+  EXPECT_FALSE(parser.next_message().has_value());
+}
+
+TEST(test_lsp_message_parser, multiple_messages_in_one_append) {
+  lsp_message_parser parser;
+  parser.append(u8"Content-Length: 2\r\n\r\n[]"
+                u8"content-length:1\r\nContent-Type: x\r\n\r\n7");
+  EXPECT_EQ(parser.next_message(), string8_view(u8"[]"));
+  EXPECT_EQ(parser.next_message(), string8_view(u8"7"));
+  EXPECT_EQ(parser.next_message(), std::nullopt);
+}
+
+TEST_F(test_lsp_server, initialize) {
+  std::vector<::Json::Value> messages = this->send({
+      R"({"jsonrpc":"2.0","id":1,"method":"initialize","params":{}})",
+  });
+  ASSERT_EQ(messages.size(), 1);
+  EXPECT_EQ(messages[0]["id"], 1);
+  EXPECT_EQ(
+      messages[0]["result"]["capabilities"]["textDocumentSync"]["change"], 2);
+}
+
+TEST_F(test_lsp_server, opening_document_publishes_diagnostics) {
+  std::vector<::Json::Value> messages = this->send({
+      R"({"jsonrpc":"2.0","method":"textDocument/didOpen","params":{
+        "textDocument":{"uri":"file:///test.js","languageId":"javascript",
+                        "version":3,"text":"let x;\n\"é\";y;"}}})",
+  });
+  ASSERT_EQ(messages.size(), 1);
+  EXPECT_EQ(messages[0]["method"], "textDocument/publishDiagnostics");
+  const ::Json::Value &params = messages[0]["params"];
+  EXPECT_EQ(params["uri"], "file:///test.js");
+  EXPECT_EQ(params["version"], 3);
+  ASSERT_EQ(params["diagnostics"].size(), 1);
+  const ::Json::Value &diagnostic = params["diagnostics"][0];
+  EXPECT_EQ(diagnostic["message"], "use of undeclared variable: y");
+  EXPECT_EQ(diagnostic["range"]["start"]["line"], 1);
+  // U+00E9 is one UTF-16 code unit but two UTF-8 bytes.
+  EXPECT_EQ(diagnostic["range"]["start"]["character"], 4);
+  EXPECT_EQ(diagnostic["range"]["end"]["character"], 5);
+}
+
+TEST_F(test_lsp_server, incremental_changes_are_applied_in_order) {
+  this->send({
+      R"({"jsonrpc":"2.0","method":"textDocument/didOpen","params":{
+        "textDocument":{"uri":"file:///test.js","languageId":"javascript",
+                        "version":1,"text":"let abc;\nabc;"}}})",
+  });
+  std::vector<::Json::Value> messages = this->send({
+      // Rename the use: abc -> abd.
+      R"({"jsonrpc":"2.0","method":"textDocument/didChange","params":{
+        "textDocument":{"uri":"file:///test.js","version":2},
+        "contentChanges":[
+          {"range":{"start":{"line":1,"character":2},
+                    "end":{"line":1,"character":3}},
+           "text":"d"}]}})",
+      // Insert a new line at the beginning.
+      R"({"jsonrpc":"2.0","method":"textDocument/didChange","params":{
+        "textDocument":{"uri":"file:///test.js","version":3},
+        "contentChanges":[
+          {"range":{"start":{"line":0,"character":0},
+                    "end":{"line":0,"character":0}},
+           "text":"// comment\n"}]}})",
+  });
+  // Both changes are linted together.
+  ASSERT_EQ(messages.size(), 1);
+  const ::Json::Value &params = messages[0]["params"];
+  EXPECT_EQ(params["version"], 3);
+  ASSERT_EQ(params["diagnostics"].size(), 1);
+  EXPECT_EQ(params["diagnostics"][0]["message"],
+            "use of undeclared variable: abd");
+  EXPECT_EQ(params["diagnostics"][0]["range"]["start"]["line"], 2);
+}
+
+TEST_F(test_lsp_server, full_change_replaces_document) {
+  this->send({
+      R"({"jsonrpc":"2.0","method":"textDocument/didOpen","params":{
+        "textDocument":{"uri":"file:///test.js","languageId":"javascript",
+                        "version":1,"text":"a;"}}})",
+  });
+  std::vector<::Json::Value> messages = this->send({
+      R"({"jsonrpc":"2.0","method":"textDocument/didChange","params":{
+        "textDocument":{"uri":"file:///test.js","version":2},
+        "contentChanges":[{"text":"let a; a;"}]}})",
+  });
+  ASSERT_EQ(messages.size(), 1);
+  EXPECT_EQ(messages[0]["params"]["diagnostics"].size(), 0);
+}
+
+TEST_F(test_lsp_server, incomplete_code_publishes_fatal_error_diagnostic) {
+  this->send({
+      R"({"jsonrpc":"2.0","method":"textDocument/didOpen","params":{
+        "textDocument":{"uri":"file:///test.js","languageId":"javascript",
+                        "version":1,"text":"a;"}}})",
+  });
+  std::vector<::Json::Value> messages = this->send({
+      R"({"jsonrpc":"2.0","method":"textDocument/didChange","params":{
+        "textDocument":{"uri":"file:///test.js","version":2},
+        "contentChanges":[{"text":"1__0;\nif ("}]}})",
+  });
+  ASSERT_EQ(messages.size(), 1);
+  const ::Json::Value &diagnostics = messages[0]["params"]["diagnostics"];
+  ASSERT_EQ(diagnostics.size(), 2);
+  EXPECT_EQ(diagnostics[0]["message"],
+            "number literal contains consecutive underscores");
+  EXPECT_NE(diagnostics[1]["message"].asString().find(
+                "fatal: token not implemented"),
+            std::string::npos)
+      << diagnostics[1]["message"];
+  EXPECT_EQ(diagnostics[1]["severity"], 1);
+  EXPECT_EQ(diagnostics[1]["range"]["start"]["line"], 1);
+  EXPECT_EQ(diagnostics[1]["range"]["start"]["character"], 4);
+
+  // The server keeps working.
+  messages = this->send({
+      R"({"jsonrpc":"2.0","method":"textDocument/didChange","params":{
+        "textDocument":{"uri":"file:///test.js","version":3},
+        "contentChanges":[{"text":"c;"}]}})",
+  });
+  ASSERT_EQ(messages.size(), 1);
+  ASSERT_EQ(messages[0]["params"]["diagnostics"].size(), 1);
+  EXPECT_EQ(messages[0]["params"]["diagnostics"][0]["message"],
+            "use of undeclared variable: c");
+}
+
+TEST_F(test_lsp_server, closing_document_clears_diagnostics) {
+  this->send({
+      R"({"jsonrpc":"2.0","method":"textDocument/didOpen","params":{
+        "textDocument":{"uri":"file:///test.js","languageId":"javascript",
+                        "version":1,"text":"a;"}}})",
+  });
+  std::vector<::Json::Value> messages = this->send({
+      R"({"jsonrpc":"2.0","method":"textDocument/didClose","params":{
+        "textDocument":{"uri":"file:///test.js"}}})",
+  });
+  ASSERT_EQ(messages.size(), 1);
+  EXPECT_EQ(messages[0]["params"]["uri"], "file:///test.js");
+  EXPECT_EQ(messages[0]["params"]["diagnostics"].size(), 0);
+}
+
+TEST_F(test_lsp_server, unknown_request_is_an_error) {
+  std::vector<::Json::Value> messages = this->send({
+      R"({"jsonrpc":"2.0","id":"abc","method":"textDocument/hover"})",
+  });
+  ASSERT_EQ(messages.size(), 1);
+  EXPECT_EQ(messages[0]["id"], "abc");
+  EXPECT_EQ(messages[0]["error"]["code"], -32601);
+}
+
+TEST_F(test_lsp_server, malformed_json_is_an_error) {
+  std::vector<::Json::Value> messages = this->send({"{not json"});
+  ASSERT_EQ(messages.size(), 1);
+  EXPECT_TRUE(messages[0]["id"].isNull());
+  EXPECT_EQ(messages[0]["error"]["code"], -32700);
+}
+
+TEST_F(test_lsp_server, exit_after_shutdown) {
+  std::vector<::Json::Value> messages = this->send({
+      R"({"jsonrpc":"2.0","id":1,"method":"shutdown"})",
+  });
+  ASSERT_EQ(messages.size(), 1);
+  EXPECT_TRUE(messages[0]["result"].isNull());
+  EXPECT_FALSE(this->server_.should_exit());
+
+  this->send({R"({"jsonrpc":"2.0","method":"exit"})"});
+  EXPECT_TRUE(this->server_.should_exit());
+  EXPECT_EQ(this->server_.exit_code(), 0);
+}
+
+TEST_F(test_lsp_server, exit_without_shutdown_fails) {
+  this->send({R"({"jsonrpc":"2.0","method":"exit"})"});
+  EXPECT_TRUE(this->server_.should_exit());
+  EXPECT_EQ(this->server_.exit_code(), 1);
+}
+}
+}
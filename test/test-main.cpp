@@ -0,0 +1,187 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cstdlib>
+#include <fstream>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/file.h>
+#include <quick-lint-js/have.h>
+#include <quick-lint-js/std-filesystem.h>
+#include <string>
+#include <vector>
+
+#if QLJS_HAVE_MKDTEMP && QLJS_HAVE_SYS_WAIT_H && QLJS_HAVE_UNISTD_H
+#include <fcntl.h>
+#include <spawn.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+#endif
+
+using ::testing::HasSubstr;
+
+namespace quick_lint_js {
+namespace {
+#if QLJS_HAVE_MKDTEMP && QLJS_HAVE_SYS_WAIT_H && QLJS_HAVE_UNISTD_H
+// Runs the quick-lint-js program.
+class test_main : public ::testing::Test {
+ protected:
+  struct run_result {
+    // As returned by waitpid.
+    int status;
+    // stdout and stderr, interleaved.
+    std::string output;
+  };
+
+  void SetUp() override {
+    std::string temp_directory_name =
+        (filesystem::temp_directory_path() / "quick-lint-js.XXXXXX").string();
+    if (!::mkdtemp(temp_directory_name.data())) {
+      std::cerr << "failed to create temporary directory\n";
+      std::abort();
+    }
+    this->temp_directory_ = temp_directory_name;
+  }
+
+  void TearDown() override { filesystem::remove_all(this->temp_directory_); }
+
+  // Returns the file's path.
+  std::string write_file(const std::string &name, const std::string &content) {
+    std::string path = (this->temp_directory_ / name).string();
+    std::ofstream(path) << content;
+    return path;
+  }
+
+  // If stdout_path is given, stdout is redirected to it, and
+  // run_result::output has only stderr.
+  run_result run_quick_lint_js(const std::vector<std::string> &arguments,
+                               const char *stdout_path = nullptr) {
+    std::string output_path = (this->temp_directory_ / "output").string();
+
+    ::posix_spawn_file_actions_t file_actions;
+    ::posix_spawn_file_actions_init(&file_actions);
+    ::posix_spawn_file_actions_addopen(&file_actions, STDERR_FILENO,
+                                       output_path.c_str(),
+                                       O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (stdout_path) {
+      ::posix_spawn_file_actions_addopen(&file_actions, STDOUT_FILENO,
+                                         stdout_path, O_WRONLY, 0);
+    } else {
+      ::posix_spawn_file_actions_adddup2(&file_actions, STDERR_FILENO,
+                                         STDOUT_FILENO);
+    }
+    std::vector<char *> argv;
+    argv.push_back(const_cast<char *>(QLJS_TEST_QUICK_LINT_JS_EXE));
+    for (const std::string &argument : arguments) {
+      argv.push_back(const_cast<char *>(argument.c_str()));
+    }
+    argv.push_back(nullptr);
+    ::pid_t pid;
+    int rc = ::posix_spawn(&pid, argv[0], &file_actions, /*attrp=*/nullptr,
+                           argv.data(), environ);
+    ::posix_spawn_file_actions_destroy(&file_actions);
+    EXPECT_EQ(rc, 0) << "posix_spawn failed";
+    if (rc != 0) {
+      return run_result{.status = -1, .output = ""};
+    }
+    int status;
+    ::waitpid(pid, &status, 0);
+
+    read_file_result output = read_file(output_path.c_str());
+    output.exit_if_not_ok();
+    string8_view output_string = output.content.string_view();
+    return run_result{
+        .status = status,
+        .output = std::string(
+            reinterpret_cast<const char *>(output_string.data()),
+            output_string.size()),
+    };
+  }
+
+  // Run quick-lint-js with different --jobs options, and check that the
+  // output and exit status match --jobs=1's.
+  void check_jobs_match_one_job(const std::vector<std::string> &files,
+                                const std::string &expected_one_job_output) {
+    auto run_with_jobs = [&](int jobs) -> run_result {
+      std::vector<std::string> arguments = {"--jobs=" + std::to_string(jobs)};
+      arguments.insert(arguments.end(), files.begin(), files.end());
+      return this->run_quick_lint_js(arguments);
+    };
+
+    run_result one_job = run_with_jobs(1);
+    EXPECT_THAT(one_job.output, HasSubstr(expected_one_job_output));
+    EXPECT_FALSE(WIFEXITED(one_job.status) && WEXITSTATUS(one_job.status) == 0)
+        << "quick-lint-js should fail";
+    for (int jobs : {2, 4, 8}) {
+      SCOPED_TRACE("--jobs=" + std::to_string(jobs));
+      // Workers race each other, so try a few times.
+      for (int attempt = 0; attempt < 5; ++attempt) {
+        run_result result = run_with_jobs(jobs);
+        EXPECT_EQ(result.output, one_job.output);
+        EXPECT_EQ(result.status, one_job.status);
+      }
+    }
+  }
+
+  filesystem::path temp_directory_;
+};
+
+TEST_F(test_main, jobs_match_one_job_after_fatal_error) {
+  std::vector<std::string> files;
+  for (int i = 0; i < 30; ++i) {
+    std::string name = "file" + std::to_string(i) + ".js";
+    // NOTE(strager): '??' is not implemented, so the parser reports a fatal
+    // error for it.
+    files.push_back(this->write_file(
+        name, i == 12 ? "let x; let x;\na ?? b;\n" : "let x; let x;\n"));
+  }
+  this->check_jobs_match_one_job(files, "fatal: token not implemented");
+}
+
+TEST_F(test_main, jobs_match_one_job_after_read_error) {
+  std::vector<std::string> files;
+  for (int i = 0; i < 30; ++i) {
+    std::string name = "file" + std::to_string(i) + ".js";
+    if (i == 12) {
+      // Don't create the file.
+      files.push_back((this->temp_directory_ / name).string());
+      continue;
+    }
+    files.push_back(this->write_file(
+        name, i == 20 ? "let x; let x;\na ?? b;\n" : "let x; let x;\n"));
+  }
+  this->check_jobs_match_one_job(files, "error: failed to open");
+}
+
+TEST_F(test_main, failing_to_write_output_fails) {
+  if (!filesystem::exists("/dev/full")) {
+    GTEST_SKIP() << "/dev/full is needed to make writes fail";
+  }
+  std::string file = this->write_file("hello.js", "let x; let x;\n");
+  run_result result = this->run_quick_lint_js(
+      {"--output-format=vim-qflist-json", file}, /*stdout_path=*/"/dev/full");
+  EXPECT_THAT(result.output, HasSubstr("error: failed to write output"));
+  EXPECT_TRUE(WIFEXITED(result.status));
+  EXPECT_EQ(WEXITSTATUS(result.status), 1);
+}
+#endif
+}
+}
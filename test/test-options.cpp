@@ -166,6 +166,100 @@ TEST(test_options, vim_file_bufnr) {
   }
 }
 
+TEST(test_options, jobs) {
+  {
+    options o = parse_options({"foo.js"});
+    EXPECT_EQ(o.jobs, 1);
+  }
+
+  {
+    options o = parse_options({"--jobs=8", "foo.js"});
+    EXPECT_THAT(o.error_unrecognized_options, IsEmpty());
+    EXPECT_EQ(o.jobs, 8);
+    ASSERT_EQ(o.files_to_lint.size(), 1);
+    EXPECT_EQ(o.files_to_lint[0].path, "foo.js"sv);
+  }
+
+  {
+    options o = parse_options({"--jobs", "3", "foo.js"});
+    EXPECT_THAT(o.error_unrecognized_options, IsEmpty());
+    EXPECT_EQ(o.jobs, 3);
+  }
+}
+
+TEST(test_options, invalid_jobs) {
+  {
+    options o = parse_options({"--jobs=garbage", "foo.js"});
+    EXPECT_THAT(o.error_unrecognized_options, ElementsAre("garbage"sv));
+    EXPECT_EQ(o.jobs, 1) << "jobs should remain the default";
+  }
+
+  {
+    options o = parse_options({"--jobs=0", "foo.js"});
+    EXPECT_THAT(o.error_unrecognized_options, ElementsAre("0"sv));
+  }
+
+  {
+    options o = parse_options({"--jobs"});
+    EXPECT_THAT(o.error_unrecognized_options, ElementsAre("--jobs"sv));
+  }
+}
+
+TEST(test_options, server) {
+  {
+    options o = parse_options({"foo.js"});
+    EXPECT_EQ(o.server_socket_path, nullptr);
+    EXPECT_EQ(o.client_socket_path, nullptr);
+  }
+
+  {
+    options o = parse_options({"--server=/tmp/qljs.sock"});
+    EXPECT_THAT(o.error_unrecognized_options, IsEmpty());
+    EXPECT_EQ(o.server_socket_path, "/tmp/qljs.sock"sv);
+    EXPECT_THAT(o.files_to_lint, IsEmpty());
+  }
+
+  {
+    options o = parse_options({"--client", "/tmp/qljs.sock", "foo.js"});
+    EXPECT_THAT(o.error_unrecognized_options, IsEmpty());
+    EXPECT_EQ(o.client_socket_path, "/tmp/qljs.sock"sv);
+    ASSERT_EQ(o.files_to_lint.size(), 1);
+    EXPECT_EQ(o.files_to_lint[0].path, "foo.js"sv);
+  }
+}
+
+TEST(test_options, lsp_server) {
+  {
+    options o = parse_options({"foo.js"});
+    EXPECT_FALSE(o.lsp_server);
+  }
+
+  {
+    options o = parse_options({"--lsp"});
+    EXPECT_THAT(o.error_unrecognized_options, IsEmpty());
+    EXPECT_TRUE(o.lsp_server);
+    EXPECT_THAT(o.files_to_lint, IsEmpty());
+  }
+}
+
+TEST(test_options, cache) {
+  {
+    options o = parse_options({"foo.js"});
+    EXPECT_EQ(o.cache_directory, nullptr);
+    EXPECT_FALSE(o.print_cache_stats);
+  }
+
+  {
+    options o = parse_options(
+        {"--cache-dir=/tmp/qljs-cache", "--cache-stats", "foo.js"});
+    EXPECT_THAT(o.error_unrecognized_options, IsEmpty());
+    EXPECT_EQ(o.cache_directory, "/tmp/qljs-cache"sv);
+    EXPECT_TRUE(o.print_cache_stats);
+    ASSERT_EQ(o.files_to_lint.size(), 1);
+    EXPECT_EQ(o.files_to_lint[0].path, "foo.js"sv);
+  }
+}
+
 TEST(test_options, print_help) {
   {
     options o = parse_options({"--help"});
@@ -0,0 +1,81 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <climits>
+#include <gtest/gtest.h>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/output-stream.h>
+
+namespace quick_lint_js {
+namespace {
+TEST(test_output_stream, appended_data_is_not_visible_until_flush) {
+  memory_output_stream s;
+  s.append_copy(u8"hello");
+  s.append_copy(u8' ');
+  s.append_copy(u8"world");
+  EXPECT_EQ(s.get_flushed_string8(), u8"");
+
+  s.flush();
+  EXPECT_EQ(s.get_flushed_string8(), u8"hello world");
+}
+
+TEST(test_output_stream, flush_with_empty_buffer_does_nothing) {
+  memory_output_stream s;
+  s.flush();
+  s.flush();
+  EXPECT_EQ(s.get_flushed_string8(), u8"");
+}
+
+TEST(test_output_stream, append_decimal_integer) {
+  for (int value : {0, 1, 9, 10, 42, 1234567890, -1, -10, INT_MAX, INT_MIN}) {
+    SCOPED_TRACE(value);
+    memory_output_stream s;
+    s.append_decimal_integer(value);
+    s.flush();
+    std::string expected = std::to_string(value);
+    EXPECT_EQ(s.get_flushed_string8(),
+              string8(expected.begin(), expected.end()));
+  }
+}
+
+TEST(test_output_stream, filling_buffer_flushes_automatically) {
+  memory_output_stream s;
+  for (std::size_t i = 0; i < output_stream::buffer_size; ++i) {
+    s.append_copy(u8'x');
+  }
+  EXPECT_EQ(s.get_flushed_string8(), u8"");
+
+  s.append_copy(u8'y');
+  EXPECT_EQ(s.get_flushed_string8(),
+            string8(output_stream::buffer_size, u8'x'));
+
+  s.flush();
+  EXPECT_EQ(s.get_flushed_string8(),
+            string8(output_stream::buffer_size, u8'x') + u8'y');
+}
+
+TEST(test_output_stream, appending_large_string_keeps_order) {
+  string8 big(output_stream::buffer_size * 3, u8'b');
+
+  memory_output_stream s;
+  s.append_copy(u8"before");
+  s.append_copy(big);
+  s.append_copy(u8"after");
+  s.flush();
+  EXPECT_EQ(s.get_flushed_string8(), u8"before" + big + u8"after");
+}
+}
+}
@@ -66,6 +66,33 @@ TEST(test_padded_string, resize_with_smaller_size_removes_characters) {
   expect_null_terminated(s);
 }
 
+TEST(test_padded_string, replace_text_with_longer_text) {
+  padded_string s(u8"hello world");
+
+  s.replace_text(6, 11, u8"everyone");
+
+  EXPECT_EQ(s, string8_view(u8"hello everyone"));
+  expect_null_terminated(s);
+}
+
+TEST(test_padded_string, replace_text_with_shorter_text) {
+  padded_string s(u8"hello world");
+
+  s.replace_text(0, 6, u8"");
+
+  EXPECT_EQ(s, string8_view(u8"world"));
+  expect_null_terminated(s);
+}
+
+TEST(test_padded_string, replace_text_can_insert) {
+  padded_string s(u8"helloworld");
+
+  s.replace_text(5, 5, u8", ");
+
+  EXPECT_EQ(s, string8_view(u8"hello, world"));
+  expect_null_terminated(s);
+}
+
 TEST(test_padded_string, comparing_with_string_view_excludes_padding_bytes) {
   EXPECT_TRUE(padded_string(string8(u8"hello")) == string8_view(u8"hello"));
 }
@@ -0,0 +1,81 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <quick-lint-js/parallel.h>
+#include <thread>
+#include <vector>
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+namespace quick_lint_js {
+namespace {
+TEST(test_parallel, consumes_results_in_order) {
+  for (int thread_count : {1, 2, 3, 8}) {
+    SCOPED_TRACE(thread_count);
+    std::vector<int> consumed_items;
+    std::vector<int> consumed_results;
+    for_each_in_parallel_in_order<int>(
+        /*item_count=*/100, /*thread_count=*/thread_count,
+        /*produce=*/
+        [](int i) -> int {
+          if (i % 7 == 0) {
+            // Encourage out-of-order completion.
+            std::this_thread::yield();
+          }
+          return i * 10;
+        },
+        /*consume=*/
+        [&](int i, int &&result) -> void {
+          consumed_items.emplace_back(i);
+          consumed_results.emplace_back(result);
+        });
+
+    ASSERT_EQ(consumed_items.size(), 100);
+    for (int i = 0; i < 100; ++i) {
+      EXPECT_EQ(consumed_items[static_cast<std::size_t>(i)], i);
+      EXPECT_EQ(consumed_results[static_cast<std::size_t>(i)], i * 10);
+    }
+  }
+}
+
+TEST(test_parallel, no_items) {
+  for (int thread_count : {1, 4}) {
+    std::vector<int> consumed_items;
+    for_each_in_parallel_in_order<int>(
+        /*item_count=*/0, /*thread_count=*/thread_count,
+        /*produce=*/[](int i) -> int { return i; },
+        /*consume=*/
+        [&](int i, int &&) -> void { consumed_items.emplace_back(i); });
+    EXPECT_THAT(consumed_items, IsEmpty());
+  }
+}
+
+TEST(test_parallel, more_threads_than_items) {
+  std::vector<int> consumed_results;
+  for_each_in_parallel_in_order<int>(
+      /*item_count=*/2, /*thread_count=*/16,
+      /*produce=*/[](int i) -> int { return i + 1; },
+      /*consume=*/
+      [&](int, int &&result) -> void {
+        consumed_results.emplace_back(result);
+      });
+  EXPECT_THAT(consumed_results, ElementsAre(1, 2));
+}
+}
+}
@@ -0,0 +1,190 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/error.h>
+#include <quick-lint-js/padded-string.h>
+#include <quick-lint-js/parse-parallel.h>
+#include <quick-lint-js/parse.h>
+#include <quick-lint-js/spy-visitor.h>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+namespace quick_lint_js {
+namespace {
+// Like spy_visitor, but also records where errors were reported relative to
+// visits.
+struct ordered_spy_visitor : public spy_visitor {
+#define QLJS_ERROR_TYPE(name, struct_body, format_call) \
+  void report(name e) override {                        \
+    this->visits.emplace_back(#name);                   \
+    spy_visitor::report(std::move(e));                  \
+  }
+  QLJS_X_ERROR_TYPES
+#undef QLJS_ERROR_TYPE
+
+  void report_fatal_error_unimplemented_character(const char *, int,
+                                                  const char *,
+                                                  const char8 *) override {
+    this->visits.emplace_back("report_fatal_error_unimplemented_character");
+  }
+  void report_fatal_error_unimplemented_token(const char *, int, const char *,
+                                              token_type,
+                                              const char8 *) override {
+    this->visits.emplace_back("report_fatal_error_unimplemented_token");
+  }
+};
+
+std::vector<string8> names(const std::vector<spy_visitor::visited_variable_use>
+                               &uses) {
+  std::vector<string8> result;
+  for (const auto &use : uses) {
+    result.emplace_back(use.name);
+  }
+  return result;
+}
+
+void expect_same_as_parse_and_visit_module(const string8 &code) {
+  padded_string expected_input(code.c_str());
+  ordered_spy_visitor expected;
+  parser p(&expected_input, &expected);
+  p.parse_and_visit_module(expected);
+
+  for (int thread_count : {1, 2, 4}) {
+    SCOPED_TRACE(thread_count);
+    padded_string input(code.c_str());
+    ordered_spy_visitor v;
+    parse_and_visit_module_in_parallel(&input, &v, v, thread_count);
+    EXPECT_EQ(v.visits, expected.visits);
+    EXPECT_EQ(names(v.variable_uses), names(expected.variable_uses));
+    EXPECT_EQ(v.errors.size(), expected.errors.size());
+  }
+}
+
+TEST(test_parse_parallel, visits_and_errors_are_in_sequential_order) {
+  for (const char8 *code : {
+           u8"",
+           u8"function f(a) { let b = a; return b; }",
+           u8"function f() { x = 0x; y; }\nfunction g() { z }",
+           u8"let f = function() { let x; x y; };\nlet g = () => { w; };",
+           u8"class C { m() { this.x = y; } static n() { z; } }",
+           u8"function outer() { function inner() { let x = `${y}`; } }",
+           u8"function f() { let w\\u{61}t = 1; return wat; }",
+           u8"let \\u{61} = 1; function f() { return \\u{61}; }",
+           u8"function f() { return /}/.test(s); } after;",
+           u8"x = 0b; function f() { y = 0b; } z = 0b;",
+           u8"function f() {}0b;",
+           // Workers must not rewrite escape sequences after a body.
+           u8"function f() {}\n\\u{76}ar x = \\u0061;",
+           // f(x) looks like a function heading, but the block is not a
+           // function body. The worker's rewrites must not leak.
+           u8"f(x)\n{ \\u{76}ar y = w\\u{61}t; }\n"
+           u8"function g() { \\u{61}; }",
+       }) {
+    SCOPED_TRACE(out_string8(code));
+    expect_same_as_parse_and_visit_module(code);
+  }
+}
+
+TEST(test_parse_parallel, many_functions_are_split_across_tasks) {
+  string8 code;
+  for (int i = 0; i < 3000; ++i) {
+    code += u8"function f(a, b) { let c = a + b; return g(c, d); }\n";
+    if (i % 1000 == 0) {
+      code += u8"function h() { let x x; }\n";
+    }
+  }
+  expect_same_as_parse_and_visit_module(code);
+}
+
+TEST(test_parse_parallel, fatal_error_in_body_is_reported_in_order) {
+  string8 code = u8"let x; let x;\n";
+  for (int i = 0; i < 3000; ++i) {
+    code += u8"function f(a, b) { let c = a + b; return g(c, d); }\n";
+    if (i == 1500) {
+      // The parser does not implement '??'.
+      code += u8"function h() { let y y; a ?? b; }\n";
+    }
+  }
+
+  padded_string expected_input(code.c_str());
+  ordered_spy_visitor expected;
+  bool expected_ok = catch_fatal_parse_errors([&]() -> void {
+    parser p(&expected_input, &expected);
+    p.parse_and_visit_module(expected);
+  });
+  ASSERT_FALSE(expected_ok);
+
+  for (int thread_count : {2, 4}) {
+    SCOPED_TRACE(thread_count);
+    padded_string input(code.c_str());
+    ordered_spy_visitor v;
+    bool ok = catch_fatal_parse_errors([&]() -> void {
+      parse_and_visit_module_in_parallel(&input, &v, v, thread_count);
+    });
+    EXPECT_FALSE(ok);
+    EXPECT_EQ(v.visits, expected.visits);
+    EXPECT_EQ(v.errors.size(), expected.errors.size());
+  }
+}
+
+TEST(test_parse_parallel, workers_do_not_modify_input) {
+  string8 code;
+  for (int i = 0; i < 3000; ++i) {
+    code += u8"function f() { let w\\u{61}t = 1; return wat; }\n";
+    code += u8"function g(a, b) { let c = a + b; return c; }\n";
+  }
+  padded_string input(code.c_str());
+  std::vector<parsed_function_body> bodies =
+      parse_function_bodies_in_parallel(&input, /*thread_count=*/4);
+  EXPECT_EQ(string8_view(code), input);
+  // Bodies with escape sequences in identifiers are left to the caller's
+  // parser.
+  EXPECT_EQ(bodies.size(), 3000);
+  for (const parsed_function_body &body : bodies) {
+    EXPECT_EQ(body.span.string_view(), u8"{ let c = a + b; return c; }");
+  }
+}
+
+TEST(test_parse_parallel, finds_bodies_of_module_level_functions) {
+  padded_string code(
+      u8"function f() { function g() {} }\n"
+      u8"let h = () => { return 1; };\n"
+      u8"if (x) { function i() { i(); } }");
+  std::vector<parsed_function_body> bodies =
+      parse_function_bodies_in_parallel(&code, /*thread_count=*/2);
+  ASSERT_EQ(bodies.size(), 3);
+  EXPECT_EQ(bodies[0].span.string_view(), u8"{ function g() {} }");
+  EXPECT_EQ(bodies[1].span.string_view(), u8"{ return 1; }");
+  EXPECT_EQ(bodies[2].span.string_view(), u8"{ i(); }");
+
+  ASSERT_EQ(bodies[0].chunks.size(), 1);
+  spy_visitor v;
+  bodies[0].chunks[0].visits.move_into(v);
+  EXPECT_THAT(v.visits, ElementsAre("visit_variable_declaration",       // g
+                                    "visit_enter_function_scope",       //
+                                    "visit_enter_function_scope_body",  //
+                                    "visit_exit_function_scope"));
+  EXPECT_TRUE(bodies[0].chunks[0].errors.empty());
+}
+}
+}
@@ -22,6 +22,7 @@
 #include <quick-lint-js/error.h>
 #include <quick-lint-js/language.h>
 #include <quick-lint-js/location.h>
+#include <quick-lint-js/null-visitor.h>
 #include <quick-lint-js/padded-string.h>
 #include <quick-lint-js/parse.h>
 #include <quick-lint-js/spy-visitor.h>
@@ -2478,5 +2479,182 @@ TEST(test_parse, variables_can_be_named_private_protected_public_static) {
     }
   }
 }
+
+TEST(test_parse, skip_function_bodies) {
+  spy_visitor v;
+  padded_string code(
+      u8"function f(x) { let y = x.z; g(y); }\n"
+      u8"let a = (b) => { return b; };\n"
+      u8"o = {m() { h(); }};\n"
+      u8"after;");
+  parser p(&code, &v);
+  p.set_skip_function_bodies(true);
+  p.parse_and_visit_module(v);
+  EXPECT_THAT(v.errors, IsEmpty());
+
+  EXPECT_THAT(v.visits, ElementsAre("visit_variable_declaration",  // f
+                                    "visit_enter_function_scope",  //
+                                    "visit_variable_declaration",  // x
+                                    "visit_enter_function_scope_body",  //
+                                    "visit_exit_function_scope",        //
+                                    "visit_enter_function_scope",       //
+                                    "visit_variable_declaration",       // b
+                                    "visit_enter_function_scope_body",  //
+                                    "visit_exit_function_scope",        //
+                                    "visit_variable_declaration",       // a
+                                    "visit_enter_function_scope",       //
+                                    "visit_enter_function_scope_body",  //
+                                    "visit_exit_function_scope",        //
+                                    "visit_variable_assignment",        // o
+                                    "visit_variable_use",        // after
+                                    "visit_end_of_module"));
+
+  const std::vector<skipped_function_body> &bodies =
+      p.skipped_function_bodies();
+  ASSERT_EQ(bodies.size(), 3);
+  EXPECT_EQ(bodies[0].span.string_view(), u8"{ let y = x.z; g(y); }");
+  EXPECT_EQ(bodies[1].span.string_view(), u8"{ return b; }");
+  EXPECT_EQ(bodies[2].span.string_view(), u8"{ h(); }");
+}
+
+TEST(test_parse, skip_function_bodies_with_curlies_in_literals) {
+  for (const char8 *body : {
+           u8"{ return /}/.test(s); }",
+           u8"{ return s.split(/}/g); }",
+           u8"{ return `}${ {k: '}'}.k }}${s}`; }",
+           u8"{ return x / y / z; }",
+           u8"{ return '}' + \"}\"; }",
+           u8"{ /* } */ // }\n }",
+       }) {
+    string8 code = u8"function f() " + string8(body) + u8"\nafter;";
+    SCOPED_TRACE(out_string8(code));
+    spy_visitor v;
+    padded_string input(code.c_str());
+    parser p(&input, &v);
+    p.set_skip_function_bodies(true);
+    p.parse_and_visit_module(v);
+    EXPECT_THAT(v.errors, IsEmpty());
+    ASSERT_EQ(p.skipped_function_bodies().size(), 1);
+    EXPECT_EQ(p.skipped_function_bodies()[0].span.string_view(), body);
+    ASSERT_EQ(v.variable_uses.size(), 1);
+    EXPECT_EQ(v.variable_uses[0].name, u8"after");
+  }
+}
+
+TEST(test_parse, skip_function_bodies_gives_up_on_ambiguous_bodies) {
+  for (const char8 *body : {
+           // '/' after a condition's ')' or after a '}' might be division or
+           // a regular expression.
+           u8"{ if (s) /}/.test(s); }",
+           u8"{ if (x) { y(); }\n /}/.test(s); }",
+           // Skipping would rewrite the escape sequences, hiding them from the
+           // parser.
+           u8"{ \\u{76}ar x; }",
+           u8"{ return w\\u{61}t; }",
+       }) {
+    string8 code = u8"function f() " + string8(body) + u8"\nafter;";
+    SCOPED_TRACE(out_string8(code));
+
+    padded_string expected_input(code.c_str());
+    spy_visitor expected;
+    parser expected_p(&expected_input, &expected);
+    expected_p.parse_and_visit_module(expected);
+
+    padded_string input(code.c_str());
+    spy_visitor v;
+    parser p(&input, &v);
+    p.set_skip_function_bodies(true);
+    p.parse_and_visit_module(v);
+    EXPECT_THAT(p.skipped_function_bodies(), IsEmpty());
+    EXPECT_EQ(v.visits, expected.visits);
+    EXPECT_EQ(v.variable_uses, expected.variable_uses);
+    EXPECT_EQ(v.errors.size(), expected.errors.size());
+  }
+}
+
+TEST(test_parse, parse_skipped_function_body_later) {
+  spy_visitor v;
+  padded_string code(u8"function f() { let x = 1__0; function g() {} }");
+  parser p(&code, &v);
+  p.set_skip_function_bodies(true);
+  p.parse_and_visit_module(v);
+  EXPECT_THAT(v.errors, IsEmpty());
+  ASSERT_EQ(p.skipped_function_bodies().size(), 1);
+
+  spy_visitor body_v;
+  p.parse_and_visit_skipped_function_body(p.skipped_function_bodies()[0],
+                                          body_v);
+  EXPECT_THAT(body_v.visits,
+              ElementsAre("visit_variable_declaration",       // x
+                          "visit_variable_declaration",       // g
+                          "visit_enter_function_scope",       //
+                          "visit_enter_function_scope_body",  //
+                          "visit_exit_function_scope"));
+  EXPECT_THAT(
+      v.errors,
+      ElementsAre(ERROR_TYPE_FIELD(
+          error_number_literal_contains_consecutive_underscores, underscores,
+          offsets_matcher(&code, 24, 26))));
+  EXPECT_EQ(p.skipped_function_bodies().size(), 1)
+      << "nested function bodies should be parsed, not skipped";
+  EXPECT_EQ(p.lexer().peek().type, token_type::end_of_file);
+}
+
+TEST(test_parse, catch_fatal_parse_errors_keeps_errors_before_fatal_error) {
+  struct fatal_error_counting_visitor : public spy_visitor {
+    void report_fatal_error_unimplemented_character(const char *, int,
+                                                    const char *,
+                                                    const char8 *) override {
+      this->fatal_error_count += 1;
+    }
+    void report_fatal_error_unimplemented_token(const char *, int,
+                                                const char *, token_type,
+                                                const char8 *) override {
+      this->fatal_error_count += 1;
+    }
+
+    int fatal_error_count = 0;
+  };
+
+  for (const char8 *code : {u8"1__0; if (", u8"1__0; \u20ac"}) {
+    SCOPED_TRACE(out_string8(code));
+    fatal_error_counting_visitor v;
+    padded_string input(code);
+    bool ok = catch_fatal_parse_errors([&]() -> void {
+      parser p(&input, &v);
+      p.parse_and_visit_module(v);
+    });
+    EXPECT_FALSE(ok);
+    EXPECT_EQ(v.fatal_error_count, 1);
+    EXPECT_THAT(
+        v.errors,
+        ElementsAre(ERROR_TYPE_FIELD(
+            error_number_literal_contains_consecutive_underscores, underscores,
+            offsets_matcher(&input, 1, 3))));
+  }
+}
+
+TEST(test_parse, catch_fatal_parse_errors_catches_fatal_error_in_first_token) {
+  padded_string code(u8"\u20ac");
+  bool ok = catch_fatal_parse_errors([&]() -> void {
+    parser p(&code, &null_error_reporter::instance);
+    null_visitor v;
+    p.parse_and_visit_module(v);
+  });
+  EXPECT_FALSE(ok);
+}
+
+TEST(test_parse, catch_fatal_parse_errors_returns_true_without_fatal_error) {
+  spy_visitor v;
+  padded_string code(u8"x;");
+  bool ok = catch_fatal_parse_errors([&]() -> void {
+    parser p(&code, &v);
+    p.parse_and_visit_module(v);
+  });
+  EXPECT_TRUE(ok);
+  EXPECT_THAT(v.errors, IsEmpty());
+  EXPECT_THAT(v.visits, ElementsAre("visit_variable_use",  // x
+                                    "visit_end_of_module"));
+}
 }
 }
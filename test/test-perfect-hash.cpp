@@ -0,0 +1,61 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <array>
+#include <gtest/gtest.h>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/perfect-hash.h>
+
+namespace quick_lint_js {
+namespace {
+TEST(test_perfect_hash, fnv_1a_64_matches_reference_values) {
+  EXPECT_EQ(hash_fnv_1a_64(u8""), 0xcbf29ce484222325ULL);
+  EXPECT_EQ(hash_fnv_1a_64(u8"a"), 0xaf63dc4c8601ec8cULL);
+  EXPECT_EQ(hash_fnv_1a_64(u8"foobar"), 0x85944171f73967e8ULL);
+}
+
+TEST(test_perfect_hash, finds_every_key) {
+  static constexpr std::array<string8_view, 5> keys = {
+      u8"Array", u8"Map", u8"require", u8"undefined", u8"x",
+  };
+  static constexpr perfect_hash_table<keys.size(), 6> table(keys);
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_EQ(table.find(keys[i]), static_cast<int>(i)) << out_string8(keys[i]);
+  }
+}
+
+TEST(test_perfect_hash, does_not_find_other_strings) {
+  static constexpr std::array<string8_view, 3> keys = {
+      u8"Array",
+      u8"Map",
+      u8"require",
+  };
+  static constexpr perfect_hash_table<keys.size(), 4> table(keys);
+  for (string8_view other : {u8"", u8"Arra", u8"Arrays", u8"map", u8"y",
+                             u8"requirement", u8"undefined"}) {
+    EXPECT_EQ(table.find(other), -1) << out_string8(other);
+  }
+}
+
+TEST(test_perfect_hash, lookup_works_at_compile_time) {
+  static constexpr std::array<string8_view, 2> keys = {u8"hello", u8"world"};
+  static constexpr perfect_hash_table<keys.size(), 4> table(keys);
+  static_assert(table.find(u8"hello") == 0);
+  static_assert(table.find(u8"world") == 1);
+  static_assert(table.find(u8"nope") == -1);
+}
+}
+}
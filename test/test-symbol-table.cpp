@@ -0,0 +1,98 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/symbol-table.h>
+#include <string>
+#include <vector>
+
+namespace quick_lint_js {
+namespace {
+TEST(test_symbol_table, interning_same_name_gives_same_symbol) {
+  symbol_table symbols;
+  symbol_id x = symbols.intern(u8"x");
+  symbol_id y = symbols.intern(u8"y");
+  EXPECT_NE(x, y);
+  EXPECT_EQ(symbols.intern(u8"x"), x);
+  EXPECT_EQ(symbols.intern(u8"y"), y);
+  EXPECT_EQ(symbols.size(), 2);
+}
+
+TEST(test_symbol_table, symbols_are_dense) {
+  symbol_table symbols;
+  EXPECT_EQ(symbols.intern(u8"a"), 0);
+  EXPECT_EQ(symbols.intern(u8"b"), 1);
+  EXPECT_EQ(symbols.intern(u8"a"), 0);
+  EXPECT_EQ(symbols.intern(u8"c"), 2);
+}
+
+TEST(test_symbol_table, name_is_copied) {
+  symbol_table symbols;
+  string8 name = u8"hello";
+  symbol_id hello = symbols.intern(name);
+  name[0] = u8'j';
+  EXPECT_EQ(symbols.name(hello), u8"hello");
+  EXPECT_EQ(symbols.find(u8"jello"), symbol_table::invalid_symbol);
+  EXPECT_EQ(symbols.find(u8"hello"), hello);
+}
+
+TEST(test_symbol_table, empty_name) {
+  symbol_table symbols;
+  symbol_id empty = symbols.intern(u8"");
+  EXPECT_EQ(symbols.intern(u8""), empty);
+  EXPECT_EQ(symbols.name(empty), u8"");
+}
+
+TEST(test_symbol_table, names_are_case_sensitive_and_length_sensitive) {
+  symbol_table symbols;
+  symbol_id map = symbols.intern(u8"map");
+  EXPECT_NE(symbols.intern(u8"Map"), map);
+  EXPECT_NE(symbols.intern(u8"ma"), map);
+  EXPECT_NE(symbols.intern(u8"maps"), map);
+}
+
+TEST(test_symbol_table, many_names_survive_growing) {
+  symbol_table symbols;
+  std::vector<symbol_id> ids;
+  for (int i = 0; i < 10000; ++i) {
+    std::string name = "v" + std::to_string(i);
+    ids.push_back(symbols.intern(string8(name.begin(), name.end())));
+  }
+  EXPECT_EQ(symbols.size(), 10000);
+  for (int i = 0; i < 10000; ++i) {
+    std::string name = "v" + std::to_string(i);
+    string8 name8(name.begin(), name.end());
+    symbol_id id = ids[static_cast<std::size_t>(i)];
+    EXPECT_EQ(symbols.find(name8), id);
+    EXPECT_EQ(symbols.name(id), name8);
+  }
+}
+
+TEST(test_symbol_table, clear_forgets_symbols) {
+  symbol_table symbols;
+  symbols.intern(u8"first");
+  symbols.intern(u8"second");
+  symbols.clear();
+  EXPECT_EQ(symbols.size(), 0);
+  EXPECT_EQ(symbols.find(u8"first"), symbol_table::invalid_symbol);
+
+  symbol_id second = symbols.intern(u8"second");
+  EXPECT_EQ(second, 0);
+  EXPECT_EQ(symbols.name(second), u8"second");
+}
+}
+}
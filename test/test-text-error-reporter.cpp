@@ -18,28 +18,36 @@
 #include <gtest/gtest.h>
 #include <quick-lint-js/char8.h>
 #include <quick-lint-js/location.h>
+#include <quick-lint-js/output-stream.h>
 #include <quick-lint-js/padded-string.h>
 #include <quick-lint-js/text-error-reporter.h>
-#include <sstream>
+#include <string>
 
 namespace quick_lint_js {
 namespace {
+std::string flush_and_get_string(memory_output_stream &stream) {
+  stream.flush();
+  string8 output = stream.get_flushed_string8();
+  return std::string(reinterpret_cast<const char *>(output.data()),
+                     output.size());
+}
+
 class test_text_error_reporter : public ::testing::Test {
  protected:
   text_error_reporter make_reporter() {
-    return text_error_reporter(this->stream_);
+    return text_error_reporter(&this->stream_);
   }
 
   text_error_reporter make_reporter(padded_string_view input) {
-    text_error_reporter reporter(this->stream_);
+    text_error_reporter reporter(&this->stream_);
     reporter.set_source(input, this->file_path_);
     return reporter;
   }
 
-  std::string get_output() { return this->stream_.str(); }
+  std::string get_output() { return flush_and_get_string(this->stream_); }
 
  private:
-  std::ostringstream stream_;
+  memory_output_stream stream_;
   static constexpr const char *file_path_ = "FILE";
 };
 
@@ -358,25 +366,26 @@ TEST(test_text_error_formatter, single_span_simple_message) {
   padded_string code(u8"hello world");
   quick_lint_js::locator locator(&code);
 
-  std::ostringstream stream;
-  text_error_formatter(stream, "FILE", locator)
+  memory_output_stream stream;
+  text_error_formatter(&stream, "FILE", locator)
       .error(u8"something happened", source_code_span(&code[0], &code[5]))
       .end();
 
-  EXPECT_EQ(stream.str(), "FILE:1:1: error: something happened\n");
+  EXPECT_EQ(flush_and_get_string(stream),
+            "FILE:1:1: error: something happened\n");
 }
 
 TEST(test_text_error_formatter, message_with_note) {
   padded_string code(u8"hello world");
   quick_lint_js::locator locator(&code);
 
-  std::ostringstream stream;
-  text_error_formatter(stream, "FILE", locator)
+  memory_output_stream stream;
+  text_error_formatter(&stream, "FILE", locator)
       .error(u8"something happened", source_code_span(&code[0], &code[5]))
       .note(u8"see here", source_code_span(&code[6], &code[11]))
       .end();
 
-  EXPECT_EQ(stream.str(),
+  EXPECT_EQ(flush_and_get_string(stream),
             "FILE:1:1: error: something happened\nFILE:1:7: note: see here\n");
 }
 
@@ -384,25 +393,27 @@ TEST(test_text_error_formatter, message_with_zero_placeholder) {
   padded_string code(u8"hello world");
   quick_lint_js::locator locator(&code);
 
-  std::ostringstream stream;
-  text_error_formatter(stream, "FILE", locator)
+  memory_output_stream stream;
+  text_error_formatter(&stream, "FILE", locator)
       .error(u8"this {0} looks fishy", source_code_span(&code[0], &code[5]))
       .end();
 
-  EXPECT_EQ(stream.str(), "FILE:1:1: error: this hello looks fishy\n");
+  EXPECT_EQ(flush_and_get_string(stream),
+            "FILE:1:1: error: this hello looks fishy\n");
 }
 
 TEST(test_text_error_formatter, message_with_extra_identifier_placeholder) {
   padded_string code(u8"hello world");
   quick_lint_js::locator locator(&code);
 
-  std::ostringstream stream;
-  text_error_formatter(stream, "FILE", locator)
+  memory_output_stream stream;
+  text_error_formatter(&stream, "FILE", locator)
       .error(u8"this {1} looks fishy", source_code_span(&code[0], &code[5]),
              identifier(source_code_span(&code[6], &code[11])))
       .end();
 
-  EXPECT_EQ(stream.str(), "FILE:1:1: error: this world looks fishy\n");
+  EXPECT_EQ(flush_and_get_string(stream),
+            "FILE:1:1: error: this world looks fishy\n");
 }
 
 TEST(test_text_error_formatter, message_with_multiple_span_placeholders) {
@@ -415,12 +426,13 @@ TEST(test_text_error_formatter, message_with_multiple_span_placeholders) {
   source_code_span be_span(&code[9], &code[11]);
   ASSERT_EQ(be_span.string_view(), u8"be");
 
-  std::ostringstream stream;
-  text_error_formatter(stream, "FILE", locator)
+  memory_output_stream stream;
+  text_error_formatter(&stream, "FILE", locator)
       .error(u8"free {1} and {0} {1} {2}", let_span, me_span, be_span)
       .end();
 
-  EXPECT_EQ(stream.str(), "FILE:1:1: error: free me and let me be\n");
+  EXPECT_EQ(flush_and_get_string(stream),
+            "FILE:1:1: error: free me and let me be\n");
 }
 }
 }
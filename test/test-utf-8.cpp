@@ -0,0 +1,138 @@
+// quick-lint-js finds bugs in JavaScript programs.
+// Copyright (C) 2020  Matthew Glazar
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <quick-lint-js/char8.h>
+#include <quick-lint-js/padded-string.h>
+#include <quick-lint-js/unicode-identifier-table.h>
+#include <quick-lint-js/utf-8.h>
+
+namespace quick_lint_js {
+namespace {
+decode_utf_8_result decode(const char8* input) {
+  padded_string padded(input);
+  return decode_utf_8(padded.data());
+}
+
+TEST(test_utf_8, decode_ascii) {
+  decode_utf_8_result result = decode(u8"a");
+  EXPECT_TRUE(result.ok);
+  EXPECT_EQ(result.size, 1);
+  EXPECT_EQ(std::uint32_t{result.code_point}, std::uint32_t{U'a'});
+}
+
+TEST(test_utf_8, decode_multi_byte_sequences) {
+  struct test_case {
+    const char8* input;
+    int size;
+    char32_t code_point;
+  };
+  for (const test_case& test : {
+           test_case{u8"\u0080", 2, 0x80},
+           test_case{u8"é", 2, 0xe9},
+           test_case{u8"߿", 2, 0x7ff},
+           test_case{u8"ࠀ", 3, 0x800},
+           test_case{u8"日", 3, 0x65e5},
+           test_case{u8"￿", 3, 0xffff},
+           test_case{u8"\U00010000", 4, 0x10000},
+           test_case{u8"\U0001d400", 4, 0x1d400},
+           test_case{u8"\U0010ffff", 4, 0x10ffff},
+       }) {
+    decode_utf_8_result result = decode(test.input);
+    EXPECT_TRUE(result.ok);
+    EXPECT_EQ(result.size, test.size);
+    EXPECT_EQ(std::uint32_t{result.code_point}, std::uint32_t{test.code_point});
+  }
+}
+
+TEST(test_utf_8, decode_invalid_sequences) {
+  for (const char* input : {
+           "\x80",              // Lone continuation byte.
+           "\xc0\x80",          // Overlong U+0000.
+           "\xc1\xbf",          // Overlong U+007F.
+           "\xe0\x9f\xbf",      // Overlong U+07FF.
+           "\xf0\x8f\xbf\xbf",  // Overlong U+FFFF.
+           "\xed\xa0\x80",      // Surrogate U+D800.
+           "\xed\xbf\xbf",      // Surrogate U+DFFF.
+           "\xf4\x90\x80\x80",  // U+110000.
+           "\xf5\x80\x80\x80",  // Invalid lead byte.
+           "\xff",              // Invalid lead byte.
+           "\xc3",              // Truncated.
+           "\xe6\x97",          // Truncated.
+           "\xf0\x9d\x90",      // Truncated.
+           "\xc3x",             // Missing continuation byte.
+       }) {
+    SCOPED_TRACE(input);
+    decode_utf_8_result result =
+        decode(reinterpret_cast<const char8*>(input));
+    EXPECT_FALSE(result.ok);
+    EXPECT_EQ(result.size, 1);
+  }
+}
+
+TEST(test_utf_8, encode_round_trips_through_decode) {
+  for (char32_t code_point :
+       {U'\0', U'a', U'\x7f', U'\x80', U'\xe9', U'\x7ff', U'\x800',
+        U'\x65e5', U'\xffff', U'\x10000', U'\x1d400', U'\x10ffff'}) {
+    SCOPED_TRACE(static_cast<unsigned long>(code_point));
+    padded_string buffer(u8"xxxx");
+    char8* end = encode_utf_8(code_point, buffer.data());
+    decode_utf_8_result result = decode_utf_8(buffer.data());
+    EXPECT_TRUE(result.ok);
+    EXPECT_EQ(result.size, end - buffer.data());
+    EXPECT_EQ(std::uint32_t{result.code_point}, std::uint32_t{code_point});
+  }
+}
+
+TEST(test_unicode_identifier_table, ascii) {
+  EXPECT_TRUE(is_unicode_id_start(U'a'));
+  EXPECT_TRUE(is_unicode_id_start(U'Z'));
+  EXPECT_FALSE(is_unicode_id_start(U'0'));
+  EXPECT_FALSE(is_unicode_id_start(U'_'));
+  EXPECT_FALSE(is_unicode_id_start(U'$'));
+  EXPECT_TRUE(is_unicode_id_continue(U'0'));
+  EXPECT_TRUE(is_unicode_id_continue(U'_'));
+  EXPECT_FALSE(is_unicode_id_continue(U'$'));
+  EXPECT_FALSE(is_unicode_id_continue(U' '));
+}
+
+TEST(test_unicode_identifier_table, non_ascii) {
+  EXPECT_TRUE(is_unicode_id_start(0xe9));     // Latin Small Letter E Acute
+  EXPECT_TRUE(is_unicode_id_start(0x65e5));   // CJK Unified Ideograph
+  EXPECT_TRUE(is_unicode_id_start(0x1d400));  // Mathematical Bold Capital A
+  EXPECT_TRUE(is_unicode_id_start(0x2118));   // Other_ID_Start
+  EXPECT_TRUE(is_unicode_id_start(0x16ee));   // Nl: Runic Arlaug Symbol
+
+  EXPECT_FALSE(is_unicode_id_start(0x301));  // Combining Acute Accent
+  EXPECT_TRUE(is_unicode_id_continue(0x301));
+  EXPECT_FALSE(is_unicode_id_start(0x663));  // Arabic-Indic Digit Three
+  EXPECT_TRUE(is_unicode_id_continue(0x663));
+  EXPECT_FALSE(is_unicode_id_start(0xb7));  // Other_ID_Continue
+  EXPECT_TRUE(is_unicode_id_continue(0xb7));
+
+  // U+2E2F Vertical Tilde is a letter (Lm) but is also Pattern_Syntax.
+  EXPECT_FALSE(is_unicode_id_start(0x2e2f));
+  EXPECT_FALSE(is_unicode_id_continue(0x2e2f));
+
+  EXPECT_FALSE(is_unicode_id_continue(0xa0));    // No-Break Space
+  EXPECT_FALSE(is_unicode_id_continue(0x3000));  // Ideographic Space
+  EXPECT_FALSE(is_unicode_id_continue(0xe000));  // Private Use
+  EXPECT_FALSE(is_unicode_id_continue(0x10ffff));
+  EXPECT_FALSE(is_unicode_id_continue(0x110000));
+}
+}
+}
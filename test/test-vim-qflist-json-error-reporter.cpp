@@ -18,16 +18,22 @@
 #include <json/reader.h>
 #include <json/value.h>
 #include <json/writer.h>
+#include <memory>
 #include <quick-lint-js/char8.h>
+#include <quick-lint-js/output-stream.h>
 #include <quick-lint-js/padded-string.h>
 #include <quick-lint-js/vim-qflist-json-error-reporter.h>
 #include <sstream>
+#include <string>
 
 namespace quick_lint_js {
 namespace {
-::Json::Value parse_json(std::stringstream &stream) {
+::Json::Value parse_json(memory_output_stream &output) {
+  output.flush();
+  string8 json = output.get_flushed_string8();
+  std::stringstream stream(
+      std::string(reinterpret_cast<const char *>(json.data()), json.size()));
   SCOPED_TRACE(stream.str());
-  stream.seekg(0);
   ::Json::Value root;
   ::Json::CharReaderBuilder builder;
   builder.strictMode(&builder.settings_);
@@ -40,30 +46,31 @@ namespace {
 class test_vim_qflist_json_error_reporter : public ::testing::Test {
  protected:
   vim_qflist_json_error_reporter make_reporter() {
-    return vim_qflist_json_error_reporter(this->stream_);
+    return vim_qflist_json_error_reporter(this->stream_.get());
   }
 
   vim_qflist_json_error_reporter make_reporter(padded_string_view input,
                                                int vim_bufnr) {
-    vim_qflist_json_error_reporter reporter(this->stream_);
+    vim_qflist_json_error_reporter reporter(this->stream_.get());
     reporter.set_source(input, /*vim_bufnr=*/vim_bufnr);
     return reporter;
   }
 
   vim_qflist_json_error_reporter make_reporter(padded_string_view input,
                                                const char *file_name) {
-    vim_qflist_json_error_reporter reporter(this->stream_);
+    vim_qflist_json_error_reporter reporter(this->stream_.get());
     reporter.set_source(input, /*file_name=*/file_name);
     return reporter;
   }
 
   ::Json::Value parse_json() {
-    ::Json::Value root = quick_lint_js::parse_json(this->stream_);
-    this->stream_ = std::stringstream();
+    ::Json::Value root = quick_lint_js::parse_json(*this->stream_);
+    this->stream_ = std::make_unique<memory_output_stream>();
     return root;
   }
 
-  std::stringstream stream_;
+  std::unique_ptr<memory_output_stream> stream_ =
+      std::make_unique<memory_output_stream>();
 };
 
 TEST_F(test_vim_qflist_json_error_reporter,
@@ -706,8 +713,8 @@ TEST(test_vim_qflist_json_error_formatter, single_span_simple_message) {
   padded_string code(u8"hello world");
   quick_lint_js::locator locator(&code);
 
-  std::stringstream stream;
-  vim_qflist_json_error_formatter(stream, locator, "FILE",
+  memory_output_stream stream;
+  vim_qflist_json_error_formatter(&stream, locator, "FILE",
                                   /*bufnr=*/std::string_view())
       .error(u8"something happened", source_code_span(&code[0], &code[5]))
       .end();
@@ -724,8 +731,8 @@ TEST(test_vim_qflist_json_error_formatter, message_with_note_ignores_note) {
   padded_string code(u8"hello world");
   quick_lint_js::locator locator(&code);
 
-  std::stringstream stream;
-  vim_qflist_json_error_formatter(stream, locator, "FILE",
+  memory_output_stream stream;
+  vim_qflist_json_error_formatter(&stream, locator, "FILE",
                                   /*bufnr=*/std::string_view())
       .error(u8"something happened", source_code_span(&code[0], &code[5]))
       .note(u8"see here", source_code_span(&code[6], &code[11]))
@@ -743,8 +750,8 @@ TEST(test_vim_qflist_json_error_formatter, message_with_zero_placeholder) {
   padded_string code(u8"hello world");
   quick_lint_js::locator locator(&code);
 
-  std::stringstream stream;
-  vim_qflist_json_error_formatter(stream, locator, "FILE",
+  memory_output_stream stream;
+  vim_qflist_json_error_formatter(&stream, locator, "FILE",
                                   /*bufnr=*/std::string_view())
       .error(u8"this {0} looks fishy", source_code_span(&code[0], &code[5]))
       .end();
@@ -758,8 +765,8 @@ TEST(test_vim_qflist_json_error_formatter,
   padded_string code(u8"hello world");
   quick_lint_js::locator locator(&code);
 
-  std::stringstream stream;
-  vim_qflist_json_error_formatter(stream, locator, "FILE",
+  memory_output_stream stream;
+  vim_qflist_json_error_formatter(&stream, locator, "FILE",
                                   /*bufnr=*/std::string_view())
       .error(u8"this {1} looks fishy", source_code_span(&code[0], &code[5]),
              identifier(source_code_span(&code[6], &code[11])))
@@ -780,8 +787,8 @@ TEST(test_vim_qflist_json_error_formatter,
   source_code_span be_span(&code[9], &code[11]);
   ASSERT_EQ(be_span.string_view(), u8"be");
 
-  std::stringstream stream;
-  vim_qflist_json_error_formatter(stream, locator, "FILE",
+  memory_output_stream stream;
+  vim_qflist_json_error_formatter(&stream, locator, "FILE",
                                   /*bufnr=*/std::string_view())
       .error(u8"free {1} and {0} {1} {2}", let_span, me_span, be_span)
       .end();